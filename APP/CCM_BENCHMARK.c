@@ -0,0 +1,142 @@
+/**
+ * @file CCM_BENCHMARK.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Times a CPU loop on its state in SRAM and in CCM RAM (LIB_CCM_BSS), idle and while DMA2 copies SRAM to
+ * 		  SRAM, to check on the board what the CCM placement saves under bus contention.
+ *
+ * # Running ?
+ * 		[♥] Init USART_DEBUGGING_CHANNEL (common_lib.h), then call APP_CcmBenchmark(). One line per state placement:
+ * 				state  idle_avg  idle_max  dma_avg  dma_max
+ * 			-> idle		no other bus master running
+ * 			-> dma		LIB_DmaMemcpy() jobs between two SRAM buffers, each callback queues the next one
+ * 			All in CPU cycles per loop of APP_CCM_BENCH_ITERATIONS, over APP_CCM_BENCH_RUNS runs.
+ * 		[♥] The SRAM state shares the SRAM1 slave with the DMA buffers (the bus matrix arbitrates each access), the
+ * 			CCM state is on the CPU D-bus only: its dma columns should stay at the idle ones, the SRAM ones grow.
+ * 			The gain printed at the end is the SRAM dma_avg minus the CCM dma_avg.
+ * 		[♥] The DMA completion interrupts land in both dma columns alike, the jobs are long to keep them rare.
+ * 		[♥] LIB_DMA_MEM_STREAM must be free (nothing else using DMA2 stream 6 during the run).
+ */
+/******************************* Includes *******************************/
+#include "common_lib.h"
+#include "dma_memory.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+#define APP_CCM_BENCH_STATE_WORDS	(256)	/*power of 2*/
+#define APP_CCM_BENCH_ITERATIONS	(1024)
+#define APP_CCM_BENCH_RUNS			(32)
+#define APP_CCM_BENCH_DMA_BYTES		(16384)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static uint32_t g_APP_CCM_BENCH_SRAM_STATE[APP_CCM_BENCH_STATE_WORDS];
+static uint32_t g_APP_CCM_BENCH_CCM_STATE[APP_CCM_BENCH_STATE_WORDS] LIB_CCM_BSS;
+
+static uint32_t g_APP_CCM_BENCH_DMA_SRC[APP_CCM_BENCH_DMA_BYTES / 4];
+static uint32_t g_APP_CCM_BENCH_DMA_DST[APP_CCM_BENCH_DMA_BYTES / 4];
+
+static volatile uint8_t g_APP_CCM_BENCH_TRAFFIC = 0;
+static volatile uint32_t g_APP_CCM_BENCH_SINK = 0;
+
+/**
+ * @func APP_CcmBenchTraffic
+ * @brief DMA job completion (DMA ISR): queues the next copy while the traffic is on.
+ */
+static void APP_CcmBenchTraffic(void* context, uint8_t status){
+	(void)context;
+	(void)status;
+	if(g_APP_CCM_BENCH_TRAFFIC){
+		LIB_DmaMemcpy(g_APP_CCM_BENCH_DMA_DST, g_APP_CCM_BENCH_DMA_SRC, APP_CCM_BENCH_DMA_BYTES, APP_CcmBenchTraffic, 0);
+	}
+}
+
+/**
+ * @func APP_CcmBenchLoop
+ * @brief Control loop stand-in: one load and one store of the state per iteration, the rest in registers.
+ */
+__attribute__((noinline)) static uint32_t APP_CcmBenchLoop(uint32_t* state){
+	uint32_t acc = 0;
+	for(uint32_t i = 0; i < APP_CCM_BENCH_ITERATIONS; i++){
+		uint32_t k = (i * 7UL) & (APP_CCM_BENCH_STATE_WORDS - 1);
+		acc += state[k];
+		state[k] = acc ^ i;
+	}
+	return acc;
+}
+
+/**
+ * @func APP_CcmBenchMeasure
+ * @brief Runs the loop APP_CCM_BENCH_RUNS times, returns the average and the worst cycles.
+ */
+static void APP_CcmBenchMeasure(uint32_t* state, uint32_t* avg, uint32_t* max){
+	uint32_t total = 0;
+	*max = 0;
+	for(uint8_t run = 0; run < APP_CCM_BENCH_RUNS; run++){
+		uint32_t start = LIB_CycleCounterRead();
+		g_APP_CCM_BENCH_SINK += APP_CcmBenchLoop(state);
+		uint32_t cycles = LIB_CycleCounterRead() - start;
+		total += cycles;
+		*max = (cycles > *max) ? cycles : *max;
+	}
+	*avg = total / APP_CCM_BENCH_RUNS;
+}
+
+static void APP_CcmBenchPrintColumn(uint32_t value){
+	LIB_PrintUint32(LIB_FormatDebugSink, value);
+	LIB_FormatDebugSink('\t');
+}
+
+
+/******************************* Functions Implementation *******************************/
+void APP_CcmBenchmark(void){
+
+	uint32_t* states[2] = {g_APP_CCM_BENCH_SRAM_STATE, g_APP_CCM_BENCH_CCM_STATE};
+	static const char* names[2] = {"sram", "ccm"};
+	uint32_t dma_avg[2];
+
+	//the copies would be done by the CPU otherwise (each callback queuing the next one at once)
+	if(!DMA_Allocate(DMA_DMA2, LIB_DMA_MEM_STREAM, 0)){
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"LIB_DMA_MEM_STREAM is busy\r\n");
+		return;
+	}
+	DMA_Free(DMA_DMA2, LIB_DMA_MEM_STREAM, 0);
+
+	LIB_CycleCounterEnable();
+	for(uint32_t i = 0; i < (APP_CCM_BENCH_DMA_BYTES / 4); i++){
+		g_APP_CCM_BENCH_DMA_SRC[i] = i * 0x9E3779B9UL;
+	}
+
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"state\tidle_avg\tidle_max\tdma_avg\tdma_max\r\n");
+
+	for(uint8_t s = 0; s < 2; s++){
+		uint32_t idle_avg;
+		uint32_t idle_max;
+		uint32_t dma_max;
+
+		APP_CcmBenchMeasure(states[s], &idle_avg, &idle_max);
+
+		//traffic on: the first job is queued here, then each callback queues the next one
+		g_APP_CCM_BENCH_TRAFFIC = 1;
+		LIB_DmaMemcpy(g_APP_CCM_BENCH_DMA_DST, g_APP_CCM_BENCH_DMA_SRC, APP_CCM_BENCH_DMA_BYTES, APP_CcmBenchTraffic, 0);
+		APP_CcmBenchMeasure(states[s], &dma_avg[s], &dma_max);
+		g_APP_CCM_BENCH_TRAFFIC = 0;
+		LIB_DmaMemWait();
+
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)names[s]);
+		LIB_FormatDebugSink('\t');
+		APP_CcmBenchPrintColumn(idle_avg);
+		APP_CcmBenchPrintColumn(idle_max);
+		APP_CcmBenchPrintColumn(dma_avg[s]);
+		LIB_PrintUint32(LIB_FormatDebugSink, dma_max);
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+	}
+
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"ccm gain under dma (cycles per loop): ");
+	LIB_PrintInt32(LIB_FormatDebugSink, (int32_t)(dma_avg[0] - dma_avg[1]));
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+}
@@ -0,0 +1,150 @@
+/**
+ * @file CRC_BENCHMARK.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Measures the CRC unit (CPU and DMA fed) against the software CRC-32 on the board.
+ *
+ * # Running ?
+ * 		[♥] Init USART_DEBUGGING_CHANNEL (common_lib.h), then call APP_CrcBenchmark(). One line per size:
+ * 				bytes  unit_cpu  unit_dma_busy  unit_dma_total  lib  bytewise
+ * 			-> unit_cpu			CRC_Accumulate(), the CPU writes each word
+ * 			-> unit_dma_busy	CRC_AccumulateDma() until it returns, the CPU is free afterwards
+ * 			-> unit_dma_total	CRC_AccumulateDma() to the completion callback
+ * 			-> lib				LIB_Crc32(): the CRC unit, or slicing-by-4 with LIB_CRC_USE_HARDWARE disabled
+ * 			-> bytewise			one table lookup per byte
+ * 			All in CPU cycles, the best of APP_CRC_BENCH_RUNS runs. Run it once with each LIB_CRC_USE_HARDWARE
+ * 			setting to get both the hardware and the slicing-by-4 columns on the target.
+ * 		[♥] The results are checked against each other, a mismatch is printed.
+ * 		[♥] CRC_DMA_STREAM must be free (nothing else using DMA2 stream 4 during the run).
+ */
+/******************************* Includes *******************************/
+#include "common_lib.h"
+#include "crc.h"
+#include "crc32.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+#define APP_CRC_BENCH_MAX_BYTES		(16384)
+#define APP_CRC_BENCH_RUNS			(4)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static const uint16_t g_APP_CRC_BENCH_SIZES[] = {64, 256, 1024, 4096, 16384};
+
+static uint32_t g_APP_CRC_BENCH_DATA[APP_CRC_BENCH_MAX_BYTES / 4];
+static uint32_t g_APP_CRC_BENCH_TABLE[256];
+
+static volatile uint8_t g_APP_CRC_BENCH_DONE = 0;
+static volatile uint32_t g_APP_CRC_BENCH_DONE_CYCLES = 0;
+
+/**
+ * @func APP_CrcBenchDone
+ * @brief DMA feed completion (DMA ISR): stamps the end.
+ */
+static void APP_CrcBenchDone(void* context, uint8_t status){
+	(void)context;
+	(void)status;
+	g_APP_CRC_BENCH_DONE_CYCLES = LIB_CycleCounterRead();
+	g_APP_CRC_BENCH_DONE = 1;
+}
+
+/**
+ * @func APP_CrcBenchBytewise
+ * @brief One table lookup per byte, same result as LIB_Crc32() on whole words.
+ */
+static uint32_t APP_CrcBenchBytewise(const uint8_t* p, uint32_t len){
+	uint32_t crc = 0xFFFFFFFFUL;
+	for(; len >= 4; len -= 4, p += 4){
+		for(int8_t k = 3; k >= 0; k--){
+			crc = (crc << 8) ^ g_APP_CRC_BENCH_TABLE[(crc >> 24) ^ p[k]];
+		}
+	}
+	return crc;
+}
+
+static void APP_CrcBenchBuildTable(void){
+	for(uint32_t b = 0; b < 256; b++){
+		uint32_t crc = b << 24;
+		for(uint8_t bit = 0; bit < 8; bit++){
+			crc = (crc & 0x80000000UL) ? ((crc << 1) ^ 0x04C11DB7UL) : (crc << 1);
+		}
+		g_APP_CRC_BENCH_TABLE[b] = crc;
+	}
+}
+
+static void APP_CrcBenchPrintColumn(uint32_t value){
+	LIB_PrintUint32(LIB_FormatDebugSink, value);
+	LIB_FormatDebugSink('\t');
+}
+
+
+/******************************* Functions Implementation *******************************/
+void APP_CrcBenchmark(void){
+
+	LIB_CycleCounterEnable();
+	CRC_Init();
+	APP_CrcBenchBuildTable();
+	for(uint32_t i = 0; i < (APP_CRC_BENCH_MAX_BYTES / 4); i++){
+		g_APP_CRC_BENCH_DATA[i] = i * 0x9E3779B9UL;
+	}
+
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"bytes\tunit_cpu\tunit_dma_busy\tunit_dma_total\tlib\tbytewise\r\n");
+
+	for(uint32_t s = 0; s < (sizeof(g_APP_CRC_BENCH_SIZES) / sizeof(g_APP_CRC_BENCH_SIZES[0])); s++){
+		uint32_t len = g_APP_CRC_BENCH_SIZES[s];
+		uint32_t unit_cpu = UINT32_MAX;
+		uint32_t dma_busy = UINT32_MAX;
+		uint32_t dma_total = UINT32_MAX;
+		uint32_t lib = UINT32_MAX;
+		uint32_t bytewise = UINT32_MAX;
+		uint32_t results[4];
+
+		for(uint8_t run = 0; run < APP_CRC_BENCH_RUNS; run++){
+
+			CRC_Reset();
+			uint32_t start = LIB_CycleCounterRead();
+			results[0] = CRC_Accumulate(g_APP_CRC_BENCH_DATA, len / 4, CRC_INPUT_WORDS);
+			uint32_t cycles = LIB_CycleCounterRead() - start;
+			unit_cpu = (cycles < unit_cpu) ? cycles : unit_cpu;
+
+			CRC_Reset();
+			g_APP_CRC_BENCH_DONE = 0;
+			start = LIB_CycleCounterRead();
+			if(!CRC_AccumulateDma(g_APP_CRC_BENCH_DATA, len / 4, APP_CrcBenchDone, 0)){
+				LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"CRC_DMA_STREAM is busy\r\n");
+				return;
+			}
+			cycles = LIB_CycleCounterRead() - start;
+			dma_busy = (cycles < dma_busy) ? cycles : dma_busy;
+			while(!g_APP_CRC_BENCH_DONE);
+			cycles = g_APP_CRC_BENCH_DONE_CYCLES - start;
+			dma_total = (cycles < dma_total) ? cycles : dma_total;
+			results[1] = CRC_Read(CRC_INPUT_WORDS);
+
+			start = LIB_CycleCounterRead();
+			results[2] = LIB_Crc32(g_APP_CRC_BENCH_DATA, len);
+			cycles = LIB_CycleCounterRead() - start;
+			lib = (cycles < lib) ? cycles : lib;
+
+			start = LIB_CycleCounterRead();
+			results[3] = APP_CrcBenchBytewise((const uint8_t*)g_APP_CRC_BENCH_DATA, len);
+			cycles = LIB_CycleCounterRead() - start;
+			bytewise = (cycles < bytewise) ? cycles : bytewise;
+		}
+
+		APP_CrcBenchPrintColumn(len);
+		APP_CrcBenchPrintColumn(unit_cpu);
+		APP_CrcBenchPrintColumn(dma_busy);
+		APP_CrcBenchPrintColumn(dma_total);
+		APP_CrcBenchPrintColumn(lib);
+		LIB_PrintUint32(LIB_FormatDebugSink, bytewise);
+		if((results[1] != results[0]) || (results[2] != results[0]) || (results[3] != results[0])){
+			LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\tMISMATCH");
+		}
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+	}
+}
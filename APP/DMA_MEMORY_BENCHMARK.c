@@ -0,0 +1,174 @@
+/**
+ * @file DMA_MEMORY_BENCHMARK.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Measures the CPU copy against a DMA2 memory-to-memory job for each size, to check
+ * 		  LIB_DMA_MEM_CPU_THRESHOLD (dma_memory.h) on the board.
+ *
+ * # Running ?
+ * 		[♥] Init USART_DEBUGGING_CHANNEL (common_lib.h), then call APP_DmaMemoryBenchmark(). One line per size:
+ * 				bytes  cpu  dma_setup  dma_isr  dma_total  lib
+ * 			-> cpu			the word loop of the library's CPU fallback
+ * 			-> dma_setup	DMA_Configure() + DMA_Start(), as done by the library for each chunk
+ * 			-> dma_isr		completion callback entry to the thread seeing it (ISR tail and exit)
+ * 			-> dma_total	DMA_Configure() to the thread seeing the completion (latency)
+ * 			-> lib			LIB_DmaMemcpy() + LIB_DmaMemWait() (CPU path below the threshold)
+ * 			All in CPU cycles, the best of APP_DMA_BENCH_RUNS runs.
+ * 		[♥] The two crossovers printed at the end are:
+ * 			-> offload	first size where dma_setup + dma_isr < cpu: the CPU gets cycles back by using the DMA
+ * 			-> latency	first size where dma_total < cpu: the copy is also done sooner
+ * 			LIB_DMA_MEM_CPU_THRESHOLD should sit around the offload crossover.
+ * 		[♥] LIB_DMA_MEM_STREAM must be free (nothing else using DMA2 during the run).
+ */
+/******************************* Includes *******************************/
+#include "common_lib.h"
+#include "dma.h"
+#include "dma_memory.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+#define APP_DMA_BENCH_MAX_BYTES		(4096)
+#define APP_DMA_BENCH_RUNS			(8)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static const uint16_t g_APP_DMA_BENCH_SIZES[] = {8, 16, 32, 48, 64, 96, 128, 192, 256, 512, 1024, 4096};
+
+static uint32_t g_APP_DMA_BENCH_SRC[APP_DMA_BENCH_MAX_BYTES / 4];
+static uint32_t g_APP_DMA_BENCH_DST[APP_DMA_BENCH_MAX_BYTES / 4];
+
+static volatile uint8_t g_APP_DMA_BENCH_DONE = 0;
+static volatile uint32_t g_APP_DMA_BENCH_CALLBACK_CYCLES = 0;
+
+/**
+ * @func APP_DmaBenchCallback
+ * @brief Stream completion (DMA ISR): stamps the callback entry.
+ */
+static void APP_DmaBenchCallback(void* context, uint8_t event){
+	(void)context;
+	(void)event;
+	g_APP_DMA_BENCH_CALLBACK_CYCLES = LIB_CycleCounterRead();
+	g_APP_DMA_BENCH_DONE = 1;
+}
+
+/**
+ * @func APP_DmaBenchCpuCopy
+ * @brief Word copy, same loop as the library's CPU fallback.
+ */
+static void APP_DmaBenchCpuCopy(uint32_t* dst, const uint32_t* src, uint32_t len){
+	for(uint32_t i = 0; i < (len >> 2); i++){
+		dst[i] = src[i];
+	}
+}
+
+static void APP_DmaBenchPrintColumn(uint32_t value){
+	LIB_PrintUint32(LIB_FormatDebugSink, value);
+	LIB_FormatDebugSink('\t');
+}
+
+
+/******************************* Functions Implementation *******************************/
+void APP_DmaMemoryBenchmark(void){
+
+	DMA_StreamConfig_t config = {
+			.channel = 0,
+			.direction = DMA_DIR_MEM_TO_MEM,
+			.priority = DMA_PRIORITY_LOW,
+			.periph_size = DMA_SIZE_WORD,
+			.mem_size = DMA_SIZE_WORD,
+			.periph_inc = DMA_INCREMENT_ENABLED,
+			.mem_inc = DMA_INCREMENT_ENABLED,
+			.circular = DMA_CIRCULAR_DISABLED,
+			.fifo = DMA_FIFO_FULL,
+			.periph_burst = DMA_BURST_SINGLE,
+			.mem_burst = DMA_BURST_SINGLE,
+			.interrupts = DMA_IT_COMPLETE | DMA_IT_ERROR,
+			.callback = APP_DmaBenchCallback,
+			.context = 0,
+	};
+	uint32_t offload_bytes = 0;
+	uint32_t latency_bytes = 0;
+
+	LIB_CycleCounterEnable();
+	for(uint32_t i = 0; i < (APP_DMA_BENCH_MAX_BYTES / 4); i++){
+		g_APP_DMA_BENCH_SRC[i] = i * 0x9E3779B9UL;
+	}
+
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"bytes\tcpu\tdma_setup\tdma_isr\tdma_total\tlib\r\n");
+
+	for(uint32_t s = 0; s < (sizeof(g_APP_DMA_BENCH_SIZES) / sizeof(g_APP_DMA_BENCH_SIZES[0])); s++){
+		uint32_t len = g_APP_DMA_BENCH_SIZES[s];
+		uint32_t cpu = UINT32_MAX;
+		uint32_t setup = UINT32_MAX;
+		uint32_t isr = UINT32_MAX;
+		uint32_t total = UINT32_MAX;
+		uint32_t lib = UINT32_MAX;
+
+		for(uint8_t run = 0; run < APP_DMA_BENCH_RUNS; run++){
+
+			/*CPU copy*/
+			uint32_t start = LIB_CycleCounterRead();
+			APP_DmaBenchCpuCopy(g_APP_DMA_BENCH_DST, g_APP_DMA_BENCH_SRC, len);
+			uint32_t cycles = LIB_CycleCounterRead() - start;
+			cpu = (cycles < cpu) ? cycles : cpu;
+
+			/*Raw DMA job, what the library does for each chunk*/
+			if(!DMA_Allocate(DMA_DMA2, LIB_DMA_MEM_STREAM, config.channel)){
+				LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"LIB_DMA_MEM_STREAM is busy\r\n");
+				return;
+			}
+			g_APP_DMA_BENCH_DONE = 0;
+			start = LIB_CycleCounterRead();
+			DMA_Configure(DMA_DMA2, LIB_DMA_MEM_STREAM, &config);
+			DMA_Start(DMA_DMA2, LIB_DMA_MEM_STREAM, (uint32_t)g_APP_DMA_BENCH_SRC, (uint32_t)g_APP_DMA_BENCH_DST,
+					  (uint16_t)(len >> 2));
+			uint32_t started = LIB_CycleCounterRead();
+			while(!g_APP_DMA_BENCH_DONE);
+			uint32_t seen = LIB_CycleCounterRead();
+			DMA_Stop(DMA_DMA2, LIB_DMA_MEM_STREAM);
+			DMA_Free(DMA_DMA2, LIB_DMA_MEM_STREAM, config.channel);
+
+			cycles = started - start;
+			setup = (cycles < setup) ? cycles : setup;
+			cycles = seen - g_APP_DMA_BENCH_CALLBACK_CYCLES;
+			isr = (cycles < isr) ? cycles : isr;
+			cycles = seen - start;
+			total = (cycles < total) ? cycles : total;
+
+			/*Through the library, CPU fallback below the threshold*/
+			start = LIB_CycleCounterRead();
+			LIB_DmaMemcpy(g_APP_DMA_BENCH_DST, g_APP_DMA_BENCH_SRC, len, 0, 0);
+			LIB_DmaMemWait();
+			cycles = LIB_CycleCounterRead() - start;
+			lib = (cycles < lib) ? cycles : lib;
+		}
+
+		if((offload_bytes == 0) && ((setup + isr) < cpu)){
+			offload_bytes = len;
+		}
+		if((latency_bytes == 0) && (total < cpu)){
+			latency_bytes = len;
+		}
+
+		APP_DmaBenchPrintColumn(len);
+		APP_DmaBenchPrintColumn(cpu);
+		APP_DmaBenchPrintColumn(setup);
+		APP_DmaBenchPrintColumn(isr);
+		APP_DmaBenchPrintColumn(total);
+		LIB_PrintUint32(LIB_FormatDebugSink, lib);
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+	}
+
+	//0: not reached within APP_DMA_BENCH_MAX_BYTES
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"offload crossover (bytes): ");
+	LIB_PrintUint32(LIB_FormatDebugSink, offload_bytes);
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\nlatency crossover (bytes): ");
+	LIB_PrintUint32(LIB_FormatDebugSink, latency_bytes);
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\nLIB_DMA_MEM_CPU_THRESHOLD: ");
+	LIB_PrintUint32(LIB_FormatDebugSink, LIB_DMA_MEM_CPU_THRESHOLD);
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+}
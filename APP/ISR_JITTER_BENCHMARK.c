@@ -0,0 +1,113 @@
+/**
+ * @file ISR_JITTER_BENCHMARK.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Measures the period jitter of a periodic timer update ISR (TIM_ISR_JITTER) under an idle and a FLASH
+ * 		  heavy background, to compare TIM_ISR_IN_FLASH with TIM_ISR_IN_RAM (tim.h) on the board.
+ *
+ * # Running ?
+ * 		[♥] Init USART_DEBUGGING_CHANNEL (common_lib.h), then call APP_IsrJitterBenchmark(). It prints the built
+ * 			TIM_ISR_MEMORY, then one line per background:
+ * 				load  samples  min  max  spread
+ * 			-> idle		a tight loop, fetched from the ART cache
+ * 			-> flash	a long unrolled loop reading a FLASH table at data-dependent addresses, its code and data
+ * 						keep evicting the ART cache lines (the ISR's ones too when it runs from FLASH)
+ * 			Periods of APP_ISR_JITTER_PERIOD_TICKS timer ticks in CPU cycles, spread = max - min.
+ * 		[♥] Build and run it once with TIM_ISR_MEMORY = TIM_ISR_IN_FLASH and once with TIM_ISR_IN_RAM: the flash
+ * 			spread is what the RAM placement should bring down to the idle one.
+ * 		[♥] Needs TIM_ISR_JITTER = TIM_ISR_JITTER_ENABLE (tim.h), APP_ISR_JITTER_TIMER must be free.
+ */
+/******************************* Includes *******************************/
+#include "common_lib.h"
+#include "tim.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+#define APP_ISR_JITTER_TIMER		(TIM_TIM6)			/*TIM7 is LCD_ASYNC_TIMER*/
+#define APP_ISR_JITTER_TICK_HZ		(1000000UL)
+#define APP_ISR_JITTER_PERIOD_TICKS	(100)				/*10 kHz*/
+#define APP_ISR_JITTER_RUN_CYCLES	(8000000UL)		/*per background, 0.5 S at 16 MHz*/
+
+#define APP_ISR_JITTER_TABLE_WORDS	(4096)				/*16 KB of FLASH, power of 2*/
+
+#define APP_ISR_JITTER_X4(s)		s s s s
+#define APP_ISR_JITTER_X64(s)		APP_ISR_JITTER_X4(APP_ISR_JITTER_X4(APP_ISR_JITTER_X4(s)))
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static const uint32_t g_APP_ISR_JITTER_TABLE[APP_ISR_JITTER_TABLE_WORDS] = {
+		0x9E3779B9UL, 0x7F4A7C15UL, 0x85EBCA6BUL, 0xC2B2AE35UL		/*the rest is 0, only the addresses matter*/
+};
+
+static volatile uint32_t g_APP_ISR_JITTER_SINK = 0;
+
+/**
+ * @func APP_IsrJitterIdle
+ * @brief Idle background: spins on the cycle counter.
+ */
+static void APP_IsrJitterIdle(uint32_t start){
+	while((LIB_CycleCounterRead() - start) < APP_ISR_JITTER_RUN_CYCLES);
+}
+
+/**
+ * @func APP_IsrJitterFlash
+ * @brief FLASH heavy background: 256 unrolled table reads per pass (a few KB of straight code), each address
+ * 		  depending on the previous read.
+ */
+__attribute__((noinline)) static void APP_IsrJitterFlash(uint32_t start){
+	uint32_t acc = 0;
+	uint32_t i = 0;
+	while((LIB_CycleCounterRead() - start) < APP_ISR_JITTER_RUN_CYCLES){
+		APP_ISR_JITTER_X4(APP_ISR_JITTER_X64(
+			acc = (acc * 33UL) + g_APP_ISR_JITTER_TABLE[(acc + (i += 37UL)) & (APP_ISR_JITTER_TABLE_WORDS - 1)];
+		))
+	}
+	g_APP_ISR_JITTER_SINK += acc;
+}
+
+static void APP_IsrJitterPrintColumn(uint32_t value){
+	LIB_PrintUint32(LIB_FormatDebugSink, value);
+	LIB_FormatDebugSink('\t');
+}
+
+
+/******************************* Functions Implementation *******************************/
+void APP_IsrJitterBenchmark(void){
+
+	static void (* const loads[2])(uint32_t start) = {APP_IsrJitterIdle, APP_IsrJitterFlash};
+	static const char* names[2] = {"idle", "flash"};
+
+	if(TIM_ISR_JITTER != TIM_ISR_JITTER_ENABLE){
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"TIM_ISR_JITTER is disabled (tim.h)\r\n");
+		return;
+	}
+
+	LIB_CycleCounterEnable();
+
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)((TIM_ISR_MEMORY == TIM_ISR_IN_RAM) ?
+			"isr memory: ram\r\n" : "isr memory: flash\r\n"));
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"load\tsamples\tmin\tmax\tspread\r\n");
+
+	for(uint8_t l = 0; l < 2; l++){
+		LIB_Jitter_t jitter;
+
+		//no update callback, the ISR only records its period; TIM_BasicInit() restarts the statistics
+		TIM_BasicInit(APP_ISR_JITTER_TIMER, APP_ISR_JITTER_TICK_HZ, 0);
+		TIM_BasicStartPeriodic(APP_ISR_JITTER_TIMER, APP_ISR_JITTER_PERIOD_TICKS);
+		loads[l](LIB_CycleCounterRead());
+		TIM_Stop(APP_ISR_JITTER_TIMER);
+		TIM_GetIsrJitter(APP_ISR_JITTER_TIMER, &jitter);
+
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)names[l]);
+		LIB_FormatDebugSink('\t');
+		APP_IsrJitterPrintColumn(jitter.samples);
+		APP_IsrJitterPrintColumn(jitter.min_period);
+		APP_IsrJitterPrintColumn(jitter.max_period);
+		LIB_PrintUint32(LIB_FormatDebugSink, jitter.max_period - jitter.min_period);
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)"\r\n");
+	}
+}
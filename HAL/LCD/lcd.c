@@ -6,14 +6,20 @@
  * @brief source file for LCD module .
  *
  *  *
- * # This LCD Driver is implemented only for 4-bit configuration.
+ * # Generic HD44780 driver, 4-bit or 8-bit bus, one {LCD_Handle_t} per display.
  *
+ * # LCD_ASYNC_MODE ?
+ * 		[♥] Every command/data byte (and every init delay) is pushed to the display's ring queue, LCD_AsyncStep()
+ * 			walks each byte through the E pulse states and returns the time the next step has to wait.
+ * 		[♥] LCD_AsyncEngine() runs from the LCD_ASYNC_TIMER one-shot interrupt: it steps every display whose wait
+ * 			has elapsed, then re-arms the timer with the nearest remaining wait of all displays.
+ * 		[♥] A queue is only popped by the ISR and pushed by the thread, a display (and the engine) is (re)started
+ * 			by LCD_AsyncKick() when the ISR has drained its queue and stopped it.
  *
  */
 /******************************* Includes *******************************/
 #include "lcd.h"
-#include <stdlib.h>
-#include <stdio.h>
+#include "num_format.h"
 
 
 /*******************************  Macros *******************************/
@@ -32,8 +38,8 @@
 #define LCD_SHIFT_DISLAY_RIGHT	(LCD_CURSOR_DECREASE | LCD_SHIFT_DISPLAY_ON)
 
 /*5.4 Display ON/OFF Control*/
-#define LCD_DISPLAY_ON			0x08
-#define LCD_DISPLAY_OFF			0x0C
+#define LCD_DISPLAY_ON			0x0C
+#define LCD_DISPLAY_OFF			0x08
 #define LCD_CURSOR_DISPLAY_ON	0x0A
 #define LCD_CURSOR_DISPLAY_OFF	0x08
 #define LCD_CURSOR_BLINK_ON		0x09
@@ -54,11 +60,33 @@
 #define LCD_5_10_FONT					0x24
 
 /*5.7 Set CG RAM Address*/
+#define LCD_SET_CGRAM_ADDRESS	0x40
+#define LCD_GLYPH_ROWS			8
 /*5.8 Set DD RAM Address*/
+#define LCD_SET_DDRAM_ADDRESS	0x80
 /*5.9 Read Busy Flag & Address*/
+#define LCD_BUSY_FLAG_BIT		7
 /*5.10 Write Data to CG or DD RAM*/
 /*5.11 Read Data to CG or DD RAM*/
 
+/*Worst-case execution times (uS) of the HD44780 instructions (270KHz oscillator) plus margin, waited without BF*/
+#define LCD_EXEC_TIME_US				(50)
+#define LCD_EXEC_TIME_LONG_US			(1600)
+
+/*Initialization by instruction waits (uS)*/
+#define LCD_POWER_ON_TIME_US			(45000)
+#define LCD_INIT_FIRST_WAIT_US			(4500)
+#define LCD_INIT_NEXT_WAIT_US			(150)
+
+/*Queue entries' types*/
+#define LCD_ENTRY_COMMAND				(0)
+#define LCD_ENTRY_DATA					(1)
+#define LCD_ENTRY_DELAY_US				(2)
+#define LCD_ENTRY_BUSY_FLAG_ON			(3)		/*init done, BF can be read from now on*/
+#define LCD_ENTRY_NIBBLE				(4)		/*init: a single E pulse with the value's high nibble on D4-D7*/
+
+#define LCD_ASYNC_QUEUE_MASK			(LCD_ASYNC_QUEUE_SIZE - 1)
+
 
 
 
@@ -66,83 +94,537 @@
 
 
 /******************************* privates *******************************/
+static LCD_Handle_t* g_LCD_SINK_TARGET = 0;
+
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
+
+#if (LCD_ASYNC_QUEUE_SIZE & LCD_ASYNC_QUEUE_MASK) != 0 || LCD_ASYNC_QUEUE_SIZE > 256
+#error "LCD_ASYNC_QUEUE_SIZE must be a power of 2 and at most 256"
+#endif
+
+typedef enum{
+	LCD_STATE_FETCH = 0,		/*pop the next entry, put RS and the (high nibble of the) byte then raise E*/
+	LCD_STATE_HIGH_NIBBLE,		/*E was high long enough, drop it to latch the high nibble*/
+	LCD_STATE_LOW_NIBBLE,		/*nibble hold time elapsed, put the low nibble and raise E*/
+	LCD_STATE_LATCH,			/*drop E to latch the byte and wait the instruction execution time*/
+	LCD_STATE_POLL_START,		/*data pins inputs, RS = 0, RW = 1 and raise E*/
+	LCD_STATE_POLL_READ,		/*sample BF (D7) and drop E*/
+	LCD_STATE_POLL_SECOND_HIGH,	/*4-bit: raise E for the address counter low nibble (ignored)*/
+	LCD_STATE_POLL_SECOND_LOW,	/*4-bit: drop E*/
+}LCD_AsyncState_en;
+
+/*Displays sharing the timing engine*/
+static LCD_Handle_t* g_LCD_DISPLAYS[LCD_MAX_DISPLAYS];
+static uint8_t g_LCD_DISPLAYS_NUM = 0;
+static volatile uint8_t g_LCD_ENGINE_RUNNING = 0;
+static uint16_t g_LCD_ENGINE_PERIOD_US = 0;		/*period the timer was armed with*/
+
+#endif
 
 
 /******************************* Functions Implementation *******************************/
 
+/**
+ * @func LCD_WriteBus
+ * @brief Puts a value on the data pins: D0-D7 on an 8-bit bus, its high nibble on D4-D7 on a 4-bit bus.
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t value
+ * @return void
+ */
+static void LCD_WriteBus(LCD_Handle_t* lcd, uint8_t value){
+
+	uint8_t first = (lcd->configs.bus_width == LCD_BUS_8BIT) ? 0 : 4;
+	for(uint8_t i = first; i < 8; i++){
+		GPIO_SetPinState(lcd->configs.data_gpio, lcd->configs.data_pins[i], GET_BIT(value, i));
+	}
+}
+
+/**
+ * @func LCD_SetDataPinsMode
+ * @brief Switches the data pins between outputs (writing) and inputs (reading BF & address).
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @param  GPIO_Mode_en mode	GPIO_INPUT or GPIO_OUTPUT
+ * @return void
+ */
+static void LCD_SetDataPinsMode(LCD_Handle_t* lcd, GPIO_Mode_en mode){
+
+	uint8_t first = (lcd->configs.bus_width == LCD_BUS_8BIT) ? 0 : 4;
+	for(uint8_t i = first; i < 8; i++){
+		GPIO_SetPinMode(lcd->configs.data_gpio, lcd->configs.data_pins[i], mode);
+	}
+}
+
+/**
+ * @func LCD_IsLongInstruction
+ * @brief Checks if the entry is Clear Display or Return Home (~1.52 mS, the others take ~37 uS).
+ *
+ * @note Static [private function]
+ * @param  uint8_t type
+ * @param  uint8_t value
+ * @return uint8_t	1: long instruction
+ */
+static uint8_t LCD_IsLongInstruction(uint8_t type, uint8_t value){
+	return (type == LCD_ENTRY_COMMAND) && ((value == LCD_CLEAR_DISPLAY) || ((value & 0xFE) == LCD_RETURN_HOME));
+}
+
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
+
+#if LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING
+/**
+ * @func LCD_AsyncPollDone
+ * @brief Ends a BF read: restores the bus then decides to poll again, go on or time out.
+ *
+ * @note Static [private function], runs in the timer ISR context
+ * @param  LCD_Handle_t* lcd
+ * @return uint16_t		uS to wait before the next step
+ */
+static uint16_t LCD_AsyncPollDone(LCD_Handle_t* lcd){
+
+	GPIO_SetPinState(lcd->configs.control_gpio, lcd->configs.rw, GPIO_LOW);
+	LCD_SetDataPinsMode(lcd, GPIO_OUTPUT);
+
+	//each poll takes 1 uS per step
+	lcd->poll_time_us += (lcd->configs.bus_width == LCD_BUS_8BIT) ? 2 : 4;
+
+	if(!lcd->busy){
+		lcd->state = LCD_STATE_FETCH;
+		return 1;
+	}
+	if(lcd->poll_time_us >= LCD_BUSY_TIMEOUT_US){
+		//no answer, fall back to the fixed delays
+		lcd->bf_available = 0;
+		lcd->state = LCD_STATE_FETCH;
+		return LCD_EXEC_TIME_LONG_US;
+	}
+	//still busy (slow controller), read again later instead of re-arming the timer every tick
+	lcd->poll_time_us += LCD_BUSY_POLL_INTERVAL_US;
+	lcd->state = LCD_STATE_POLL_START;
+	return LCD_BUSY_POLL_INTERVAL_US;
+}
+#endif
+
+/**
+ * @func LCD_AsyncStep
+ * @brief Performs one step of a display's current byte.
+ *
+ * @note Static [private function], runs in the timer ISR context
+ * @param  LCD_Handle_t* lcd
+ * @return uint16_t		uS to wait before the next step, 0 if the queue is drained (display stopped)
+ */
+static uint16_t LCD_AsyncStep(LCD_Handle_t* lcd){
+
+	LCD_Config_t* cfg = &lcd->configs;
+	uint16_t wait_us = 1;
+
+	switch(lcd->state){
+	case LCD_STATE_FETCH:
+		if(lcd->queue_tail == lcd->queue_head){
+			//nothing left, the next enqueue restarts the display
+			lcd->running = 0;
+			return 0;
+		}
+		lcd->current = lcd->queue[lcd->queue_tail];
+		lcd->queue_tail = (lcd->queue_tail + 1) & LCD_ASYNC_QUEUE_MASK;
+
+		if(lcd->current.type == LCD_ENTRY_DELAY_US){
+			wait_us = lcd->current.value;
+			break;
+		}
+		if(lcd->current.type == LCD_ENTRY_BUSY_FLAG_ON){
+			lcd->bf_available = (LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING);
+			break;
+		}
+
+		//RS = 0 for the instruction register, 1 for data - RW = 0, when writing
+		GPIO_SetPinState(cfg->control_gpio, cfg->rs, (lcd->current.type == LCD_ENTRY_DATA) ? GPIO_HIGH : GPIO_LOW);
+		GPIO_SetPinState(cfg->control_gpio, cfg->rw, GPIO_LOW);
+		LCD_WriteBus(lcd, (uint8_t)lcd->current.value);
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+
+		//one E pulse per byte on an 8-bit bus
+		if((cfg->bus_width == LCD_BUS_8BIT) || (lcd->current.type == LCD_ENTRY_NIBBLE)){
+			lcd->state = LCD_STATE_LATCH;
+		}else{
+			lcd->state = LCD_STATE_HIGH_NIBBLE;
+		}
+		break;
+
+	case LCD_STATE_HIGH_NIBBLE:
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+		lcd->state = LCD_STATE_LOW_NIBBLE;
+		break;
+
+	case LCD_STATE_LOW_NIBBLE:
+		LCD_WriteBus(lcd, (uint8_t)(lcd->current.value << 4));
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+		lcd->state = LCD_STATE_LATCH;
+		break;
+
+	case LCD_STATE_LATCH:
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+#if LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING
+		if(lcd->bf_available){
+			//first read before the typical execution time, so a ready LCD is seen well before the worst case
+			wait_us = LCD_IsLongInstruction(lcd->current.type, (uint8_t)lcd->current.value) ?
+					  LCD_BUSY_FIRST_POLL_LONG_US : LCD_BUSY_FIRST_POLL_US;
+			lcd->poll_time_us = wait_us;
+			lcd->state = LCD_STATE_POLL_START;
+			break;
+		}
+#endif
+		wait_us = LCD_IsLongInstruction(lcd->current.type, (uint8_t)lcd->current.value) ? LCD_EXEC_TIME_LONG_US : LCD_EXEC_TIME_US;
+		lcd->state = LCD_STATE_FETCH;
+		break;
+
+#if LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING
+	case LCD_STATE_POLL_START:
+		LCD_SetDataPinsMode(lcd, GPIO_INPUT);
+		//RS = 0, RW = 1 -> Read Busy Flag & Address
+		GPIO_SetPinState(cfg->control_gpio, cfg->rs, GPIO_LOW);
+		GPIO_SetPinState(cfg->control_gpio, cfg->rw, GPIO_HIGH);
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+		lcd->state = LCD_STATE_POLL_READ;
+		break;
+
+	case LCD_STATE_POLL_READ:
+		lcd->busy = GPIO_GetPinState(cfg->data_gpio, cfg->data_pins[LCD_BUSY_FLAG_BIT]);
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+		if(cfg->bus_width == LCD_BUS_8BIT){
+			wait_us = LCD_AsyncPollDone(lcd);
+		}else{
+			lcd->state = LCD_STATE_POLL_SECOND_HIGH;
+		}
+		break;
+
+	case LCD_STATE_POLL_SECOND_HIGH:
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+		lcd->state = LCD_STATE_POLL_SECOND_LOW;
+		break;
+
+	case LCD_STATE_POLL_SECOND_LOW:
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+		wait_us = LCD_AsyncPollDone(lcd);
+		break;
+#endif
+
+	default:
+		lcd->state = LCD_STATE_FETCH;
+		break;
+	}
+
+	return wait_us;
+}
+
+/**
+ * @func LCD_AsyncEngine
+ * @brief LCD_ASYNC_TIMER update callback, steps every display whose wait has elapsed then re-arms the timer
+ * 		  with the nearest remaining wait (1 uS ticks), so all displays progress concurrently.
+ *
+ * @note Static [private function], runs in the timer ISR context
+ * @return void
+ */
+static void LCD_AsyncEngine(void){
+
+	uint32_t next_us = UINT32_MAX;
+
+	for(uint8_t i = 0; i < g_LCD_DISPLAYS_NUM; i++){
+
+		LCD_Handle_t* lcd = g_LCD_DISPLAYS[i];
+		if(!lcd->running){
+			continue;
+		}
+
+		if(lcd->remaining_us > g_LCD_ENGINE_PERIOD_US){
+			lcd->remaining_us -= g_LCD_ENGINE_PERIOD_US;
+		}else{
+			lcd->remaining_us = LCD_AsyncStep(lcd);
+		}
+
+		if(lcd->running && (lcd->remaining_us < next_us)){
+			next_us = lcd->remaining_us;
+		}
+	}
+
+	if(next_us == UINT32_MAX){
+		//all displays drained, the next enqueue restarts the engine
+		g_LCD_ENGINE_RUNNING = 0;
+		return;
+	}
+
+	g_LCD_ENGINE_PERIOD_US = (uint16_t)next_us;
+	TIM_BasicStartOneShot(LCD_ASYNC_TIMER, g_LCD_ENGINE_PERIOD_US);
+}
+
+/**
+ * @func LCD_AsyncKick
+ * @brief Starts the display if it has stopped after draining its queue, and the engine if it's stopped.
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+static void LCD_AsyncKick(LCD_Handle_t* lcd){
+
+	uint32_t primask = LIB_EnterCritical();
+	if(!lcd->running){
+		lcd->running = 1;
+		lcd->state = LCD_STATE_FETCH;
+		//stepped at the engine's next interrupt
+		lcd->remaining_us = 0;
+	}
+	if(!g_LCD_ENGINE_RUNNING){
+		g_LCD_ENGINE_RUNNING = 1;
+		g_LCD_ENGINE_PERIOD_US = 1;
+		TIM_BasicStartOneShot(LCD_ASYNC_TIMER, 1);
+	}
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func LCD_AsyncRegister
+ * @brief Adds a display to the engine (once), initializes the engine's timer with the first display.
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @return uint8_t	1: registered, 0: LCD_MAX_DISPLAYS displays already registered
+ */
+static uint8_t LCD_AsyncRegister(LCD_Handle_t* lcd){
+
+	uint32_t primask = LIB_EnterCritical();
+
+	lcd->running = 0;
+	lcd->queue_head = 0;
+	lcd->queue_tail = 0;
+
+	uint8_t found = 0;
+	for(uint8_t i = 0; i < g_LCD_DISPLAYS_NUM; i++){
+		found |= (g_LCD_DISPLAYS[i] == lcd);
+	}
+	if(!found){
+		if(g_LCD_DISPLAYS_NUM == LCD_MAX_DISPLAYS){
+			//never stepped by the engine, its queue would fill up and block the caller forever
+			LIB_ExitCritical(primask);
+			return 0;
+		}
+		g_LCD_DISPLAYS[g_LCD_DISPLAYS_NUM] = lcd;
+		g_LCD_DISPLAYS_NUM++;
+		if(g_LCD_DISPLAYS_NUM == 1){
+			/*1 uS ticks one-shot timer clocking the queues out*/
+			TIM_BasicInit(LCD_ASYNC_TIMER, 1000000UL, LCD_AsyncEngine);
+		}
+	}
+
+	LIB_ExitCritical(primask);
+	return 1;
+}
+
+#else
+
+/**
+ * @func LCD_Delay_us
+ * @brief Blocking delay for the blocking mode, no limit on the delay unlike LIB_SysTickDelay_us().
+ *
+ * @note Static [private function]
+ * @param  uint16_t us
+ * @return void
+ */
+static void LCD_Delay_us(uint16_t us){
+	if(us >= 1000){
+		LIB_SysTickDelay_ms(us / 1000);
+		us %= 1000;
+	}
+	if(us != 0){
+		LIB_SysTickDelay_us(us);
+	}
+}
+
+#if LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING
+/**
+ * @func LCD_ReadBusyAddress
+ * @brief Reads the busy flag and the address counter (Read Busy Flag & Address instruction, 1 or 2 E pulses).
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @return uint8_t	BF[7] AC[6:0]
+ */
+static uint8_t LCD_ReadBusyAddress(LCD_Handle_t* lcd){
+
+	LCD_Config_t* cfg = &lcd->configs;
+	uint8_t value = 0;
+	uint8_t first = (cfg->bus_width == LCD_BUS_8BIT) ? 0 : 4;
+	uint8_t pulses = (cfg->bus_width == LCD_BUS_8BIT) ? 1 : 2;
+
+	LCD_SetDataPinsMode(lcd, GPIO_INPUT);
+
+	//RS = 0, RW = 1 -> Read Busy Flag & Address
+	GPIO_SetPinState(cfg->control_gpio, cfg->rs, GPIO_LOW);
+	GPIO_SetPinState(cfg->control_gpio, cfg->rw, GPIO_HIGH);
+
+	for(uint8_t pulse = 0; pulse < pulses; pulse++){
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+		//data delay time (tDDR = 360 nS)
+		LIB_SysTickDelay_us(1);
+		for(uint8_t i = first; i < 8; i++){
+			//4-bit: high nibble first, then the low nibble on the same pins
+			value |= (uint8_t)(GPIO_GetPinState(cfg->data_gpio, cfg->data_pins[i]) << (i - (pulse * 4)));
+		}
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+		LIB_SysTickDelay_us(1);
+	}
+
+	GPIO_SetPinState(cfg->control_gpio, cfg->rw, GPIO_LOW);
+	LCD_SetDataPinsMode(lcd, GPIO_OUTPUT);
+
+	return value;
+}
+#endif
+
+/**
+ * @func LCD_WaitReady
+ * @brief Waits until the LCD finishes the instruction just latched, polling BF when it's available.
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t long_instruction		1: Clear Display / Return Home
+ * @return void
+ */
+static void LCD_WaitReady(LCD_Handle_t* lcd, uint8_t long_instruction){
+
+#if LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING
+	if(lcd->bf_available){
+		//each read takes ~2 uS per E pulse
+		for(uint16_t elapsed = 0; elapsed < LCD_BUSY_TIMEOUT_US; elapsed += 4){
+			if(!GET_BIT(LCD_ReadBusyAddress(lcd), LCD_BUSY_FLAG_BIT)){
+				return;
+			}
+		}
+		//no answer, fall back to the fixed delays
+		lcd->bf_available = 0;
+		long_instruction = 1;
+	}
+#endif
+
+	if(long_instruction){
+		LCD_Delay_us(LCD_EXEC_TIME_LONG_US);
+	}
+}
 
 /**
  * @func LCD_LatchBits
  * @brief Responsible to latch whatever it receives (commands/data) and writes it on the LCD Registers.
  *
  * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t bits
+ * @param  uint8_t pulses	1: 8-bit bus or a single nibble, 2: both nibbles on a 4-bit bus
  * @return void
  */
-static void LCD_LatchBits(uint8_t bits){
+static void LCD_LatchBits(LCD_Handle_t* lcd, uint8_t bits, uint8_t pulses){
+
+	LCD_Config_t* cfg = &lcd->configs;
 
+	//with BF polling only the E pulse timings (~1 uS) are needed, the execution time is polled after
+	uint8_t pulse_us = lcd->bf_available ? 1 : 10;
+	uint8_t hold_us = lcd->bf_available ? 1 : 30;
 
 	//RW = 0, when writing
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_RW, GPIO_LOW);
+	GPIO_SetPinState(cfg->control_gpio, cfg->rw, GPIO_LOW);
 
 	//RW and RS setup time
-	LIB_SysTickDelay_us(10);
+	LIB_SysTickDelay_us(pulse_us);
+
+	for(uint8_t pulse = 0; pulse < pulses; pulse++){
+
+		//Set the E pulse
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_HIGH);
+
+		//E rising time
+		LIB_SysTickDelay_us(pulse_us);
+
+		//DATA SETUP (2nd pulse: low nibble)
+		LCD_WriteBus(lcd, (uint8_t)(bits << (pulse * 4)));
+
+		//Clear the E pulse
+		GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+
+		//Data Hold time and E falling time
+		LIB_SysTickDelay_us(hold_us);
+	}
 
-	/*1st Nibble*/
+}
+
+#endif
 
-	//Set the E pulse
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_E, GPIO_HIGH);
+/**
+ * @func LCD_Send
+ * @brief Sends an entry (command, data, nibble, delay...) to the display: queued in LCD_ASYNC_MODE,
+ * 		  performed right away in LCD_BLOCKING_MODE.
+ *
+ * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t type		LCD_ENTRY_XXX
+ * @param  uint16_t value	byte to write or delay in uS
+ * @return void
+ */
+static void LCD_Send(LCD_Handle_t* lcd, uint8_t type, uint16_t value){
 
-	//E rising time
-	LIB_SysTickDelay_us(10);
+	if(!lcd->initialized){
+		return;
+	}
 
-	//DATA SETUP
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D4, GET_BIT(bits,4));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D5, GET_BIT(bits,5));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D6, GET_BIT(bits,6));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D7, GET_BIT(bits,7));
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
 
-	//Clear the E pulse
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_E, GPIO_LOW);
+	uint8_t next = (lcd->queue_head + 1) & LCD_ASYNC_QUEUE_MASK;
 
-	//Data Hold time and E falling time
-	LIB_SysTickDelay_us(30);
+	//full, wait for the ISR to free a slot
+	while(next == lcd->queue_tail);
 
-	/*2nd Nibble*/
-	//Set the E pulse
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_E, GPIO_HIGH);
+	lcd->queue[lcd->queue_head].type = type;
+	lcd->queue[lcd->queue_head].value = value;
+	lcd->queue_head = next;
 
-	//E rising time
-	LIB_SysTickDelay_us(10);
+	LCD_AsyncKick(lcd);
 
-	//DATA SETUP
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D4, GET_BIT(bits,0));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D5, GET_BIT(bits,1));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D6, GET_BIT(bits,2));
-	GPIO_SetPinState(LCD_DATA_GPIO, LCD_D7, GET_BIT(bits,3));
+#else
 
+	switch(type){
+	case LCD_ENTRY_DELAY_US:
+		LCD_Delay_us(value);
+		break;
 
-	//Clear the E pulse
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_E, GPIO_LOW);
+	case LCD_ENTRY_BUSY_FLAG_ON:
+		lcd->bf_available = (LCD_BUSY_FLAG_MODE == LCD_BUSY_FLAG_POLLING);
+		break;
 
-	//Data Hold time and E falling time
-	LIB_SysTickDelay_us(30);
+	default:
+		//RS = 0 for the instruction register, 1 for data
+		GPIO_SetPinState(lcd->configs.control_gpio, lcd->configs.rs, (type == LCD_ENTRY_DATA) ? GPIO_HIGH : GPIO_LOW);
+		if((lcd->configs.bus_width == LCD_BUS_8BIT) || (type == LCD_ENTRY_NIBBLE)){
+			LCD_LatchBits(lcd, (uint8_t)value, 1);
+		}else{
+			LCD_LatchBits(lcd, (uint8_t)value, 2);
+		}
+		LCD_WaitReady(lcd, LCD_IsLongInstruction(type, (uint8_t)value));
+		break;
+	}
 
+#endif
 }
 
 /**
  * @func LCD_SendCommand
  * @brief Send a command to the LCD .
  * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t cmd
  * @return void
  */
-static void LCD_SendCommand(uint8_t cmd){
-	//RS = 0, when working with instruction register
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_RS, GPIO_LOW);
-
-	LCD_LatchBits(cmd);
-
+static void LCD_SendCommand(LCD_Handle_t* lcd, uint8_t cmd){
+	LCD_Send(lcd, LCD_ENTRY_COMMAND, cmd);
 }
 
 
@@ -151,71 +633,108 @@ static void LCD_SendCommand(uint8_t cmd){
  * @brief Send 1 Byte data through data lines .
  *
  * @note Static [private function]
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t data
  * @return void
  */
-static void LCD_SendData(uint8_t data){
-
-	//RS = 1, when working with data
-	GPIO_SetPinState(LCD_CONTROL_GPIO, LCD_RS, GPIO_HIGH);
-
-	LCD_LatchBits(data);
+static void LCD_SendData(LCD_Handle_t* lcd, uint8_t data){
+	LCD_Send(lcd, LCD_ENTRY_DATA, data);
 }
 
 /**
  * @func LCD_Init
  * @brief Initializing the LCD ( GPIO data pins, GPIO control pins, mode, font, lines, cursor, display, blinking, ...etc).
  *
- * @param  void
- * @return void
+ * # Initialization by instruction (HD44780 datasheet figures 23/24), works whatever the state the LCD
+ * 	 was left in (e.g. MCU reset while the LCD stayed powered in 4-bit mode).
+ *
+ * @param  LCD_Handle_t* lcd	handle with its {configs} filled, at most LCD_MAX_DISPLAYS handles in LCD_ASYNC_MODE
+ * @return uint8_t				1: initialized, 0: no free display slot (LCD_MAX_DISPLAYS reached)
  */
-void LCD_Init(){
+uint8_t LCD_Init(LCD_Handle_t* lcd){
+
+	LCD_Config_t* cfg = &lcd->configs;
+
+	lcd->initialized = 0;
+
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
+	if(!LCD_AsyncRegister(lcd)){
+		return 0;
+	}
+#endif
+
+	if(cfg->rows > LCD_MAX_ROWS){
+		cfg->rows = LCD_MAX_ROWS;
+	}
+	if(cfg->columns > LCD_MAX_COLUMNS){
+		cfg->columns = LCD_MAX_COLUMNS;
+	}
 
 	/*Configuring related GPIO pins*/
 	//DATA PINs
-	RCC_EnableAHB1Clock(LCD_DATA_RCC_GPIO);
-	GPIO_SetPinMode(LCD_DATA_GPIO, LCD_D4, GPIO_OUTPUT);
-	GPIO_SetPinMode(LCD_DATA_GPIO, LCD_D5, GPIO_OUTPUT);
-	GPIO_SetPinMode(LCD_DATA_GPIO, LCD_D6, GPIO_OUTPUT);
-	GPIO_SetPinMode(LCD_DATA_GPIO, LCD_D7, GPIO_OUTPUT);
+	RCC_EnableAHB1Clock(cfg->data_rcc_gpio);
+	LCD_SetDataPinsMode(lcd, GPIO_OUTPUT);
 	//CONTROL PINs
-	RCC_EnableAHB1Clock(LCD_CONTROL_RCC_GPIO);
-	GPIO_SetPinMode(LCD_CONTROL_GPIO, LCD_RS, GPIO_OUTPUT);
-	GPIO_SetPinMode(LCD_CONTROL_GPIO, LCD_RW, GPIO_OUTPUT);
-	GPIO_SetPinMode(LCD_CONTROL_GPIO, LCD_E, GPIO_OUTPUT);
-
-	/*Wait for more than 30ms after Power On*/
-	LIB_SysTickDelay_ms(35);
+	RCC_EnableAHB1Clock(cfg->control_rcc_gpio);
+	GPIO_SetPinMode(cfg->control_gpio, cfg->rs, GPIO_OUTPUT);
+	GPIO_SetPinMode(cfg->control_gpio, cfg->rw, GPIO_OUTPUT);
+	GPIO_SetPinMode(cfg->control_gpio, cfg->e, GPIO_OUTPUT);
+	GPIO_SetPinState(cfg->control_gpio, cfg->e, GPIO_LOW);
+
+	/*BF can't be read before the interface width is set*/
+	lcd->bf_available = 0;
+	lcd->initialized = 1;
+
+	/*Wait for more than 40ms after Power On*/
+	LCD_Send(lcd, LCD_ENTRY_DELAY_US, LCD_POWER_ON_TIME_US);
+
+	/***_________ Function Set (8-bit) x3 _________***/
+	LCD_Send(lcd, LCD_ENTRY_NIBBLE, LCD_8_BIT_MODE);
+	LCD_Send(lcd, LCD_ENTRY_DELAY_US, LCD_INIT_FIRST_WAIT_US);
+	LCD_Send(lcd, LCD_ENTRY_NIBBLE, LCD_8_BIT_MODE);
+	LCD_Send(lcd, LCD_ENTRY_DELAY_US, LCD_INIT_NEXT_WAIT_US);
+	LCD_Send(lcd, LCD_ENTRY_NIBBLE, LCD_8_BIT_MODE);
+	LCD_Send(lcd, LCD_ENTRY_DELAY_US, LCD_INIT_NEXT_WAIT_US);
+
+	if(cfg->bus_width == LCD_BUS_4BIT){
+		//switch to 4-bit, still a single E pulse
+		LCD_Send(lcd, LCD_ENTRY_NIBBLE, LCD_4_BIT_MODE);
+		LCD_Send(lcd, LCD_ENTRY_DELAY_US, LCD_INIT_NEXT_WAIT_US);
+	}
 
 	/***_________ Function Set _________***/
-	LCD_SendCommand(0x20);
-	LCD_SendCommand(0x20);
-	//2 lines  - 5*10 font
-	LCD_SendCommand(0x0C);
-
-	/*Wait for more than 39 uS*/
-	LIB_SysTickDelay_us(50);
+	//bus width - lines - 5*8 font
+	LCD_SendCommand(lcd, ((cfg->bus_width == LCD_BUS_8BIT) ? LCD_8_BIT_MODE : LCD_4_BIT_MODE) |
+						 ((cfg->rows > 1) ? LCD_2_LINES : LCD_1_LINE) | LCD_5_7_FONT);
 
 	/***_________ Display ON/OFF Control _________***/
-	//Blink Off  - Cursor On  - Display On
-	LCD_SendCommand(0x00);
-	LCD_SendCommand(0xE0);
-
-	/*Wait for more than 39 uS*/
-	LIB_SysTickDelay_us(50);
-
+	//Blink Off  - Cursor Off  - Display On
+	LCD_SendCommand(lcd, LCD_DISPLAY_ON | LCD_CURSOR_DISPLAY_OFF | LCD_CURSOR_BLINK_OFF);
 
 	/***_________ Display Clear _________***/
-	LCD_SendCommand(0x00);
-	LCD_SendCommand(0x01);
-
-	/*Wait for more than 1.5 mSecond*/
-	LIB_SysTickDelay_ms(5);
+	LCD_SendCommand(lcd, LCD_CLEAR_DISPLAY);
 
 	/***_________ Entry Mode Set  _________***/
-	LCD_SendCommand(0x00);
-	LCD_SendCommand(0x06);
+	LCD_SendCommand(lcd, LCD_CURSOR_INCREASE);
+
+	/*From now on BF is polled after each byte (LCD_BUSY_FLAG_POLLING)*/
+	LCD_Send(lcd, LCD_ENTRY_BUSY_FLAG_ON, 0);
+
+	/*The display is blank after clearing it*/
+	LCD_FbClear(lcd);
+	for(uint8_t row = 0; row < LCD_MAX_ROWS; row++){
+		for(uint8_t col = 0; col < LCD_MAX_COLUMNS; col++){
+			lcd->fb_flushed[row][col] = ' ';
+		}
+	}
+	//CGRAM content is undefined after power on
+	for(uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++){
+		lcd->glyph_bitmap[slot] = 0;
+		lcd->glyph_last_use[slot] = 0;
+	}
+	lcd->glyph_clock = 0;
 
+	return 1;
 }
 
 
@@ -223,13 +742,14 @@ void LCD_Init(){
  * @func LCD_PrintChar
  * @brief print a character on LCD.
  *
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t byte
  * @return void
  */
-void LCD_PrintChar(uint8_t byte){
+void LCD_PrintChar(LCD_Handle_t* lcd, uint8_t byte){
 
 
-	LCD_SendData(byte);
+	LCD_SendData(lcd, byte);
 
 }
 
@@ -238,14 +758,15 @@ void LCD_PrintChar(uint8_t byte){
  * @brief print a string.
  * # The functions invokes LCD_PrintChar() function until it encounters an null terminator '\0'.
  *
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t* str
  * @return void
  */
-void LCD_PrintString(uint8_t* str){
+void LCD_PrintString(LCD_Handle_t* lcd, uint8_t* str){
 
 	uint8_t i = 0;
 	while(str[i] != '\0'){
-		LCD_SendData(str[i]);
+		LCD_SendData(lcd, str[i]);
 		i++;
 	}
 
@@ -253,33 +774,254 @@ void LCD_PrintString(uint8_t* str){
 
 
 /**
- * @func LCD_PrintString
+ * @func LCD_PrintInt32
  * @brief prints any signed/unsigned number with the range of [-2^31 : 2^31 - 1].
  *
+ * @param  LCD_Handle_t* lcd
  * @param  int32_t num_32
  * @return void
  */
-void LCD_PrintInt32(int32_t num_32){
+void LCD_PrintInt32(LCD_Handle_t* lcd, int32_t num_32){
+
+	uint8_t buffer[LIB_FORMAT_BUFFER_SIZE];
+
+	//handles INT32_MIN, its negation doesn't fit an int32_t
+	LIB_FormatInt32(buffer, num_32);
+	LCD_PrintString(lcd, buffer);
 
-	uint8_t buffer[20];
+}
+
+
+/**
+ * @func LCD_IsIdle
+ * @brief Checks if everything queued has been written to the LCD (always idle in LCD_BLOCKING_MODE).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return uint8_t	1: idle, 0: still writing
+ */
+uint8_t LCD_IsIdle(LCD_Handle_t* lcd){
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
+	return (lcd->running == 0);
+#else
+	(void)lcd;
+	return 1;
+#endif
+}
 
+/**
+ * @func LCD_SetSinkTarget
+ * @brief Selects the display LCD_SinkChar() prints to.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_SetSinkTarget(LCD_Handle_t* lcd){
+	g_LCD_SINK_TARGET = lcd;
+}
 
-	if(num_32 < 0)
-	{
-		//negative
-		num_32 = num_32 * -1 ;
-		LCD_PrintString("-");
-	}else if(num_32 == 0){
-		//do nothing
-	}else{
-		//do nothing
+/**
+ * @func LCD_SinkChar
+ * @brief LIB_FormatSink_t printing to the display selected by LCD_SetSinkTarget().
+ *
+ * @param  uint8_t ch
+ * @return void
+ */
+void LCD_SinkChar(uint8_t ch){
+	if(g_LCD_SINK_TARGET != 0){
+		LCD_SendData(g_LCD_SINK_TARGET, ch);
 	}
+}
 
-	itoa(num_32, buffer, 10);
-	LCD_PrintString(buffer);
+/**
+ * @func LCD_SetCursor
+ * @brief Moves the address counter (where the next printed character goes).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @return void
+ */
+void LCD_SetCursor(LCD_Handle_t* lcd, uint8_t row, uint8_t col){
 
+	if((row < lcd->configs.rows) && (col < lcd->configs.columns)){
+		LCD_SendCommand(lcd, LCD_SET_DDRAM_ADDRESS | (lcd->configs.row_address[row] + col));
+	}
 }
 
+/**
+ * @func LCD_GlyphGet
+ * @brief Returns the character code of a custom glyph, uploading it to the least recently used CGRAM slot
+ * 		  if it isn't already loaded.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  const uint8_t* bitmap	8 rows of 5 pixels (LSBs), must stay valid (static const)
+ * @return uint8_t					LCD_GLYPH_CODE_BASE + slot
+ */
+uint8_t LCD_GlyphGet(LCD_Handle_t* lcd, const uint8_t* bitmap){
+
+	uint8_t victim = 0;
+
+	lcd->glyph_clock++;
+
+	for(uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++){
+		if(lcd->glyph_bitmap[slot] == bitmap){
+			//hit, nothing to send
+			lcd->glyph_last_use[slot] = lcd->glyph_clock;
+			return LCD_GLYPH_CODE_BASE + slot;
+		}
+		//empty slots have the oldest stamp (0)
+		if(lcd->glyph_last_use[slot] < lcd->glyph_last_use[victim]){
+			victim = slot;
+		}
+	}
+
+	/*Miss: upload the bitmap over the least recently used slot*/
+	LCD_SendCommand(lcd, LCD_SET_CGRAM_ADDRESS | (victim * LCD_GLYPH_ROWS));
+	for(uint8_t row = 0; row < LCD_GLYPH_ROWS; row++){
+		LCD_SendData(lcd, bitmap[row] & 0x1F);
+	}
+
+	lcd->glyph_bitmap[victim] = bitmap;
+	lcd->glyph_last_use[victim] = lcd->glyph_clock;
+	return LCD_GLYPH_CODE_BASE + victim;
+}
+
+/**
+ * @func LCD_GlyphInvalidate
+ * @brief Forces the next LCD_GlyphGet() of this bitmap to upload it again (its content was changed).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  const uint8_t* bitmap
+ * @return void
+ */
+void LCD_GlyphInvalidate(LCD_Handle_t* lcd, const uint8_t* bitmap){
+
+	for(uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++){
+		if(lcd->glyph_bitmap[slot] == bitmap){
+			lcd->glyph_bitmap[slot] = 0;
+			lcd->glyph_last_use[slot] = 0;
+		}
+	}
+}
+
+/**
+ * @func LCD_FbWriteChar
+ * @brief Writes a character in the shadow framebuffer (shown on the next LCD_Flush()).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @param  uint8_t ch
+ * @return void
+ */
+void LCD_FbWriteChar(LCD_Handle_t* lcd, uint8_t row, uint8_t col, uint8_t ch){
+
+	if((row < lcd->configs.rows) && (col < lcd->configs.columns)){
+		lcd->fb[row][col] = ch;
+	}
+}
+
+/**
+ * @func LCD_FbWriteString
+ * @brief Writes a string in the shadow framebuffer starting from (row, col), clipped at the end of the row.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @param  uint8_t* str		null terminated
+ * @return void
+ */
+void LCD_FbWriteString(LCD_Handle_t* lcd, uint8_t row, uint8_t col, uint8_t* str){
+
+	if(row >= lcd->configs.rows){
+		return;
+	}
+	while((*str != '\0') && (col < lcd->configs.columns)){
+		lcd->fb[row][col] = *str;
+		str++;
+		col++;
+	}
+}
+
+/**
+ * @func LCD_FbClear
+ * @brief Fills the shadow framebuffer with spaces (shown on the next LCD_Flush()).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_FbClear(LCD_Handle_t* lcd){
+
+	for(uint8_t row = 0; row < LCD_MAX_ROWS; row++){
+		for(uint8_t col = 0; col < LCD_MAX_COLUMNS; col++){
+			lcd->fb[row][col] = ' ';
+		}
+	}
+}
+
+/**
+ * @func LCD_FbInvalidate
+ * @brief Forgets the flushed state so the next LCD_Flush() rewrites every cell.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_FbInvalidate(LCD_Handle_t* lcd){
+
+	for(uint8_t row = 0; row < LCD_MAX_ROWS; row++){
+		for(uint8_t col = 0; col < LCD_MAX_COLUMNS; col++){
+			//the inverse can't be equal to the wanted character
+			lcd->fb_flushed[row][col] = (uint8_t)~lcd->fb[row][col];
+		}
+	}
+}
+
+/**
+ * @func LCD_Flush
+ * @brief Sends only the cells of the shadow framebuffer that changed since the last flush.
+ *
+ * # The LCD address counter increments after each data write (entry mode: increment, no shift), so
+ * 	 the address command is skipped while the changed cells are adjacent. The counter isn't tracked
+ * 	 between flushes since LCD_PrintXXX() may have moved it.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return uint16_t		number of bytes (commands + data) sent to the LCD, 0 if the display isn't initialized
+ */
+uint16_t LCD_Flush(LCD_Handle_t* lcd){
+
+	uint16_t sent = 0;
+
+	//nothing would reach the display: the flushed copy must keep matching what it really shows
+	if(!lcd->initialized){
+		return 0;
+	}
+
+	for(uint8_t row = 0; row < lcd->configs.rows; row++){
+
+		//column the LCD address counter points at in this row, columns: unknown
+		uint8_t cursor = lcd->configs.columns;
+
+		for(uint8_t col = 0; col < lcd->configs.columns; col++){
+
+			uint8_t ch = lcd->fb[row][col];
+			if(ch == lcd->fb_flushed[row][col]){
+				continue;
+			}
+
+			if(cursor != col){
+				LCD_SendCommand(lcd, LCD_SET_DDRAM_ADDRESS | (lcd->configs.row_address[row] + col));
+				sent++;
+			}
+			LCD_SendData(lcd, ch);
+			sent++;
+
+			lcd->fb_flushed[row][col] = ch;
+			cursor = col + 1;
+		}
+	}
+
+	return sent;
+}
 
 
 /******************************* ISR *******************************/
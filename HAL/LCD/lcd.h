@@ -5,7 +5,62 @@
  *
  * @brief header file for LCD module.
  *
- * This module implements LCD module in 4-bit mode
+ * This module implements a generic HD44780 character LCD driver (4-bit or 8-bit bus, any geometry up to
+ * LCD_MAX_ROWS x LCD_MAX_COLUMNS, up to LCD_MAX_DISPLAYS displays).
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which Display ?
+ * 		[♥] Each display has its own {LCD_Handle_t} variable (static, it holds the display's queue and buffers),
+ * 			every API takes the handle of the display it works on.
+ *
+ * # Usage Work Flow ?
+ * 		1. Make a static {LCD_Handle_t} variable and fill its {configs} member: pin map, bus width and geometry.
+ * 		2. Call LCD_Init() with it, it returns 0 if the display can't be driven (more than LCD_MAX_DISPLAYS
+ * 			handles in LCD_ASYNC_MODE), the display's APIs then do nothing.
+ * 		3. Use LCD_PrintXXX()/LCD_SetCursor() or the shadow framebuffer APIs + LCD_Flush().
+ *
+ * # Driving modes ?
+ * 		[♥] LCD_BLOCKING_MODE	-> every API returns after the LCD has finished, waiting using SysTick busy delays.
+ * 		[♥] LCD_ASYNC_MODE		-> APIs only queue the commands/data and return immediately. A one-shot timer
+ * 			(LCD_ASYNC_TIMER) interrupt clocks them out, waiting only the HD44780 timings in between, so the
+ * 			CPU is free while the LCD is being written.
+ * 			-> One timer is shared by all the displays: each display has its own state machine and remaining
+ * 				wait, the timer is armed with the nearest one so all displays are written concurrently.
+ * 			-> If a display's queue is full, the caller waits until the ISR frees a slot, so don't call the
+ * 				LCD APIs from an ISR that has a higher priority than the timer's.
+ *
+ * # Bus width ?
+ * 		[♥] LCD_BUS_8BIT writes a byte with one E pulse (D0-D7), LCD_BUS_4BIT needs two (D4-D7 only).
+ *
+ * # Busy flag ?
+ * 		[♥] With LCD_BUSY_FLAG_POLLING the RW pin is used to read the busy flag (data pins switched to inputs) after
+ * 			each byte, so the next one is sent as soon as the LCD is ready instead of after the worst-case time.
+ * 		[♥] In LCD_ASYNC_MODE the first read is done LCD_BUSY_FIRST_POLL_US (LCD_BUSY_FIRST_POLL_LONG_US for Clear
+ * 			Display/Return Home) after the byte, below the typical execution times, and the next ones every
+ * 			LCD_BUSY_POLL_INTERVAL_US, so the timer interrupt doesn't fire every tick while the LCD is busy.
+ * 		[♥] If BF doesn't clear within LCD_BUSY_TIMEOUT_US (display missing/RW not wired) the driver falls back
+ * 			to the fixed worst-case delays for that display until its next LCD_Init().
+ * 		[♥] When reading, the LCD drives the data pins with its supply voltage, so a 5V LCD needs 5V tolerant (FT) pins.
+ *
+ * # Custom glyphs (CGRAM) ?
+ * 		[♥] LCD_GlyphGet() takes a 5x8 bitmap (8 rows, 5 LSBs used) and returns the character code to print it.
+ * 		[♥] The 8 CGRAM slots are a cache keyed by the bitmap's address: an already loaded glyph costs nothing,
+ * 			a new one replaces the least recently used slot (8 data bytes, CGRAM isn't rewritten every frame).
+ * 		[♥] Cells already showing an evicted glyph change with it, so keep at most 8 glyphs visible at once.
+ * 		[♥] Uploading moves the address counter to CGRAM, get the glyph codes first then LCD_SetCursor()
+ * 			(or use the framebuffer, LCD_Flush() always sets the address).
+ * 		[♥] If a bitmap is modified in place call LCD_GlyphInvalidate() so it's uploaded again.
+ *
+ * # Shadow framebuffer ?
+ * 		[♥] LCD_FbWriteChar()/LCD_FbWriteString()/LCD_FbClear() only update a RAM copy of the screen.
+ * 		[♥] LCD_Flush() compares it with what was last flushed and sends only the changed cells, a
+ * 			Set DDRAM Address command is sent only where the cursor isn't already at the changed cell,
+ * 			so a run of adjacent changed cells costs one address command + one data byte per cell.
+ * 		[♥] Intended for periodically refreshed screens that mostly repaint the same text. If LCD_PrintXXX()
+ * 			APIs are mixed with it, call LCD_FbInvalidate() so the next flush repaints everything.
+ *
+ * # Formatting ?
+ * 		[♥] LCD_SetSinkTarget() + LCD_SinkChar() let the LIB_PrintXXX() functions (num_format.h) print to a display.
  */
 #ifndef LCD_LCD_H_
 #define LCD_LCD_H_
@@ -17,29 +72,129 @@
 #include "rcc.h"
 #include "common_lib.h"
 #include "bit_math.h"
+#include "tim.h"
+
+/*Character codes of the 8 CGRAM glyphs (0x08 - 0x0F mirror 0x00 - 0x07, and can't end a string)*/
+#define LCD_GLYPH_CODE_BASE		0x08
+#define LCD_GLYPH_SLOTS			8
+
+/*DDRAM address of each row's first cell for the usual 1/2/4 lines modules (rows 2, 3 continue rows 0, 1)*/
+#define LCD_DEFAULT_ROW_ADDRESS(columns)	{0x00, 0x40, (columns), 0x40 + (columns)}
 
 /******************************* Configurations *******************************/
 /**
- * @defgroup LCD connection configurations (GPIO pins used for data/control & GPIO port used).
+ * @brief Configuring how the driver waits for the LCD.
  *
- * # This LCD Driver is implemented only for 4-bit configuration.
+ * #Choose Between
+ * 		- LCD_BLOCKING_MODE
+ * 		- LCD_ASYNC_MODE
+ */
+#define LCD_BLOCKING_MODE		0
+#define LCD_ASYNC_MODE			1
+#define LCD_DRIVING_MODE		LCD_ASYNC_MODE
+
+/*One-shot timer used by LCD_ASYNC_MODE (a basic timer TIM6/TIM7 is enough), shared by all displays*/
+#define LCD_ASYNC_TIMER			TIM_TIM7
+
+/*Number of queued commands/data bytes per display in LCD_ASYNC_MODE (power of 2, at most 256)*/
+#define LCD_ASYNC_QUEUE_SIZE	64
+
+/**
+ * @brief Configuring how the driver knows that the LCD finished an instruction.
  *
+ * #Choose Between
+ * 		- LCD_BUSY_FLAG_DELAYS	-> fixed worst-case delays, RW is kept low
+ * 		- LCD_BUSY_FLAG_POLLING	-> reads BF through RW, with LCD_BUSY_TIMEOUT_US fallback to the delays
  */
-#define LCD_D4	GPIO_PIN4
-#define LCD_D5	GPIO_PIN5
-#define LCD_D6	GPIO_PIN6
-#define LCD_D7	GPIO_PIN7
-#define LCD_DATA_GPIO		GPIOA
-#define LCD_DATA_RCC_GPIO		RCC_AHB1_GPIOA
+#define LCD_BUSY_FLAG_DELAYS	0
+#define LCD_BUSY_FLAG_POLLING	1
+#define LCD_BUSY_FLAG_MODE		LCD_BUSY_FLAG_POLLING
 
-#define LCD_RS	GPIO_PIN8
-#define LCD_RW	GPIO_PIN9
-#define LCD_E	GPIO_PIN10
-#define LCD_CONTROL_GPIO	GPIOA
-#define LCD_CONTROL_RCC_GPIO	RCC_AHB1_GPIOA
+#define LCD_BUSY_TIMEOUT_US		(3000)
+
+/*LCD_ASYNC_MODE: first BF read after the byte, under the typical 37 uS / 1.52 mS (270 KHz), then every
+  LCD_BUSY_POLL_INTERVAL_US*/
+#define LCD_BUSY_FIRST_POLL_US		(15)
+#define LCD_BUSY_FIRST_POLL_LONG_US	(1200)
+#define LCD_BUSY_POLL_INTERVAL_US	(20)
+
+/*Largest geometry a handle can have (sizes the shadow framebuffer) and number of displays*/
+#define LCD_MAX_ROWS			4
+#define LCD_MAX_COLUMNS			20
+#define LCD_MAX_DISPLAYS		2
 
 
 /******************************* Types *******************************/
+/**
+ * @enum LCD_BusWidth_en
+ */
+typedef enum{
+	LCD_BUS_4BIT = 4,	/*D4-D7 wired, 2 E pulses per byte*/
+	LCD_BUS_8BIT = 8,	/*D0-D7 wired, 1 E pulse per byte*/
+}LCD_BusWidth_en;
+
+/**
+ * @struct LCD_Config_t
+ * @brief Pin map and geometry of one display.
+ */
+typedef struct{
+	GPIO_t* data_gpio;
+	RCC_AHB1PERIPH_en data_rcc_gpio;
+	GPIO_Pin_en data_pins[8];		/*D0-D7 pins, only [4] - [7] are used by LCD_BUS_4BIT*/
+
+	GPIO_t* control_gpio;
+	RCC_AHB1PERIPH_en control_rcc_gpio;
+	GPIO_Pin_en rs;
+	GPIO_Pin_en rw;
+	GPIO_Pin_en e;
+
+	LCD_BusWidth_en bus_width;
+	uint8_t rows;					/*1, 2 or 4 - up to LCD_MAX_ROWS*/
+	uint8_t columns;				/*up to LCD_MAX_COLUMNS*/
+	uint8_t row_address[LCD_MAX_ROWS];	/*DDRAM address of each row's first cell, LCD_DEFAULT_ROW_ADDRESS(columns)*/
+}LCD_Config_t;
+
+/**
+ * @struct LCD_AsyncEntry_t
+ * @note Private to the driver (LCD_ASYNC_MODE queue entry)
+ */
+typedef struct{
+	uint8_t type;
+	uint16_t value;
+}LCD_AsyncEntry_t;
+
+/**
+ * @struct LCD_Handle_t
+ * @brief One display: its configurations and the driver's state for it.
+ * @note Only {configs} is to be filled by the user, the other members are private to the driver.
+ */
+typedef struct{
+	LCD_Config_t configs;
+
+	volatile uint8_t bf_available;		/*1: BF is read after each byte*/
+	uint8_t initialized;				/*1: LCD_Init() succeeded, the APIs are ignored otherwise*/
+
+	/*Shadow framebuffer: what the application wants shown and what was last sent to the LCD*/
+	uint8_t fb[LCD_MAX_ROWS][LCD_MAX_COLUMNS];
+	uint8_t fb_flushed[LCD_MAX_ROWS][LCD_MAX_COLUMNS];
+
+	/*CGRAM glyph cache: bitmap loaded in each slot and its last use (LRU)*/
+	const uint8_t* glyph_bitmap[LCD_GLYPH_SLOTS];
+	uint32_t glyph_last_use[LCD_GLYPH_SLOTS];
+	uint32_t glyph_clock;
+
+#if LCD_DRIVING_MODE == LCD_ASYNC_MODE
+	LCD_AsyncEntry_t queue[LCD_ASYNC_QUEUE_SIZE];
+	volatile uint8_t queue_head;		/*written by the thread only*/
+	volatile uint8_t queue_tail;		/*written by the ISR only*/
+	volatile uint8_t running;
+	uint8_t state;
+	uint8_t busy;
+	LCD_AsyncEntry_t current;
+	uint16_t poll_time_us;
+	uint32_t remaining_us;				/*time left before the next step*/
+#endif
+}LCD_Handle_t;
 
 
 /******************************* Functions prototypes *******************************/
@@ -48,19 +203,20 @@
  * @func LCD_Init
  * @brief Initializing the LCD ( GPIO data pins, GPIO control pins, mode, font, lines, cursor, display, blinking, ...etc).
  *
- * @param  void
- * @return void
+ * @param  LCD_Handle_t* lcd	handle with its {configs} filled, at most LCD_MAX_DISPLAYS handles in LCD_ASYNC_MODE
+ * @return uint8_t				1: initialized, 0: no free display slot (LCD_MAX_DISPLAYS reached)
  */
-void LCD_Init();
+uint8_t LCD_Init(LCD_Handle_t* lcd);
 
 /**
  * @func LCD_PrintChar
  * @brief print a character on LCD.
  *
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t byte
  * @return void
  */
-void LCD_PrintChar(uint8_t byte);
+void LCD_PrintChar(LCD_Handle_t* lcd, uint8_t byte);
 
 
 /**
@@ -68,19 +224,132 @@ void LCD_PrintChar(uint8_t byte);
  * @brief print a string.
  * # The functions invokes LCD_PrintChar() function until it encounters an null terminator '\0'.
  *
+ * @param  LCD_Handle_t* lcd
  * @param  uint8_t* str
  * @return void
  */
-void LCD_PrintString(uint8_t* str);
+void LCD_PrintString(LCD_Handle_t* lcd, uint8_t* str);
 
 
 /**
- * @func LCD_PrintString
+ * @func LCD_PrintInt32
  * @brief prints any signed/unsigned number with the range of [-2^31 : 2^31 - 1].
  *
+ * @param  LCD_Handle_t* lcd
  * @param  int32_t num_32
  * @return void
  */
-void LCD_PrintInt32(int32_t num_32);
+void LCD_PrintInt32(LCD_Handle_t* lcd, int32_t num_32);
+
+
+/**
+ * @func LCD_IsIdle
+ * @brief Checks if everything queued has been written to the LCD (always idle in LCD_BLOCKING_MODE).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return uint8_t	1: idle, 0: still writing
+ */
+uint8_t LCD_IsIdle(LCD_Handle_t* lcd);
+
+/**
+ * @func LCD_SetSinkTarget
+ * @brief Selects the display LCD_SinkChar() prints to.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_SetSinkTarget(LCD_Handle_t* lcd);
+
+/**
+ * @func LCD_SinkChar
+ * @brief LIB_FormatSink_t printing to the display selected by LCD_SetSinkTarget().
+ *
+ * @param  uint8_t ch
+ * @return void
+ */
+void LCD_SinkChar(uint8_t ch);
+
+/**
+ * @func LCD_SetCursor
+ * @brief Moves the address counter (where the next printed character goes).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @return void
+ */
+void LCD_SetCursor(LCD_Handle_t* lcd, uint8_t row, uint8_t col);
+
+/**
+ * @func LCD_GlyphGet
+ * @brief Returns the character code of a custom glyph, uploading it to the least recently used CGRAM slot
+ * 		  if it isn't already loaded.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  const uint8_t* bitmap	8 rows of 5 pixels (LSBs), must stay valid (static const)
+ * @return uint8_t					LCD_GLYPH_CODE_BASE + slot
+ */
+uint8_t LCD_GlyphGet(LCD_Handle_t* lcd, const uint8_t* bitmap);
+
+/**
+ * @func LCD_GlyphInvalidate
+ * @brief Forces the next LCD_GlyphGet() of this bitmap to upload it again (its content was changed).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  const uint8_t* bitmap
+ * @return void
+ */
+void LCD_GlyphInvalidate(LCD_Handle_t* lcd, const uint8_t* bitmap);
+
+/**
+ * @func LCD_FbWriteChar
+ * @brief Writes a character in the shadow framebuffer (shown on the next LCD_Flush()).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @param  uint8_t ch
+ * @return void
+ */
+void LCD_FbWriteChar(LCD_Handle_t* lcd, uint8_t row, uint8_t col, uint8_t ch);
+
+/**
+ * @func LCD_FbWriteString
+ * @brief Writes a string in the shadow framebuffer starting from (row, col), clipped at the end of the row.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @param  uint8_t row		[0 - rows-1]
+ * @param  uint8_t col		[0 - columns-1]
+ * @param  uint8_t* str		null terminated
+ * @return void
+ */
+void LCD_FbWriteString(LCD_Handle_t* lcd, uint8_t row, uint8_t col, uint8_t* str);
+
+/**
+ * @func LCD_FbClear
+ * @brief Fills the shadow framebuffer with spaces (shown on the next LCD_Flush()).
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_FbClear(LCD_Handle_t* lcd);
+
+/**
+ * @func LCD_FbInvalidate
+ * @brief Forgets the flushed state so the next LCD_Flush() rewrites every cell.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return void
+ */
+void LCD_FbInvalidate(LCD_Handle_t* lcd);
+
+/**
+ * @func LCD_Flush
+ * @brief Sends only the cells of the shadow framebuffer that changed since the last flush.
+ *
+ * @param  LCD_Handle_t* lcd
+ * @return uint16_t		number of bytes (commands + data) sent to the LCD, 0 if the display isn't initialized
+ */
+uint16_t LCD_Flush(LCD_Handle_t* lcd);
 
 #endif /* LCD_LCD_H_ */
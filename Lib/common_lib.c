@@ -74,6 +74,91 @@ void LIB_SysTickDelay_ms(uint32_t msec){
 	}
 }
 
+/**
+ * @func LIB_EnterCritical
+ * @brief Masks all configurable interrupts (PRIMASK) and returns the previous mask so critical sections can nest.
+ *
+ * @return uint32_t	previous PRIMASK value, to be passed to LIB_ExitCritical().
+ */
+uint32_t LIB_EnterCritical(void){
+	uint32_t primask;
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i" ::: "memory");
+	return primask;
+}
+
+/**
+ * @func LIB_ExitCritical
+ * @brief Restores the interrupt mask saved by LIB_EnterCritical().
+ *
+ * @param uint32_t primask [in]	value returned by the matching LIB_EnterCritical()
+ * @return void .
+ */
+void LIB_ExitCritical(uint32_t primask){
+	__asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/**
+ * @func LIB_CycleCounterEnable
+ * @brief Starts the DWT cycle counter (CPU clock cycles, wraps every 2^32 cycles: ~268 s at 16 MHz).
+ *
+ * @return void .
+ */
+void LIB_CycleCounterEnable(void){
+
+	//the DWT is powered by the trace enable bit
+	CoreDebug->DEMCR |= (1UL << CoreDebug_DEMCR_TRCENA);
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= (1UL << DWT_CTRL_CYCCNTENA);
+}
+
+/**
+ * @func LIB_CycleCounterRead
+ * @brief Returns the DWT cycle counter, durations are computed with unsigned subtraction (wrap safe).
+ *
+ * @return uint32_t
+ */
+uint32_t LIB_CycleCounterRead(void){
+	return DWT->CYCCNT;
+}
+
+/**
+ * @func LIB_JitterReset
+ * @brief Clears the jitter statistics.
+ *
+ * @param LIB_Jitter_t* jitter [out]
+ * @return void .
+ */
+void LIB_JitterReset(LIB_Jitter_t* jitter){
+	*jitter = (LIB_Jitter_t){0};
+}
+
+/**
+ * @func LIB_JitterRecord
+ * @brief Records a periodic event (e.g. at an ISR entry): the period since the previous one updates min/max.
+ * @note Needs the cycle counter (LIB_CycleCounterEnable()), runs from SRAM (LIB_RAMFUNC).
+ *
+ * @param LIB_Jitter_t* jitter [in/out]
+ * @return void .
+ */
+LIB_RAMFUNC void LIB_JitterRecord(LIB_Jitter_t* jitter){
+
+	uint32_t now = DWT->CYCCNT;
+	uint32_t period = now - jitter->last;
+
+	//the first event only starts the measurement
+	if(jitter->last != 0){
+		if((jitter->samples == 0) || (period < jitter->min_period)){
+			jitter->min_period = period;
+		}
+		if(period > jitter->max_period){
+			jitter->max_period = period;
+		}
+		jitter->samples++;
+	}
+	jitter->last = now;
+}
+
 /******************************* ISR *******************************/
 
 
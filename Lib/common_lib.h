@@ -18,6 +18,24 @@
 #include "usart.h"
 
 /*******************************  Macros *******************************/
+/**
+ * @defgroup LIB_CCM_Placement
+ * @brief Places a variable in the 64 KB CCM RAM (0x10000000): zero wait state on the CPU D-bus and no contention
+ * 			with the DMA/bus masters, but NOT reachable by the DMA: never for DMA buffers.
+ * 		LIB_CCM_DATA	-> initialized variables, copied from FLASH by the startup (.ccmram)
+ * 		LIB_CCM_BSS		-> zero-initialized variables, cleared by the startup (.ccmbss, no FLASH space)
+ * 		APP_CcmBenchmark() (APP/CCM_BENCHMARK.c) times a loop with its state in SRAM and in CCM under DMA traffic.
+ */
+#define LIB_CCM_DATA	__attribute__((section(".ccmram")))
+#define LIB_CCM_BSS		__attribute__((section(".ccmbss")))
+
+/**
+ * @def LIB_RAMFUNC
+ * @brief Places a function in SRAM (.ramfunc, copied from FLASH by the startup): executed with no FLASH wait states
+ * 			or ART misses (constant timing) and usable while the FLASH is being written. Never inlined, so it always
+ * 			runs from SRAM, the calls from/to FLASH go through linker veneers.
+ */
+#define LIB_RAMFUNC		__attribute__((section(".ramfunc"), noinline))
 
 
 /******************************* globals *******************************/
@@ -28,6 +46,17 @@
 
 
 /******************************* Types *******************************/
+/**
+ * @struct LIB_Jitter_t
+ * @brief Periodic event jitter in CPU cycles: max_period - min_period.
+ * @note Initialize using LIB_JitterReset() (or zero-initialized).
+ */
+typedef struct{
+	uint32_t last;				/*cycle counter at the previous event*/
+	uint32_t min_period;
+	uint32_t max_period;
+	uint32_t samples;			/*periods measured*/
+}LIB_Jitter_t;
 
 
 /******************************* Functions prototypes *******************************/
@@ -53,5 +82,57 @@ void LIB_SysTickDelay_us(uint16_t usec);
  */
 void LIB_SysTickDelay_ms(uint32_t msec);
 
+/**
+ * @func LIB_EnterCritical
+ * @brief Masks all configurable interrupts (PRIMASK) and returns the previous mask so critical sections can nest.
+ *
+ * @return uint32_t	previous PRIMASK value, to be passed to LIB_ExitCritical().
+ */
+uint32_t LIB_EnterCritical(void);
+
+/**
+ * @func LIB_ExitCritical
+ * @brief Restores the interrupt mask saved by LIB_EnterCritical().
+ *
+ * @param uint32_t primask [in]	value returned by the matching LIB_EnterCritical()
+ * @return void .
+ */
+void LIB_ExitCritical(uint32_t primask);
+
+/**
+ * @func LIB_CycleCounterEnable
+ * @brief Starts the DWT cycle counter (CPU clock cycles, wraps every 2^32 cycles: ~268 s at 16 MHz).
+ *
+ * @return void .
+ */
+void LIB_CycleCounterEnable(void);
+
+/**
+ * @func LIB_CycleCounterRead
+ * @brief Returns the DWT cycle counter, durations are computed with unsigned subtraction (wrap safe).
+ *
+ * @return uint32_t
+ */
+uint32_t LIB_CycleCounterRead(void);
+
+/**
+ * @func LIB_JitterReset
+ * @brief Clears the jitter statistics.
+ *
+ * @param LIB_Jitter_t* jitter [out]
+ * @return void .
+ */
+void LIB_JitterReset(LIB_Jitter_t* jitter);
+
+/**
+ * @func LIB_JitterRecord
+ * @brief Records a periodic event (e.g. at an ISR entry): the period since the previous one updates min/max.
+ * @note Needs the cycle counter (LIB_CycleCounterEnable()), runs from SRAM (LIB_RAMFUNC).
+ *
+ * @param LIB_Jitter_t* jitter [in/out]
+ * @return void .
+ */
+void LIB_JitterRecord(LIB_Jitter_t* jitter);
+
 
 #endif /* COMMON_LIB_H_ */
@@ -0,0 +1,295 @@
+/**
+ * @file crc32.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Bulk CRC-32 checksums on the CRC unit (CPU or DMA fed) with a bit-exact table-driven software fallback.
+ *
+ * # Slicing-by-4
+ * 		[♥] T0[b] is the CRC of the byte b alone, Tk[b] the CRC of b followed by k zero bytes, so XORing a word into
+ * 			the CRC and looking its 4 bytes up in T3..T0 processes the whole word at once.
+ * 		[♥] The reflected tables are the same with the bits reversed, a zlib word step is the RBIT image of a
+ * 			CRC unit word step, which is why the CRC unit can compute it from bit-reversed words.
+ */
+/******************************* Includes *******************************/
+#include "crc32.h"
+
+/*******************************  Macros *******************************/
+#if (LIB_CRC_USE_HARDWARE == LIB_CRC_HARDWARE_ENABLE) && defined(__arm__)
+#define LIB_CRC_HARDWARE_PATH		1
+#else
+#define LIB_CRC_HARDWARE_PATH		0
+#endif
+
+#if LIB_CRC_HARDWARE_PATH == 1
+#include "crc.h"
+#endif
+
+#define LIB_CRC_POLY				(0x04C11DB7UL)
+#define LIB_CRC_POLY_REFLECTED		(0xEDB88320UL)
+#define LIB_CRC_INIT				(0xFFFFFFFFUL)
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+#if LIB_CRC_HARDWARE_PATH == 1
+static uint8_t g_LIB_CRC_READY = 0;
+
+/*Running LIB_Crc32Async(): the 0 - 3 tail bytes are done by the DMA completion*/
+typedef struct{
+	const uint8_t* tail;
+	uint8_t tail_len;
+	LIB_Crc32Callback_t callback;
+	void* context;
+}LIB_CrcAsync_t;
+
+static LIB_CrcAsync_t g_LIB_CRC_ASYNC;
+#else
+/*[k][b]: CRC of the byte b followed by k zero bytes*/
+static uint32_t g_LIB_CRC_TABLE[4][256];
+static uint32_t g_LIB_CRC_TABLE_REFLECTED[4][256];
+static uint8_t g_LIB_CRC_TABLES_READY = 0;
+#endif
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func LIB_CrcByte
+ * @brief Processes one byte MSB first (CRC unit bit order).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint32_t LIB_CrcByte(uint32_t crc, uint8_t byte){
+
+	crc ^= (uint32_t)byte << 24;
+	for(uint8_t bit = 0; bit < 8; bit++){
+		crc = (crc & 0x80000000UL) ? ((crc << 1) ^ LIB_CRC_POLY) : (crc << 1);
+	}
+
+	return crc;
+}
+
+/**
+ * @func LIB_CrcByteReflected
+ * @brief Processes one byte LSB first (zlib bit order).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint32_t LIB_CrcByteReflected(uint32_t crc, uint8_t byte){
+
+	crc ^= byte;
+	for(uint8_t bit = 0; bit < 8; bit++){
+		crc = (crc & 1UL) ? ((crc >> 1) ^ LIB_CRC_POLY_REFLECTED) : (crc >> 1);
+	}
+
+	return crc;
+}
+
+#if LIB_CRC_HARDWARE_PATH == 1
+/**
+ * @func LIB_CrcIsCcm
+ * @brief Checks if a buffer overlaps the CCM RAM (not reachable by the DMA).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint8_t LIB_CrcIsCcm(const void* buf, uint32_t len){
+
+	uint32_t start = (uint32_t)buf;
+
+	return (start < (CCMRAM_BASE + CCMRAM_SIZE)) && ((start + len) > CCMRAM_BASE);
+}
+
+/**
+ * @func LIB_CrcStart
+ * @brief Enables the CRC unit at the first call and resets the CRC.
+ *
+ * @note STATIC FUNCTION
+ */
+static void LIB_CrcStart(void){
+
+	//the CRC unit holds the running CRC of a LIB_Crc32Async()
+	while(!CRC_DmaIsIdle());
+
+	if(!g_LIB_CRC_READY){
+		CRC_Init();
+		g_LIB_CRC_READY = 1;
+	}else{
+		CRC_Reset();
+	}
+}
+#else
+/**
+ * @func LIB_CrcLoadWord
+ * @brief Loads a little endian word from any address (one LDR on little endian targets).
+ *
+ * @note STATIC FUNCTION
+ */
+static inline uint32_t LIB_CrcLoadWord(const uint8_t* p){
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @func LIB_CrcBuildTables
+ * @brief Builds the slicing-by-4 tables at the first call.
+ *
+ * @note STATIC FUNCTION
+ */
+static void LIB_CrcBuildTables(void){
+
+	if(g_LIB_CRC_TABLES_READY){
+		return;
+	}
+
+	for(uint32_t b = 0; b < 256; b++){
+		g_LIB_CRC_TABLE[0][b] = LIB_CrcByte(0, (uint8_t)b);
+		g_LIB_CRC_TABLE_REFLECTED[0][b] = LIB_CrcByteReflected(0, (uint8_t)b);
+	}
+	//One more zero byte: shift the previous CRC by 8 bits and fold the byte shifted out through T0
+	for(uint8_t k = 1; k < 4; k++){
+		for(uint32_t b = 0; b < 256; b++){
+			uint32_t prev = g_LIB_CRC_TABLE[k - 1][b];
+			uint32_t prev_reflected = g_LIB_CRC_TABLE_REFLECTED[k - 1][b];
+
+			g_LIB_CRC_TABLE[k][b] = (prev << 8) ^ g_LIB_CRC_TABLE[0][prev >> 24];
+			g_LIB_CRC_TABLE_REFLECTED[k][b] = (prev_reflected >> 8) ^ g_LIB_CRC_TABLE_REFLECTED[0][prev_reflected & 0xFF];
+		}
+	}
+
+	g_LIB_CRC_TABLES_READY = 1;
+}
+#endif
+
+/**
+ * @func LIB_Crc32
+ * @brief Computes the CRC unit CRC-32 of a buffer (little endian words, then the tail bytes).
+ *
+ * @param const void* data [in]		any alignment
+ * @param uint32_t len [in]			number of bytes
+ * @return uint32_t
+ */
+uint32_t LIB_Crc32(const void* data, uint32_t len){
+
+	const uint8_t* p = (const uint8_t*)data;
+	uint32_t words = len >> 2;
+	uint32_t crc;
+
+#if LIB_CRC_HARDWARE_PATH == 1
+	LIB_CrcStart();
+	crc = CRC_Accumulate(data, words, CRC_INPUT_WORDS);
+	p += words << 2;
+#else
+	LIB_CrcBuildTables();
+	crc = LIB_CRC_INIT;
+	while(words--){
+		crc ^= LIB_CrcLoadWord(p);
+		crc = g_LIB_CRC_TABLE[3][crc >> 24] ^ g_LIB_CRC_TABLE[2][(crc >> 16) & 0xFF] ^
+			  g_LIB_CRC_TABLE[1][(crc >> 8) & 0xFF] ^ g_LIB_CRC_TABLE[0][crc & 0xFF];
+		p += 4;
+	}
+#endif
+
+	for(len &= 0x3; len; len--){
+		crc = LIB_CrcByte(crc, *p++);
+	}
+
+	return crc;
+}
+
+/**
+ * @func LIB_Crc32Zlib
+ * @brief Computes the zlib compatible (bit-reflected) CRC-32 of a buffer.
+ *
+ * @param const void* data [in]		any alignment
+ * @param uint32_t len [in]			number of bytes
+ * @return uint32_t					e.g. 0xCBF43926 for "123456789"
+ */
+uint32_t LIB_Crc32Zlib(const void* data, uint32_t len){
+
+	const uint8_t* p = (const uint8_t*)data;
+	uint32_t words = len >> 2;
+	uint32_t crc;
+
+#if LIB_CRC_HARDWARE_PATH == 1
+	LIB_CrcStart();
+	crc = CRC_Accumulate(data, words, CRC_INPUT_BIT_REVERSED);
+	p += words << 2;
+#else
+	LIB_CrcBuildTables();
+	crc = LIB_CRC_INIT;
+	while(words--){
+		crc ^= LIB_CrcLoadWord(p);
+		crc = g_LIB_CRC_TABLE_REFLECTED[3][crc & 0xFF] ^ g_LIB_CRC_TABLE_REFLECTED[2][(crc >> 8) & 0xFF] ^
+			  g_LIB_CRC_TABLE_REFLECTED[1][(crc >> 16) & 0xFF] ^ g_LIB_CRC_TABLE_REFLECTED[0][crc >> 24];
+		p += 4;
+	}
+#endif
+
+	for(len &= 0x3; len; len--){
+		crc = LIB_CrcByteReflected(crc, *p++);
+	}
+
+	return crc ^ 0xFFFFFFFFUL;
+}
+
+#if LIB_CRC_HARDWARE_PATH == 1
+/**
+ * @func LIB_CrcDmaDone
+ * @brief CRC unit DMA feed completion (DMA ISR): the tail bytes, then the user callback.
+ *
+ * @note STATIC FUNCTION
+ */
+static void LIB_CrcDmaDone(void* context, uint8_t status){
+
+	LIB_CrcAsync_t job = g_LIB_CRC_ASYNC;
+	uint32_t crc = CRC_Read(CRC_INPUT_WORDS);
+
+	(void)context;
+
+	for(uint8_t i = 0; i < job.tail_len; i++){
+		crc = LIB_CrcByte(crc, job.tail[i]);
+	}
+
+	if(job.callback != 0){
+		job.callback(job.context, (status == CRC_STATUS_OK) ? LIB_CRC_STATUS_OK : LIB_CRC_STATUS_ERROR, crc);
+	}
+}
+#endif
+
+/**
+ * @func LIB_Crc32Async
+ * @brief Computes LIB_Crc32() of a buffer with the words fed by DMA, the callback gets the result.
+ * @note Short/CCM buffers (or all of them on a host build or if the stream is owned by another driver) are done by
+ * 		 the CPU, the callback is then invoked before returning.
+ *
+ * @param const void* data [in]				any alignment, untouched until the callback
+ * @param uint32_t len [in]					number of bytes
+ * @param LIB_Crc32Callback_t callback [in]
+ * @param void* context [in]
+ * @return uint8_t							1: started (or done), 0: a DMA checksum is running
+ */
+uint8_t LIB_Crc32Async(const void* data, uint32_t len, LIB_Crc32Callback_t callback, void* context){
+
+#if LIB_CRC_HARDWARE_PATH == 1
+	uint32_t words = len >> 2;
+
+	if(!CRC_DmaIsIdle()){
+		return 0;
+	}
+	if((len >= LIB_CRC_DMA_THRESHOLD) && !LIB_CrcIsCcm(data, len)){
+		LIB_CrcStart();
+		g_LIB_CRC_ASYNC = (LIB_CrcAsync_t){(const uint8_t*)data + (words << 2), (uint8_t)(len & 0x3), callback, context};
+		if(CRC_AccumulateDma(data, words, LIB_CrcDmaDone, 0)){
+			return 1;
+		}
+	}
+#endif
+
+	uint32_t crc = LIB_Crc32(data, len);
+	if(callback != 0){
+		callback(context, LIB_CRC_STATUS_OK, crc);
+	}
+
+	return 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file crc32.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Bulk CRC-32 checksums on the CRC unit (CPU or DMA fed) with a bit-exact table-driven software fallback.
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which CRC ?
+ * 		[♥] LIB_Crc32(): the STM32 CRC unit one (polynomial 0x04C11DB7, init 0xFFFFFFFF, no final XOR), the buffer is
+ * 			processed as little endian 32-bit words (what the unit sees when the CPU/DMA reads memory), then the
+ * 			0 - 3 remaining bytes one by one MSB first. Same result as the CRC unit fed with the same words.
+ * 		[♥] LIB_Crc32Zlib(): the bit-reflected CRC-32 of zlib/PNG/Ethernet (crc32(0, data, len) in zlib).
+ * 		[♥] The results don't depend on the buffer alignment, an unaligned buffer is read with unaligned word loads
+ * 			(CPU) or packed into words by the DMA FIFO.
+ *
+ * # Which implementation ?
+ * 		[♥] On the target with LIB_CRC_USE_HARDWARE enabled, the CRC unit is used. LIB_Crc32() and LIB_Crc32Zlib() feed
+ * 			it by the CPU (4 AHB cycles per word, a DMA feed waited for wouldn't be faster). The zlib variant is always
+ * 			fed by the CPU since each word must be bit-reversed (RBIT) before being written.
+ * 		[♥] LIB_Crc32Async() returns at once and hands buffers of at least LIB_CRC_DMA_THRESHOLD bytes (outside CCM RAM)
+ * 			to DMA2, the callback gets the CRC from the DMA ISR (LIB_CRC_STATUS_ERROR on a DMA transfer error). Shorter
+ * 			buffers, or all of them if the stream is owned by another driver, are done by the CPU before returning.
+ * 		[♥] Otherwise (or on a host build) slicing-by-4 tables are used: one word per iteration with 4 table lookups,
+ * 			the tables (8 KB of RAM) are built at the first call. Both paths give identical results.
+ *
+ * # Not reentrant ?
+ * 		[♥] The CRC unit holds the running CRC, so the functions must not be called from an ISR while a call is
+ * 			in progress. LIB_Crc32()/LIB_Crc32Zlib() wait for a running LIB_Crc32Async() first.
+ * 		[♥] Benchmarks: Test/host/test_crc32.c (slicing-by-4 vs bytewise, "make -C Test/host bench") and
+ * 			APP/CRC_BENCHMARK.c (CRC unit CPU/DMA fed vs bytewise on the board).
+ */
+#ifndef CRC32_H_
+#define CRC32_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include <stdint.h>
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup LIB_Crc_Status_Options (LIB_Crc32Async() completion status)
+ */
+#define LIB_CRC_STATUS_OK			(0)
+#define LIB_CRC_STATUS_ERROR		(1)		/*DMA transfer error, the CRC is meaningless*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/**
+ * @brief Configuring if the CRC unit is used when building for the target.
+ *
+ * #Choose Between
+ * 		- LIB_CRC_HARDWARE_ENABLE
+ * 		- LIB_CRC_HARDWARE_DISABLE		(slicing-by-4 tables only)
+ */
+#define LIB_CRC_HARDWARE_ENABLE		1
+#define LIB_CRC_HARDWARE_DISABLE	0
+#define LIB_CRC_USE_HARDWARE		LIB_CRC_HARDWARE_ENABLE
+
+/*LIB_Crc32Async() feeds buffers of at least this number of bytes to the CRC unit by DMA (0xFFFFFFFF: CPU only)*/
+#define LIB_CRC_DMA_THRESHOLD		(1024UL)
+
+
+/******************************* Types *******************************/
+/**
+ * @brief LIB_Crc32Async() completion callback, invoked from the DMA ISR (or from the caller when done by the CPU).
+ *
+ * @param void* context		-> the checksum's context
+ * @param uint8_t status	-> @defgroup LIB_Crc_Status_Options
+ * @param uint32_t crc		-> same value as LIB_Crc32()
+ */
+typedef void (*LIB_Crc32Callback_t)(void* context, uint8_t status, uint32_t crc);
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func LIB_Crc32
+ * @brief Computes the CRC unit CRC-32 of a buffer (little endian words, then the tail bytes).
+ *
+ * @param const void* data [in]		any alignment
+ * @param uint32_t len [in]			number of bytes
+ * @return uint32_t
+ */
+uint32_t LIB_Crc32(const void* data, uint32_t len);
+
+/**
+ * @func LIB_Crc32Zlib
+ * @brief Computes the zlib compatible (bit-reflected) CRC-32 of a buffer.
+ *
+ * @param const void* data [in]		any alignment
+ * @param uint32_t len [in]			number of bytes
+ * @return uint32_t					e.g. 0xCBF43926 for "123456789"
+ */
+uint32_t LIB_Crc32Zlib(const void* data, uint32_t len);
+
+/**
+ * @func LIB_Crc32Async
+ * @brief Computes LIB_Crc32() of a buffer with the words fed by DMA, the callback gets the result.
+ * @param const void* data [in]				any alignment, untouched until the callback
+ * @param uint32_t len [in]					number of bytes
+ * @param LIB_Crc32Callback_t callback [in]
+ * @param void* context [in]
+ * @return uint8_t							1: started (or done), 0: a DMA checksum is running
+ */
+uint8_t LIB_Crc32Async(const void* data, uint32_t len, LIB_Crc32Callback_t callback, void* context);
+
+
+#endif /* CRC32_H_ */
@@ -0,0 +1,345 @@
+/**
+ * @file dma_memory.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Asynchronous memcpy/memset on DMA2 (memory-to-memory) with a chained jobs queue.
+ *
+ * # Memory-to-memory streams
+ * 		[♥] PAR is the source and M0AR the destination, the transfer starts as soon as the stream is enabled
+ * 			(no peripheral request), direct mode isn't allowed so the FIFO is used.
+ * 		[♥] A fill reads the same source word again and again (PINC = 0), the pattern lives in the job itself
+ * 			which stays in the queue until the job is done.
+ */
+/******************************* Includes *******************************/
+#include "dma_memory.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+/*NDTR is 16 bits*/
+#define LIB_DMA_MEM_MAX_ITEMS		(0xFFFFUL)
+
+/*Memory-to-memory streams have no peripheral request, any channel will do*/
+#define LIB_DMA_MEM_CHANNEL			(0)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+typedef struct{
+	uint8_t* dst;
+	const uint8_t* src;		/*copies only*/
+	uint32_t len;			/*bytes left*/
+	uint32_t pattern;		/*fills only, the byte value repeated 4 times*/
+	uint8_t fill;
+	uint8_t cpu;			/*done by the CPU in its turn*/
+	LIB_DmaMemCallback_t callback;
+	void* context;
+}LIB_DmaMemJob_t;
+
+static LIB_DmaMemJob_t g_LIB_DMA_MEM_QUEUE[LIB_DMA_MEM_QUEUE_SIZE];
+static uint8_t g_LIB_DMA_MEM_HEAD = 0;
+static volatile uint8_t g_LIB_DMA_MEM_COUNT = 0;		/*queued jobs, the one at head is running while count != 0*/
+
+/*The stream is running a chunk of the job at head*/
+static volatile uint8_t g_LIB_DMA_MEM_BUSY = 0;
+
+/*Bytes moved by the running chunk*/
+static uint32_t g_LIB_DMA_MEM_CHUNK = 0;
+
+/*The job at head is being done by the CPU from thread context (long CPU jobs, see LIB_DmaMemRunQueue())*/
+static volatile uint8_t g_LIB_DMA_MEM_THREAD_JOB = 0;
+
+static void LIB_DmaMemDmaCallback(void* dma_context, uint8_t event);
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func LIB_DmaMemIsCcm
+ * @brief Checks if a buffer overlaps the CCM RAM.
+ *
+ * @note STATIC FUNCTION
+ */
+static uint8_t LIB_DmaMemIsCcm(const void* buf, uint32_t len){
+
+	uint32_t start = (uint32_t)buf;
+
+	return (start < (CCMRAM_BASE + CCMRAM_SIZE)) && ((start + len) > CCMRAM_BASE);
+}
+
+/**
+ * @func LIB_DmaMemCpuRun
+ * @brief Does a job with the CPU, word by word when everything is word aligned.
+ *
+ * @note STATIC FUNCTION
+ */
+static void LIB_DmaMemCpuRun(LIB_DmaMemJob_t* job){
+
+	uint8_t* dst = job->dst;
+	const uint8_t* src = job->src;
+	uint32_t len = job->len;
+	uint8_t aligned = ((((uint32_t)dst | (job->fill ? 0 : (uint32_t)src) | len) & 3) == 0);
+
+	if(aligned){
+		uint32_t* dst_word = (uint32_t*)dst;
+		const uint32_t* src_word = (const uint32_t*)src;
+		for(uint32_t i = 0; i < (len >> 2); i++){
+			dst_word[i] = job->fill ? job->pattern : src_word[i];
+		}
+	}else{
+		for(uint32_t i = 0; i < len; i++){
+			dst[i] = job->fill ? (uint8_t)job->pattern : src[i];
+		}
+	}
+	job->len = 0;
+}
+
+/**
+ * @func LIB_DmaMemStartChunk
+ * @brief Starts the stream on the next chunk (at most LIB_DMA_MEM_MAX_ITEMS items) of a job.
+ *
+ * @note STATIC FUNCTION
+ */
+static void LIB_DmaMemStartChunk(LIB_DmaMemJob_t* job){
+
+	uint8_t word = ((((uint32_t)job->dst | (job->fill ? 0 : (uint32_t)job->src) | job->len) & 3) == 0);
+	uint8_t shift = word ? 2 : 0;
+	uint32_t items = job->len >> shift;
+	DMA_StreamConfig_t config = {
+			.channel = LIB_DMA_MEM_CHANNEL,
+			.direction = DMA_DIR_MEM_TO_MEM,
+			.priority = DMA_PRIORITY_LOW,		//peripheral requests go first
+			.periph_size = word ? DMA_SIZE_WORD : DMA_SIZE_BYTE,
+			.mem_size = word ? DMA_SIZE_WORD : DMA_SIZE_BYTE,
+			.periph_inc = job->fill ? DMA_INCREMENT_DISABLED : DMA_INCREMENT_ENABLED,
+			.mem_inc = DMA_INCREMENT_ENABLED,
+			.circular = DMA_CIRCULAR_DISABLED,
+			.fifo = DMA_FIFO_FULL,
+			.periph_burst = DMA_BURST_SINGLE,
+			.mem_burst = DMA_BURST_SINGLE,
+			.interrupts = DMA_IT_COMPLETE | DMA_IT_ERROR,
+			.callback = LIB_DmaMemDmaCallback,
+			.context = 0,
+	};
+
+	if(items > LIB_DMA_MEM_MAX_ITEMS){
+		items = LIB_DMA_MEM_MAX_ITEMS;
+	}
+	g_LIB_DMA_MEM_CHUNK = items << shift;
+	g_LIB_DMA_MEM_BUSY = 1;
+
+	DMA_Configure(DMA_DMA2, LIB_DMA_MEM_STREAM, &config);
+	DMA_Start(DMA_DMA2, LIB_DMA_MEM_STREAM,
+			  job->fill ? (uint32_t)&job->pattern : (uint32_t)job->src, (uint32_t)job->dst, (uint16_t)items);
+}
+
+/**
+ * @func LIB_DmaMemFinishHead
+ * @brief Removes the job at the queue head and invokes its callback.
+ *
+ * @note STATIC FUNCTION, called with the queue not empty and the stream stopped
+ */
+static void LIB_DmaMemFinishHead(uint8_t status){
+
+	LIB_DmaMemJob_t* job = &g_LIB_DMA_MEM_QUEUE[g_LIB_DMA_MEM_HEAD];
+	LIB_DmaMemCallback_t callback = job->callback;
+	void* context = job->context;
+
+	g_LIB_DMA_MEM_HEAD = (g_LIB_DMA_MEM_HEAD + 1) % LIB_DMA_MEM_QUEUE_SIZE;
+	g_LIB_DMA_MEM_COUNT--;
+
+	if(callback != 0){
+		callback(context, status);
+	}
+}
+
+/**
+ * @func LIB_DmaMemRunQueue
+ * @brief Runs the queued jobs until one is handed to the stream (or the queue is empty).
+ * 		  Only the CPU jobs shorter than LIB_DMA_MEM_CPU_THRESHOLD are done here, a longer one (CCM, no stream)
+ * 		  stops the queue at its turn and is left to LIB_DmaMemRunThreadJob().
+ *
+ * @note STATIC FUNCTION, called with the stream stopped, from a critical section or the DMA ISR
+ */
+static void LIB_DmaMemRunQueue(void){
+
+	//a callback may queue a job, which then starts the stream itself
+	while((g_LIB_DMA_MEM_COUNT != 0) && !g_LIB_DMA_MEM_BUSY && !g_LIB_DMA_MEM_THREAD_JOB){
+		LIB_DmaMemJob_t* job = &g_LIB_DMA_MEM_QUEUE[g_LIB_DMA_MEM_HEAD];
+		if(!job->cpu){
+			LIB_DmaMemStartChunk(job);
+			return;
+		}
+		if(job->len >= LIB_DMA_MEM_CPU_THRESHOLD){
+			//unbounded copy, not with the interrupts masked nor in the DMA ISR
+			return;
+		}
+		LIB_DmaMemCpuRun(job);
+		LIB_DmaMemFinishHead(LIB_DMA_MEM_STATUS_OK);
+	}
+}
+
+/**
+ * @func LIB_DmaMemRunThreadJob
+ * @brief Does the long CPU jobs the queue stopped at, with the interrupts enabled.
+ *
+ * @note STATIC FUNCTION, thread context only
+ */
+static void LIB_DmaMemRunThreadJob(void){
+
+	uint32_t primask = LIB_EnterCritical();
+	while((g_LIB_DMA_MEM_COUNT != 0) && !g_LIB_DMA_MEM_BUSY && !g_LIB_DMA_MEM_THREAD_JOB){
+		//only a long CPU job stops the queue (LIB_DmaMemRunQueue() has run after each change)
+		g_LIB_DMA_MEM_THREAD_JOB = 1;
+		LIB_ExitCritical(primask);
+
+		//jobs queued by the ISRs meanwhile go behind it, the head stays in place
+		LIB_DmaMemCpuRun(&g_LIB_DMA_MEM_QUEUE[g_LIB_DMA_MEM_HEAD]);
+
+		primask = LIB_EnterCritical();
+		g_LIB_DMA_MEM_THREAD_JOB = 0;
+		LIB_DmaMemFinishHead(LIB_DMA_MEM_STATUS_OK);
+		LIB_DmaMemRunQueue();
+	}
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func LIB_DmaMemSubmit
+ * @brief Queues a job, short/CCM jobs (or all of them if the stream isn't available) are done by the CPU.
+ *
+ * @note STATIC FUNCTION
+ * @return uint8_t		1: queued (or done), 0: the queue is full
+ */
+static uint8_t LIB_DmaMemSubmit(LIB_DmaMemJob_t* job){
+
+	if(job->len == 0){
+		return 1;
+	}
+
+	job->cpu = (job->len < LIB_DMA_MEM_CPU_THRESHOLD) ||
+			   LIB_DmaMemIsCcm(job->dst, job->len) ||
+			   (!job->fill && LIB_DmaMemIsCcm(job->src, job->len)) ||
+			   !DMA_Allocate(DMA_DMA2, LIB_DMA_MEM_STREAM, LIB_DMA_MEM_CHANNEL);
+
+	uint32_t primask = LIB_EnterCritical();
+	if(job->cpu && (g_LIB_DMA_MEM_COUNT == 0)){
+		//nothing queued before it, done at once with the interrupts enabled
+		LIB_ExitCritical(primask);
+		LIB_DmaMemCpuRun(job);
+		if(job->callback != 0){
+			job->callback(job->context, LIB_DMA_MEM_STATUS_OK);
+		}
+		return 1;
+	}
+	if(g_LIB_DMA_MEM_COUNT >= LIB_DMA_MEM_QUEUE_SIZE){
+		LIB_ExitCritical(primask);
+		return 0;
+	}
+
+	LIB_DmaMemJob_t* slot = &g_LIB_DMA_MEM_QUEUE[(g_LIB_DMA_MEM_HEAD + g_LIB_DMA_MEM_COUNT) % LIB_DMA_MEM_QUEUE_SIZE];
+	*slot = *job;
+	g_LIB_DMA_MEM_COUNT++;
+	LIB_DmaMemRunQueue();
+	LIB_ExitCritical(primask);
+
+	return 1;
+}
+
+/**
+ * @func LIB_DmaMemcpy
+ * @brief Queues a copy of len bytes from src to dst (non-overlapping buffers).
+ *
+ * @param void* dst [out]
+ * @param const void* src [in]
+ * @param uint32_t len [in]						number of bytes
+ * @param LIB_DmaMemCallback_t callback [in]	0: none
+ * @param void* context [in]
+ * @return uint8_t								1: queued (or done), 0: the queue is full
+ */
+uint8_t LIB_DmaMemcpy(void* dst, const void* src, uint32_t len, LIB_DmaMemCallback_t callback, void* context){
+
+	LIB_DmaMemJob_t job = {(uint8_t*)dst, (const uint8_t*)src, len, 0, 0, 0, callback, context};
+
+	return LIB_DmaMemSubmit(&job);
+}
+
+/**
+ * @func LIB_DmaMemset
+ * @brief Queues a fill of len bytes of dst with value.
+ *
+ * @param void* dst [out]
+ * @param uint8_t value [in]
+ * @param uint32_t len [in]						number of bytes
+ * @param LIB_DmaMemCallback_t callback [in]	0: none
+ * @param void* context [in]
+ * @return uint8_t								1: queued (or done), 0: the queue is full
+ */
+uint8_t LIB_DmaMemset(void* dst, uint8_t value, uint32_t len, LIB_DmaMemCallback_t callback, void* context){
+
+	LIB_DmaMemJob_t job = {(uint8_t*)dst, 0, len, value * 0x01010101UL, 1, 0, callback, context};
+
+	return LIB_DmaMemSubmit(&job);
+}
+
+/**
+ * @func LIB_DmaMemIsIdle
+ * @brief Checks if all the queued jobs are done, first doing the long CPU job the queue may be stopped at.
+ *
+ * @note Thread context only (the long CPU jobs are done here).
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t LIB_DmaMemIsIdle(void){
+	LIB_DmaMemRunThreadJob();
+	return (g_LIB_DMA_MEM_COUNT == 0);
+}
+
+/**
+ * @func LIB_DmaMemWait
+ * @brief Waits until all the queued jobs are done.
+ *
+ * @note Thread context only (the long CPU jobs are done here).
+ * @return void
+ */
+void LIB_DmaMemWait(void){
+	while(!LIB_DmaMemIsIdle());
+}
+
+/**
+ * @func LIB_DmaMemDmaCallback
+ * @brief Chunk completion (DMA ISR): chains the next chunk of the job, or ends it.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void LIB_DmaMemDmaCallback(void* dma_context, uint8_t event){
+
+	(void)dma_context;
+
+	if(!g_LIB_DMA_MEM_BUSY || (g_LIB_DMA_MEM_COUNT == 0)){
+		return;
+	}
+	LIB_DmaMemJob_t* job = &g_LIB_DMA_MEM_QUEUE[g_LIB_DMA_MEM_HEAD];
+
+	g_LIB_DMA_MEM_BUSY = 0;
+
+	if(event == DMA_EVENT_ERROR){
+		DMA_Stop(DMA_DMA2, LIB_DMA_MEM_STREAM);
+		LIB_DmaMemFinishHead(LIB_DMA_MEM_STATUS_ERROR);
+	}else{
+		job->dst += g_LIB_DMA_MEM_CHUNK;
+		if(!job->fill){
+			job->src += g_LIB_DMA_MEM_CHUNK;
+		}
+		job->len -= g_LIB_DMA_MEM_CHUNK;
+
+		if(job->len != 0){
+			LIB_DmaMemStartChunk(job);
+			return;
+		}
+		LIB_DmaMemFinishHead(LIB_DMA_MEM_STATUS_OK);
+	}
+	LIB_DmaMemRunQueue();
+}
@@ -0,0 +1,122 @@
+/**
+ * @file dma_memory.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Asynchronous memcpy/memset on DMA2 (memory-to-memory) with a chained jobs queue.
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Moving ADC blocks or framebuffers with a CPU loop keeps the CPU busy for the whole copy, DMA2 (the only
+ * 			controller able to do memory-to-memory) does it while the CPU runs something else.
+ *
+ * # Jobs queue ?
+ * 		[♥] LIB_DmaMemcpy()/LIB_DmaMemset() queue a job and return at once, the jobs run one after the other in
+ * 			queue order and each callback is invoked from the DMA ISR when its job is done.
+ * 		[♥] The buffers must stay valid (and untouched) until the callback, LIB_DmaMemWait() waits for all jobs.
+ * 		[♥] Word transfers are used when the addresses and the length are multiples of 4, byte transfers otherwise.
+ * 			Jobs longer than a stream can do at once (65535 items) are chained chunk by chunk.
+ *
+ * # CPU fallback ?
+ * 		[♥] Below LIB_DMA_MEM_CPU_THRESHOLD bytes the stream setup and the completion interrupt cost more than the
+ * 			copy itself, the job is done by the CPU (at once if the queue is empty, else in its turn).
+ * 			APP_DmaMemoryBenchmark() (APP/DMA_MEMORY_BENCHMARK.c) prints both costs per size and the crossover,
+ * 			re-run it after changing the clocks or the flash wait states.
+ * 		[♥] CCM RAM is only on the CPU D-bus, jobs touching it are always done by the CPU.
+ * 		[♥] Also done by the CPU if LIB_DMA_MEM_STREAM is owned by another driver.
+ * 		[♥] The DMA ISR only does the CPU jobs shorter than LIB_DMA_MEM_CPU_THRESHOLD in their turn. A longer one
+ * 			(CCM, no stream) stops the queue until the next LIB_DmaMemIsIdle()/LIB_DmaMemWait() call, which does
+ * 			it with the interrupts enabled: call them from thread context, and poll LIB_DmaMemIsIdle() when such
+ * 			jobs are queued behind others. A long CPU job queued while the queue is empty is done at once by the
+ * 			caller (from an ISR if queued from a callback).
+ */
+#ifndef DMA_MEMORY_H_
+#define DMA_MEMORY_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include <stdint.h>
+#include "dma.h"
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup LIB_DmaMem_Status_Options (job completion status)
+ */
+#define LIB_DMA_MEM_STATUS_OK		(0)
+#define LIB_DMA_MEM_STATUS_ERROR	(1)		/*DMA transfer error, the destination is partially written*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*DMA2 stream used for the jobs (0 - 7, not shared with a peripheral request in use)*/
+#define LIB_DMA_MEM_STREAM			(DMA_STREAM6)
+
+/*Queued jobs*/
+#define LIB_DMA_MEM_QUEUE_SIZE		(8)
+
+/*Jobs shorter than this number of bytes are done by the CPU, APP/DMA_MEMORY_BENCHMARK.c measures the crossover*/
+#define LIB_DMA_MEM_CPU_THRESHOLD	(64)
+
+
+/******************************* Types *******************************/
+/**
+ * @brief Job completion callback, invoked from the DMA ISR (or from the caller when done by the CPU at once,
+ * 		  from LIB_DmaMemIsIdle()/LIB_DmaMemWait() for a long CPU job the queue stopped at).
+ *
+ * @param void* context		-> the job's context
+ * @param uint8_t status	-> @defgroup LIB_DmaMem_Status_Options
+ */
+typedef void (*LIB_DmaMemCallback_t)(void* context, uint8_t status);
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func LIB_DmaMemcpy
+ * @brief Queues a copy of len bytes from src to dst (non-overlapping buffers).
+ *
+ * @param void* dst [out]
+ * @param const void* src [in]
+ * @param uint32_t len [in]						number of bytes
+ * @param LIB_DmaMemCallback_t callback [in]	0: none
+ * @param void* context [in]
+ * @return uint8_t								1: queued (or done), 0: the queue is full
+ */
+uint8_t LIB_DmaMemcpy(void* dst, const void* src, uint32_t len, LIB_DmaMemCallback_t callback, void* context);
+
+/**
+ * @func LIB_DmaMemset
+ * @brief Queues a fill of len bytes of dst with value.
+ *
+ * @param void* dst [out]
+ * @param uint8_t value [in]
+ * @param uint32_t len [in]						number of bytes
+ * @param LIB_DmaMemCallback_t callback [in]	0: none
+ * @param void* context [in]
+ * @return uint8_t								1: queued (or done), 0: the queue is full
+ */
+uint8_t LIB_DmaMemset(void* dst, uint8_t value, uint32_t len, LIB_DmaMemCallback_t callback, void* context);
+
+/**
+ * @func LIB_DmaMemIsIdle
+ * @brief Checks if all the queued jobs are done, first doing the long CPU job the queue may be stopped at.
+ *
+ * @note Thread context only (the long CPU jobs are done here).
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t LIB_DmaMemIsIdle(void);
+
+/**
+ * @func LIB_DmaMemWait
+ * @brief Waits until all the queued jobs are done.
+ *
+ * @note Thread context only (the long CPU jobs are done here).
+ * @return void
+ */
+void LIB_DmaMemWait(void);
+
+
+#endif /* DMA_MEMORY_H_ */
@@ -0,0 +1,363 @@
+/**
+ * @file dsp_filter.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Streaming fixed-point filter stages for ADC/DMA sample blocks.
+ *
+ * # Bit exactness
+ * 		[♥] Every stage is defined in terms of exact integer sums followed by one rounding step
+ * 			(add half an LSB then arithmetic shift), so the DSP and the portable C paths give identical outputs.
+ */
+/******************************* Includes *******************************/
+#include "dsp_filter.h"
+
+/*******************************  Macros *******************************/
+#if (LIB_FILTER_USE_DSP_EXTENSION == LIB_FILTER_DSP_ENABLE) && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define LIB_FILTER_DSP_PATH		1
+#elif defined(LIB_FILTER_DSP_HOST_MODEL)
+/*host test builds only: runs the DSP path with C models of the instructions (see Test/host)*/
+#define LIB_FILTER_DSP_PATH		1
+#else
+#define LIB_FILTER_DSP_PATH		0
+#endif
+
+/*two Q15 samples packed in one word, multiplied by SMLAD as (1 * lo) + (1 * hi)*/
+#define LIB_FILTER_SMLAD_ONES	(0x00010001UL)
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+/*word view of a Q15 buffer, may_alias keeps the packed loads legal for the compiler*/
+typedef uint32_t __attribute__((__may_alias__)) LIB_FilterWord_t;
+
+#if (LIB_FILTER_DSP_PATH == 1) && defined(LIB_FILTER_DSP_HOST_MODEL)
+/*Instruction models, written from the ARMv7-M ARM pseudo code rather than from the C path below*/
+static inline int32_t LIB_FilterSmlad(uint32_t x, uint32_t y, int32_t acc){
+	/*16x16 products summed and accumulated modulo 2^32 (Q flag not modelled)*/
+	int32_t product1 = (int32_t)(int16_t)(x & 0xFFFFU) * (int16_t)(y & 0xFFFFU);
+	int32_t product2 = (int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16);
+	return (int32_t)((uint32_t)product1 + (uint32_t)product2 + (uint32_t)acc);
+}
+
+static inline int32_t LIB_FilterQAdd(int32_t a, int32_t b){
+	int32_t result = (int32_t)((uint32_t)a + (uint32_t)b);
+	/*overflow when both operands have the same sign and the result doesn't*/
+	if(((a ^ result) & (b ^ result)) < 0){
+		result = (a < 0) ? INT32_MIN : INT32_MAX;
+	}
+	return result;
+}
+
+static inline int32_t LIB_FilterQSub(int32_t a, int32_t b){
+	int32_t result = (int32_t)((uint32_t)a - (uint32_t)b);
+	if(((a ^ b) & (a ^ result)) < 0){
+		result = (a < 0) ? INT32_MIN : INT32_MAX;
+	}
+	return result;
+}
+
+/*(a * b + 2^31) >> 32*/
+static inline int32_t LIB_FilterMulHighRound(int32_t a, int32_t b){
+	uint64_t product = (uint64_t)((int64_t)a * b) + 0x80000000ULL;
+	return (int32_t)(uint32_t)(product >> 32);
+}
+#elif LIB_FILTER_DSP_PATH == 1
+static inline int32_t LIB_FilterSmlad(uint32_t x, uint32_t y, int32_t acc){
+	int32_t result;
+	__asm volatile ("smlad %0, %1, %2, %3" : "=r" (result) : "r" (x), "r" (y), "r" (acc));
+	return result;
+}
+
+static inline int32_t LIB_FilterQAdd(int32_t a, int32_t b){
+	int32_t result;
+	__asm volatile ("qadd %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+	return result;
+}
+
+static inline int32_t LIB_FilterQSub(int32_t a, int32_t b){
+	int32_t result;
+	__asm volatile ("qsub %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+	return result;
+}
+
+/*(a * b + 2^31) >> 32*/
+static inline int32_t LIB_FilterMulHighRound(int32_t a, int32_t b){
+	int32_t result;
+	__asm volatile ("smmulr %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+	return result;
+}
+#else
+static inline int32_t LIB_FilterSaturate32(int64_t value){
+	if(value > INT32_MAX){
+		value = INT32_MAX;
+	}else if(value < INT32_MIN){
+		value = INT32_MIN;
+	}
+	return (int32_t)value;
+}
+
+static inline int32_t LIB_FilterQAdd(int32_t a, int32_t b){
+	return LIB_FilterSaturate32((int64_t)a + b);
+}
+
+static inline int32_t LIB_FilterQSub(int32_t a, int32_t b){
+	return LIB_FilterSaturate32((int64_t)a - b);
+}
+
+/*(a * b + 2^31) >> 32*/
+static inline int32_t LIB_FilterMulHighRound(int32_t a, int32_t b){
+	return (int32_t)((((int64_t)a * b) + 0x80000000LL) >> 32);
+}
+#endif
+
+/**
+ * @func LIB_FilterRoundShift
+ * @brief Divides by 2^shift rounding half up, the only rounding step used by all stages.
+ */
+static inline int32_t LIB_FilterRoundShift(int32_t value, uint8_t shift){
+	if(shift == 0){
+		return value;
+	}
+	return (value + (1L << (shift - 1))) >> shift;
+}
+
+/**
+ * @func LIB_FilterBlockSum_q15
+ * @brief Exact sum of n consecutive Q15 samples.
+ */
+static int32_t LIB_FilterBlockSum_q15(const LIB_q15_t* samples, uint32_t n){
+
+	int32_t sum = 0;
+
+#if LIB_FILTER_DSP_PATH == 1
+	/*SMLAD adds two samples per instruction, it needs word aligned packed pairs*/
+	if(((uintptr_t)samples & 0x3U) == 0){
+		const LIB_FilterWord_t* words = (const LIB_FilterWord_t*)samples;
+		uint32_t pairs = n >> 1;
+
+		while(pairs >= 2){
+			sum = LIB_FilterSmlad(words[0], LIB_FILTER_SMLAD_ONES, sum);
+			sum = LIB_FilterSmlad(words[1], LIB_FILTER_SMLAD_ONES, sum);
+			words += 2;
+			pairs -= 2;
+		}
+		if(pairs != 0){
+			sum = LIB_FilterSmlad(words[0], LIB_FILTER_SMLAD_ONES, sum);
+		}
+		samples += (n & ~1UL);
+		n &= 1UL;
+	}
+#endif
+
+	while(n != 0){
+		sum += *samples++;
+		n--;
+	}
+	return sum;
+}
+
+/**
+ * @func LIB_FilterCicPush
+ * @brief Feeds one sample through the integrators, returns 1 and the decimated output once per R samples.
+ */
+static uint8_t LIB_FilterCicPush(LIB_CicFilter_t* filter, LIB_q15_t sample, LIB_q15_t* output){
+
+	/*integrators and combs rely on modulo-2^32 wrap around, so they're kept unsigned*/
+	uint32_t acc = (uint32_t)(int32_t)sample;
+	for(uint8_t stage = 0; stage < filter->order; stage++){
+		filter->integrator[stage] += acc;
+		acc = filter->integrator[stage];
+	}
+
+	filter->phase++;
+	if(filter->phase < (1U << filter->log2_factor)){
+		return 0;
+	}
+	filter->phase = 0;
+
+	for(uint8_t stage = 0; stage < filter->order; stage++){
+		uint32_t delayed = filter->comb[stage];
+		filter->comb[stage] = acc;
+		acc -= delayed;
+	}
+
+	*output = (LIB_q15_t)LIB_FilterRoundShift((int32_t)acc, filter->order * filter->log2_factor);
+	return 1;
+}
+
+/******************************* Functions Implementation *******************************/
+/**
+ * @func LIB_FilterCicInit
+ * @brief Resets a CIC decimator and sets its order and decimation factor.
+ *
+ * @param LIB_CicFilter_t* filter [out]	filter state
+ * @param uint8_t order [in]				[1 - LIB_FILTER_CIC_MAX_ORDER], clamped
+ * @param uint8_t log2_factor [in]		decimation factor R = 2^log2_factor, clamped so order*log2_factor <= LIB_FILTER_CIC_MAX_SHIFT
+ * @return void .
+ */
+void LIB_FilterCicInit(LIB_CicFilter_t* filter, uint8_t order, uint8_t log2_factor){
+
+	if(order == 0){
+		order = 1;
+	}else if(order > LIB_FILTER_CIC_MAX_ORDER){
+		order = LIB_FILTER_CIC_MAX_ORDER;
+	}
+	if((order * log2_factor) > LIB_FILTER_CIC_MAX_SHIFT){
+		log2_factor = LIB_FILTER_CIC_MAX_SHIFT / order;
+	}
+
+	filter->order = order;
+	filter->log2_factor = log2_factor;
+	filter->phase = 0;
+	for(uint8_t stage = 0; stage < LIB_FILTER_CIC_MAX_ORDER; stage++){
+		filter->integrator[stage] = 0;
+		filter->comb[stage] = 0;
+	}
+}
+
+/**
+ * @func LIB_FilterCicDecimate_q15
+ * @brief Decimates a block of Q15 samples in place, the output is normalized by the CIC gain R^order (rounded).
+ * 		  The block length doesn't need to be a multiple of R, the remainder is carried to the next call.
+ *
+ * @param LIB_CicFilter_t* filter [in/out]	filter state
+ * @param LIB_q15_t* buf [in/out]			input block, outputs are written at its start
+ * @param uint32_t len [in]					number of input samples
+ * @return uint32_t							number of output samples written
+ */
+uint32_t LIB_FilterCicDecimate_q15(LIB_CicFilter_t* filter, LIB_q15_t* buf, uint32_t len){
+
+	uint32_t in = 0;
+	uint32_t out = 0;
+	LIB_q15_t output;
+
+	/*Output #n is written only after input #n has been consumed, so working in place is safe*/
+
+	/*Complete the output period left open by the previous block*/
+	while((filter->phase != 0) && (in < len)){
+		out += LIB_FilterCicPush(filter, buf[in++], &buf[out]);
+	}
+
+	/*Boxcar fast path: at a period boundary (integrator == comb) every output is the plain
+	 *sum of R samples, so whole periods skip the per-sample integrator updates*/
+	if(filter->order == 1){
+		uint32_t factor = (1UL << filter->log2_factor);
+		while((len - in) >= factor){
+			int32_t sum = LIB_FilterBlockSum_q15(&buf[in], factor);
+			in += factor;
+			buf[out++] = (LIB_q15_t)LIB_FilterRoundShift(sum, filter->log2_factor);
+		}
+	}
+
+	while(in < len){
+		if(LIB_FilterCicPush(filter, buf[in++], &output)){
+			buf[out++] = output;
+		}
+	}
+
+	return out;
+}
+
+/**
+ * @func LIB_FilterMovingAverageInit
+ * @brief Resets a moving average and attaches its delay line.
+ *
+ * @param LIB_MovingAverage_t* filter [out]	filter state
+ * @param LIB_q15_t* history [in]			delay line of 2^log2_length samples (static storage, no allocation)
+ * @param uint8_t log2_length [in]			[0 - LIB_FILTER_MA_MAX_LOG2_LENGTH], clamped
+ * @return void .
+ */
+void LIB_FilterMovingAverageInit(LIB_MovingAverage_t* filter, LIB_q15_t* history, uint8_t log2_length){
+
+	if(log2_length > LIB_FILTER_MA_MAX_LOG2_LENGTH){
+		log2_length = LIB_FILTER_MA_MAX_LOG2_LENGTH;
+	}
+
+	filter->history = history;
+	filter->log2_length = log2_length;
+	filter->index = 0;
+	filter->sum = 0;
+
+	for(uint32_t i = 0; i < (1UL << log2_length); i++){
+		history[i] = 0;
+	}
+}
+
+/**
+ * @func LIB_FilterMovingAverage_q15
+ * @brief Replaces each sample of the block with the rounded average of the last 2^log2_length samples.
+ *
+ * @param LIB_MovingAverage_t* filter [in/out]	filter state
+ * @param LIB_q15_t* buf [in/out]				block filtered in place
+ * @param uint32_t len [in]						number of samples
+ * @return void .
+ */
+void LIB_FilterMovingAverage_q15(LIB_MovingAverage_t* filter, LIB_q15_t* buf, uint32_t len){
+
+	/*running sum: one add and one subtract per sample regardless of the window length*/
+	uint16_t mask = (uint16_t)((1UL << filter->log2_length) - 1);
+	uint16_t index = filter->index;
+	int32_t sum = filter->sum;
+
+	for(uint32_t i = 0; i < len; i++){
+		LIB_q15_t sample = buf[i];
+		sum += sample - filter->history[index];
+		filter->history[index] = sample;
+		index = (index + 1) & mask;
+		buf[i] = (LIB_q15_t)LIB_FilterRoundShift(sum, filter->log2_length);
+	}
+
+	filter->index = index;
+	filter->sum = sum;
+}
+
+/**
+ * @func LIB_FilterIir_q15
+ * @brief Single-pole IIR on a block of Q15 samples in place.
+ *
+ * @param LIB_IirQ15_t* filter [in/out]	coefficient and state
+ * @param LIB_q15_t* buf [in/out]		block filtered in place
+ * @param uint32_t len [in]				number of samples
+ * @return void .
+ */
+void LIB_FilterIir_q15(LIB_IirQ15_t* filter, LIB_q15_t* buf, uint32_t len){
+
+	int32_t alpha = filter->alpha;
+	int32_t state = filter->state;
+
+	for(uint32_t i = 0; i < len; i++){
+		/*(x - y) fits 17 bits and alpha 15 bits, the product can't overflow 32 bits*/
+		state += LIB_FilterRoundShift(alpha * (buf[i] - state), 15);
+		buf[i] = (LIB_q15_t)state;
+	}
+
+	filter->state = (LIB_q15_t)state;
+}
+
+/**
+ * @func LIB_FilterIir_q31
+ * @brief Single-pole IIR on a block of Q31 samples in place (saturating).
+ *
+ * @param LIB_IirQ31_t* filter [in/out]	coefficient and state
+ * @param LIB_q31_t* buf [in/out]		block filtered in place
+ * @param uint32_t len [in]				number of samples
+ * @return void .
+ */
+void LIB_FilterIir_q31(LIB_IirQ31_t* filter, LIB_q31_t* buf, uint32_t len){
+
+	int32_t alpha = filter->alpha;
+	int32_t state = filter->state;
+
+	for(uint32_t i = 0; i < len; i++){
+		int32_t error = LIB_FilterQSub(buf[i], state);
+		/*Q31 * Q31 high word is Q30, doubled back to Q31 (|result| < 2^30 so it can't overflow)*/
+		state = LIB_FilterQAdd(state, LIB_FilterMulHighRound(alpha, error) * 2);
+		buf[i] = state;
+	}
+
+	filter->state = state;
+}
+
+/******************************* ISR *******************************/
@@ -0,0 +1,177 @@
+/**
+ * @file dsp_filter.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Streaming fixed-point filter stages for ADC/DMA sample blocks.
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # What is provided ?
+ * 		[♥] CIC/boxcar decimation (order 1 is the plain boxcar average), moving average and single-pole IIR.
+ * 		[♥] All stages work IN PLACE on a block of samples (e.g. a DMA half-buffer) and keep their state in a
+ * 			caller-owned struct, so consecutive blocks are filtered as one continuous stream.
+ * 		[♥] Right aligned ADC samples (0 - 4095) are valid Q15 inputs, so a uint16_t DMA buffer can be passed casted.
+ *
+ * # Which implementation ?
+ * 		[♥] When the compiler targets the Cortex-M4 DSP extension (__ARM_FEATURE_DSP) and LIB_FILTER_USE_DSP_EXTENSION
+ * 			is enabled, the hot loops use SMLAD (two Q15 samples per instruction) and QADD/QSUB/SMMULR for Q31.
+ * 		[♥] Otherwise a portable C implementation is used, it rounds exactly the same way so both paths
+ * 			produce bit-identical outputs (host builds can be used to generate reference vectors).
+ *
+ * # Usage Work Flow ?
+ * 		1. Make a filter variable and call its Init function once (or fill alpha/state for the IIR).
+ * 		2. On every DMA half/full transfer callback, call the filter function on the ready half-buffer.
+ * 		3. Decimators return the number of output samples written at the start of the buffer.
+ */
+#ifndef DSP_FILTER_H_
+#define DSP_FILTER_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include <stdint.h>
+
+/*******************************  Macros *******************************/
+#define LIB_FILTER_CIC_MAX_ORDER	(3)
+
+/*order * log2_factor must not exceed this value so the CIC gain fits a 32-bit accumulator with Q15 inputs*/
+#define LIB_FILTER_CIC_MAX_SHIFT	(15)
+
+#define LIB_FILTER_MA_MAX_LOG2_LENGTH	(15)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/**
+ * @brief Configuring if the Cortex-M4 DSP instructions are used when the compiler targets them.
+ *
+ * #Choose Between
+ * 		- LIB_FILTER_DSP_ENABLE
+ * 		- LIB_FILTER_DSP_DISABLE	(portable C path only)
+ */
+#define LIB_FILTER_DSP_ENABLE			1
+#define LIB_FILTER_DSP_DISABLE			0
+#define LIB_FILTER_USE_DSP_EXTENSION	LIB_FILTER_DSP_ENABLE
+
+
+/******************************* Types *******************************/
+typedef int16_t LIB_q15_t;
+typedef int32_t LIB_q31_t;
+
+/**
+ * @struct LIB_CicFilter_t
+ * @brief CIC decimator state (order 1 is a boxcar average of R = 2^log2_factor samples).
+ * @note Initialize using LIB_FilterCicInit().
+ */
+typedef struct{
+	uint8_t order;			/*number of integrator/comb stages [1 - LIB_FILTER_CIC_MAX_ORDER]*/
+	uint8_t log2_factor;	/*decimation factor R = 2^log2_factor*/
+	uint16_t phase;			/*input samples consumed in the current output period*/
+	uint32_t integrator[LIB_FILTER_CIC_MAX_ORDER];	/*modulo-2^32 integrators*/
+	uint32_t comb[LIB_FILTER_CIC_MAX_ORDER];		/*comb delay elements*/
+}LIB_CicFilter_t;
+
+/**
+ * @struct LIB_MovingAverage_t
+ * @brief Running-sum moving average over 2^log2_length samples.
+ * @note Initialize using LIB_FilterMovingAverageInit().
+ */
+typedef struct{
+	LIB_q15_t* history;		/*caller supplied delay line of 2^log2_length samples*/
+	uint8_t log2_length;
+	uint16_t index;
+	int32_t sum;
+}LIB_MovingAverage_t;
+
+/**
+ * @struct LIB_IirQ15_t
+ * @brief Single-pole IIR (exponential smoothing)  y += alpha * (x - y), alpha in Q15 (0 - 0x7FFF).
+ */
+typedef struct{
+	LIB_q15_t alpha;
+	LIB_q15_t state;
+}LIB_IirQ15_t;
+
+/**
+ * @struct LIB_IirQ31_t
+ * @brief Single-pole IIR (exponential smoothing)  y += alpha * (x - y), alpha in Q31 (0 - 0x7FFFFFFF).
+ */
+typedef struct{
+	LIB_q31_t alpha;
+	LIB_q31_t state;
+}LIB_IirQ31_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func LIB_FilterCicInit
+ * @brief Resets a CIC decimator and sets its order and decimation factor.
+ *
+ * @param LIB_CicFilter_t* filter [out]	filter state
+ * @param uint8_t order [in]				[1 - LIB_FILTER_CIC_MAX_ORDER], clamped
+ * @param uint8_t log2_factor [in]		decimation factor R = 2^log2_factor, clamped so order*log2_factor <= LIB_FILTER_CIC_MAX_SHIFT
+ * @return void .
+ */
+void LIB_FilterCicInit(LIB_CicFilter_t* filter, uint8_t order, uint8_t log2_factor);
+
+/**
+ * @func LIB_FilterCicDecimate_q15
+ * @brief Decimates a block of Q15 samples in place, the output is normalized by the CIC gain R^order (rounded).
+ * 		  The block length doesn't need to be a multiple of R, the remainder is carried to the next call.
+ *
+ * @param LIB_CicFilter_t* filter [in/out]	filter state
+ * @param LIB_q15_t* buf [in/out]			input block, outputs are written at its start
+ * @param uint32_t len [in]					number of input samples
+ * @return uint32_t							number of output samples written
+ */
+uint32_t LIB_FilterCicDecimate_q15(LIB_CicFilter_t* filter, LIB_q15_t* buf, uint32_t len);
+
+/**
+ * @func LIB_FilterMovingAverageInit
+ * @brief Resets a moving average and attaches its delay line.
+ *
+ * @param LIB_MovingAverage_t* filter [out]	filter state
+ * @param LIB_q15_t* history [in]			delay line of 2^log2_length samples (static storage, no allocation)
+ * @param uint8_t log2_length [in]			[0 - LIB_FILTER_MA_MAX_LOG2_LENGTH], clamped
+ * @return void .
+ */
+void LIB_FilterMovingAverageInit(LIB_MovingAverage_t* filter, LIB_q15_t* history, uint8_t log2_length);
+
+/**
+ * @func LIB_FilterMovingAverage_q15
+ * @brief Replaces each sample of the block with the rounded average of the last 2^log2_length samples.
+ *
+ * @param LIB_MovingAverage_t* filter [in/out]	filter state
+ * @param LIB_q15_t* buf [in/out]				block filtered in place
+ * @param uint32_t len [in]						number of samples
+ * @return void .
+ */
+void LIB_FilterMovingAverage_q15(LIB_MovingAverage_t* filter, LIB_q15_t* buf, uint32_t len);
+
+/**
+ * @func LIB_FilterIir_q15
+ * @brief Single-pole IIR on a block of Q15 samples in place.
+ *
+ * @param LIB_IirQ15_t* filter [in/out]	coefficient and state
+ * @param LIB_q15_t* buf [in/out]		block filtered in place
+ * @param uint32_t len [in]				number of samples
+ * @return void .
+ */
+void LIB_FilterIir_q15(LIB_IirQ15_t* filter, LIB_q15_t* buf, uint32_t len);
+
+/**
+ * @func LIB_FilterIir_q31
+ * @brief Single-pole IIR on a block of Q31 samples in place (saturating).
+ *
+ * @param LIB_IirQ31_t* filter [in/out]	coefficient and state
+ * @param LIB_q31_t* buf [in/out]		block filtered in place
+ * @param uint32_t len [in]				number of samples
+ * @return void .
+ */
+void LIB_FilterIir_q31(LIB_IirQ31_t* filter, LIB_q31_t* buf, uint32_t len);
+
+
+#endif /* DSP_FILTER_H_ */
@@ -35,9 +35,37 @@
  *
  */
 
+#define	DWT_OFFSET					(0x00001000UL)
+#define DWT_BASE		(CORTEX_M4_PERIPH_BASE + DWT_OFFSET)
+
 #define	SysTick_OFFSET				(0x0000E000UL)
 #define SysTick_BASE	(CORTEX_M4_PERIPH_BASE + SysTick_OFFSET)
 
+#define	NVIC_OFFSET					(0x0000E100UL)
+#define NVIC_BASE		(CORTEX_M4_PERIPH_BASE + NVIC_OFFSET)
+
+#define	SCB_OFFSET					(0x0000ED00UL)
+#define SCB_BASE		(CORTEX_M4_PERIPH_BASE + SCB_OFFSET)
+
+#define	CoreDebug_OFFSET			(0x0000EDF0UL)
+#define CoreDebug_BASE	(CORTEX_M4_PERIPH_BASE + CoreDebug_OFFSET)
+
+#define	FPU_OFFSET					(0x0000EF30UL)
+#define FPU_BASE		(CORTEX_M4_PERIPH_BASE + FPU_OFFSET)
+
+
+
+
+/*********CCM RAM Block*****************/
+/**
+ * @def CCMRAM_BASE
+ * @brief The base address of the core coupled memory (CCM data RAM).
+ * 64-Kbyte on the CPU D-bus only, the DMAs can't reach it
+ * (0x1000 0000 - 0x1000 FFFF)
+ */
+#define CCMRAM_BASE 				(0x10000000UL)
+#define CCMRAM_SIZE 				(0x00010000UL)
+
 
 
 
@@ -53,6 +81,7 @@
 #define APB1_OFFSET (0x00000000UL)
 #define APB2_OFFSET (0x00010000UL)
 #define AHB1_OFFSET (0x00020000UL)
+#define AHB2_OFFSET (0x10000000UL)
 
 
 
@@ -66,6 +95,7 @@
 #define APB1_BASE	(PERIPH_BASE + APB1_OFFSET)
 #define APB2_BASE	(PERIPH_BASE + APB2_OFFSET)
 #define AHB1_BASE	(PERIPH_BASE + AHB1_OFFSET)
+#define AHB2_BASE	(PERIPH_BASE + AHB2_OFFSET)
 
 /**
  * @defgroup Peripherals_offsets_and_bases_from_APB1_Bus_Base
@@ -83,6 +113,57 @@
 #define USART5_OFFSET	(0x00005000UL)
 #define USART5_BASE		(APB1_BASE + USART5_OFFSET)
 
+#define TIM2_OFFSET		(0x00000000UL)
+#define TIM2_BASE		(APB1_BASE + TIM2_OFFSET)
+
+#define TIM3_OFFSET		(0x00000400UL)
+#define TIM3_BASE		(APB1_BASE + TIM3_OFFSET)
+
+#define TIM4_OFFSET		(0x00000800UL)
+#define TIM4_BASE		(APB1_BASE + TIM4_OFFSET)
+
+#define TIM5_OFFSET		(0x00000C00UL)
+#define TIM5_BASE		(APB1_BASE + TIM5_OFFSET)
+
+#define TIM6_OFFSET		(0x00001000UL)
+#define TIM6_BASE		(APB1_BASE + TIM6_OFFSET)
+
+#define TIM7_OFFSET		(0x00001400UL)
+#define TIM7_BASE		(APB1_BASE + TIM7_OFFSET)
+
+#define TIM12_OFFSET	(0x00001800UL)
+#define TIM12_BASE		(APB1_BASE + TIM12_OFFSET)
+
+#define TIM13_OFFSET	(0x00001C00UL)
+#define TIM13_BASE		(APB1_BASE + TIM13_OFFSET)
+
+#define TIM14_OFFSET	(0x00002000UL)
+#define TIM14_BASE		(APB1_BASE + TIM14_OFFSET)
+
+#define SPI2_OFFSET		(0x00003800UL)
+#define SPI2_BASE		(APB1_BASE + SPI2_OFFSET)
+
+#define SPI3_OFFSET		(0x00003C00UL)
+#define SPI3_BASE		(APB1_BASE + SPI3_OFFSET)
+
+#define I2C1_OFFSET		(0x00005400UL)
+#define I2C1_BASE		(APB1_BASE + I2C1_OFFSET)
+
+#define I2C2_OFFSET		(0x00005800UL)
+#define I2C2_BASE		(APB1_BASE + I2C2_OFFSET)
+
+#define I2C3_OFFSET		(0x00005C00UL)
+#define I2C3_BASE		(APB1_BASE + I2C3_OFFSET)
+
+#define DAC_OFFSET		(0x00007400UL)
+#define DAC_BASE		(APB1_BASE + DAC_OFFSET)
+
+#define RTC_OFFSET		(0x00002800UL)
+#define RTC_BASE		(APB1_BASE + RTC_OFFSET)
+
+#define PWR_OFFSET		(0x00007000UL)
+#define PWR_BASE		(APB1_BASE + PWR_OFFSET)
+
 
 /**
  * @defgroup Peripherals_offsets_and_bases_from_APB2_Bus_Base
@@ -94,6 +175,27 @@
 #define USART6_OFFSET	(0x00001400UL)
 #define USART6_BASE		(APB2_BASE + USART6_OFFSET)
 
+#define EXTI_OFFSET		(0x00003C00UL)
+#define EXTI_BASE		(APB2_BASE + EXTI_OFFSET)
+
+#define TIM1_OFFSET		(0x00000000UL)
+#define TIM1_BASE		(APB2_BASE + TIM1_OFFSET)
+
+#define TIM8_OFFSET		(0x00000400UL)
+#define TIM8_BASE		(APB2_BASE + TIM8_OFFSET)
+
+#define TIM9_OFFSET		(0x00004000UL)
+#define TIM9_BASE		(APB2_BASE + TIM9_OFFSET)
+
+#define TIM10_OFFSET	(0x00004400UL)
+#define TIM10_BASE		(APB2_BASE + TIM10_OFFSET)
+
+#define TIM11_OFFSET	(0x00004800UL)
+#define TIM11_BASE		(APB2_BASE + TIM11_OFFSET)
+
+#define SPI1_OFFSET		(0x00003000UL)
+#define SPI1_BASE		(APB2_BASE + SPI1_OFFSET)
+
 
 #define ADC_OFFSET		(0x00002000UL)
 #define ADC_BASE		(APB2_BASE + ADC_OFFSET)
@@ -132,9 +234,25 @@
 #define GPIOH_OFFSET	(0x00001C00UL)
 #define GPIOH_BASE		(AHB1_BASE + GPIOH_OFFSET)
 
+#define CRC_OFFSET		(0x00003000UL)
+#define CRC_BASE		(AHB1_BASE + CRC_OFFSET)
+
 #define RCC_OFFSET	(0x00003800UL)
 #define RCC_BASE		(AHB1_BASE + RCC_OFFSET)
 
+#define DMA1_OFFSET		(0x00006000UL)
+#define DMA1_BASE		(AHB1_BASE + DMA1_OFFSET)
+
+#define DMA2_OFFSET		(0x00006400UL)
+#define DMA2_BASE		(AHB1_BASE + DMA2_OFFSET)
+
+/**
+ * @defgroup Peripherals_offsets_and_bases_from_AHB2_Bus_Base
+ * @brief once we have reach the peripheral, we can reach each register inside it using systematic offsets.
+ */
+#define RNG_OFFSET		(0x00060800UL)
+#define RNG_BASE		(AHB2_BASE + RNG_OFFSET)
+
 
 
 
@@ -204,6 +322,76 @@ typedef struct{
 }SysTick_t;
 
 
+typedef struct{
+
+	volatile uint32_t ISER[8];		/*Interrupt Set-enable Registers			OFFSET: 0x000*/
+	uint32_t RESERVED0[24];
+	volatile uint32_t ICER[8];		/*Interrupt Clear-enable Registers			OFFSET: 0x080*/
+	uint32_t RESERVED1[24];
+	volatile uint32_t ISPR[8];		/*Interrupt Set-pending Registers			OFFSET: 0x100*/
+	uint32_t RESERVED2[24];
+	volatile uint32_t ICPR[8];		/*Interrupt Clear-pending Registers			OFFSET: 0x180*/
+	uint32_t RESERVED3[24];
+	volatile uint32_t IABR[8];		/*Interrupt Active Bit Registers			OFFSET: 0x200*/
+	uint32_t RESERVED4[56];
+	volatile uint8_t  IPR[240];		/*Interrupt Priority Registers (byte access)	OFFSET: 0x300*/
+	uint32_t RESERVED5[644];
+	volatile uint32_t STIR;			/*Software Trigger Interrupt Register		OFFSET: 0xE00*/
+}NVIC_t;
+
+
+typedef struct{
+
+	volatile uint32_t CPUID;		/*CPUID Base Register						OFFSET: 0x00*/
+	volatile uint32_t ICSR;			/*Interrupt Control and State Register		OFFSET: 0x04*/
+	volatile uint32_t VTOR;			/*Vector Table Offset Register				OFFSET: 0x08*/
+	volatile uint32_t AIRCR;		/*Application Interrupt and Reset Control	OFFSET: 0x0C*/
+	volatile uint32_t SCR;			/*System Control Register					OFFSET: 0x10*/
+	volatile uint32_t CCR;			/*Configuration and Control Register		OFFSET: 0x14*/
+	volatile uint8_t  SHPR[12];		/*System Handler Priority Registers (byte access, exceptions 4 - 15)	OFFSET: 0x18*/
+	volatile uint32_t SHCSR;		/*System Handler Control and State Register	OFFSET: 0x24*/
+	volatile uint32_t CFSR;			/*Configurable Fault Status Register		OFFSET: 0x28*/
+	volatile uint32_t HFSR;			/*HardFault Status Register					OFFSET: 0x2C*/
+	volatile uint32_t DFSR;			/*Debug Fault Status Register				OFFSET: 0x30*/
+	volatile uint32_t MMFAR;		/*MemManage Fault Address Register			OFFSET: 0x34*/
+	volatile uint32_t BFAR;			/*BusFault Address Register					OFFSET: 0x38*/
+	volatile uint32_t AFSR;			/*Auxiliary Fault Status Register			OFFSET: 0x3C*/
+	uint32_t RESERVED0[18];			/*Feature registers, 0x40-0x84*/
+	volatile uint32_t CPACR;		/*Coprocessor Access Control Register		OFFSET: 0x88*/
+}SCB_t;
+
+
+typedef struct{
+
+	volatile uint32_t CTRL;			/*DWT Control Register						OFFSET: 0x00*/
+	volatile uint32_t CYCCNT;		/*DWT Cycle Count Register					OFFSET: 0x04*/
+	volatile uint32_t CPICNT;		/*DWT CPI Count Register					OFFSET: 0x08*/
+	volatile uint32_t EXCCNT;		/*DWT Exception Overhead Count Register		OFFSET: 0x0C*/
+	volatile uint32_t SLEEPCNT;		/*DWT Sleep Count Register					OFFSET: 0x10*/
+	volatile uint32_t LSUCNT;		/*DWT LSU Count Register					OFFSET: 0x14*/
+	volatile uint32_t FOLDCNT;		/*DWT Folded-instruction Count Register		OFFSET: 0x18*/
+	volatile uint32_t PCSR;			/*DWT Program Counter Sample Register		OFFSET: 0x1C*/
+}DWT_t;
+
+
+typedef struct{
+
+	volatile uint32_t DHCSR;		/*Debug Halting Control and Status Register	OFFSET: 0x00*/
+	volatile uint32_t DCRSR;		/*Debug Core Register Selector Register		OFFSET: 0x04*/
+	volatile uint32_t DCRDR;		/*Debug Core Register Data Register			OFFSET: 0x08*/
+	volatile uint32_t DEMCR;		/*Debug Exception and Monitor Control		OFFSET: 0x0C*/
+}CoreDebug_t;
+
+
+typedef struct{
+
+	uint32_t RESERVED0;				/*Reserved, 0xEF30*/
+	volatile uint32_t FPCCR;		/*Floating-point Context Control Register	OFFSET: 0x04*/
+	volatile uint32_t FPCAR;		/*Floating-point Context Address Register	OFFSET: 0x08*/
+	volatile uint32_t FPDSCR;		/*Floating-point Default Status Control		OFFSET: 0x0C*/
+}FPU_t;
+
+
 typedef struct{
 
 	volatile uint32_t SR;	/*USART Status Register*/
@@ -243,6 +431,170 @@ typedef struct
 
 
 
+typedef struct
+{
+  volatile uint32_t CR1;    /*!< TIM control register 1,                      Address offset: 0x00 */
+  volatile uint32_t CR2;    /*!< TIM control register 2,                      Address offset: 0x04 */
+  volatile uint32_t SMCR;   /*!< TIM slave mode control register,             Address offset: 0x08 */
+  volatile uint32_t DIER;   /*!< TIM DMA/interrupt enable register,           Address offset: 0x0C */
+  volatile uint32_t SR;     /*!< TIM status register,                         Address offset: 0x10 */
+  volatile uint32_t EGR;    /*!< TIM event generation register,               Address offset: 0x14 */
+  volatile uint32_t CCMR1;  /*!< TIM capture/compare mode register 1,         Address offset: 0x18 */
+  volatile uint32_t CCMR2;  /*!< TIM capture/compare mode register 2,         Address offset: 0x1C */
+  volatile uint32_t CCER;   /*!< TIM capture/compare enable register,         Address offset: 0x20 */
+  volatile uint32_t CNT;    /*!< TIM counter register,                        Address offset: 0x24 */
+  volatile uint32_t PSC;    /*!< TIM prescaler,                               Address offset: 0x28 */
+  volatile uint32_t ARR;    /*!< TIM auto-reload register,                    Address offset: 0x2C */
+  volatile uint32_t RCR;    /*!< TIM repetition counter register,             Address offset: 0x30 */
+  volatile uint32_t CCR1;   /*!< TIM capture/compare register 1,              Address offset: 0x34 */
+  volatile uint32_t CCR2;   /*!< TIM capture/compare register 2,              Address offset: 0x38 */
+  volatile uint32_t CCR3;   /*!< TIM capture/compare register 3,              Address offset: 0x3C */
+  volatile uint32_t CCR4;   /*!< TIM capture/compare register 4,              Address offset: 0x40 */
+  volatile uint32_t BDTR;   /*!< TIM break and dead-time register,            Address offset: 0x44 */
+  volatile uint32_t DCR;    /*!< TIM DMA control register,                    Address offset: 0x48 */
+  volatile uint32_t DMAR;   /*!< TIM DMA address for full transfer,           Address offset: 0x4C */
+  volatile uint32_t OR;     /*!< TIM option register,                         Address offset: 0x50 */
+}TIM_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR1;    /*!< SPI control register 1 (not used in I2S mode),      Address offset: 0x00 */
+  volatile uint32_t CR2;    /*!< SPI control register 2,                             Address offset: 0x04 */
+  volatile uint32_t SR;     /*!< SPI status register,                                Address offset: 0x08 */
+  volatile uint32_t DR;     /*!< SPI data register,                                  Address offset: 0x0C */
+  volatile uint32_t CRCPR;  /*!< SPI CRC polynomial register (not used in I2S mode), Address offset: 0x10 */
+  volatile uint32_t RXCRCR; /*!< SPI RX CRC register (not used in I2S mode),         Address offset: 0x14 */
+  volatile uint32_t TXCRCR; /*!< SPI TX CRC register (not used in I2S mode),         Address offset: 0x18 */
+  volatile uint32_t I2SCFGR;/*!< SPI_I2S configuration register,                     Address offset: 0x1C */
+  volatile uint32_t I2SPR;  /*!< SPI_I2S prescaler register,                         Address offset: 0x20 */
+}SPI_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR1;    /*!< I2C Control register 1,                      Address offset: 0x00 */
+  volatile uint32_t CR2;    /*!< I2C Control register 2,                      Address offset: 0x04 */
+  volatile uint32_t OAR1;   /*!< I2C Own address register 1,                  Address offset: 0x08 */
+  volatile uint32_t OAR2;   /*!< I2C Own address register 2,                  Address offset: 0x0C */
+  volatile uint32_t DR;     /*!< I2C Data register,                           Address offset: 0x10 */
+  volatile uint32_t SR1;    /*!< I2C Status register 1,                       Address offset: 0x14 */
+  volatile uint32_t SR2;    /*!< I2C Status register 2,                       Address offset: 0x18 */
+  volatile uint32_t CCR;    /*!< I2C Clock control register,                  Address offset: 0x1C */
+  volatile uint32_t TRISE;  /*!< I2C TRISE register,                          Address offset: 0x20 */
+  volatile uint32_t FLTR;   /*!< I2C FLTR register,                           Address offset: 0x24 */
+}I2C_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR;      /*!< DAC control register,                                    Address offset: 0x00 */
+  volatile uint32_t SWTRIGR; /*!< DAC software trigger register,                           Address offset: 0x04 */
+  volatile uint32_t DHR12R1; /*!< DAC channel1 12-bit right-aligned data holding register, Address offset: 0x08 */
+  volatile uint32_t DHR12L1; /*!< DAC channel1 12-bit left aligned data holding register,  Address offset: 0x0C */
+  volatile uint32_t DHR8R1;  /*!< DAC channel1 8-bit right aligned data holding register,  Address offset: 0x10 */
+  volatile uint32_t DHR12R2; /*!< DAC channel2 12-bit right aligned data holding register, Address offset: 0x14 */
+  volatile uint32_t DHR12L2; /*!< DAC channel2 12-bit left aligned data holding register,  Address offset: 0x18 */
+  volatile uint32_t DHR8R2;  /*!< DAC channel2 8-bit right-aligned data holding register,  Address offset: 0x1C */
+  volatile uint32_t DHR12RD; /*!< Dual DAC 12-bit right-aligned data holding register,     Address offset: 0x20 */
+  volatile uint32_t DHR12LD; /*!< DUAL DAC 12-bit left aligned data holding register,      Address offset: 0x24 */
+  volatile uint32_t DHR8RD;  /*!< DUAL DAC 8-bit right aligned data holding register,      Address offset: 0x28 */
+  volatile uint32_t DOR1;    /*!< DAC channel1 data output register,                       Address offset: 0x2C */
+  volatile uint32_t DOR2;    /*!< DAC channel2 data output register,                       Address offset: 0x30 */
+  volatile uint32_t SR;      /*!< DAC status register,                                     Address offset: 0x34 */
+}DAC_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR;     /*!< DMA stream x configuration register,         Address offset: 0x10 + 0x18 * x */
+  volatile uint32_t NDTR;   /*!< DMA stream x number of data register,        Address offset: 0x14 + 0x18 * x */
+  volatile uint32_t PAR;    /*!< DMA stream x peripheral address register,    Address offset: 0x18 + 0x18 * x */
+  volatile uint32_t M0AR;   /*!< DMA stream x memory 0 address register,      Address offset: 0x1C + 0x18 * x */
+  volatile uint32_t M1AR;   /*!< DMA stream x memory 1 address register,      Address offset: 0x20 + 0x18 * x */
+  volatile uint32_t FCR;    /*!< DMA stream x FIFO control register,          Address offset: 0x24 + 0x18 * x */
+}DMA_Stream_t;
+
+typedef struct
+{
+  volatile uint32_t LISR;   /*!< DMA low interrupt status register,           Address offset: 0x00 */
+  volatile uint32_t HISR;   /*!< DMA high interrupt status register,          Address offset: 0x04 */
+  volatile uint32_t LIFCR;  /*!< DMA low interrupt flag clear register,       Address offset: 0x08 */
+  volatile uint32_t HIFCR;  /*!< DMA high interrupt flag clear register,      Address offset: 0x0C */
+  DMA_Stream_t STREAM[8];   /*!< DMA streams 0 - 7,                           Address offset: 0x10 */
+}DMA_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t DR;     /*!< CRC Data register,                           Address offset: 0x00 */
+  volatile uint32_t IDR;    /*!< CRC Independent data register,               Address offset: 0x04 */
+  volatile uint32_t CR;     /*!< CRC Control register,                        Address offset: 0x08 */
+}CRC_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR;     /*!< RNG control register,                        Address offset: 0x00 */
+  volatile uint32_t SR;     /*!< RNG status register,                         Address offset: 0x04 */
+  volatile uint32_t DR;     /*!< RNG data register,                           Address offset: 0x08 */
+}RNG_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t CR;     /*!< PWR power control register,                  Address offset: 0x00 */
+  volatile uint32_t CSR;    /*!< PWR power control/status register,           Address offset: 0x04 */
+}PWR_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t TR;        /*!< RTC time register,                                    Address offset: 0x00 */
+  volatile uint32_t DR;        /*!< RTC date register,                                    Address offset: 0x04 */
+  volatile uint32_t CR;        /*!< RTC control register,                                 Address offset: 0x08 */
+  volatile uint32_t ISR;       /*!< RTC initialization and status register,               Address offset: 0x0C */
+  volatile uint32_t PRER;      /*!< RTC prescaler register,                               Address offset: 0x10 */
+  volatile uint32_t WUTR;      /*!< RTC wakeup timer register,                            Address offset: 0x14 */
+  volatile uint32_t CALIBR;    /*!< RTC calibration register,                             Address offset: 0x18 */
+  volatile uint32_t ALRMAR;    /*!< RTC alarm A register,                                 Address offset: 0x1C */
+  volatile uint32_t ALRMBR;    /*!< RTC alarm B register,                                 Address offset: 0x20 */
+  volatile uint32_t WPR;       /*!< RTC write protection register,                        Address offset: 0x24 */
+  volatile uint32_t SSR;       /*!< RTC sub second register,                              Address offset: 0x28 */
+  volatile uint32_t SHIFTR;    /*!< RTC shift control register,                           Address offset: 0x2C */
+  volatile uint32_t TSTR;      /*!< RTC time stamp time register,                         Address offset: 0x30 */
+  volatile uint32_t TSDR;      /*!< RTC time stamp date register,                         Address offset: 0x34 */
+  volatile uint32_t TSSSR;     /*!< RTC time-stamp sub second register,                   Address offset: 0x38 */
+  volatile uint32_t CALR;      /*!< RTC calibration register,                             Address offset: 0x3C */
+  volatile uint32_t TAFCR;     /*!< RTC tamper and alternate function configuration,      Address offset: 0x40 */
+  volatile uint32_t ALRMASSR;  /*!< RTC alarm A sub second register,                      Address offset: 0x44 */
+  volatile uint32_t ALRMBSSR;  /*!< RTC alarm B sub second register,                      Address offset: 0x48 */
+  uint32_t      RESERVED0;     /*!< Reserved, 0x4C                                                             */
+  volatile uint32_t BKPR[20];  /*!< RTC backup registers 0 - 19,                          Address offset: 0x50 */
+}RTC_t;
+
+
+
+typedef struct
+{
+  volatile uint32_t IMR;    /*!< EXTI interrupt mask register,                Address offset: 0x00 */
+  volatile uint32_t EMR;    /*!< EXTI event mask register,                    Address offset: 0x04 */
+  volatile uint32_t RTSR;   /*!< EXTI rising trigger selection register,      Address offset: 0x08 */
+  volatile uint32_t FTSR;   /*!< EXTI falling trigger selection register,     Address offset: 0x0C */
+  volatile uint32_t SWIER;  /*!< EXTI software interrupt event register,      Address offset: 0x10 */
+  volatile uint32_t PR;     /*!< EXTI pending register,                       Address offset: 0x14 */
+}EXTI_t;
+
+
+
 typedef struct
 {
   volatile uint32_t CSR;    /*!< ADC Common status register,                  Address offset: ADC1 base address + 0x300 */
@@ -268,6 +620,11 @@ typedef struct
 #define GPIOH	((GPIO_t*)GPIOH_BASE)
 
 #define SysTick	((SysTick_t*)SysTick_BASE)
+#define NVIC	((NVIC_t*)NVIC_BASE)
+#define SCB		((SCB_t*)SCB_BASE)
+#define DWT		((DWT_t*)DWT_BASE)
+#define CoreDebug	((CoreDebug_t*)CoreDebug_BASE)
+#define FPU		((FPU_t*)FPU_BASE)
 
 #define USART1	((USART_t*)USART1_BASE)
 #define USART2	((USART_t*)USART2_BASE)
@@ -281,6 +638,42 @@ typedef struct
 #define ADC3	((ADC_t*)ADC3_BASE)
 #define ADC_COMMON	((ADC_Common_t*)ADC_COMMON_BASE)
 
+#define DMA1	((DMA_t*)DMA1_BASE)
+#define DMA2	((DMA_t*)DMA2_BASE)
+
+#define CRC		((CRC_t*)CRC_BASE)
+
+#define RNG		((RNG_t*)RNG_BASE)
+
+#define PWR		((PWR_t*)PWR_BASE)
+#define RTC		((RTC_t*)RTC_BASE)
+#define EXTI	((EXTI_t*)EXTI_BASE)
+
+#define TIM1	((TIM_t*)TIM1_BASE)
+#define TIM2	((TIM_t*)TIM2_BASE)
+#define TIM3	((TIM_t*)TIM3_BASE)
+#define TIM4	((TIM_t*)TIM4_BASE)
+#define TIM5	((TIM_t*)TIM5_BASE)
+#define TIM6	((TIM_t*)TIM6_BASE)
+#define TIM7	((TIM_t*)TIM7_BASE)
+#define TIM8	((TIM_t*)TIM8_BASE)
+#define TIM9	((TIM_t*)TIM9_BASE)
+#define TIM10	((TIM_t*)TIM10_BASE)
+#define TIM11	((TIM_t*)TIM11_BASE)
+#define TIM12	((TIM_t*)TIM12_BASE)
+#define TIM13	((TIM_t*)TIM13_BASE)
+#define TIM14	((TIM_t*)TIM14_BASE)
+
+#define SPI1	((SPI_t*)SPI1_BASE)
+#define SPI2	((SPI_t*)SPI2_BASE)
+#define SPI3	((SPI_t*)SPI3_BASE)
+
+#define I2C1	((I2C_t*)I2C1_BASE)
+#define I2C2	((I2C_t*)I2C2_BASE)
+#define I2C3	((I2C_t*)I2C3_BASE)
+
+#define DAC		((DAC_t*)DAC_BASE)
+
 /*____________________________________________________________________________________________*/
 /*____________________________________RCC Registers Bits_____________________________________*/
 /*____________________________________________________________________________________________*/
@@ -717,6 +1110,98 @@ typedef struct
 #define SysTick_CALIB_NOREF				31
 
 
+/*____________________________________________________________________________________________*/
+/*_____________________________________ SCB Registers Bits ___________________________________*/
+/*____________________________________________________________________________________________*/
+
+/* #SCB_ICSR Register ############################ */
+#define SCB_ICSR_VECTACTIVE				0	//[0-8]
+//____________RES						[9-10]
+#define SCB_ICSR_RETTOBASE				11
+#define SCB_ICSR_VECTPENDING			12	//[12-18]
+//____________RES						[19-21]
+#define SCB_ICSR_ISRPENDING				22
+//____________RES						[23-24]
+#define SCB_ICSR_PENDSTCLR				25
+#define SCB_ICSR_PENDSTSET				26
+#define SCB_ICSR_PENDSVCLR				27
+#define SCB_ICSR_PENDSVSET				28
+//____________RES						[29-30]
+#define SCB_ICSR_NMIPENDSET				31
+
+/* #SCB_AIRCR Register ############################ */
+#define SCB_AIRCR_VECTRESET				0
+#define SCB_AIRCR_VECTCLRACTIVE			1
+#define SCB_AIRCR_SYSRESETREQ			2
+//____________RES						[3-7]
+#define SCB_AIRCR_PRIGROUP				8	//[8-10]
+//____________RES						[11-14]
+#define SCB_AIRCR_ENDIANNESS			15
+#define SCB_AIRCR_VECTKEY				16	//[16-31]	write 0x05FA
+
+/* #SCB_SCR Register ############################ */
+//____________RES						0
+#define SCB_SCR_SLEEPONEXIT				1
+#define SCB_SCR_SLEEPDEEP				2
+//____________RES						3
+#define SCB_SCR_SEVONPEND				4
+//____________RES						[5-31]
+
+/* #SCB_CCR Register ############################ */
+#define SCB_CCR_NONBASETHRDENA			0
+#define SCB_CCR_USERSETMPEND			1
+//____________RES						2
+#define SCB_CCR_UNALIGN_TRP				3
+#define SCB_CCR_DIV_0_TRP				4
+//____________RES						[5-7]
+#define SCB_CCR_BFHFNMIGN				8
+#define SCB_CCR_STKALIGN				9
+//____________RES						[10-31]
+
+/* #SCB_SHCSR Register ############################ */
+#define SCB_SHCSR_MEMFAULTENA			16
+#define SCB_SHCSR_BUSFAULTENA			17
+#define SCB_SHCSR_USGFAULTENA			18
+//____________RES						[19-31]
+
+/* #SCB_CPACR Register ############################ */
+//____________RES						[0-19]
+#define SCB_CPACR_CP10					20	//[20-21]
+#define SCB_CPACR_CP11					22	//[22-23]
+//____________RES						[24-31]
+
+
+/*____________________________________________________________________________________________*/
+/*________________________________ DWT/CoreDebug/FPU Registers Bits ___________________________*/
+/*____________________________________________________________________________________________*/
+
+/* #DWT_CTRL Register ############################ */
+#define DWT_CTRL_CYCCNTENA				0
+#define DWT_CTRL_EXCEVTENA				16
+#define DWT_CTRL_SLEEPEVTENA			19
+#define DWT_CTRL_NOCYCCNT				25
+#define DWT_CTRL_NUMCOMP				28	//[28-31]
+
+/* #CoreDebug_DEMCR Register ############################ */
+#define CoreDebug_DEMCR_VC_CORERESET	0
+#define CoreDebug_DEMCR_TRCENA			24
+//____________RES						[25-31]
+
+/* #FPU_FPCCR Register ############################ */
+#define FPU_FPCCR_LSPACT				0
+#define FPU_FPCCR_USER					1
+//____________RES						2
+#define FPU_FPCCR_THREAD				3
+#define FPU_FPCCR_HFRDY					4
+#define FPU_FPCCR_MMRDY					5
+#define FPU_FPCCR_BFRDY					6
+//____________RES						7
+#define FPU_FPCCR_MONRDY				8
+//____________RES						[9-29]
+#define FPU_FPCCR_LSPEN					30
+#define FPU_FPCCR_ASPEN					31
+
+
 /*____________________________________________________________________________________________*/
 /*___________________________________ SysTick Registers Bits _________________________________*/
 /*____________________________________________________________________________________________*/
@@ -950,6 +1435,488 @@ typedef struct
 
 
 
+/*____________________________________________________________________________________________*/
+/*____________________________________ TIM Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #TIM_CR1 ############################ */
+#define TIM_CR1_CEN				0
+#define TIM_CR1_UDIS			1
+#define TIM_CR1_URS				2
+#define TIM_CR1_OPM				3
+#define TIM_CR1_DIR				4
+#define TIM_CR1_CMS				5	//[5-6]
+#define TIM_CR1_ARPE			7
+#define TIM_CR1_CKD				8	//[8-9]
+//____________RES				[10-31]
+
+/* #TIM_CR2 ############################ */
+#define TIM_CR2_CCPC			0
+//____________RES				1
+#define TIM_CR2_CCUS			2
+#define TIM_CR2_CCDS			3
+#define TIM_CR2_MMS				4	//[4-6]
+#define TIM_CR2_TI1S			7
+#define TIM_CR2_OIS1			8
+#define TIM_CR2_OIS1N			9
+#define TIM_CR2_OIS2			10
+#define TIM_CR2_OIS2N			11
+#define TIM_CR2_OIS3			12
+#define TIM_CR2_OIS3N			13
+#define TIM_CR2_OIS4			14
+//____________RES				[15-31]
+
+/* #TIM_SMCR ############################ */
+#define TIM_SMCR_SMS			0	//[0-2]
+//____________RES				3
+#define TIM_SMCR_TS				4	//[4-6]
+#define TIM_SMCR_MSM			7
+#define TIM_SMCR_ETF			8	//[8-11]
+#define TIM_SMCR_ETPS			12	//[12-13]
+#define TIM_SMCR_ECE			14
+#define TIM_SMCR_ETP			15
+//____________RES				[16-31]
+
+/* #TIM_DIER ############################ */
+#define TIM_DIER_UIE			0
+#define TIM_DIER_CC1IE			1
+#define TIM_DIER_CC2IE			2
+#define TIM_DIER_CC3IE			3
+#define TIM_DIER_CC4IE			4
+#define TIM_DIER_COMIE			5
+#define TIM_DIER_TIE			6
+#define TIM_DIER_BIE			7
+#define TIM_DIER_UDE			8
+#define TIM_DIER_CC1DE			9
+#define TIM_DIER_CC2DE			10
+#define TIM_DIER_CC3DE			11
+#define TIM_DIER_CC4DE			12
+#define TIM_DIER_COMDE			13
+#define TIM_DIER_TDE			14
+//____________RES				[15-31]
+
+/* #TIM_SR ############################ */
+#define TIM_SR_UIF				0
+#define TIM_SR_CC1IF			1
+#define TIM_SR_CC2IF			2
+#define TIM_SR_CC3IF			3
+#define TIM_SR_CC4IF			4
+#define TIM_SR_COMIF			5
+#define TIM_SR_TIF				6
+#define TIM_SR_BIF				7
+//____________RES				8
+#define TIM_SR_CC1OF			9
+#define TIM_SR_CC2OF			10
+#define TIM_SR_CC3OF			11
+#define TIM_SR_CC4OF			12
+//____________RES				[13-31]
+
+/* #TIM_EGR ############################ */
+#define TIM_EGR_UG				0
+#define TIM_EGR_CC1G			1
+#define TIM_EGR_CC2G			2
+#define TIM_EGR_CC3G			3
+#define TIM_EGR_CC4G			4
+#define TIM_EGR_COMG			5
+#define TIM_EGR_TG				6
+#define TIM_EGR_BG				7
+//____________RES				[8-31]
+
+/* #TIM_CCMR1 (CCMR2 has the same layout for channels 3 - 4) ############################ */
+#define TIM_CCMR1_CC1S			0	//[0-1]
+#define TIM_CCMR1_OC1FE			2		/*Output compare mode*/
+#define TIM_CCMR1_OC1PE			3
+#define TIM_CCMR1_OC1M			4	//[4-6]
+#define TIM_CCMR1_OC1CE			7
+#define TIM_CCMR1_IC1PSC		2	//[2-3]	/*Input capture mode*/
+#define TIM_CCMR1_IC1F			4	//[4-7]
+#define TIM_CCMR1_CC2S			8	//[8-9]
+#define TIM_CCMR1_OC2FE			10
+#define TIM_CCMR1_OC2PE			11
+#define TIM_CCMR1_OC2M			12	//[12-14]
+#define TIM_CCMR1_OC2CE			15
+#define TIM_CCMR1_IC2PSC		10	//[10-11]
+#define TIM_CCMR1_IC2F			12	//[12-15]
+//____________RES				[16-31]
+
+/* #TIM_CCER (4 bits per channel: CCxE = 4 * (x - 1)) ############################ */
+#define TIM_CCER_CC1E			0
+#define TIM_CCER_CC1P			1
+#define TIM_CCER_CC1NE			2
+#define TIM_CCER_CC1NP			3
+#define TIM_CCER_CC2E			4
+#define TIM_CCER_CC2P			5
+#define TIM_CCER_CC2NE			6
+#define TIM_CCER_CC2NP			7
+#define TIM_CCER_CC3E			8
+#define TIM_CCER_CC3P			9
+#define TIM_CCER_CC3NE			10
+#define TIM_CCER_CC3NP			11
+#define TIM_CCER_CC4E			12
+#define TIM_CCER_CC4P			13
+//____________RES				14
+#define TIM_CCER_CC4NP			15
+//____________RES				[16-31]
+
+/* #TIM_BDTR ############################ */
+#define TIM_BDTR_DTG			0	//[0-7]
+#define TIM_BDTR_LOCK			8	//[8-9]
+#define TIM_BDTR_OSSI			10
+#define TIM_BDTR_OSSR			11
+#define TIM_BDTR_BKE			12
+#define TIM_BDTR_BKP			13
+#define TIM_BDTR_AOE			14
+#define TIM_BDTR_MOE			15
+//____________RES				[16-31]
+
+/* #TIM_DCR ############################ */
+#define TIM_DCR_DBA				0	//[0-4]
+//____________RES				[5-7]
+#define TIM_DCR_DBL				8	//[8-12]
+//____________RES				[13-31]
+
+
+
+/*____________________________________ DMA Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #DMA_LISR/HISR/LIFCR/HIFCR (per stream flags, shifted by 0, 6, 16, 22 for streams 0/4, 1/5, 2/6, 3/7) ### */
+#define DMA_ISR_FEIF			0
+//____________RES				1
+#define DMA_ISR_DMEIF			2
+#define DMA_ISR_TEIF			3
+#define DMA_ISR_HTIF			4
+#define DMA_ISR_TCIF			5
+
+/* #DMA_SxCR ############################ */
+#define DMA_SxCR_EN				0
+#define DMA_SxCR_DMEIE			1
+#define DMA_SxCR_TEIE			2
+#define DMA_SxCR_HTIE			3
+#define DMA_SxCR_TCIE			4
+#define DMA_SxCR_PFCTRL			5
+#define DMA_SxCR_DIR			6	//[6-7]
+#define DMA_SxCR_CIRC			8
+#define DMA_SxCR_PINC			9
+#define DMA_SxCR_MINC			10
+#define DMA_SxCR_PSIZE			11	//[11-12]
+#define DMA_SxCR_MSIZE			13	//[13-14]
+#define DMA_SxCR_PINCOS			15
+#define DMA_SxCR_PL				16	//[16-17]
+#define DMA_SxCR_DBM			18
+#define DMA_SxCR_CT				19
+//____________RES				20
+#define DMA_SxCR_PBURST			21	//[21-22]
+#define DMA_SxCR_MBURST			23	//[23-24]
+#define DMA_SxCR_CHSEL			25	//[25-27]
+//____________RES				[28-31]
+
+/* #DMA_SxFCR ############################ */
+#define DMA_SxFCR_FTH			0	//[0-1]
+#define DMA_SxFCR_DMDIS			2
+#define DMA_SxFCR_FS			3	//[3-5]
+//____________RES				6
+#define DMA_SxFCR_FEIE			7
+//____________RES				[8-31]
+
+
+
+/*____________________________________ SPI Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #SPI_CR1 ############################ */
+#define SPI_CR1_CPHA			0
+#define SPI_CR1_CPOL			1
+#define SPI_CR1_MSTR			2
+#define SPI_CR1_BR				3	//[3-5]
+#define SPI_CR1_SPE				6
+#define SPI_CR1_LSBFIRST		7
+#define SPI_CR1_SSI				8
+#define SPI_CR1_SSM				9
+#define SPI_CR1_RXONLY			10
+#define SPI_CR1_DFF				11
+#define SPI_CR1_CRCNEXT			12
+#define SPI_CR1_CRCEN			13
+#define SPI_CR1_BIDIOE			14
+#define SPI_CR1_BIDIMODE		15
+//____________RES				[16-31]
+
+/* #SPI_CR2 ############################ */
+#define SPI_CR2_RXDMAEN			0
+#define SPI_CR2_TXDMAEN			1
+#define SPI_CR2_SSOE			2
+//____________RES				3
+#define SPI_CR2_FRF				4
+#define SPI_CR2_ERRIE			5
+#define SPI_CR2_RXNEIE			6
+#define SPI_CR2_TXEIE			7
+//____________RES				[8-31]
+
+/* #SPI_SR ############################ */
+#define SPI_SR_RXNE				0
+#define SPI_SR_TXE				1
+#define SPI_SR_CHSIDE			2
+#define SPI_SR_UDR				3
+#define SPI_SR_CRCERR			4
+#define SPI_SR_MODF				5
+#define SPI_SR_OVR				6
+#define SPI_SR_BSY				7
+#define SPI_SR_FRE				8
+//____________RES				[9-31]
+
+
+
+/*____________________________________ I2C Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #I2C_CR1 ############################ */
+#define I2C_CR1_PE				0
+#define I2C_CR1_SMBUS			1
+//____________RES				2
+#define I2C_CR1_SMBTYPE			3
+#define I2C_CR1_ENARP			4
+#define I2C_CR1_ENPEC			5
+#define I2C_CR1_ENGC			6
+#define I2C_CR1_NOSTRETCH		7
+#define I2C_CR1_START			8
+#define I2C_CR1_STOP			9
+#define I2C_CR1_ACK				10
+#define I2C_CR1_POS				11
+#define I2C_CR1_PEC				12
+#define I2C_CR1_ALERT			13
+//____________RES				14
+#define I2C_CR1_SWRST			15
+//____________RES				[16-31]
+
+/* #I2C_CR2 ############################ */
+#define I2C_CR2_FREQ			0	//[0-5]
+//____________RES				[6-7]
+#define I2C_CR2_ITERREN			8
+#define I2C_CR2_ITEVTEN			9
+#define I2C_CR2_ITBUFEN			10
+#define I2C_CR2_DMAEN			11
+#define I2C_CR2_LAST			12
+//____________RES				[13-31]
+
+/* #I2C_SR1 ############################ */
+#define I2C_SR1_SB				0
+#define I2C_SR1_ADDR			1
+#define I2C_SR1_BTF				2
+#define I2C_SR1_ADD10			3
+#define I2C_SR1_STOPF			4
+//____________RES				5
+#define I2C_SR1_RXNE			6
+#define I2C_SR1_TXE				7
+#define I2C_SR1_BERR			8
+#define I2C_SR1_ARLO			9
+#define I2C_SR1_AF				10
+#define I2C_SR1_OVR				11
+#define I2C_SR1_PECERR			12
+//____________RES				13
+#define I2C_SR1_TIMEOUT			14
+#define I2C_SR1_SMBALERT		15
+//____________RES				[16-31]
+
+/* #I2C_SR2 ############################ */
+#define I2C_SR2_MSL				0
+#define I2C_SR2_BUSY			1
+#define I2C_SR2_TRA				2
+//____________RES				3
+#define I2C_SR2_GENCALL			4
+#define I2C_SR2_SMBDEFAULT		5
+#define I2C_SR2_SMBHOST			6
+#define I2C_SR2_DUALF			7
+#define I2C_SR2_PEC				8	//[8-15]
+//____________RES				[16-31]
+
+/* #I2C_CCR ############################ */
+#define I2C_CCR_CCR				0	//[0-11]
+//____________RES				[12-13]
+#define I2C_CCR_DUTY			14
+#define I2C_CCR_FS				15
+//____________RES				[16-31]
+
+/* #I2C_TRISE ############################ */
+#define I2C_TRISE_TRISE			0	//[0-5]
+//____________RES				[6-31]
+
+
+
+
+/*____________________________________________________________________________________________*/
+/*____________________________________ DAC Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+
+/* #DAC_CR (channel 2 bits are the channel 1 bits + DAC_CR_CH2_SHIFT) ############################ */
+#define DAC_CR_EN1				0
+#define DAC_CR_BOFF1			1
+#define DAC_CR_TEN1				2
+#define DAC_CR_TSEL1			3	//[3-5]
+#define DAC_CR_WAVE1			6	//[6-7]
+#define DAC_CR_MAMP1			8	//[8-11]
+#define DAC_CR_DMAEN1			12
+#define DAC_CR_DMAUDRIE1		13
+//____________RES				[14-15]
+#define DAC_CR_EN2				16
+#define DAC_CR_BOFF2			17
+#define DAC_CR_TEN2				18
+#define DAC_CR_TSEL2			19	//[19-21]
+#define DAC_CR_WAVE2			22	//[22-23]
+#define DAC_CR_MAMP2			24	//[24-27]
+#define DAC_CR_DMAEN2			28
+#define DAC_CR_DMAUDRIE2		29
+//____________RES				[30-31]
+
+#define DAC_CR_CH2_SHIFT		16
+
+/* #DAC_SWTRIGR ############################ */
+#define DAC_SWTRIGR_SWTRIG1		0
+#define DAC_SWTRIGR_SWTRIG2		1
+//____________RES				[2-31]
+
+/* #DAC_SR ############################ */
+//____________RES				[0-12]
+#define DAC_SR_DMAUDR1			13
+//____________RES				[14-28]
+#define DAC_SR_DMAUDR2			29
+//____________RES				[30-31]
+
+
+
+
+/*____________________________________________________________________________________________*/
+/*____________________________________ CRC Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #CRC_IDR ############################ */
+#define CRC_IDR_IDR				0	//[0-7]
+//____________RES				[8-31]
+
+/* #CRC_CR ############################ */
+#define CRC_CR_RESET			0
+//____________RES				[1-31]
+
+
+
+
+/*____________________________________________________________________________________________*/
+/*____________________________________ RNG Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #RNG_CR ############################ */
+//____________RES				[0-1]
+#define RNG_CR_RNGEN			2
+#define RNG_CR_IE				3
+//____________RES				[4-31]
+
+/* #RNG_SR ############################ */
+#define RNG_SR_DRDY				0
+#define RNG_SR_CECS				1
+#define RNG_SR_SECS				2
+//____________RES				[3-4]
+#define RNG_SR_CEIS				5
+#define RNG_SR_SEIS				6
+//____________RES				[7-31]
+
+
+
+/*____________________________________________________________________________________________*/
+/*____________________________________ PWR Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #PWR_CR ############################ */
+#define PWR_CR_LPDS				0
+#define PWR_CR_PDDS				1
+#define PWR_CR_CWUF				2
+#define PWR_CR_CSBF				3
+#define PWR_CR_PVDE				4
+#define PWR_CR_PLS				5	//[5-7]
+#define PWR_CR_DBP				8
+#define PWR_CR_FPDS				9
+//____________RES				[10-13]
+#define PWR_CR_VOS				14
+//____________RES				[15-31]
+
+/* #PWR_CSR ############################ */
+#define PWR_CSR_WUF				0
+#define PWR_CSR_SBF				1
+#define PWR_CSR_PVDO			2
+#define PWR_CSR_BRR				3
+//____________RES				[4-7]
+#define PWR_CSR_EWUP			8
+#define PWR_CSR_BRE				9
+//____________RES				[10-13]
+#define PWR_CSR_VOSRDY			14
+//____________RES				[15-31]
+
+
+
+
+/*____________________________________________________________________________________________*/
+/*____________________________________ RTC Registers Bits _____________________________________*/
+/*____________________________________________________________________________________________*/
+/* #RTC_TR ############################ */
+#define RTC_TR_SU				0	//[0-3]
+#define RTC_TR_ST				4	//[4-6]
+//____________RES				7
+#define RTC_TR_MNU				8	//[8-11]
+#define RTC_TR_MNT				12	//[12-14]
+//____________RES				15
+#define RTC_TR_HU				16	//[16-19]
+#define RTC_TR_HT				20	//[20-21]
+#define RTC_TR_PM				22
+//____________RES				[23-31]
+
+/* #RTC_CR ############################ */
+#define RTC_CR_WUCKSEL			0	//[0-2]
+#define RTC_CR_TSEDGE			3
+#define RTC_CR_REFCKON			4
+#define RTC_CR_BYPSHAD			5
+#define RTC_CR_FMT				6
+#define RTC_CR_DCE				7
+#define RTC_CR_ALRAE			8
+#define RTC_CR_ALRBE			9
+#define RTC_CR_WUTE				10
+#define RTC_CR_TSE				11
+#define RTC_CR_ALRAIE			12
+#define RTC_CR_ALRBIE			13
+#define RTC_CR_WUTIE			14
+#define RTC_CR_TSIE				15
+#define RTC_CR_ADD1H			16
+#define RTC_CR_SUB1H			17
+#define RTC_CR_BKP				18
+#define RTC_CR_COSEL			19
+#define RTC_CR_POL				20
+#define RTC_CR_OSEL				21	//[21-22]
+#define RTC_CR_COE				23
+//____________RES				[24-31]
+
+/* #RTC_ISR ############################ */
+#define RTC_ISR_ALRAWF			0
+#define RTC_ISR_ALRBWF			1
+#define RTC_ISR_WUTWF			2
+#define RTC_ISR_SHPF			3
+#define RTC_ISR_INITS			4
+#define RTC_ISR_RSF				5
+#define RTC_ISR_INITF			6
+#define RTC_ISR_INIT			7
+#define RTC_ISR_ALRAF			8
+#define RTC_ISR_ALRBF			9
+#define RTC_ISR_WUTF			10
+#define RTC_ISR_TSF				11
+#define RTC_ISR_TSOVF			12
+#define RTC_ISR_TAMP1F			13
+#define RTC_ISR_TAMP2F			14
+//____________RES				15
+#define RTC_ISR_RECALPF			16
+//____________RES				[17-31]
+
+/* #RTC_PRER ############################ */
+#define RTC_PRER_PREDIV_S		0	//[0-14]
+//____________RES				15
+#define RTC_PRER_PREDIV_A		16	//[16-22]
+//____________RES				[23-31]
+
+/* #RTC_WPR ############################ */
+#define RTC_WPR_KEY				0	//[0-7]
+//____________RES				[8-31]
+
+/* #RTC_SSR ############################ */
+#define RTC_SSR_SS				0	//[0-15]
+//____________RES				[16-31]
 
 
 
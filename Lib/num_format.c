@@ -0,0 +1,279 @@
+/**
+ * @file num_format.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Allocation-free integer, hex and fixed-point to text conversion for LCD/USART output.
+ *
+ * # Divide-free decimal conversion
+ * 		[♥] n / 100 = (n * 0x51EB851F) >> 37 and n / 10 = (n * 0xCCCCCCCD) >> 35 are exact for every 32-bit n,
+ * 			so each pair of digits costs one UMULL and one lookup in g_LIB_DIGIT_PAIRS instead of two UDIVs.
+ */
+/******************************* Includes *******************************/
+#include "num_format.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define LIB_FORMAT_UINT32_MAX_DIGITS	(10)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static const uint8_t g_LIB_DIGIT_PAIRS[201] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+static const uint8_t g_LIB_HEX_DIGITS[16] = {
+		'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+static const uint32_t g_LIB_POWERS_OF_10[LIB_FORMAT_MAX_DECIMALS + 1] = {
+		1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+static inline uint32_t LIB_FormatDiv10(uint32_t n){
+	return (uint32_t)(((uint64_t)n * 0xCCCCCCCDULL) >> 35);
+}
+
+static inline uint32_t LIB_FormatDiv100(uint32_t n){
+	return (uint32_t)(((uint64_t)n * 0x51EB851FULL) >> 37);
+}
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func LIB_FormatDecimal
+ * @brief Writes the decimal digits of value (no terminator).
+ *
+ * @note STATIC FUNCTION
+ * @return uint8_t	number of digits written
+ */
+static uint8_t LIB_FormatDecimal(uint8_t* buf, uint32_t value){
+
+	//count the digits first so they're written in place, no temporary buffer to copy
+	uint8_t len = 1;
+	while((len < LIB_FORMAT_UINT32_MAX_DIGITS) && (value >= g_LIB_POWERS_OF_10[len])){
+		len++;
+	}
+
+	//two digits per iteration, from the least significant
+	uint8_t pos = len;
+	while(value >= 100){
+		uint32_t quotient = LIB_FormatDiv100(value);
+		uint32_t pair = (value - (quotient * 100)) * 2;
+		pos -= 2;
+		buf[pos] = g_LIB_DIGIT_PAIRS[pair];
+		buf[pos + 1] = g_LIB_DIGIT_PAIRS[pair + 1];
+		value = quotient;
+	}
+	if(value >= 10){
+		buf[0] = g_LIB_DIGIT_PAIRS[value * 2];
+		buf[1] = g_LIB_DIGIT_PAIRS[(value * 2) + 1];
+	}else{
+		buf[0] = (uint8_t)('0' + value);
+	}
+	return len;
+}
+
+/**
+ * @func LIB_FormatUint32
+ * @brief Converts an unsigned number to decimal text.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param uint32_t value [in]
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatUint32(uint8_t* buf, uint32_t value){
+
+	uint8_t len = LIB_FormatDecimal(buf, value);
+	buf[len] = '\0';
+	return len;
+}
+
+/**
+ * @func LIB_FormatInt32
+ * @brief Converts a signed number to decimal text, the whole range [-2^31 : 2^31 - 1] is valid.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param int32_t value [in]
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatInt32(uint8_t* buf, int32_t value){
+
+	uint8_t len = 0;
+	//negate as unsigned, -INT32_MIN doesn't fit an int32_t
+	uint32_t magnitude = (uint32_t)value;
+
+	if(value < 0){
+		buf[len++] = '-';
+		magnitude = 0UL - magnitude;
+	}
+	len += LIB_FormatDecimal(&buf[len], magnitude);
+	buf[len] = '\0';
+	return len;
+}
+
+/**
+ * @func LIB_FormatHex32
+ * @brief Converts a number to upper case hex text (no "0x" prefix), zero padded to min_digits.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param uint32_t value [in]
+ * @param uint8_t min_digits [in]	[1 - 8], e.g. 2 for a byte, 8 for a register
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatHex32(uint8_t* buf, uint32_t value, uint8_t min_digits){
+
+	uint8_t len = 1;
+
+	if(min_digits > 8){
+		min_digits = 8;
+	}
+	while((len < 8) && ((value >> (len * 4)) != 0)){
+		len++;
+	}
+	if(len < min_digits){
+		len = min_digits;
+	}
+
+	for(uint8_t i = 0; i < len; i++){
+		buf[len - 1 - i] = g_LIB_HEX_DIGITS[(value >> (i * 4)) & 0xF];
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+/**
+ * @func LIB_FormatFixed
+ * @brief Converts a signed Q-format number to decimal text with the chosen number of decimals (rounded).
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param int32_t value [in]		fixed-point raw value
+ * @param uint8_t frac_bits [in]	[0 - 31] number of fraction bits
+ * @param uint8_t decimals [in]		[0 - LIB_FORMAT_MAX_DECIMALS], clamped
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatFixed(uint8_t* buf, int32_t value, uint8_t frac_bits, uint8_t decimals){
+
+	uint8_t len = 0;
+	uint32_t magnitude = (value < 0) ? (0UL - (uint32_t)value) : (uint32_t)value;
+
+	if(frac_bits > 31){
+		frac_bits = 31;
+	}
+	if(decimals > LIB_FORMAT_MAX_DECIMALS){
+		decimals = LIB_FORMAT_MAX_DECIMALS;
+	}
+
+	uint32_t scale = g_LIB_POWERS_OF_10[decimals];
+	uint32_t integer = magnitude >> frac_bits;
+	uint32_t fraction = magnitude & ((1UL << frac_bits) - 1);
+
+	//fraction * 10^decimals / 2^frac_bits rounded, fits 64 bits since fraction < 2^31 and scale < 2^30
+	uint64_t rounding = (frac_bits != 0) ? (1ULL << (frac_bits - 1)) : 0;
+	uint32_t scaled = (uint32_t)((((uint64_t)fraction * scale) + rounding) >> frac_bits);
+	if(scaled >= scale){
+		//rounded up to the next integer (e.g. 0.999 -> 1.00)
+		integer++;
+		scaled -= scale;
+	}
+
+	//no "-0.00"
+	if((value < 0) && ((integer != 0) || (scaled != 0))){
+		buf[len++] = '-';
+	}
+	len += LIB_FormatDecimal(&buf[len], integer);
+
+	if(decimals != 0){
+		buf[len++] = '.';
+		//zero padded decimals, from the least significant
+		for(uint8_t i = decimals; i > 0; i--){
+			uint32_t quotient = LIB_FormatDiv10(scaled);
+			buf[len + i - 1] = (uint8_t)('0' + (scaled - (quotient * 10)));
+			scaled = quotient;
+		}
+		len += decimals;
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+/**
+ * @func LIB_PrintString
+ * @brief Pushes a null terminated string to a sink.
+ *
+ * @param LIB_FormatSink_t sink [in]
+ * @param const uint8_t* str [in]
+ * @return void .
+ */
+void LIB_PrintString(LIB_FormatSink_t sink, const uint8_t* str){
+	while(*str != '\0'){
+		sink(*str);
+		str++;
+	}
+}
+
+/**
+ * @func LIB_PrintUint32
+ * @brief LIB_FormatUint32() into a sink.
+ */
+void LIB_PrintUint32(LIB_FormatSink_t sink, uint32_t value){
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	LIB_FormatUint32(buf, value);
+	LIB_PrintString(sink, buf);
+}
+
+/**
+ * @func LIB_PrintInt32
+ * @brief LIB_FormatInt32() into a sink.
+ */
+void LIB_PrintInt32(LIB_FormatSink_t sink, int32_t value){
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	LIB_FormatInt32(buf, value);
+	LIB_PrintString(sink, buf);
+}
+
+/**
+ * @func LIB_PrintHex32
+ * @brief LIB_FormatHex32() into a sink.
+ */
+void LIB_PrintHex32(LIB_FormatSink_t sink, uint32_t value, uint8_t min_digits){
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	LIB_FormatHex32(buf, value, min_digits);
+	LIB_PrintString(sink, buf);
+}
+
+/**
+ * @func LIB_PrintFixed
+ * @brief LIB_FormatFixed() into a sink.
+ */
+void LIB_PrintFixed(LIB_FormatSink_t sink, int32_t value, uint8_t frac_bits, uint8_t decimals){
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	LIB_FormatFixed(buf, value, frac_bits, decimals);
+	LIB_PrintString(sink, buf);
+}
+
+/**
+ * @func LIB_FormatDebugSink
+ * @brief Sink writing to the debugging USART (USART_DEBUGGING_CHANNEL in common_lib.h).
+ *
+ * @param uint8_t ch [in]
+ * @return void .
+ */
+void LIB_FormatDebugSink(uint8_t ch){
+	USART_SendChar(USART_DEBUGGING_CHANNEL, ch);
+}
+
+
+/******************************* ISR *******************************/
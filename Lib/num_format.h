@@ -0,0 +1,140 @@
+/**
+ * @file num_format.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Allocation-free integer, hex and fixed-point to text conversion for LCD/USART output.
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Replaces itoa()/printf() which pull newlib's formatter and _sbrk() and use a hardware divide per digit.
+ * 		[♥] Decimal conversion uses reciprocal multiplications (UMULL) and a two-digit table, no division at all.
+ *
+ * # Buffers or sinks ?
+ * 		[♥] LIB_FormatXXX()	-> writes a null terminated string into a caller buffer of at least LIB_FORMAT_BUFFER_SIZE
+ * 								bytes and returns its length (without the terminator).
+ * 		[♥] LIB_PrintXXX()	-> formats on the stack then pushes each character to a sink callback,
+ * 								e.g. LIB_PrintInt32(LCD_SinkChar, x) or LIB_PrintInt32(LIB_FormatDebugSink, x).
+ *
+ * # Fixed-point ?
+ * 		[♥] A Q-format value with frac_bits fraction bits (Q15 -> 15, Q16.16 -> 16) is printed with the chosen number
+ * 			of decimals, rounded to nearest (half away from zero).
+ */
+#ifndef NUM_FORMAT_H_
+#define NUM_FORMAT_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include <stdint.h>
+
+/*******************************  Macros *******************************/
+/*Enough for any output of this module: sign + 10 integer digits + '.' + 9 decimals + '\0'*/
+#define LIB_FORMAT_BUFFER_SIZE		(24)
+
+#define LIB_FORMAT_MAX_DECIMALS		(9)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+
+
+/******************************* Types *******************************/
+/**
+ * @brief Character sink, receives the formatted text one character at a time (e.g. LCD_SinkChar).
+ */
+typedef void (*LIB_FormatSink_t)(uint8_t ch);
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func LIB_FormatUint32
+ * @brief Converts an unsigned number to decimal text.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param uint32_t value [in]
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatUint32(uint8_t* buf, uint32_t value);
+
+/**
+ * @func LIB_FormatInt32
+ * @brief Converts a signed number to decimal text, the whole range [-2^31 : 2^31 - 1] is valid.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param int32_t value [in]
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatInt32(uint8_t* buf, int32_t value);
+
+/**
+ * @func LIB_FormatHex32
+ * @brief Converts a number to upper case hex text (no "0x" prefix), zero padded to min_digits.
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param uint32_t value [in]
+ * @param uint8_t min_digits [in]	[1 - 8], e.g. 2 for a byte, 8 for a register
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatHex32(uint8_t* buf, uint32_t value, uint8_t min_digits);
+
+/**
+ * @func LIB_FormatFixed
+ * @brief Converts a signed Q-format number to decimal text with the chosen number of decimals (rounded).
+ *
+ * @param uint8_t* buf [out]		at least LIB_FORMAT_BUFFER_SIZE bytes
+ * @param int32_t value [in]		fixed-point raw value
+ * @param uint8_t frac_bits [in]	[0 - 31] number of fraction bits
+ * @param uint8_t decimals [in]		[0 - LIB_FORMAT_MAX_DECIMALS], clamped
+ * @return uint8_t					string length
+ */
+uint8_t LIB_FormatFixed(uint8_t* buf, int32_t value, uint8_t frac_bits, uint8_t decimals);
+
+/**
+ * @func LIB_PrintString
+ * @brief Pushes a null terminated string to a sink.
+ *
+ * @param LIB_FormatSink_t sink [in]
+ * @param const uint8_t* str [in]
+ * @return void .
+ */
+void LIB_PrintString(LIB_FormatSink_t sink, const uint8_t* str);
+
+/**
+ * @func LIB_PrintUint32
+ * @brief LIB_FormatUint32() into a sink.
+ */
+void LIB_PrintUint32(LIB_FormatSink_t sink, uint32_t value);
+
+/**
+ * @func LIB_PrintInt32
+ * @brief LIB_FormatInt32() into a sink.
+ */
+void LIB_PrintInt32(LIB_FormatSink_t sink, int32_t value);
+
+/**
+ * @func LIB_PrintHex32
+ * @brief LIB_FormatHex32() into a sink.
+ */
+void LIB_PrintHex32(LIB_FormatSink_t sink, uint32_t value, uint8_t min_digits);
+
+/**
+ * @func LIB_PrintFixed
+ * @brief LIB_FormatFixed() into a sink.
+ */
+void LIB_PrintFixed(LIB_FormatSink_t sink, int32_t value, uint8_t frac_bits, uint8_t decimals);
+
+/**
+ * @func LIB_FormatDebugSink
+ * @brief Sink writing to the debugging USART (USART_DEBUGGING_CHANNEL in common_lib.h).
+ *
+ * @param uint8_t ch [in]
+ * @return void .
+ */
+void LIB_FormatDebugSink(uint8_t ch);
+
+
+#endif /* NUM_FORMAT_H_ */
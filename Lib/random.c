@@ -0,0 +1,117 @@
+/**
+ * @file random.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Non-blocking random bytes (nonces, keys, backoff jitter) served from the RNG entropy pool.
+ */
+/******************************* Includes *******************************/
+#include "random.h"
+
+/*******************************  Macros *******************************/
+#if defined(__arm__)
+#define LIB_RANDOM_HARDWARE_PATH	1
+#else
+#define LIB_RANDOM_HARDWARE_PATH	0
+#endif
+
+#if LIB_RANDOM_HARDWARE_PATH == 1
+#include "rng.h"
+#endif
+
+/*Words copied out of the pool at once*/
+#define LIB_RANDOM_CHUNK_WORDS		(8)
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+#if LIB_RANDOM_HARDWARE_PATH == 0
+static uint32_t g_LIB_RANDOM_STATE = LIB_RANDOM_HOST_SEED;
+#endif
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func LIB_RandomWords
+ * @brief Takes up to count random words (RNG pool or host generator).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint32_t LIB_RandomWords(uint32_t* words, uint32_t count){
+
+#if LIB_RANDOM_HARDWARE_PATH == 1
+	return RNG_Read(words, count);
+#else
+	//xorshift32 (Marsaglia)
+	for(uint32_t i = 0; i < count; i++){
+		g_LIB_RANDOM_STATE ^= g_LIB_RANDOM_STATE << 13;
+		g_LIB_RANDOM_STATE ^= g_LIB_RANDOM_STATE >> 17;
+		g_LIB_RANDOM_STATE ^= g_LIB_RANDOM_STATE << 5;
+		words[i] = g_LIB_RANDOM_STATE;
+	}
+	return count;
+#endif
+}
+
+/**
+ * @func LIB_RandomInit
+ * @brief Starts the RNG (host build: restarts the deterministic sequence).
+ *
+ * @return void
+ */
+void LIB_RandomInit(void){
+#if LIB_RANDOM_HARDWARE_PATH == 1
+	RNG_Init();
+#else
+	g_LIB_RANDOM_STATE = LIB_RANDOM_HOST_SEED;
+#endif
+}
+
+/**
+ * @func LIB_RandomFill
+ * @brief Fills a buffer with random bytes from the pool, doesn't wait.
+ *
+ * @param void* buf [out]
+ * @param uint32_t len [in]		number of bytes
+ * @return uint32_t				number of bytes written
+ */
+uint32_t LIB_RandomFill(void* buf, uint32_t len){
+
+	uint8_t* p = (uint8_t*)buf;
+	uint32_t words[LIB_RANDOM_CHUNK_WORDS];
+	uint32_t filled = 0;
+
+	while(filled < len){
+		uint32_t wanted = (len - filled + 3) >> 2;
+		uint32_t request = (wanted < LIB_RANDOM_CHUNK_WORDS) ? wanted : LIB_RANDOM_CHUNK_WORDS;
+		uint32_t got = LIB_RandomWords(words, request);
+
+		for(uint32_t i = 0; (i < got) && (filled < len); i++){
+			for(uint8_t b = 0; (b < 4) && (filled < len); b++){
+				p[filled++] = (uint8_t)(words[i] >> (b * 8));
+			}
+		}
+		//pool ran short
+		if(got < request){
+			break;
+		}
+	}
+
+	return filled;
+}
+
+/**
+ * @func LIB_RandomAvailable
+ * @brief Returns the number of random bytes LIB_RandomFill() can provide right now.
+ *
+ * @return uint32_t		(host build: UINT32_MAX)
+ */
+uint32_t LIB_RandomAvailable(void){
+#if LIB_RANDOM_HARDWARE_PATH == 1
+	return RNG_Available() * 4;
+#else
+	return UINT32_MAX;
+#endif
+}
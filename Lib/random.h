@@ -0,0 +1,71 @@
+/**
+ * @file random.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Non-blocking random bytes (nonces, keys, backoff jitter) served from the RNG entropy pool.
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] The hardware RNG fills its pool by interrupt in the background, LIB_RandomFill() only copies words out of
+ * 			it, so it never waits for the 40 RNG clock cycles of a new number.
+ * 		[♥] It returns the number of bytes written, less than len when the pool runs short (retry later or check
+ * 			LIB_RandomAvailable() first), each pool word is used once, the unused bytes of the last word are dropped.
+ *
+ * # Host builds ?
+ * 		[♥] Without the RNG (not built for ARM) a deterministic xorshift32 generator seeded with LIB_RANDOM_HOST_SEED
+ * 			is used instead, LIB_RandomInit() restarts the sequence, so tests get reproducible "random" data.
+ * 			It is NOT suitable for anything but testing.
+ */
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include <stdint.h>
+
+/*******************************  Macros *******************************/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Seed of the host build generator (non-zero)*/
+#define LIB_RANDOM_HOST_SEED		(0x2545F491UL)
+
+
+/******************************* Types *******************************/
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func LIB_RandomInit
+ * @brief Starts the RNG (host build: restarts the deterministic sequence).
+ *
+ * @return void
+ */
+void LIB_RandomInit(void);
+
+/**
+ * @func LIB_RandomFill
+ * @brief Fills a buffer with random bytes from the pool, doesn't wait.
+ *
+ * @param void* buf [out]
+ * @param uint32_t len [in]		number of bytes
+ * @return uint32_t				number of bytes written
+ */
+uint32_t LIB_RandomFill(void* buf, uint32_t len);
+
+/**
+ * @func LIB_RandomAvailable
+ * @brief Returns the number of random bytes LIB_RandomFill() can provide right now.
+ *
+ * @return uint32_t		(host build: UINT32_MAX)
+ */
+uint32_t LIB_RandomAvailable(void);
+
+
+#endif /* RANDOM_H_ */
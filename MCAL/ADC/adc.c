@@ -27,6 +27,22 @@
  * 		5. Use ADC_Start() to start conversion
  * 		6. Use ADC_Read() to read the output value
  *
+ * # Analog Watchdog ?
+ * 		[♥] Instead of polling ADC_Read() and comparing each sample against limits in C, the hardware compares
+ * 			every conversion against HTR/LTR at full sample rate and raises an interrupt only on a violation.
+ * 		1. Make a {ADC_WatchdogConfig_t} variable, choose single channel or all channels, thresholds and a callback.
+ * 		2. Call ADC_ConfigureWatchdog() after ADC_Init().
+ * 		3. The callback is invoked from ADC_IRQHandler() with the violating ADC instance.
+ * 		4. In ADC_AWD_ONE_SHOT trigger mode, re-arm the watchdog using ADC_RearmWatchdog() once the violation is handled.
+ *
+ * # Internal Channels (Temperature sensor, VREFINT, VBAT) ?
+ * 		[♥] They're ADC1 only channels (16, 17, 18) with no GPIO pins.
+ * 		1. Call ADC_EnableInternalChannel() for each needed channel, then wait the sensor start-up time (~10 us).
+ * 		2. Configure them as any other channel using ADC_ConfigureChannel() (e.g. in a scan sequence),
+ * 			with a sampling time of at least 10 us (ADC_SAMPT_480CYCLES is safe for ADCCLK <= 36MHz).
+ * 		3. Pass the raw (12-bit right aligned) samples to ADC_ComputeVdda_mV(), ADC_ComputeVbat_mV(), ADC_ComputeTemperature_cdegC()
+ * 			[♥] Integer math only, VDDA is measured from VREFINT and used to compensate the other readings ratiometrically.
+ *
  * # Adding more Features ?
  * 		[♥] Adding more features means that there're more configurations to be considered.
  * 		[♥] New configurations options need to be added for each new configuration parameter in adc.h @macros
@@ -41,6 +57,13 @@
 #include "adc.h"
 
 /*******************************  Macros *******************************/
+#define ADC_INSTANCES_NUM		(3)
+
+/*ADC1, ADC2 and ADC3 global interrupts share one NVIC line*/
+#define ADC_IRQ_NUM				(18)
+
+#define ADC_AWD_THRESHOLD_MASK	(0x0FFFUL)
+#define ADC_CR1_AWDCH_MASK		(0x1FUL)
 
 
 /******************************* Configurations (if any) *******************************/
@@ -51,6 +74,11 @@
 static uint8_t g_ADC_TAKEN_CHANNELS[ADC_TOTAL_CHANNELS]= {0};
 static uint8_t g_ADC_TAKEN_CHANNELS_INDEX = 0;
 
+//maps each ADC instance to its analog watchdog callback and trigger mode (ISR-shared).
+static ADC_t* const g_ADC_INSTANCES[ADC_INSTANCES_NUM] = {ADC1, ADC2, ADC3};
+static volatile ADC_WatchdogCallback_t g_ADC_WATCHDOG_CALLBACKS[ADC_INSTANCES_NUM] = {0};
+static volatile uint8_t g_ADC_WATCHDOG_TRIGGER[ADC_INSTANCES_NUM] = {0};
+
 /******************************* Functions Implementation *******************************/
 
 /**
@@ -92,6 +120,21 @@ static void ADC_ConfigureGPIOPins(){
 
 
 }
+/**
+ * @func ADC_GetInstanceIndex
+ * @brief Maps an ADC instance base address to its index in g_ADC_INSTANCES.
+ *
+ * @return uint8_t	index [0-2], or ADC_INSTANCES_NUM if the address is not an ADC instance.
+ *
+ */
+static uint8_t ADC_GetInstanceIndex(ADC_t* instance){
+	uint8_t index = 0;
+	while((index < ADC_INSTANCES_NUM) && (g_ADC_INSTANCES[index] != instance)){
+		index++;
+	}
+	return index;
+}
+
 /**
  * @func ADC_Init
  * @brief Initializes the provided ADC peripheral.
@@ -169,7 +212,10 @@ void ADC_Init(ADC_Handle_t* adc){
 void ADC_ConfigureChannel(ADC_Handle_t* adc, ADC_ChannelConfig_t* channel){
 	/*This is needed for the GPIO configuration step as the ADC_ConfigureGPIOPins() function
 	 *configures all the used gpio pins by checking the taken channels.*/
-	g_ADC_TAKEN_CHANNELS[g_ADC_TAKEN_CHANNELS_INDEX++] = channel->channel_num;
+	//internal channels (16, 17, 18) have no GPIO pins
+	if(channel->channel_num <= ADC_IN15_12){
+		g_ADC_TAKEN_CHANNELS[g_ADC_TAKEN_CHANNELS_INDEX++] = channel->channel_num;
+	}
 
 
 	/*Configure used channels' related gpio pins*/
@@ -212,11 +258,12 @@ void ADC_ConfigureChannel(ADC_Handle_t* adc, ADC_ChannelConfig_t* channel){
 	 * based on its value*/
 	uint8_t ch_samp_time = channel->sampling_time;
 
-	if(ch_samp_time > 9){
-		adc->instace->SMPR1 |= (channel->sampling_time << (((channel->channel_num)-10)*3));
+	//SMPR1 holds channels [10-18], SMPR2 holds channels [0-9]
+	if(channel->channel_num > 9){
+		adc->instace->SMPR1 |= (ch_samp_time << (((channel->channel_num)-10)*3));
 	}else{
 		//from 0 to 9
-		adc->instace->SMPR2 |= (channel->sampling_time << (((channel->channel_num))*3));
+		adc->instace->SMPR2 |= (ch_samp_time << (((channel->channel_num))*3));
 	}
 
 
@@ -258,6 +305,255 @@ uint16_t ADC_Read(ADC_Handle_t* adc){
 }
 
 
+
+/**
+ * @func ADC_ConfigureWatchdog
+ * @brief Configures and enables the analog watchdog on regular channels with its interrupt.
+ *
+ * @param	ADC_Handle_t* adc[IN]					-> specifies which ADC peripheral to guard.
+ * @param	ADC_WatchdogConfig_t* watchdog[IN]		-> watchdog mode, guarded channel, thresholds and callback.
+ *
+ * Important Registers:
+ * 		#ADC_HTR, ADC_LTR:
+ * 			♦ HT[11:0], LT[11:0]	-> higher/lower thresholds
+ * 		#ADC_CR1:
+ * 			♦ AWDCH[4:0]	-> guarded channel in single channel mode
+ * 			♦ AWDSGL[9]		-> 0: all channels	,	1: single channel
+ * 			♦ AWDIE[6]		-> analog watchdog interrupt enable
+ * 			♦ AWDEN[23]		-> analog watchdog enable on regular channels
+ *
+ * @return void
+ *
+ */
+void ADC_ConfigureWatchdog(ADC_Handle_t* adc, ADC_WatchdogConfig_t* watchdog){
+
+	uint8_t index = ADC_GetInstanceIndex(adc->instace);
+	if(index >= ADC_INSTANCES_NUM){
+		return;
+	}
+
+	/*Stop watching while the window is being changed so no false violation is reported*/
+	CLEAR_BIT(adc->instace->CR1, ADC_CR1_AWDEN);
+	CLEAR_BIT(adc->instace->CR1, ADC_CR1_AWDIE);
+
+	g_ADC_WATCHDOG_CALLBACKS[index] = watchdog->callback;
+	g_ADC_WATCHDOG_TRIGGER[index] = watchdog->trigger;
+
+	//thresholds window
+	adc->instace->HTR = (watchdog->high_threshold & ADC_AWD_THRESHOLD_MASK);
+	adc->instace->LTR = (watchdog->low_threshold & ADC_AWD_THRESHOLD_MASK);
+
+	//single channel || all channels
+	adc->instace->CR1 &= ~(ADC_CR1_AWDCH_MASK << ADC_CR1_AWDCH);
+	if(watchdog->mode == ADC_AWD_SINGLE_CHANNEL){
+		adc->instace->CR1 |= ((watchdog->channel_num & ADC_CR1_AWDCH_MASK) << ADC_CR1_AWDCH);
+		SET_BIT(adc->instace->CR1, ADC_CR1_AWDSGL);
+	}else{
+		CLEAR_BIT(adc->instace->CR1, ADC_CR1_AWDSGL);
+	}
+
+	//clear any stale flag, then enable the interrupt and the watchdog on regular channels
+	CLEAR_BIT(adc->instace->SR, ADC_SR_AWD);
+	SET_BIT(adc->instace->CR1, ADC_CR1_AWDIE);
+	SET_BIT(adc->instace->CR1, ADC_CR1_AWDEN);
+
+	//enable ADC global interrupt line in the NVIC
+	NVIC_EnableIRQ(ADC_IRQ_NUM);
+}
+
+
+/**
+ * @func ADC_RearmWatchdog
+ * @brief Clears a pending watchdog flag and re-enables its interrupt (needed after a violation in ADC_AWD_ONE_SHOT mode).
+ *
+ * @param	ADC_Handle_t* adc[IN]	-> specifies which ADC peripheral.
+ * @return void
+ *
+ */
+void ADC_RearmWatchdog(ADC_Handle_t* adc){
+	CLEAR_BIT(adc->instace->SR, ADC_SR_AWD);
+	SET_BIT(adc->instace->CR1, ADC_CR1_AWDIE);
+}
+
+
+/**
+ * @func ADC_DisableWatchdog
+ * @brief Disables the analog watchdog and its interrupt.
+ *
+ * @param	ADC_Handle_t* adc[IN]	-> specifies which ADC peripheral.
+ * @return void
+ *
+ */
+void ADC_DisableWatchdog(ADC_Handle_t* adc){
+	CLEAR_BIT(adc->instace->CR1, ADC_CR1_AWDEN);
+	CLEAR_BIT(adc->instace->CR1, ADC_CR1_AWDIE);
+	CLEAR_BIT(adc->instace->SR, ADC_SR_AWD);
+}
+
+
+/**
+ * @func ADC_EnableInternalChannel
+ * @brief Connects an internal channel (temperature sensor / VREFINT / VBAT) to ADC1.
+ *
+ * @param	uint8_t channel_num[IN]	-> ADC_IN16_TEMP_SENSOR, ADC_IN17_VREFINT or ADC_IN18_VBAT
+ *
+ * Important Register:
+ * 		#ADC_COMMON_CCR:
+ * 			♦ TSVREFE[23]	-> temperature sensor and VREFINT enable
+ * 			♦ VBATE[22]		-> VBAT enable
+ * @note The temperature sensor and VREFINT share the same enable bit.
+ * @note Keep VBATE disabled when not measuring as the bridge drains the battery.
+ * @return void
+ *
+ */
+void ADC_EnableInternalChannel(uint8_t channel_num){
+	switch(channel_num){
+	case ADC_IN16_TEMP_SENSOR:
+	case ADC_IN17_VREFINT:
+		SET_BIT(ADC_COMMON->CCR, ADC_CCR_TSVREF);
+		break;
+	case ADC_IN18_VBAT:
+		SET_BIT(ADC_COMMON->CCR, ADC_CCR_VBATE);
+		break;
+	default:
+		//not an internal channel
+		break;
+	}
+}
+
+
+/**
+ * @func ADC_DisableInternalChannel
+ * @brief Disconnects an internal channel (temperature sensor / VREFINT / VBAT) from ADC1.
+ *
+ * @param	uint8_t channel_num[IN]	-> ADC_IN16_TEMP_SENSOR, ADC_IN17_VREFINT or ADC_IN18_VBAT
+ * @return void
+ *
+ */
+void ADC_DisableInternalChannel(uint8_t channel_num){
+	switch(channel_num){
+	case ADC_IN16_TEMP_SENSOR:
+	case ADC_IN17_VREFINT:
+		CLEAR_BIT(ADC_COMMON->CCR, ADC_CCR_TSVREF);
+		break;
+	case ADC_IN18_VBAT:
+		CLEAR_BIT(ADC_COMMON->CCR, ADC_CCR_VBATE);
+		break;
+	default:
+		//not an internal channel
+		break;
+	}
+}
+
+
+/**
+ * @func ADC_ComputeVdda_mV
+ * @brief Computes the actual analog supply VDDA from a VREFINT reading and its factory calibration.
+ * 			VDDA = 3300 mV * VREFINT_CAL / vrefint_raw
+ *
+ * @param	uint16_t vrefint_raw[IN]	-> 12-bit right aligned VREFINT sample
+ * @return uint16_t	VDDA in millivolts (0 if vrefint_raw is 0)
+ *
+ */
+uint16_t ADC_ComputeVdda_mV(uint16_t vrefint_raw){
+	if(vrefint_raw == 0){
+		return 0;
+	}
+	uint32_t vrefint_cal = *ADC_VREFINT_CAL_ADDR;
+	return (uint16_t)(((ADC_CAL_VDDA_mV * vrefint_cal) + (vrefint_raw / 2)) / vrefint_raw);
+}
+
+
+/**
+ * @func ADC_ComputeMillivolts
+ * @brief Converts a 12-bit right aligned sample of any channel into millivolts using the measured VDDA.
+ *
+ * @param	uint16_t raw[IN]		-> 12-bit right aligned sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV() (or the nominal value)
+ * @return uint16_t	input voltage in millivolts
+ *
+ */
+uint16_t ADC_ComputeMillivolts(uint16_t raw, uint16_t vdda_mv){
+	return (uint16_t)((((uint32_t)raw * vdda_mv) + (ADC_FULL_SCALE_12_BIT / 2)) / ADC_FULL_SCALE_12_BIT);
+}
+
+
+/**
+ * @func ADC_ComputeVbat_mV
+ * @brief Converts a VBAT channel sample into the battery voltage, compensating the internal /2 bridge.
+ *
+ * @param	uint16_t vbat_raw[IN]	-> 12-bit right aligned VBAT sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV()
+ * @return uint16_t	VBAT in millivolts
+ *
+ */
+uint16_t ADC_ComputeVbat_mV(uint16_t vbat_raw, uint16_t vdda_mv){
+	return (uint16_t)((((uint32_t)vbat_raw * vdda_mv * ADC_VBAT_BRIDGE_RATIO) + (ADC_FULL_SCALE_12_BIT / 2)) / ADC_FULL_SCALE_12_BIT);
+}
+
+
+/**
+ * @func ADC_ComputeTemperature_cdegC
+ * @brief Converts a temperature sensor sample into hundredths of a degree Celsius using the two-point factory calibration.
+ * 			The sample is first rescaled to the calibration supply (3.3V) using the measured VDDA, then interpolated
+ * 			between TS_CAL1 (30 C) and TS_CAL2 (110 C).
+ *
+ * @param	uint16_t ts_raw[IN]		-> 12-bit right aligned temperature sensor sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV()
+ * @return int32_t	temperature in centi-degrees Celsius (e.g. 2534 -> 25.34 C)
+ *
+ */
+int32_t ADC_ComputeTemperature_cdegC(uint16_t ts_raw, uint16_t vdda_mv){
+
+	int32_t ts_cal1 = *ADC_TS_CAL1_ADDR;
+	int32_t ts_cal2 = *ADC_TS_CAL2_ADDR;
+
+	/*	T = 30 + (ts_raw * VDDA / 3300 - CAL1) * (110 - 30) / (CAL2 - CAL1)
+	 *	Both sides are kept multiplied by 3300 so no precision is lost in the VDDA rescaling, and
+	 *	(11000 - 3000) / 3300 is reduced to 80 / 33 so the numerator fits 32 bits (|diff| < 2^24).*/
+	int32_t diff = ((int32_t)ts_raw * vdda_mv) - (ts_cal1 * (int32_t)ADC_CAL_VDDA_mV);
+	int32_t numerator = diff * ((ADC_TS_CAL2_cdegC - ADC_TS_CAL1_cdegC) / 100);
+	int32_t denominator = (ts_cal2 - ts_cal1) * (int32_t)(ADC_CAL_VDDA_mV / 100);
+
+	if(denominator <= 0){
+		//blank/corrupted calibration
+		return 0;
+	}
+
+	//round to nearest, for either sign
+	if(numerator >= 0){
+		numerator += denominator / 2;
+	}else{
+		numerator -= denominator / 2;
+	}
+
+	return ADC_TS_CAL1_cdegC + (numerator / denominator);
+}
+
 /******************************* ISR *******************************/
+/**
+ * @func ADC_IRQHandler
+ * @brief Shared ADC1/ADC2/ADC3 interrupt, overrides the weak alias in the startup file.
+ * 		  Dispatches analog watchdog violations to the registered callbacks.
+ */
+void ADC_IRQHandler(void){
+
+	for(uint8_t index = 0; index < ADC_INSTANCES_NUM; index++){
+		ADC_t* instance = g_ADC_INSTANCES[index];
+
+		if(GET_BIT(instance->SR, ADC_SR_AWD) && GET_BIT(instance->CR1, ADC_CR1_AWDIE)){
+			//rc_w0 flag: cleared by writing 0
+			CLEAR_BIT(instance->SR, ADC_SR_AWD);
+
+			if(g_ADC_WATCHDOG_TRIGGER[index] == ADC_AWD_ONE_SHOT){
+				CLEAR_BIT(instance->CR1, ADC_CR1_AWDIE);
+			}
+
+			if(g_ADC_WATCHDOG_CALLBACKS[index] != 0){
+				g_ADC_WATCHDOG_CALLBACKS[index](instance);
+			}
+		}
+	}
+}
 
 
@@ -28,6 +28,22 @@
  * 		5. Use ADC_Start() to start conversion
  * 		6. Use ADC_Read() to read the output value
  *
+ * # Analog Watchdog ?
+ * 		[♥] Instead of polling ADC_Read() and comparing each sample against limits in C, the hardware compares
+ * 			every conversion against HTR/LTR at full sample rate and raises an interrupt only on a violation.
+ * 		1. Make a {ADC_WatchdogConfig_t} variable, choose single channel or all channels, thresholds and a callback.
+ * 		2. Call ADC_ConfigureWatchdog() after ADC_Init().
+ * 		3. The callback is invoked from ADC_IRQHandler() with the violating ADC instance.
+ * 		4. In ADC_AWD_ONE_SHOT trigger mode, re-arm the watchdog using ADC_RearmWatchdog() once the violation is handled.
+ *
+ * # Internal Channels (Temperature sensor, VREFINT, VBAT) ?
+ * 		[♥] They're ADC1 only channels (16, 17, 18) with no GPIO pins.
+ * 		1. Call ADC_EnableInternalChannel() for each needed channel, then wait the sensor start-up time (~10 us).
+ * 		2. Configure them as any other channel using ADC_ConfigureChannel() (e.g. in a scan sequence),
+ * 			with a sampling time of at least 10 us (ADC_SAMPT_480CYCLES is safe for ADCCLK <= 36MHz).
+ * 		3. Pass the raw (12-bit right aligned) samples to ADC_ComputeVdda_mV(), ADC_ComputeVbat_mV(), ADC_ComputeTemperature_cdegC()
+ * 			[♥] Integer math only, VDDA is measured from VREFINT and used to compensate the other readings ratiometrically.
+ *
  * # Adding more Features ?
  * 		[♥] Adding more features means that there're more configurations to be considered.
  * 		[♥] New configurations options need to be added for each new configuration parameter in adc.h @macros
@@ -47,6 +63,7 @@
 #include "common_lib.h"
 #include "bit_math.h"
 #include "memory_map.h"
+#include "nvic.h"
 #include "stdint.h"
 
 /******************************* Types *******************************/
@@ -115,6 +132,24 @@ typedef struct{
 	ADC_Config_t configs;
 }ADC_Handle_t;
 
+/**
+ * @brief Analog watchdog callback, invoked from ADC_IRQHandler() with the ADC instance that detected the violation.
+ */
+typedef void (*ADC_WatchdogCallback_t)(ADC_t* instance);
+
+/**
+ * @enum ADC_WatchdogConfig_t
+ * @brief Grouping the analog watchdog configurations of an ADC instance.
+ */
+typedef struct{
+	uint8_t mode;				/*guard a single channel or all regular channels out of @defgroup ADC_AWD_Mode_Options*/
+	uint8_t channel_num;		/*guarded channel in ADC_AWD_SINGLE_CHANNEL mode, out of @defgroup ADC_Channels_Options*/
+	uint8_t trigger;			/*choose out of @defgroup ADC_AWD_Trigger_Options*/
+	uint16_t high_threshold;	/*12-bit higher threshold, compared against the raw (right aligned) conversion*/
+	uint16_t low_threshold;		/*12-bit lower threshold, compared against the raw (right aligned) conversion*/
+	ADC_WatchdogCallback_t callback;	/*invoked on every out-of-window conversion*/
+}ADC_WatchdogConfig_t;
+
 /*******************************  Macros *******************************/
 /** @defgroup ADC_Clock_Prescaler_Options
   *
@@ -172,6 +207,10 @@ typedef struct{
 #define ADC_IN13_123		(13)//ADC_PIN3
 #define ADC_IN14_12			(14)//ADC_PIN4
 #define ADC_IN15_12			(15)//ADC_PIN5
+/*Internal (ADC1 only)*/
+#define ADC_IN16_TEMP_SENSOR	(16)
+#define ADC_IN17_VREFINT		(17)
+#define ADC_IN18_VBAT			(18)
 
 
 /** @defgroup ADC_RANKS_Options
@@ -207,6 +246,38 @@ typedef struct{
 #define ADC_SAMPT_144CYCLES		(6)
 #define ADC_SAMPT_480CYCLES		(7)
 
+/** @defgroup ADC_AWD_Mode_Options
+  *
+  */
+#define ADC_AWD_SINGLE_CHANNEL		(0)
+#define ADC_AWD_ALL_CHANNELS		(1)
+
+/** @defgroup ADC_AWD_Trigger_Options
+  *	ADC_AWD_ONE_SHOT	-> the interrupt is disabled after the first violation till ADC_RearmWatchdog() is called,
+  *						   so a signal that stays out of the window doesn't flood the CPU at the sample rate.
+  *	ADC_AWD_CONTINUOUS	-> the callback is invoked for every violating conversion.
+  */
+#define ADC_AWD_ONE_SHOT			(0)
+#define ADC_AWD_CONTINUOUS			(1)
+
+
+/** @defgroup ADC_Factory_Calibration
+  *	Values measured in production at VDDA = 3.3V (12-bit raw), located in the system memory (datasheet: "Temperature
+  *	sensor calibration values" and "Internal reference voltage calibration values").
+  */
+#define ADC_TS_CAL1_ADDR		((const volatile uint16_t*)0x1FFF7A2CUL)	/*temperature sensor raw at 30 C*/
+#define ADC_TS_CAL2_ADDR		((const volatile uint16_t*)0x1FFF7A2EUL)	/*temperature sensor raw at 110 C*/
+#define ADC_VREFINT_CAL_ADDR	((const volatile uint16_t*)0x1FFF7A2AUL)	/*VREFINT raw at 30 C*/
+
+#define ADC_CAL_VDDA_mV			(3300UL)
+#define ADC_TS_CAL1_cdegC		(3000L)
+#define ADC_TS_CAL2_cdegC		(11000L)
+
+/*VBAT is internally divided by 2 before reaching the ADC input*/
+#define ADC_VBAT_BRIDGE_RATIO	(2UL)
+
+#define ADC_FULL_SCALE_12_BIT	(4095UL)
+
 
 /******************************* globals *******************************/
 
@@ -295,4 +366,127 @@ void ADC_Start(ADC_Handle_t* adc);
 uint16_t ADC_Read(ADC_Handle_t* adc);
 
 
+/**
+ * @func ADC_ConfigureWatchdog
+ * @brief Configures and enables the analog watchdog on regular channels with its interrupt.
+ *
+ * @param	ADC_Handle_t* adc[IN]					-> specifies which ADC peripheral to guard.
+ * @param	ADC_WatchdogConfig_t* watchdog[IN]		-> watchdog mode, guarded channel, thresholds and callback.
+ *
+ * Important Registers:
+ * 		#ADC_HTR, ADC_LTR:
+ * 			♦ HT[11:0], LT[11:0]	-> higher/lower thresholds
+ * 		#ADC_CR1:
+ * 			♦ AWDCH[4:0]	-> guarded channel in single channel mode
+ * 			♦ AWDSGL[9]		-> 0: all channels	,	1: single channel
+ * 			♦ AWDIE[6]		-> analog watchdog interrupt enable
+ * 			♦ AWDEN[23]		-> analog watchdog enable on regular channels
+ *
+ * @return void
+ *
+ */
+void ADC_ConfigureWatchdog(ADC_Handle_t* adc, ADC_WatchdogConfig_t* watchdog);
+
+
+/**
+ * @func ADC_RearmWatchdog
+ * @brief Clears a pending watchdog flag and re-enables its interrupt (needed after a violation in ADC_AWD_ONE_SHOT mode).
+ *
+ * @param	ADC_Handle_t* adc[IN]	-> specifies which ADC peripheral.
+ * @return void
+ *
+ */
+void ADC_RearmWatchdog(ADC_Handle_t* adc);
+
+
+/**
+ * @func ADC_DisableWatchdog
+ * @brief Disables the analog watchdog and its interrupt.
+ *
+ * @param	ADC_Handle_t* adc[IN]	-> specifies which ADC peripheral.
+ * @return void
+ *
+ */
+void ADC_DisableWatchdog(ADC_Handle_t* adc);
+
+
+/**
+ * @func ADC_EnableInternalChannel
+ * @brief Connects an internal channel (temperature sensor / VREFINT / VBAT) to ADC1.
+ *
+ * @param	uint8_t channel_num[IN]	-> ADC_IN16_TEMP_SENSOR, ADC_IN17_VREFINT or ADC_IN18_VBAT
+ *
+ * Important Register:
+ * 		#ADC_COMMON_CCR:
+ * 			♦ TSVREFE[23]	-> temperature sensor and VREFINT enable
+ * 			♦ VBATE[22]		-> VBAT enable
+ * @note The temperature sensor and VREFINT share the same enable bit.
+ * @note Keep VBATE disabled when not measuring as the bridge drains the battery.
+ * @return void
+ *
+ */
+void ADC_EnableInternalChannel(uint8_t channel_num);
+
+
+/**
+ * @func ADC_DisableInternalChannel
+ * @brief Disconnects an internal channel (temperature sensor / VREFINT / VBAT) from ADC1.
+ *
+ * @param	uint8_t channel_num[IN]	-> ADC_IN16_TEMP_SENSOR, ADC_IN17_VREFINT or ADC_IN18_VBAT
+ * @return void
+ *
+ */
+void ADC_DisableInternalChannel(uint8_t channel_num);
+
+
+/**
+ * @func ADC_ComputeVdda_mV
+ * @brief Computes the actual analog supply VDDA from a VREFINT reading and its factory calibration.
+ * 			VDDA = 3300 mV * VREFINT_CAL / vrefint_raw
+ *
+ * @param	uint16_t vrefint_raw[IN]	-> 12-bit right aligned VREFINT sample
+ * @return uint16_t	VDDA in millivolts (0 if vrefint_raw is 0)
+ *
+ */
+uint16_t ADC_ComputeVdda_mV(uint16_t vrefint_raw);
+
+
+/**
+ * @func ADC_ComputeMillivolts
+ * @brief Converts a 12-bit right aligned sample of any channel into millivolts using the measured VDDA.
+ *
+ * @param	uint16_t raw[IN]		-> 12-bit right aligned sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV() (or the nominal value)
+ * @return uint16_t	input voltage in millivolts
+ *
+ */
+uint16_t ADC_ComputeMillivolts(uint16_t raw, uint16_t vdda_mv);
+
+
+/**
+ * @func ADC_ComputeVbat_mV
+ * @brief Converts a VBAT channel sample into the battery voltage, compensating the internal /2 bridge.
+ *
+ * @param	uint16_t vbat_raw[IN]	-> 12-bit right aligned VBAT sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV()
+ * @return uint16_t	VBAT in millivolts
+ *
+ */
+uint16_t ADC_ComputeVbat_mV(uint16_t vbat_raw, uint16_t vdda_mv);
+
+
+/**
+ * @func ADC_ComputeTemperature_cdegC
+ * @brief Converts a temperature sensor sample into hundredths of a degree Celsius using the two-point factory calibration.
+ * 			The sample is first rescaled to the calibration supply (3.3V) using the measured VDDA, then interpolated
+ * 			between TS_CAL1 (30 C) and TS_CAL2 (110 C).
+ *
+ * @param	uint16_t ts_raw[IN]		-> 12-bit right aligned temperature sensor sample
+ * @param	uint16_t vdda_mv[IN]	-> VDDA from ADC_ComputeVdda_mV()
+ * @return int32_t	temperature in centi-degrees Celsius (e.g. 2534 -> 25.34 C)
+ *
+ */
+int32_t ADC_ComputeTemperature_cdegC(uint16_t ts_raw, uint16_t vdda_mv);
+
+
 #endif /* ADC_ADC_H_ */
@@ -0,0 +1,291 @@
+/**
+ * @file crc.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief CRC module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # What does the CRC unit compute ?
+ * 		[♥] -> CRC-32 with the Ethernet polynomial 0x04C11DB7, initial value 0xFFFFFFFF (CRC_Reset()), no final XOR.
+ * 		[♥] -> Each 32-bit word written to CRC->DR is processed MSB first in 4 AHB cycles, there is no byte access,
+ * 				so the data is always fed as whole words (a word loaded from memory is little endian).
+ * 		[♥] -> Bit-reflected CRCs (zlib, PNG, Ethernet FCS) are obtained with CRC_INPUT_BIT_REVERSED, each word is
+ * 				bit-reversed (RBIT) before being written and CRC_Read() bit-reverses the result back.
+ *
+ * # Usage Work Flow ?
+ * 		1. CRC_Init() once.
+ * 		2. CRC_Reset() before each new checksum.
+ * 		3. Feed the words by the CPU with CRC_Accumulate() or by DMA with CRC_AccumulateDma(), both can be mixed
+ * 			(a CPU feed only once the DMA one is done).
+ * 		4. CRC_Read().
+ *
+ * # DMA feed ?
+ * 		[♥] CRC_AccumulateDma() lets DMA2 (memory-to-memory, CRC_DMA_STREAM) write the words to CRC->DR and returns at
+ * 			once, the CPU is free during the transfer. Unaligned buffers are packed into words by the stream FIFO.
+ * 		[♥] The callback is invoked from the DMA ISR at the end with CRC_STATUS_OK, then CRC_Read() gives the CRC, or
+ * 			with CRC_STATUS_DMA_ERROR on a transfer error (only part of the words were fed, the CRC is meaningless).
+ * 			CRC_DmaIsIdle() can be polled instead.
+ * 		[♥] The stream is allocated for the transfer only and released before the callback, if another driver owns it
+ * 			(or a DMA feed is already running) the function returns 0 and nothing is fed (use CRC_Accumulate()).
+ * 		[♥] CCM RAM isn't reachable by the DMA.
+ * 		[♥] Buffers longer than a stream can do at once (65535 items) are fed chunk by chunk from the DMA ISR.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "crc.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+/*Request channel used to own the memory-to-memory stream*/
+#define CRC_DMA_CHANNEL				(0)
+
+/*Words per DMA chunk (NDTR counts source items: bytes for unaligned buffers, words otherwise)*/
+#define CRC_DMA_MAX_WORDS			(0xFFFFUL)
+#define CRC_DMA_MAX_WORDS_PACKED	(0xFFFFUL / 4)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+/*Word read from any address (the Cortex-M4 LDR accepts unaligned addresses)*/
+typedef struct __attribute__((packed)){
+	uint32_t value;
+}CRC_UnalignedWord_t;
+
+#if defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__)
+static inline uint32_t CRC_BitReverse(uint32_t value){
+	uint32_t result;
+	__asm volatile ("rbit %0, %1" : "=r" (result) : "r" (value));
+	return result;
+}
+#else
+static inline uint32_t CRC_BitReverse(uint32_t value){
+	value = ((value >> 1) & 0x55555555UL) | ((value & 0x55555555UL) << 1);
+	value = ((value >> 2) & 0x33333333UL) | ((value & 0x33333333UL) << 2);
+	value = ((value >> 4) & 0x0F0F0F0FUL) | ((value & 0x0F0F0F0FUL) << 4);
+	value = ((value >> 8) & 0x00FF00FFUL) | ((value & 0x00FF00FFUL) << 8);
+	return (value >> 16) | (value << 16);
+}
+#endif
+
+/*Running DMA feed, one at a time (the CRC unit holds a single running CRC)*/
+typedef struct{
+	uint32_t address;			/*next chunk*/
+	uint32_t words;				/*words left, the running chunk included*/
+	uint32_t chunk;				/*words of the running chunk*/
+	uint8_t packed;				/*unaligned buffer, read byte by byte*/
+	CRC_Callback_t callback;
+	void* context;
+}CRC_DmaFeed_t;
+
+static CRC_DmaFeed_t g_CRC_DMA_FEED;
+static volatile uint8_t g_CRC_DMA_BUSY = 0;
+
+static void CRC_DmaCallback(void* dma_context, uint8_t event);
+
+
+/******************************* Functions Implementation *******************************/
+/**
+ * @func CRC_Init
+ * @brief Enables the CRC unit clock and resets the CRC.
+ *
+ * @return void
+ */
+void CRC_Init(void){
+	RCC_EnableAHB1Clock(RCC_AHB1_CRC);
+	CRC_Reset();
+}
+
+/**
+ * @func CRC_Reset
+ * @brief Loads the initial value 0xFFFFFFFF.
+ *
+ * #Important Registers:
+ * 			=> CRC->CR
+ * 				[♥] RESET		Resets DR to 0xFFFFFFFF
+ *
+ * @return void
+ */
+void CRC_Reset(void){
+	SET_BIT(CRC->CR, CRC_CR_RESET);
+}
+
+/**
+ * @func CRC_Accumulate
+ * @brief Feeds words to the CRC by the CPU.
+ *
+ * @param	const void* data[IN]		-> any alignment
+ * @param	uint32_t words[IN]			-> number of 32-bit words
+ * @param	uint8_t input[IN]			-> choose out of @defgroup CRC_Input_Options
+ *
+ * #Important Registers:
+ * 			=> CRC->DR		Write: data to accumulate, Read: current CRC
+ *
+ * @return uint32_t		current CRC (bit-reversed with CRC_INPUT_BIT_REVERSED)
+ */
+uint32_t CRC_Accumulate(const void* data, uint32_t words, uint8_t input){
+
+	const CRC_UnalignedWord_t* word = (const CRC_UnalignedWord_t*)data;
+
+	if(input == CRC_INPUT_BIT_REVERSED){
+		while(words--){
+			CRC->DR = CRC_BitReverse((word++)->value);
+		}
+	}else{
+		//4 writes per iteration, the CRC unit takes 4 AHB cycles per word so the loop overhead is hidden
+		for(; words >= 4; words -= 4, word += 4){
+			CRC->DR = word[0].value;
+			CRC->DR = word[1].value;
+			CRC->DR = word[2].value;
+			CRC->DR = word[3].value;
+		}
+		while(words--){
+			CRC->DR = (word++)->value;
+		}
+	}
+
+	return CRC_Read(input);
+}
+
+/**
+ * @func CRC_DmaStartChunk
+ * @brief Starts the stream on the next chunk (at most CRC_DMA_MAX_WORDS(_PACKED) words) of the feed.
+ *
+ * @note STATIC FUNCTION
+ */
+static void CRC_DmaStartChunk(void){
+
+	CRC_DmaFeed_t* feed = &g_CRC_DMA_FEED;
+	uint32_t max_words = feed->packed ? CRC_DMA_MAX_WORDS_PACKED : CRC_DMA_MAX_WORDS;
+
+	feed->chunk = (feed->words > max_words) ? max_words : feed->words;
+	DMA_Start(DMA_DMA2, CRC_DMA_STREAM, feed->address, (uint32_t)&CRC->DR,
+			  (uint16_t)(feed->packed ? (feed->chunk * 4) : feed->chunk));
+}
+
+/**
+ * @func CRC_AccumulateDma
+ * @brief Starts feeding words to the CRC by DMA2 (CRC_INPUT_WORDS only), the callback is invoked at the end.
+ *
+ * @param	const void* data[IN]		-> any alignment, not in CCM RAM, untouched until the callback
+ * @param	uint32_t words[IN]			-> number of 32-bit words
+ * @param	CRC_Callback_t callback[IN]	-> 0: none (poll CRC_DmaIsIdle())
+ * @param	void* context[IN]
+ *
+ * #Important Registers:
+ * 			=> DMA2->STREAM[CRC_DMA_STREAM]
+ * 				[♥] PAR		Source buffer (memory-to-memory)
+ * 				[♥] M0AR	&CRC->DR, not incremented
+ *
+ * @return uint8_t		1: started (or nothing to feed), 0: CRC_DMA_STREAM is owned by another driver or a DMA
+ * 						feed is running, nothing fed
+ */
+uint8_t CRC_AccumulateDma(const void* data, uint32_t words, CRC_Callback_t callback, void* context){
+
+	uint32_t address = (uint32_t)data;
+	uint8_t packed = ((address & 0x3UL) != 0);
+
+	uint32_t primask = LIB_EnterCritical();
+	if(g_CRC_DMA_BUSY || !DMA_Allocate(DMA_DMA2, CRC_DMA_STREAM, CRC_DMA_CHANNEL)){
+		LIB_ExitCritical(primask);
+		return 0;
+	}
+	g_CRC_DMA_BUSY = 1;
+	LIB_ExitCritical(primask);
+
+	if(words == 0){
+		DMA_Free(DMA_DMA2, CRC_DMA_STREAM, CRC_DMA_CHANNEL);
+		g_CRC_DMA_BUSY = 0;
+		if(callback != 0){
+			callback(context, CRC_STATUS_OK);
+		}
+		return 1;
+	}
+
+	//An unaligned buffer is read byte by byte, the FIFO packs each 4 bytes into one word write
+	DMA_StreamConfig_t config = {
+			.channel = CRC_DMA_CHANNEL,
+			.direction = DMA_DIR_MEM_TO_MEM,
+			.priority = DMA_PRIORITY_MEDIUM,
+			.periph_size = packed ? DMA_SIZE_BYTE : DMA_SIZE_WORD,
+			.mem_size = DMA_SIZE_WORD,
+			.periph_inc = DMA_INCREMENT_ENABLED,
+			.mem_inc = DMA_INCREMENT_DISABLED,
+			.circular = DMA_CIRCULAR_DISABLED,
+			.fifo = DMA_FIFO_FULL,
+			.periph_burst = DMA_BURST_SINGLE,
+			.mem_burst = DMA_BURST_SINGLE,
+			.interrupts = DMA_IT_COMPLETE | DMA_IT_ERROR,
+			.callback = CRC_DmaCallback,
+			.context = 0,
+	};
+
+	g_CRC_DMA_FEED = (CRC_DmaFeed_t){address, words, 0, packed, callback, context};
+	DMA_Configure(DMA_DMA2, CRC_DMA_STREAM, &config);
+	CRC_DmaStartChunk();
+
+	return 1;
+}
+
+/**
+ * @func CRC_DmaIsIdle
+ * @brief Checks if no DMA feed is running.
+ *
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t CRC_DmaIsIdle(void){
+	return !g_CRC_DMA_BUSY;
+}
+
+/**
+ * @func CRC_Read
+ * @brief Returns the current CRC.
+ *
+ * @param	uint8_t input[IN]			-> choose out of @defgroup CRC_Input_Options (the one used to feed)
+ * @return uint32_t
+ */
+uint32_t CRC_Read(uint8_t input){
+	return (input == CRC_INPUT_BIT_REVERSED) ? CRC_BitReverse(CRC->DR) : CRC->DR;
+}
+
+
+/**
+ * @func CRC_DmaCallback
+ * @brief Chunk completion (DMA ISR): chains the next chunk, or releases the stream and ends the feed.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void CRC_DmaCallback(void* dma_context, uint8_t event){
+
+	CRC_DmaFeed_t* feed = &g_CRC_DMA_FEED;
+	uint8_t status = CRC_STATUS_OK;
+
+	(void)dma_context;
+
+	if(!g_CRC_DMA_BUSY){
+		return;
+	}
+
+	if(event == DMA_EVENT_ERROR){
+		//TEIF (bus error on the source) or a FIFO/direct mode error, the stream is disabled by hardware
+		status = CRC_STATUS_DMA_ERROR;
+	}else{
+		feed->address += feed->chunk * 4;
+		feed->words -= feed->chunk;
+		if(feed->words != 0){
+			CRC_DmaStartChunk();
+			return;
+		}
+	}
+
+	//released first, the callback may start another feed
+	DMA_Free(DMA_DMA2, CRC_DMA_STREAM, CRC_DMA_CHANNEL);
+	g_CRC_DMA_BUSY = 0;
+	if(feed->callback != 0){
+		feed->callback(feed->context, status);
+	}
+}
@@ -0,0 +1,151 @@
+/**
+ * @file crc.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief CRC module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # What does the CRC unit compute ?
+ * 		[♥] -> CRC-32 with the Ethernet polynomial 0x04C11DB7, initial value 0xFFFFFFFF (CRC_Reset()), no final XOR.
+ * 		[♥] -> Each 32-bit word written to CRC->DR is processed MSB first in 4 AHB cycles, there is no byte access,
+ * 				so the data is always fed as whole words (a word loaded from memory is little endian).
+ * 		[♥] -> Bit-reflected CRCs (zlib, PNG, Ethernet FCS) are obtained with CRC_INPUT_BIT_REVERSED, each word is
+ * 				bit-reversed (RBIT) before being written and CRC_Read() bit-reverses the result back.
+ *
+ * # Usage Work Flow ?
+ * 		1. CRC_Init() once.
+ * 		2. CRC_Reset() before each new checksum.
+ * 		3. Feed the words by the CPU with CRC_Accumulate() or by DMA with CRC_AccumulateDma(), both can be mixed
+ * 			(a CPU feed only once the DMA one is done).
+ * 		4. CRC_Read().
+ *
+ * # DMA feed ?
+ * 		[♥] CRC_AccumulateDma() lets DMA2 (memory-to-memory, CRC_DMA_STREAM) write the words to CRC->DR and returns at
+ * 			once, the CPU is free during the transfer. Unaligned buffers are packed into words by the stream FIFO.
+ * 		[♥] The callback is invoked from the DMA ISR at the end with CRC_STATUS_OK, then CRC_Read() gives the CRC, or
+ * 			with CRC_STATUS_DMA_ERROR on a transfer error (only part of the words were fed, the CRC is meaningless).
+ * 			CRC_DmaIsIdle() can be polled instead.
+ * 		[♥] The stream is allocated for the transfer only and released before the callback, if another driver owns it
+ * 			(or a DMA feed is already running) the function returns 0 and nothing is fed (use CRC_Accumulate()).
+ * 		[♥] CCM RAM isn't reachable by the DMA.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in crc.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef CRC_CRC_H_
+#define CRC_CRC_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "dma.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup CRC_Input_Options
+ */
+#define CRC_INPUT_WORDS				(0)		/*words written as loaded*/
+#define CRC_INPUT_BIT_REVERSED		(1)		/*reflected CRC, words and result bit-reversed*/
+
+/**
+ * @defgroup CRC_Status_Options (DMA feed completion status)
+ */
+#define CRC_STATUS_OK				(0)
+#define CRC_STATUS_DMA_ERROR		(1)		/*DMA transfer error, part of the words weren't fed*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*DMA2 stream used by CRC_AccumulateDma() (memory-to-memory, channel 0)*/
+#define CRC_DMA_STREAM				(DMA_STREAM4)
+
+
+/******************************* Types *******************************/
+/**
+ * @brief DMA feed completion callback, invoked from the DMA ISR.
+ *
+ * @param void* context		-> the feed's context
+ * @param uint8_t status	-> @defgroup CRC_Status_Options
+ */
+typedef void (*CRC_Callback_t)(void* context, uint8_t status);
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func CRC_Init
+ * @brief Enables the CRC unit clock and resets the CRC.
+ *
+ * @return void
+ */
+void CRC_Init(void);
+
+/**
+ * @func CRC_Reset
+ * @brief Loads the initial value 0xFFFFFFFF.
+ *
+ * #Important Registers:
+ * 			=> CRC->CR
+ * 				[♥] RESET		Resets DR to 0xFFFFFFFF
+ *
+ * @return void
+ */
+void CRC_Reset(void);
+
+/**
+ * @func CRC_Accumulate
+ * @brief Feeds words to the CRC by the CPU.
+ *
+ * @param	const void* data[IN]		-> any alignment
+ * @param	uint32_t words[IN]			-> number of 32-bit words
+ * @param	uint8_t input[IN]			-> choose out of @defgroup CRC_Input_Options
+ *
+ * #Important Registers:
+ * 			=> CRC->DR		Write: data to accumulate, Read: current CRC
+ *
+ * @return uint32_t		current CRC (bit-reversed with CRC_INPUT_BIT_REVERSED)
+ */
+uint32_t CRC_Accumulate(const void* data, uint32_t words, uint8_t input);
+
+/**
+ * @func CRC_AccumulateDma
+ * @brief Starts feeding words to the CRC by DMA2 (CRC_INPUT_WORDS only), the callback is invoked at the end.
+ *
+ * @param	const void* data[IN]		-> any alignment, not in CCM RAM, untouched until the callback
+ * @param	uint32_t words[IN]			-> number of 32-bit words
+ * @param	CRC_Callback_t callback[IN]	-> 0: none (poll CRC_DmaIsIdle())
+ * @param	void* context[IN]
+ * @return uint8_t		1: started (or nothing to feed), 0: CRC_DMA_STREAM is owned by another driver or a DMA
+ * 						feed is running, nothing fed
+ */
+uint8_t CRC_AccumulateDma(const void* data, uint32_t words, CRC_Callback_t callback, void* context);
+
+/**
+ * @func CRC_DmaIsIdle
+ * @brief Checks if no DMA feed is running.
+ *
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t CRC_DmaIsIdle(void);
+
+/**
+ * @func CRC_Read
+ * @brief Returns the current CRC.
+ *
+ * @param	uint8_t input[IN]			-> choose out of @defgroup CRC_Input_Options (the one used to feed)
+ * @return uint32_t
+ */
+uint32_t CRC_Read(uint8_t input);
+
+
+#endif /* CRC_CRC_H_ */
@@ -0,0 +1,335 @@
+/**
+ * @file dac.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief DAC module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which DAC Channel ?
+ * 		[♥] -> Channel 1 drives PA4, channel 2 drives PA5 (both pins in analog mode using GPIO), we choose the channel
+ * 				by passing DAC_Channel_en, the channel 2 bits of DAC->CR are the channel 1 bits shifted by 16.
+ * 		[♥] -> Output = VREF+ x DOR / 4096.
+ *
+ * # Usage Work Flow ?
+ * 		1. Set PA4/PA5 as analog.
+ * 		2. Make a {DAC_Config_t} variable and call DAC_Init() for each channel.
+ * 		3. DAC_TRIGGER_NONE: DAC_Write()/DAC_WriteDual() are applied at once.
+ * 			Any other trigger: the written value is applied at the next trigger (DAC_SoftwareTrigger() or a timer).
+ *
+ * # Waveform streaming (no CPU) ?
+ * 		[♥] DAC_StartStream() plays a RAM/FLASH table forever: TIM6 or TIM7 (TIM_TriggerInit()) triggers the DAC at the
+ * 			sample rate, each trigger moves the next sample to the output and requests the next one from the DMA,
+ * 			which runs in circular mode over the table.
+ * 				Channel 1 -> DMA1 stream 5 channel 7
+ * 				Channel 2 -> DMA1 stream 6 channel 7
+ * 		[♥] A DMA underrun (the DMA too late for a trigger, e.g. a too high rate) is counted and the stream resumed,
+ * 			@DAC_GetUnderruns().
+ *
+ * # Built-in waveforms ?
+ * 		[♥] DAC_StartWave() adds the hardware noise (LFSR) or triangle generator to the channel's DHR base value at each
+ * 			trigger, amplitude = 2^n - 1 (@DAC_Amplitude_Options), no DMA and no CPU either.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "dac.h"
+
+/*******************************  Macros *******************************/
+#define DAC_CHANNELS_NUM			(2)
+
+/*DHR12Rx, DHR12Lx, DHR8Rx of a channel are consecutive, channel 2's follow channel 1's*/
+#define DAC_DHR_PER_CHANNEL			(3)
+
+/*Channel 1 bits of DAC->CR*/
+#define DAC_CR_CHANNEL_MASK			(0xFFFFUL)
+#define DAC_CR_TSEL_MASK			(0b111UL)
+#define DAC_CR_WAVE_MASK			(0b11UL)
+#define DAC_CR_MAMP_MASK			(0xFUL)
+
+/*NVIC line shared with TIM6*/
+#define DAC_IRQ_NUM					(54)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+/*DMA request of each channel (DMA1)*/
+typedef struct{
+	DMA_Stream_en stream;
+	uint8_t channel;
+}DAC_DmaRequest_t;
+
+static const DAC_DmaRequest_t g_DAC_DMA[DAC_CHANNELS_NUM] = {
+		{DMA_STREAM5, 7},		/*Channel 1*/
+		{DMA_STREAM6, 7},		/*Channel 2*/
+};
+
+/*Table playback of each channel*/
+typedef struct{
+	const uint16_t* table;
+	uint16_t table_len;
+	uint8_t running;
+	TIM_Peripheral_en tim;
+	volatile uint32_t underruns;
+	volatile uint32_t* dhr;
+}DAC_Stream_t;
+
+static DAC_Stream_t g_DAC_STREAMS[DAC_CHANNELS_NUM];
+
+static void DAC_IRQHandler(void);
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func DAC_GetDhr
+ * @brief Returns the data holding register of a channel for an alignment.
+ *
+ * @note STATIC FUNCTION
+ */
+static volatile uint32_t* DAC_GetDhr(DAC_Channel_en channel, uint8_t alignment){
+	return &(&DAC->DHR12R1)[(channel * DAC_DHR_PER_CHANNEL) + alignment];
+}
+
+/**
+ * @func DAC_Init
+ * @brief Configures and enables a channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	const DAC_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] ENx			Channel enable
+ * 				[♥] BOFFx		Output buffer disable
+ * 				[♥] TENx		Trigger enable
+ * 				[♥] TSELx[3-5]	Trigger selection
+ *
+ * @return void
+ */
+void DAC_Init(DAC_Channel_en channel, const DAC_Config_t* config){
+
+	uint8_t shift = channel * DAC_CR_CH2_SHIFT;
+	uint32_t cr = ((uint32_t)(config->buffer & 1) << DAC_CR_BOFF1);
+
+	RCC_EnableAPB1Clock(RCC_APB1_DAC);
+
+	if(config->trigger != DAC_TRIGGER_NONE){
+		cr |= (1UL << DAC_CR_TEN1) | ((uint32_t)(config->trigger & DAC_CR_TSEL_MASK) << DAC_CR_TSEL1);
+	}
+	cr |= (1UL << DAC_CR_EN1);
+
+	DAC->CR = (DAC->CR & ~(DAC_CR_CHANNEL_MASK << shift)) | (cr << shift);
+}
+
+/**
+ * @func DAC_Write
+ * @brief Writes the data holding register of a channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	uint8_t alignment[IN]		-> choose out of @defgroup DAC_Alignment_Options
+ * @param	uint16_t value[IN]
+ * @return void
+ */
+void DAC_Write(DAC_Channel_en channel, uint8_t alignment, uint16_t value){
+	*DAC_GetDhr(channel, alignment) = value;
+}
+
+/**
+ * @func DAC_WriteDual
+ * @brief Writes both channels with a single register write (they are updated at the same time).
+ *
+ * @param	uint8_t alignment[IN]		-> choose out of @defgroup DAC_Alignment_Options
+ * @param	uint16_t value1[IN]			-> channel 1
+ * @param	uint16_t value2[IN]			-> channel 2
+ *
+ * #Important Registers:
+ * 			=> DAC->DHR12RD / DHR12LD / DHR8RD		Channel 1 in the low half, channel 2 in the high half
+ *
+ * @return void
+ */
+void DAC_WriteDual(uint8_t alignment, uint16_t value1, uint16_t value2){
+
+	//DHR8RD packs the two 8-bit values in its low half-word
+	uint8_t shift = (alignment == DAC_ALIGN_8BIT_RIGHT) ? 8 : 16;
+
+	(&DAC->DHR12RD)[alignment] = (uint32_t)value1 | ((uint32_t)value2 << shift);
+}
+
+/**
+ * @func DAC_SoftwareTrigger
+ * @brief Triggers a channel configured with DAC_TRIGGER_SOFTWARE.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return void
+ */
+void DAC_SoftwareTrigger(DAC_Channel_en channel){
+	SET_BIT(DAC->SWTRIGR, (DAC_SWTRIGR_SWTRIG1 + channel));
+}
+
+/**
+ * @func DAC_StartWave
+ * @brief Starts the built-in noise or triangle generator of a triggered channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	uint8_t wave[IN]			-> choose out of @defgroup DAC_Wave_Options
+ * @param	uint8_t amplitude[IN]		-> choose out of @defgroup DAC_Amplitude_Options
+ * @param	uint16_t base[IN]			-> 12-bit value the generator output is added to
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] WAVEx[6-7]		00: none, 01: noise, 1x: triangle
+ * 				[♥] MAMPx[8-11]		Mask/amplitude selector
+ *
+ * @return void
+ */
+void DAC_StartWave(DAC_Channel_en channel, uint8_t wave, uint8_t amplitude, uint16_t base){
+
+	uint8_t shift = channel * DAC_CR_CH2_SHIFT;
+	uint32_t mask = (DAC_CR_WAVE_MASK << DAC_CR_WAVE1) | (DAC_CR_MAMP_MASK << DAC_CR_MAMP1);
+	uint32_t bits = ((uint32_t)(wave & DAC_CR_WAVE_MASK) << DAC_CR_WAVE1) |
+					((uint32_t)(amplitude & DAC_CR_MAMP_MASK) << DAC_CR_MAMP1);
+
+	DAC->CR = (DAC->CR & ~(mask << shift)) | (bits << shift);
+	DAC_Write(channel, DAC_ALIGN_12BIT_RIGHT, base);
+}
+
+/**
+ * @func DAC_StartStream
+ * @brief Plays a table forever at the provided sample rate, paced by TIM6/TIM7 and fed by DMA (circular).
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	TIM_Peripheral_en tim[IN]		-> TIM_TIM6 or TIM_TIM7
+ * @param	uint32_t sample_hz[IN]
+ * @param	const uint16_t* table[IN]		-> samples, must stay valid while running
+ * @param	uint16_t table_len[IN]
+ * @param	uint8_t alignment[IN]			-> choose out of @defgroup DAC_Alignment_Options
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] DMAENx		DMA request at each trigger
+ * 				[♥] DMAUDRIEx	DMA underrun interrupt
+ *
+ * @return uint32_t		actual sample rate, 0: wrong timer or the DMA stream is used by another driver
+ */
+uint32_t DAC_StartStream(DAC_Channel_en channel, TIM_Peripheral_en tim, uint32_t sample_hz, const uint16_t* table,
+		uint16_t table_len, uint8_t alignment){
+
+	const DAC_DmaRequest_t* request = &g_DAC_DMA[channel];
+	DAC_Stream_t* stream = &g_DAC_STREAMS[channel];
+	uint8_t shift = channel * DAC_CR_CH2_SHIFT;
+	DMA_StreamConfig_t dma_config = {
+			.channel = request->channel,
+			.direction = DMA_DIR_MEM_TO_PERIPH,
+			.priority = DMA_PRIORITY_HIGH,
+			.periph_size = DMA_SIZE_HALF_WORD,
+			.mem_size = DMA_SIZE_HALF_WORD,
+			.periph_inc = DMA_INCREMENT_DISABLED,
+			.mem_inc = DMA_INCREMENT_ENABLED,
+			.circular = DMA_CIRCULAR_ENABLED,
+			.fifo = DMA_FIFO_DIRECT,
+			.interrupts = DMA_IT_NONE,
+	};
+
+	if(((tim != TIM_TIM6) && (tim != TIM_TIM7)) || (table_len == 0)){
+		return 0;
+	}
+	DAC_StopStream(channel);
+	if(!DMA_Allocate(DMA_DMA1, request->stream, request->channel)){
+		return 0;
+	}
+
+	stream->table = table;
+	stream->table_len = table_len;
+	stream->tim = tim;
+	stream->underruns = 0;
+	stream->dhr = DAC_GetDhr(channel, alignment);
+
+	RCC_EnableAPB1Clock(RCC_APB1_DAC);
+
+	/*Channel: timer trigger, DMA request at each trigger, no generator, the buffer setting is kept*/
+	uint32_t mask = (1UL << DAC_CR_TEN1) | (DAC_CR_TSEL_MASK << DAC_CR_TSEL1) |
+					(DAC_CR_WAVE_MASK << DAC_CR_WAVE1) | (DAC_CR_MAMP_MASK << DAC_CR_MAMP1) |
+					(1UL << DAC_CR_DMAEN1) | (1UL << DAC_CR_DMAUDRIE1);
+	uint32_t bits = (1UL << DAC_CR_EN1) | (1UL << DAC_CR_TEN1) |
+					((uint32_t)((tim == TIM_TIM6) ? DAC_TRIGGER_TIM6 : DAC_TRIGGER_TIM7) << DAC_CR_TSEL1) |
+					(1UL << DAC_CR_DMAEN1) | (1UL << DAC_CR_DMAUDRIE1);
+	DAC->CR = (DAC->CR & ~(mask << shift)) | (bits << shift);
+
+	DMA_Configure(DMA_DMA1, request->stream, &dma_config);
+	DMA_Start(DMA_DMA1, request->stream, (uint32_t)stream->dhr, (uint32_t)table, table_len);
+	stream->running = 1;
+
+	TIM_SetDacIRQHook(DAC_IRQHandler);
+	NVIC_EnableIRQ(DAC_IRQ_NUM);
+
+	//the pacing timer starts last, the first sample is already requested
+	return TIM_TriggerInit(tim, sample_hz);
+}
+
+/**
+ * @func DAC_StopStream
+ * @brief Stops the table playback, the output keeps the last sample.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return void
+ */
+void DAC_StopStream(DAC_Channel_en channel){
+
+	DAC_Stream_t* stream = &g_DAC_STREAMS[channel];
+	DAC_Stream_t* other = &g_DAC_STREAMS[channel ^ 1];
+	uint8_t shift = channel * DAC_CR_CH2_SHIFT;
+
+	if(!stream->running){
+		return;
+	}
+	stream->running = 0;
+
+	DAC->CR &= ~(((1UL << DAC_CR_DMAEN1) | (1UL << DAC_CR_DMAUDRIE1)) << shift);
+	DMA_Free(DMA_DMA1, g_DAC_DMA[channel].stream, g_DAC_DMA[channel].channel);
+
+	//the other channel may be paced by the same timer
+	if(!other->running || (other->tim != stream->tim)){
+		TIM_Stop(stream->tim);
+	}
+}
+
+/**
+ * @func DAC_GetUnderruns
+ * @brief Returns the number of DMA underruns of a channel since its stream was started.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return uint32_t
+ */
+uint32_t DAC_GetUnderruns(DAC_Channel_en channel){
+	return g_DAC_STREAMS[channel].underruns;
+}
+
+/**
+ * @func DAC_IRQHandler
+ * @brief DMA underrun: counts it and restarts the channel's stream at the beginning of the table.
+ *
+ * @note STATIC FUNCTION, invoked from TIM6_DAC_IRQHandler (tim.c)
+ * @return void
+ */
+static void DAC_IRQHandler(void){
+
+	for(uint8_t channel = 0; channel < DAC_CHANNELS_NUM; channel++){
+		DAC_Stream_t* stream = &g_DAC_STREAMS[channel];
+		uint8_t shift = channel * DAC_CR_CH2_SHIFT;
+
+		if(!GET_BIT(DAC->SR, (DAC_SR_DMAUDR1 + shift)) || !stream->running){
+			continue;
+		}
+		//rc_w1, then RM0090: DMAEN cleared and the stream restarted before re-enabling the requests
+		DAC->SR = (1UL << (DAC_SR_DMAUDR1 + shift));
+		stream->underruns++;
+
+		CLEAR_BIT(DAC->CR, (DAC_CR_DMAEN1 + shift));
+		DMA_Stop(DMA_DMA1, g_DAC_DMA[channel].stream);
+		DMA_Start(DMA_DMA1, g_DAC_DMA[channel].stream, (uint32_t)stream->dhr, (uint32_t)stream->table,
+				  stream->table_len);
+		SET_BIT(DAC->CR, (DAC_CR_DMAEN1 + shift));
+	}
+}
@@ -0,0 +1,239 @@
+/**
+ * @file dac.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief DAC module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which DAC Channel ?
+ * 		[♥] -> Channel 1 drives PA4, channel 2 drives PA5 (both pins in analog mode using GPIO), we choose the channel
+ * 				by passing DAC_Channel_en, the channel 2 bits of DAC->CR are the channel 1 bits shifted by 16.
+ * 		[♥] -> Output = VREF+ x DOR / 4096.
+ *
+ * # Usage Work Flow ?
+ * 		1. Set PA4/PA5 as analog.
+ * 		2. Make a {DAC_Config_t} variable and call DAC_Init() for each channel.
+ * 		3. DAC_TRIGGER_NONE: DAC_Write()/DAC_WriteDual() are applied at once.
+ * 			Any other trigger: the written value is applied at the next trigger (DAC_SoftwareTrigger() or a timer).
+ *
+ * # Waveform streaming (no CPU) ?
+ * 		[♥] DAC_StartStream() plays a RAM/FLASH table forever: TIM6 or TIM7 (TIM_TriggerInit()) triggers the DAC at the
+ * 			sample rate, each trigger moves the next sample to the output and requests the next one from the DMA,
+ * 			which runs in circular mode over the table.
+ * 				Channel 1 -> DMA1 stream 5 channel 7
+ * 				Channel 2 -> DMA1 stream 6 channel 7
+ * 		[♥] A DMA underrun (the DMA too late for a trigger, e.g. a too high rate) is counted and the stream resumed,
+ * 			@DAC_GetUnderruns().
+ *
+ * # Built-in waveforms ?
+ * 		[♥] DAC_StartWave() adds the hardware noise (LFSR) or triangle generator to the channel's DHR base value at each
+ * 			trigger, amplitude = 2^n - 1 (@DAC_Amplitude_Options), no DMA and no CPU either.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in dac.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef DAC_DAC_H_
+#define DAC_DAC_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+#include "dma.h"
+#include "tim.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup DAC_Alignment_Options
+ */
+#define DAC_ALIGN_12BIT_RIGHT		(0)		/*value [0 - 4095]*/
+#define DAC_ALIGN_12BIT_LEFT		(1)		/*value [0 - 65535], the 4 LSBs are ignored (unsigned Q16)*/
+#define DAC_ALIGN_8BIT_RIGHT		(2)		/*value [0 - 255]*/
+
+/**
+ * @defgroup DAC_Trigger_Options
+ */
+#define DAC_TRIGGER_NONE			(0xFF)	/*output updated one APB1 cycle after each write*/
+#define DAC_TRIGGER_TIM6			(0b000)
+#define DAC_TRIGGER_TIM8			(0b001)
+#define DAC_TRIGGER_TIM7			(0b010)
+#define DAC_TRIGGER_TIM5			(0b011)
+#define DAC_TRIGGER_TIM2			(0b100)
+#define DAC_TRIGGER_TIM4			(0b101)
+#define DAC_TRIGGER_EXTI9			(0b110)
+#define DAC_TRIGGER_SOFTWARE		(0b111)
+
+/**
+ * @defgroup DAC_OutputBuffer_Options
+ */
+#define DAC_BUFFER_ENABLED			(0)		/*drives low impedance loads*/
+#define DAC_BUFFER_DISABLED			(1)		/*rail to rail*/
+
+/**
+ * @defgroup DAC_Wave_Options
+ */
+#define DAC_WAVE_NONE				(0b00)
+#define DAC_WAVE_NOISE				(0b01)
+#define DAC_WAVE_TRIANGLE			(0b10)
+
+/**
+ * @defgroup DAC_Amplitude_Options (triangle amplitude / noise LFSR mask, 2^(n + 1) - 1)
+ */
+#define DAC_AMPLITUDE_1				(0)
+#define DAC_AMPLITUDE_3				(1)
+#define DAC_AMPLITUDE_7				(2)
+#define DAC_AMPLITUDE_15			(3)
+#define DAC_AMPLITUDE_31			(4)
+#define DAC_AMPLITUDE_63			(5)
+#define DAC_AMPLITUDE_127			(6)
+#define DAC_AMPLITUDE_255			(7)
+#define DAC_AMPLITUDE_511			(8)
+#define DAC_AMPLITUDE_1023			(9)
+#define DAC_AMPLITUDE_2047			(10)
+#define DAC_AMPLITUDE_4095			(11)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+
+
+/******************************* Types *******************************/
+typedef enum{
+	DAC_CHANNEL1 = 0,
+	DAC_CHANNEL2,
+}DAC_Channel_en;
+
+/**
+ * @struct DAC_Config_t
+ * @brief Channel configuration.
+ */
+typedef struct{
+	uint8_t trigger;		/*choose out of @defgroup DAC_Trigger_Options*/
+	uint8_t buffer;			/*choose out of @defgroup DAC_OutputBuffer_Options*/
+}DAC_Config_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func DAC_Init
+ * @brief Configures and enables a channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	const DAC_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] ENx			Channel enable
+ * 				[♥] BOFFx		Output buffer disable
+ * 				[♥] TENx		Trigger enable
+ * 				[♥] TSELx[3-5]	Trigger selection
+ *
+ * @return void
+ */
+void DAC_Init(DAC_Channel_en channel, const DAC_Config_t* config);
+
+/**
+ * @func DAC_Write
+ * @brief Writes the data holding register of a channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	uint8_t alignment[IN]		-> choose out of @defgroup DAC_Alignment_Options
+ * @param	uint16_t value[IN]
+ * @return void
+ */
+void DAC_Write(DAC_Channel_en channel, uint8_t alignment, uint16_t value);
+
+/**
+ * @func DAC_WriteDual
+ * @brief Writes both channels with a single register write (they are updated at the same time).
+ *
+ * @param	uint8_t alignment[IN]		-> choose out of @defgroup DAC_Alignment_Options
+ * @param	uint16_t value1[IN]			-> channel 1
+ * @param	uint16_t value2[IN]			-> channel 2
+ *
+ * #Important Registers:
+ * 			=> DAC->DHR12RD / DHR12LD / DHR8RD		Channel 1 in the low half, channel 2 in the high half
+ *
+ * @return void
+ */
+void DAC_WriteDual(uint8_t alignment, uint16_t value1, uint16_t value2);
+
+/**
+ * @func DAC_SoftwareTrigger
+ * @brief Triggers a channel configured with DAC_TRIGGER_SOFTWARE.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return void
+ */
+void DAC_SoftwareTrigger(DAC_Channel_en channel);
+
+/**
+ * @func DAC_StartWave
+ * @brief Starts the built-in noise or triangle generator of a triggered channel.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	uint8_t wave[IN]			-> choose out of @defgroup DAC_Wave_Options
+ * @param	uint8_t amplitude[IN]		-> choose out of @defgroup DAC_Amplitude_Options
+ * @param	uint16_t base[IN]			-> 12-bit value the generator output is added to
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] WAVEx[6-7]		00: none, 01: noise, 1x: triangle
+ * 				[♥] MAMPx[8-11]		Mask/amplitude selector
+ *
+ * @return void
+ */
+void DAC_StartWave(DAC_Channel_en channel, uint8_t wave, uint8_t amplitude, uint16_t base);
+
+/**
+ * @func DAC_StartStream
+ * @brief Plays a table forever at the provided sample rate, paced by TIM6/TIM7 and fed by DMA (circular).
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @param	TIM_Peripheral_en tim[IN]		-> TIM_TIM6 or TIM_TIM7
+ * @param	uint32_t sample_hz[IN]
+ * @param	const uint16_t* table[IN]		-> samples, must stay valid while running
+ * @param	uint16_t table_len[IN]
+ * @param	uint8_t alignment[IN]			-> choose out of @defgroup DAC_Alignment_Options
+ *
+ * #Important Registers:
+ * 			=> DAC->CR
+ * 				[♥] DMAENx		DMA request at each trigger
+ * 				[♥] DMAUDRIEx	DMA underrun interrupt
+ *
+ * @return uint32_t		actual sample rate, 0: wrong timer or the DMA stream is used by another driver
+ */
+uint32_t DAC_StartStream(DAC_Channel_en channel, TIM_Peripheral_en tim, uint32_t sample_hz, const uint16_t* table,
+		uint16_t table_len, uint8_t alignment);
+
+/**
+ * @func DAC_StopStream
+ * @brief Stops the table playback, the output keeps the last sample.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return void
+ */
+void DAC_StopStream(DAC_Channel_en channel);
+
+/**
+ * @func DAC_GetUnderruns
+ * @brief Returns the number of DMA underruns of a channel since its stream was started.
+ *
+ * @param	DAC_Channel_en channel[IN]
+ * @return uint32_t
+ */
+uint32_t DAC_GetUnderruns(DAC_Channel_en channel);
+
+
+#endif /* DAC_DAC_H_ */
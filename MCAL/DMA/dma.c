@@ -0,0 +1,465 @@
+/**
+ * @file dma.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief DMA1/DMA2 streams' module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which DMA Stream ?
+ * 		[♥] -> A stream is chosen by passing DMA_Peripheral_en (DMA1/DMA2) and DMA_Stream_en (stream 0 - 7),
+ * 				DMA_Peripheral_en is used as an index of the g_DMA_INSTANCES that has the base addresses of both
+ * 				controllers.
+ * 		[♥] -> Each peripheral request is wired to fixed {controller, stream, channel} triplets (RM0090 tables 42/43),
+ * 				the drivers using DMA (TIM, SPI, I2C, ...) know their own triplets.
+ *
+ * # Allocation ?
+ * 		[♥] A stream serves one request (channel) at a time. DMA_Allocate() reserves it for a channel and fails if
+ * 			another channel already owns it, so two drivers can't silently fight over the same stream.
+ * 			Allocating again with the same channel succeeds (re-initialization of the same driver).
+ *
+ * # Usage Work Flow ?
+ * 		1. Call DMA_Allocate() and check its result.
+ * 		2. Make a {DMA_StreamConfig_t} variable and call DMA_Configure().
+ * 		3. Call DMA_Start() (or DMA_StartDoubleBuffer()), then DMA_Stop() when done.
+ * 		4. The callback (if any) is invoked from the stream's ISR with DMA_EVENT_HALF / COMPLETE / ERROR.
+ *
+ * # Double buffer ?
+ * 		[♥] DMA_StartDoubleBuffer() alternates between two memory buffers (circular), at each DMA_EVENT_COMPLETE
+ * 			DMA_GetCurrentTarget() tells which buffer the DMA is now using, the other one can be processed and
+ * 			replaced with DMA_SetMemory().
+ *
+ * # FIFO and burst ?
+ * 		[♥] DMA_FIFO_DIRECT (no FIFO) for single transfers, or a FIFO threshold to pack/unpack different
+ * 			peripheral/memory sizes and to allow bursts (a burst must fit in the FIFO threshold, RM0090 table 48).
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "dma.h"
+
+/*******************************  Macros *******************************/
+#define DMA_INSTANCES_NUM			(2)
+#define DMA_STREAMS_NUM				(8)
+
+#define DMA_NO_OWNER				(0xFF)
+
+/*The 5 flags of a stream (FEIF, DMEIF, TEIF, HTIF, TCIF) in LISR/HISR*/
+#define DMA_STREAM_FLAGS_MASK		(0x3DUL)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static DMA_t* const g_DMA_INSTANCES[DMA_INSTANCES_NUM] = {DMA1, DMA2};
+
+static const RCC_AHB1PERIPH_en g_DMA_RCC[DMA_INSTANCES_NUM] = {RCC_AHB1_DMA1, RCC_AHB1_DMA2};
+
+/*Flags position of streams 0/4, 1/5, 2/6, 3/7 in LISR/HISR*/
+static const uint8_t g_DMA_FLAGS_SHIFT[4] = {0, 6, 16, 22};
+
+/*NVIC line of each stream*/
+static const uint8_t g_DMA_IRQ_NUM[DMA_INSTANCES_NUM][DMA_STREAMS_NUM] = {
+		{11, 12, 13, 14, 15, 16, 17, 47},		/*DMA1*/
+		{56, 57, 58, 59, 60, 68, 69, 70},		/*DMA2*/
+};
+
+/*Owner channel and callback of each stream*/
+typedef struct{
+	uint8_t channel;		/*DMA_NO_OWNER: free*/
+	DMA_Callback_t callback;
+	void* context;
+}DMA_StreamState_t;
+
+static DMA_StreamState_t g_DMA_STREAMS[DMA_INSTANCES_NUM][DMA_STREAMS_NUM] = {
+		{{DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0},
+		 {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}},
+		{{DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0},
+		 {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}, {DMA_NO_OWNER, 0, 0}},
+};
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func DMA_ReadFlags
+ * @brief Returns the flags of a stream aligned to @DMA_ISR_FEIF ... DMA_ISR_TCIF.
+ *
+ * @note STATIC FUNCTION
+ */
+static uint32_t DMA_ReadFlags(DMA_t* instance, DMA_Stream_en stream){
+
+	uint32_t isr = (stream < 4) ? instance->LISR : instance->HISR;
+
+	return (isr >> g_DMA_FLAGS_SHIFT[stream % 4]) & DMA_STREAM_FLAGS_MASK;
+}
+
+/**
+ * @func DMA_ClearFlags
+ * @brief Clears the provided flags of a stream (all of them must be cleared before enabling it).
+ *
+ * @note STATIC FUNCTION
+ */
+static void DMA_ClearFlags(DMA_t* instance, DMA_Stream_en stream, uint32_t flags){
+
+	uint32_t mask = (flags << g_DMA_FLAGS_SHIFT[stream % 4]);
+
+	if(stream < 4){
+		instance->LIFCR = mask;
+	}else{
+		instance->HIFCR = mask;
+	}
+}
+
+/**
+ * @func DMA_Allocate
+ * @brief Reserves a stream for a request channel and enables the controller's clock.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t channel[IN]		-> request channel [0 - 7]
+ * @return uint8_t		1: reserved (or already reserved for the same channel), 0: conflict with another channel
+ */
+uint8_t DMA_Allocate(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+
+	DMA_StreamState_t* state = &g_DMA_STREAMS[dma][stream];
+
+	if((state->channel != DMA_NO_OWNER) && (state->channel != channel)){
+		return 0;
+	}
+	state->channel = channel;
+	RCC_EnableAHB1Clock(g_DMA_RCC[dma]);
+
+	return 1;
+}
+
+/**
+ * @func DMA_Free
+ * @brief Stops and releases a stream, nothing is done if the stream isn't owned by the provided channel.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t channel[IN]		-> request channel [0 - 7] used in DMA_Allocate()
+ * @return void
+ */
+void DMA_Free(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+
+	DMA_StreamState_t* state = &g_DMA_STREAMS[dma][stream];
+
+	if(state->channel != channel){
+		return;
+	}
+	DMA_Stop(dma, stream);
+	state->channel = DMA_NO_OWNER;
+	state->callback = 0;
+}
+
+/**
+ * @func DMA_Configure
+ * @brief Stops the stream and applies the configuration (the stream must be allocated).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	const DMA_StreamConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> DMA->STREAM[x].CR
+ * 				[♥] CHSEL[25:27]				Request channel
+ * 				[♥] MBURST/PBURST				Burst transfers (FIFO mode)
+ * 				[♥] PL, MSIZE, PSIZE, MINC, PINC, CIRC, DIR
+ * 				[♥] TCIE, HTIE, TEIE, DMEIE		Interrupts
+ * 			=> DMA->STREAM[x].FCR
+ * 				[♥] DMDIS, FTH[0:1]				FIFO mode and threshold
+ * 				[♥] FEIE						FIFO error interrupt
+ *
+ * @return void
+ */
+void DMA_Configure(DMA_Peripheral_en dma, DMA_Stream_en stream, const DMA_StreamConfig_t* config){
+
+	DMA_Stream_t* regs = &g_DMA_INSTANCES[dma]->STREAM[stream];
+	DMA_StreamState_t* state = &g_DMA_STREAMS[dma][stream];
+
+	DMA_Stop(dma, stream);
+
+	state->callback = config->callback;
+	state->context = config->context;
+
+	uint32_t cr = ((uint32_t)(config->channel & 0b111) << DMA_SxCR_CHSEL) |
+				  ((uint32_t)(config->priority & 0b11) << DMA_SxCR_PL) |
+				  ((uint32_t)(config->mem_size & 0b11) << DMA_SxCR_MSIZE) |
+				  ((uint32_t)(config->periph_size & 0b11) << DMA_SxCR_PSIZE) |
+				  ((uint32_t)(config->mem_inc & 1) << DMA_SxCR_MINC) |
+				  ((uint32_t)(config->periph_inc & 1) << DMA_SxCR_PINC) |
+				  ((uint32_t)(config->circular & 1) << DMA_SxCR_CIRC) |
+				  ((uint32_t)(config->direction & 0b11) << DMA_SxCR_DIR);
+	uint32_t fcr = 0;
+
+	if(config->fifo != DMA_FIFO_DIRECT){
+		fcr = (1UL << DMA_SxFCR_DMDIS) | ((uint32_t)(config->fifo & 0b11) << DMA_SxFCR_FTH);
+		//bursts only exist with the FIFO
+		cr |= ((uint32_t)(config->mem_burst & 0b11) << DMA_SxCR_MBURST) |
+			  ((uint32_t)(config->periph_burst & 0b11) << DMA_SxCR_PBURST);
+	}
+
+	if(config->interrupts & DMA_IT_HALF){
+		cr |= (1UL << DMA_SxCR_HTIE);
+	}
+	if(config->interrupts & DMA_IT_COMPLETE){
+		cr |= (1UL << DMA_SxCR_TCIE);
+	}
+	if(config->interrupts & DMA_IT_ERROR){
+		cr |= (1UL << DMA_SxCR_TEIE) | (1UL << DMA_SxCR_DMEIE);
+		if(config->fifo != DMA_FIFO_DIRECT){
+			fcr |= (1UL << DMA_SxFCR_FEIE);
+		}
+	}
+
+	regs->CR = cr;
+	regs->FCR = fcr;
+
+	if(config->interrupts != DMA_IT_NONE){
+		uint8_t irq_num = g_DMA_IRQ_NUM[dma][stream];
+		NVIC_EnableIRQ(irq_num);
+	}
+}
+
+/**
+ * @func DMA_Start
+ * @brief Starts a configured stream.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint32_t periph_addr[IN]	-> peripheral register (memory source in DMA_DIR_MEM_TO_MEM)
+ * @param	uint32_t mem_addr[IN]
+ * @param	uint16_t count[IN]			-> number of data items (of periph_size)
+ * @return void
+ */
+void DMA_Start(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem_addr, uint16_t count){
+
+	DMA_t* instance = g_DMA_INSTANCES[dma];
+	DMA_Stream_t* regs = &instance->STREAM[stream];
+
+	DMA_ClearFlags(instance, stream, DMA_STREAM_FLAGS_MASK);
+	CLEAR_BIT(regs->CR, DMA_SxCR_DBM);
+	regs->PAR = periph_addr;
+	regs->M0AR = mem_addr;
+	regs->NDTR = count;
+	SET_BIT(regs->CR, DMA_SxCR_EN);
+}
+
+/**
+ * @func DMA_StartDoubleBuffer
+ * @brief Starts a configured stream alternating between two memory buffers (DBM, circular).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint32_t periph_addr[IN]
+ * @param	uint32_t mem0_addr[IN]
+ * @param	uint32_t mem1_addr[IN]
+ * @param	uint16_t count[IN]			-> number of data items of each buffer
+ *
+ * #Important Registers:
+ * 			=> DMA->STREAM[x].CR
+ * 				[♥] DBM		Double buffer mode
+ * 				[♥] CT		Current target (0: M0AR, 1: M1AR)
+ *
+ * @return void
+ */
+void DMA_StartDoubleBuffer(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem0_addr,
+		uint32_t mem1_addr, uint16_t count){
+
+	DMA_t* instance = g_DMA_INSTANCES[dma];
+	DMA_Stream_t* regs = &instance->STREAM[stream];
+
+	DMA_ClearFlags(instance, stream, DMA_STREAM_FLAGS_MASK);
+	//DBM implies circular, starts on M0AR
+	regs->CR |= (1UL << DMA_SxCR_DBM) | (1UL << DMA_SxCR_CIRC);
+	CLEAR_BIT(regs->CR, DMA_SxCR_CT);
+	regs->PAR = periph_addr;
+	regs->M0AR = mem0_addr;
+	regs->M1AR = mem1_addr;
+	regs->NDTR = count;
+	SET_BIT(regs->CR, DMA_SxCR_EN);
+}
+
+/**
+ * @func DMA_Stop
+ * @brief Disables the stream and waits until the ongoing transfer is over.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return void
+ */
+void DMA_Stop(DMA_Peripheral_en dma, DMA_Stream_en stream){
+
+	DMA_t* instance = g_DMA_INSTANCES[dma];
+	DMA_Stream_t* regs = &instance->STREAM[stream];
+
+	CLEAR_BIT(regs->CR, DMA_SxCR_EN);
+	while(GET_BIT(regs->CR, DMA_SxCR_EN));
+	DMA_ClearFlags(instance, stream, DMA_STREAM_FLAGS_MASK);
+}
+
+/**
+ * @func DMA_IsEnabled
+ * @brief Checks if the stream is still running (a normal mode transfer disables it at its end).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint8_t		1: running, 0: stopped
+ */
+uint8_t DMA_IsEnabled(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	return GET_BIT(g_DMA_INSTANCES[dma]->STREAM[stream].CR, DMA_SxCR_EN);
+}
+
+/**
+ * @func DMA_GetRemaining
+ * @brief Returns the number of data items left (NDTR), e.g. a circular write position is count - NDTR.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint16_t
+ */
+uint16_t DMA_GetRemaining(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	return (uint16_t)g_DMA_INSTANCES[dma]->STREAM[stream].NDTR;
+}
+
+/**
+ * @func DMA_GetCurrentTarget
+ * @brief Returns the memory buffer in use in double buffer mode.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint8_t		0: mem0, 1: mem1
+ */
+uint8_t DMA_GetCurrentTarget(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	return GET_BIT(g_DMA_INSTANCES[dma]->STREAM[stream].CR, DMA_SxCR_CT);
+}
+
+/**
+ * @func DMA_SetMemory
+ * @brief Replaces a memory buffer of a double buffer stream, only the buffer not in use can be replaced.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t target[IN]		-> 0: mem0, 1: mem1
+ * @param	uint32_t mem_addr[IN]
+ * @return uint8_t		1: replaced, 0: the buffer is in use
+ */
+uint8_t DMA_SetMemory(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t target, uint32_t mem_addr){
+
+	DMA_Stream_t* regs = &g_DMA_INSTANCES[dma]->STREAM[stream];
+
+	//RM0090: writing the address in use while the stream is enabled is ignored and raises a TEIF
+	if(GET_BIT(regs->CR, DMA_SxCR_EN) && (GET_BIT(regs->CR, DMA_SxCR_CT) == target)){
+		return 0;
+	}
+	if(target == 0){
+		regs->M0AR = mem_addr;
+	}else{
+		regs->M1AR = mem_addr;
+	}
+	return 1;
+}
+
+/**
+ * @func DMA_IRQDispatch
+ * @brief Clears the pending flags of a stream and invokes its callback for each enabled event
+ * 		  (an error is reported alone).
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void DMA_IRQDispatch(DMA_Peripheral_en dma, DMA_Stream_en stream){
+
+	DMA_t* instance = g_DMA_INSTANCES[dma];
+	DMA_Stream_t* regs = &instance->STREAM[stream];
+	DMA_StreamState_t* state = &g_DMA_STREAMS[dma][stream];
+	uint32_t flags = DMA_ReadFlags(instance, stream);
+	uint32_t cr = regs->CR;
+
+	DMA_ClearFlags(instance, stream, flags);
+
+	if(state->callback == 0){
+		return;
+	}
+
+	if((GET_BIT(flags, DMA_ISR_TEIF) && GET_BIT(cr, DMA_SxCR_TEIE)) ||
+	   (GET_BIT(flags, DMA_ISR_DMEIF) && GET_BIT(cr, DMA_SxCR_DMEIE)) ||
+	   (GET_BIT(flags, DMA_ISR_FEIF) && GET_BIT(regs->FCR, DMA_SxFCR_FEIE))){
+		state->callback(state->context, DMA_EVENT_ERROR);
+		return;		//the callback may have restarted the stream, the other flags are stale
+	}
+	if(GET_BIT(flags, DMA_ISR_HTIF) && GET_BIT(cr, DMA_SxCR_HTIE)){
+		state->callback(state->context, DMA_EVENT_HALF);
+	}
+	if(GET_BIT(flags, DMA_ISR_TCIF) && GET_BIT(cr, DMA_SxCR_TCIE)){
+		state->callback(state->context, DMA_EVENT_COMPLETE);
+	}
+}
+
+
+/******************************* ISR *******************************/
+void DMA1_Stream0_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM0);
+}
+
+void DMA1_Stream1_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM1);
+}
+
+void DMA1_Stream2_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM2);
+}
+
+void DMA1_Stream3_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM3);
+}
+
+void DMA1_Stream4_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM4);
+}
+
+void DMA1_Stream5_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM5);
+}
+
+void DMA1_Stream6_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM6);
+}
+
+void DMA1_Stream7_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA1, DMA_STREAM7);
+}
+
+void DMA2_Stream0_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM0);
+}
+
+void DMA2_Stream1_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM1);
+}
+
+void DMA2_Stream2_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM2);
+}
+
+void DMA2_Stream3_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM3);
+}
+
+void DMA2_Stream4_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM4);
+}
+
+void DMA2_Stream5_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM5);
+}
+
+void DMA2_Stream6_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM6);
+}
+
+void DMA2_Stream7_IRQHandler(void){
+	DMA_IRQDispatch(DMA_DMA2, DMA_STREAM7);
+}
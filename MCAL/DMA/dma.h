@@ -0,0 +1,308 @@
+/**
+ * @file dma.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief DMA1/DMA2 streams' module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which DMA Stream ?
+ * 		[♥] -> A stream is chosen by passing DMA_Peripheral_en (DMA1/DMA2) and DMA_Stream_en (stream 0 - 7),
+ * 				DMA_Peripheral_en is used as an index of the g_DMA_INSTANCES that has the base addresses of both
+ * 				controllers.
+ * 		[♥] -> Each peripheral request is wired to fixed {controller, stream, channel} triplets (RM0090 tables 42/43),
+ * 				the drivers using DMA (TIM, SPI, I2C, ...) know their own triplets.
+ *
+ * # Allocation ?
+ * 		[♥] A stream serves one request (channel) at a time. DMA_Allocate() reserves it for a channel and fails if
+ * 			another channel already owns it, so two drivers can't silently fight over the same stream.
+ * 			Allocating again with the same channel succeeds (re-initialization of the same driver).
+ *
+ * # Usage Work Flow ?
+ * 		1. Call DMA_Allocate() and check its result.
+ * 		2. Make a {DMA_StreamConfig_t} variable and call DMA_Configure().
+ * 		3. Call DMA_Start() (or DMA_StartDoubleBuffer()), then DMA_Stop() when done.
+ * 		4. The callback (if any) is invoked from the stream's ISR with DMA_EVENT_HALF / COMPLETE / ERROR.
+ *
+ * # Double buffer ?
+ * 		[♥] DMA_StartDoubleBuffer() alternates between two memory buffers (circular), at each DMA_EVENT_COMPLETE
+ * 			DMA_GetCurrentTarget() tells which buffer the DMA is now using, the other one can be processed and
+ * 			replaced with DMA_SetMemory().
+ *
+ * # FIFO and burst ?
+ * 		[♥] DMA_FIFO_DIRECT (no FIFO) for single transfers, or a FIFO threshold to pack/unpack different
+ * 			peripheral/memory sizes and to allow bursts (a burst must fit in the FIFO threshold, RM0090 table 48).
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in dma.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef DMA_DMA_H_
+#define DMA_DMA_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup DMA_Direction_Options
+ */
+#define DMA_DIR_PERIPH_TO_MEM		(0b00)
+#define DMA_DIR_MEM_TO_PERIPH		(0b01)
+#define DMA_DIR_MEM_TO_MEM			(0b10)		/*DMA2 only, PAR is the source*/
+
+/**
+ * @defgroup DMA_Size_Options
+ */
+#define DMA_SIZE_BYTE				(0b00)
+#define DMA_SIZE_HALF_WORD			(0b01)
+#define DMA_SIZE_WORD				(0b10)
+
+/**
+ * @defgroup DMA_Priority_Options
+ */
+#define DMA_PRIORITY_LOW			(0b00)
+#define DMA_PRIORITY_MEDIUM			(0b01)
+#define DMA_PRIORITY_HIGH			(0b10)
+#define DMA_PRIORITY_VERY_HIGH		(0b11)
+
+/**
+ * @defgroup DMA_Increment_Options
+ */
+#define DMA_INCREMENT_DISABLED		(0)
+#define DMA_INCREMENT_ENABLED		(1)
+
+/**
+ * @defgroup DMA_Circular_Options
+ */
+#define DMA_CIRCULAR_DISABLED		(0)
+#define DMA_CIRCULAR_ENABLED		(1)
+
+/**
+ * @defgroup DMA_FIFO_Options
+ */
+#define DMA_FIFO_DIRECT				(0xFF)		/*direct mode*/
+#define DMA_FIFO_1_4				(0b00)		/*FIFO threshold*/
+#define DMA_FIFO_1_2				(0b01)
+#define DMA_FIFO_3_4				(0b10)
+#define DMA_FIFO_FULL				(0b11)
+
+/**
+ * @defgroup DMA_Burst_Options
+ */
+#define DMA_BURST_SINGLE			(0b00)
+#define DMA_BURST_INCR4				(0b01)
+#define DMA_BURST_INCR8				(0b10)
+#define DMA_BURST_INCR16			(0b11)
+
+/**
+ * @defgroup DMA_Interrupt_Options (OR-able)
+ */
+#define DMA_IT_NONE					(0)
+#define DMA_IT_HALF					(1 << 0)
+#define DMA_IT_COMPLETE				(1 << 1)
+#define DMA_IT_ERROR				(1 << 2)		/*transfer, direct mode and FIFO errors*/
+
+/**
+ * @defgroup DMA_Event_Options (callback's event)
+ */
+#define DMA_EVENT_HALF				(0)
+#define DMA_EVENT_COMPLETE			(1)
+#define DMA_EVENT_ERROR				(2)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+
+
+/******************************* Types *******************************/
+typedef enum{
+	DMA_DMA1 = 0,
+	DMA_DMA2,
+}DMA_Peripheral_en;
+
+typedef enum{
+	DMA_STREAM0 = 0,
+	DMA_STREAM1,
+	DMA_STREAM2,
+	DMA_STREAM3,
+	DMA_STREAM4,
+	DMA_STREAM5,
+	DMA_STREAM6,
+	DMA_STREAM7,
+}DMA_Stream_en;
+
+/**
+ * @brief Stream callback, invoked from the stream's ISR.
+ *
+ * @param void* context		-> the configuration's context
+ * @param uint8_t event		-> @defgroup DMA_Event_Options
+ */
+typedef void (*DMA_Callback_t)(void* context, uint8_t event);
+
+/**
+ * @struct DMA_StreamConfig_t
+ * @brief Stream configuration (everything but the addresses and the number of data items).
+ */
+typedef struct{
+	uint8_t channel;		/*request channel [0 - 7]*/
+	uint8_t direction;		/*choose out of @defgroup DMA_Direction_Options*/
+	uint8_t priority;		/*choose out of @defgroup DMA_Priority_Options*/
+	uint8_t periph_size;	/*choose out of @defgroup DMA_Size_Options*/
+	uint8_t mem_size;		/*choose out of @defgroup DMA_Size_Options*/
+	uint8_t periph_inc;		/*choose out of @defgroup DMA_Increment_Options*/
+	uint8_t mem_inc;		/*choose out of @defgroup DMA_Increment_Options*/
+	uint8_t circular;		/*choose out of @defgroup DMA_Circular_Options*/
+	uint8_t fifo;			/*choose out of @defgroup DMA_FIFO_Options*/
+	uint8_t periph_burst;	/*choose out of @defgroup DMA_Burst_Options (FIFO mode only)*/
+	uint8_t mem_burst;		/*choose out of @defgroup DMA_Burst_Options (FIFO mode only)*/
+	uint8_t interrupts;		/*choose out of @defgroup DMA_Interrupt_Options*/
+	DMA_Callback_t callback;	/*0: none*/
+	void* context;
+}DMA_StreamConfig_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func DMA_Allocate
+ * @brief Reserves a stream for a request channel and enables the controller's clock.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t channel[IN]		-> request channel [0 - 7]
+ * @return uint8_t		1: reserved (or already reserved for the same channel), 0: conflict with another channel
+ */
+uint8_t DMA_Allocate(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel);
+
+/**
+ * @func DMA_Free
+ * @brief Stops and releases a stream, nothing is done if the stream isn't owned by the provided channel.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t channel[IN]		-> request channel [0 - 7] used in DMA_Allocate()
+ * @return void
+ */
+void DMA_Free(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel);
+
+/**
+ * @func DMA_Configure
+ * @brief Stops the stream and applies the configuration (the stream must be allocated).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	const DMA_StreamConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> DMA->STREAM[x].CR
+ * 				[♥] CHSEL[25:27]				Request channel
+ * 				[♥] MBURST/PBURST				Burst transfers (FIFO mode)
+ * 				[♥] PL, MSIZE, PSIZE, MINC, PINC, CIRC, DIR
+ * 				[♥] TCIE, HTIE, TEIE, DMEIE		Interrupts
+ * 			=> DMA->STREAM[x].FCR
+ * 				[♥] DMDIS, FTH[0:1]				FIFO mode and threshold
+ * 				[♥] FEIE						FIFO error interrupt
+ *
+ * @return void
+ */
+void DMA_Configure(DMA_Peripheral_en dma, DMA_Stream_en stream, const DMA_StreamConfig_t* config);
+
+/**
+ * @func DMA_Start
+ * @brief Starts a configured stream.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint32_t periph_addr[IN]	-> peripheral register (memory source in DMA_DIR_MEM_TO_MEM)
+ * @param	uint32_t mem_addr[IN]
+ * @param	uint16_t count[IN]			-> number of data items (of periph_size)
+ * @return void
+ */
+void DMA_Start(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem_addr, uint16_t count);
+
+/**
+ * @func DMA_StartDoubleBuffer
+ * @brief Starts a configured stream alternating between two memory buffers (DBM, circular).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint32_t periph_addr[IN]
+ * @param	uint32_t mem0_addr[IN]
+ * @param	uint32_t mem1_addr[IN]
+ * @param	uint16_t count[IN]			-> number of data items of each buffer
+ *
+ * #Important Registers:
+ * 			=> DMA->STREAM[x].CR
+ * 				[♥] DBM		Double buffer mode
+ * 				[♥] CT		Current target (0: M0AR, 1: M1AR)
+ *
+ * @return void
+ */
+void DMA_StartDoubleBuffer(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem0_addr,
+		uint32_t mem1_addr, uint16_t count);
+
+/**
+ * @func DMA_Stop
+ * @brief Disables the stream and waits until the ongoing transfer is over.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return void
+ */
+void DMA_Stop(DMA_Peripheral_en dma, DMA_Stream_en stream);
+
+/**
+ * @func DMA_IsEnabled
+ * @brief Checks if the stream is still running (a normal mode transfer disables it at its end).
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint8_t		1: running, 0: stopped
+ */
+uint8_t DMA_IsEnabled(DMA_Peripheral_en dma, DMA_Stream_en stream);
+
+/**
+ * @func DMA_GetRemaining
+ * @brief Returns the number of data items left (NDTR), e.g. a circular write position is count - NDTR.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint16_t
+ */
+uint16_t DMA_GetRemaining(DMA_Peripheral_en dma, DMA_Stream_en stream);
+
+/**
+ * @func DMA_GetCurrentTarget
+ * @brief Returns the memory buffer in use in double buffer mode.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @return uint8_t		0: mem0, 1: mem1
+ */
+uint8_t DMA_GetCurrentTarget(DMA_Peripheral_en dma, DMA_Stream_en stream);
+
+/**
+ * @func DMA_SetMemory
+ * @brief Replaces a memory buffer of a double buffer stream, only the buffer not in use can be replaced.
+ *
+ * @param	DMA_Peripheral_en dma[IN]
+ * @param	DMA_Stream_en stream[IN]
+ * @param	uint8_t target[IN]		-> 0: mem0, 1: mem1
+ * @param	uint32_t mem_addr[IN]
+ * @return uint8_t		1: replaced, 0: the buffer is in use
+ */
+uint8_t DMA_SetMemory(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t target, uint32_t mem_addr);
+
+
+#endif /* DMA_DMA_H_ */
@@ -12,6 +12,7 @@
 /******************** Includes and Macros ********************/
 #include "gpio.h"
 #include "bit_math.h"
+#include "common_lib.h"
 
 /******************** Functions Implementation ********************/
 
@@ -153,4 +154,22 @@ GPIO_Pin_State_en GPIO_GetPinState(GPIO_t* port, GPIO_Pin_en pin){
 
 }
 
+/**
+ * @func GPIO_TogglePin
+ * @brief Inverts the output state of the specified pin (fast path, executed from SRAM).
+ *
+ * @param GPIO_t* port[in]				Pointer to the Specified the targeted port
+ * @param GPIO_Pin_en pin[in]			Specifies the targeted pin
+ *
+ * @return void
+ */
+LIB_RAMFUNC void GPIO_TogglePin(GPIO_t* port, GPIO_Pin_en pin){
+/*
+ * - One BSRR write: reset the pin if it is high, set it otherwise
+ * */
+	uint32_t odr = port->ODR;
+
+	port->BSRR = ((odr & (1UL << pin)) << 16) | (~odr & (1UL << pin));
+}
+
 
@@ -249,6 +249,17 @@ void GPIO_SetPinState(GPIO_t* port, GPIO_Pin_en pin, GPIO_Pin_State_en state);
  */
 GPIO_Pin_State_en GPIO_GetPinState(GPIO_t* port, GPIO_Pin_en pin);
 
+/**
+ * @func GPIO_TogglePin
+ * @brief Inverts the output state of the specified pin (fast path, executed from SRAM).
+ *
+ * @param GPIO_t* port[in]				Pointer to the Specified the targeted port
+ * @param GPIO_Pin_en pin[in]			Specifies the targeted pin
+ *
+ * @return void
+ */
+void GPIO_TogglePin(GPIO_t* port, GPIO_Pin_en pin);
+
 
 
 
@@ -0,0 +1,739 @@
+/**
+ * @file i2c.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief I2C master module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which I2C Instance ?
+ * 		[♥] -> We choose which I2C instance to work with during whatever API we're working with by passing
+ * 				I2C_Peripheral_en of the dedicated instance.
+ * 			->I2C_Peripheral_en is used as an index of the g_I2C_INSTANCES that has the base addresses of
+ * 				All I2C instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] PCLK1 is configured @Configurations section in the header (i2c.h) file, it must match the RCC APB1
+ *			prescaler, FREQ/CCR/TRISE are computed from it (at least 2 MHz for standard mode, 4 MHz for fast mode).
+ *
+ * # Usage Work Flow ?
+ * 		1. Configure SCL/SDA as alternate function AF4, open-drain (with pull-ups), using GPIO_SetPinAF().
+ * 			(DISC board CS43L22: I2C1 on PB6/PB9, address 0x4A)
+ * 		2. Make a {I2C_Config_t} variable and call I2C_Init().
+ * 		3. Make a {I2C_Transaction_t} variable for each transaction and call I2C_Queue(),
+ * 			or use I2C_WriteReadBlocking().
+ *
+ * # Transactions queue ?
+ * 		[♥] A transaction is a write phase, then a repeated start and a read phase (any of them can be empty,
+ * 			both empty is an address probe). The whole sequence runs from the event/error interrupts, the
+ * 			callback gets the transaction's status and the next queued transaction starts right after.
+ * 		[♥] Reads of at least I2C_DMA_THRESHOLD bytes use DMA (LAST bit NACKs the final byte by hardware):
+ * 				I2C1 -> DMA1 stream 5 channel 1
+ * 				I2C2 -> DMA1 stream 2 channel 7
+ * 				I2C3 -> DMA1 stream 2 channel 3 (shared with I2C2)
+ * 			The stream is allocated by I2C_Init() through the DMA driver, if another driver already owns it
+ * 			(e.g. I2C2 and I2C3 both initialized) the instance falls back to byte by byte reads.
+ * 		[♥] The queue holds copies of the descriptors, the tx/rx buffers must stay valid until the callback.
+ *
+ * # Errors recovery ?
+ * 		[♥] NACK (AF)				-> STOP, the transaction completes with I2C_STATUS_NACK.
+ * 		[♥] Arbitration lost		-> retried up to I2C_ARBITRATION_RETRIES times, then I2C_STATUS_ARBITRATION_LOST.
+ * 		[♥] Bus error / stuck bus	-> I2C_RecoverBus(): 9 SCL pulses by GPIO to release a slave holding SDA, a STOP,
+ * 									   then a peripheral software reset (~100 uS). It only runs from thread context
+ * 									   with interrupts enabled: before the first transaction of an idle queue if the
+ * 									   bus is seen busy while nobody is master, and after a bus error (the error ISR
+ * 									   or a DMA read error completes the transaction with I2C_STATUS_BUS_ERROR and
+ * 									   parks the queue, the next I2C_Queue()/I2C_IsIdle() call recovers the bus and
+ * 									   restarts it).
+ * 		[♥] I2C_Queue() may wait for the bus and recover it, don't call it from an ISR or a critical section.
+ *
+ * # Master receiver sequences (RM0090 27.3.3, the last bytes must be NACKed before they're received) ?
+ * 		[♥] 1 byte	-> ACK = 0 before clearing ADDR, STOP right after, read at RXNE.
+ * 		[♥] 2 bytes	-> POS = 1 and ACK = 0 before clearing ADDR, at BTF: STOP then read both.
+ * 		[♥] N > 2	-> RXNE per byte until 3 are left, at BTF: ACK = 0 and read N-2, at the next BTF: STOP then
+ * 					   read the last two.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "i2c.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define I2C_INSTANCES_NUM			(3)
+
+#define I2C_PHASE_WRITE				(0)
+#define I2C_PHASE_READ				(1)
+
+#define I2C_MIN_CCR_STANDARD		(4)
+#define I2C_MIN_CCR_FAST			(1)
+#define I2C_MAX_RISE_NS_STANDARD	(1000UL)
+#define I2C_MAX_RISE_NS_FAST		(300UL)
+
+/*Bounded polling of the STOP/BUSY bits (a few bit times at 100 kHz)*/
+#define I2C_WAIT_LOOPS				(10000UL)
+
+#define I2C_RECOVERY_CLOCKS			(9)
+#define I2C_RECOVERY_HALF_BIT_US	(5)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static I2C_t* const g_I2C_INSTANCES[I2C_INSTANCES_NUM] = {I2C1, I2C2, I2C3};
+
+static const RCC_APB1PERIPH_en g_I2C_RCC[I2C_INSTANCES_NUM] = {RCC_APB1_I2C1, RCC_APB1_I2C2, RCC_APB1_I2C3};
+
+/*NVIC lines: event and error*/
+static const uint8_t g_I2C_EV_IRQ_NUM[I2C_INSTANCES_NUM] = {31, 33, 72};
+static const uint8_t g_I2C_ER_IRQ_NUM[I2C_INSTANCES_NUM] = {32, 34, 73};
+
+/*RX DMA request of each I2C (DMA1)*/
+typedef struct{
+	DMA_Stream_en stream;
+	uint8_t channel;
+}I2C_DmaRequest_t;
+
+static const I2C_DmaRequest_t g_I2C_RX_DMA[I2C_INSTANCES_NUM] = {
+		{DMA_STREAM5, 1},		/*I2C1*/
+		{DMA_STREAM2, 7},		/*I2C2*/
+		{DMA_STREAM2, 3},		/*I2C3*/
+};
+
+/*Transactions queue and the sequence state of each instance*/
+typedef struct{
+	I2C_Transaction_t queue[I2C_QUEUE_SIZE];
+	uint8_t head;
+	volatile uint8_t count;		/*queued transactions, the one at head is running while count != 0*/
+	uint8_t phase;				/*I2C_PHASE_WRITE / I2C_PHASE_READ*/
+	uint8_t addressed;			/*ADDR seen in the current phase, data events before it are stale*/
+	uint8_t dma_allocated;		/*the RX stream is owned, reads of at least I2C_DMA_THRESHOLD bytes use it*/
+	uint8_t dma_active;
+	uint8_t retries;
+	volatile uint8_t parked;	/*transactions queued but none started, the next thread call starts the head*/
+	volatile uint8_t recover;	/*a bus error was seen, the bus is recovered before the next START*/
+	uint16_t index;				/*bytes done in the current phase*/
+	I2C_Config_t config;
+}I2C_State_t;
+
+static I2C_State_t g_I2C_STATES[I2C_INSTANCES_NUM];
+
+static void I2C_RxDmaCallback(void* dma_context, uint8_t event);
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func I2C_Configure
+ * @brief Applies the timing (FREQ, CCR, TRISE) and enables the peripheral.
+ *
+ * @note STATIC FUNCTION
+ * @return uint32_t		actual SCL frequency
+ */
+static uint32_t I2C_Configure(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	uint32_t speed = g_I2C_STATES[i2c].config.speed_hz;
+	uint32_t freq_mhz = I2C_APB1_CLOCK / 1000000UL;
+	uint32_t ccr;
+	uint32_t actual;
+
+	instance->CR1 = 0;
+	instance->CR2 = (freq_mhz << I2C_CR2_FREQ);
+
+	if(speed <= I2C_SPEED_STANDARD){
+		//t_high = t_low = CCR x T_PCLK1, rounded up so SCL never exceeds speed
+		ccr = (I2C_APB1_CLOCK + (2 * speed) - 1) / (2 * speed);
+		if(ccr < I2C_MIN_CCR_STANDARD){
+			ccr = I2C_MIN_CCR_STANDARD;
+		}
+		instance->CCR = (ccr << I2C_CCR_CCR);
+		instance->TRISE = ((freq_mhz * I2C_MAX_RISE_NS_STANDARD) / 1000UL) + 1;
+		actual = I2C_APB1_CLOCK / (2 * ccr);
+	}else{
+		//DUTY = 0: t_high = CCR x T_PCLK1, t_low = 2 x CCR x T_PCLK1
+		ccr = (I2C_APB1_CLOCK + (3 * speed) - 1) / (3 * speed);
+		if(ccr < I2C_MIN_CCR_FAST){
+			ccr = I2C_MIN_CCR_FAST;
+		}
+		instance->CCR = (1UL << I2C_CCR_FS) | (ccr << I2C_CCR_CCR);
+		instance->TRISE = ((freq_mhz * I2C_MAX_RISE_NS_FAST) / 1000UL) + 1;
+		actual = I2C_APB1_CLOCK / (3 * ccr);
+	}
+
+	SET_BIT(instance->CR1, I2C_CR1_PE);
+
+	return actual;
+}
+
+/**
+ * @func I2C_WaitStopSent
+ * @brief Waits (bounded) until the hardware has generated a requested STOP.
+ *
+ * @note STATIC FUNCTION
+ */
+static void I2C_WaitStopSent(I2C_t* instance){
+	for(uint32_t i = 0; (i < I2C_WAIT_LOOPS) && GET_BIT(instance->CR1, I2C_CR1_STOP); i++);
+}
+
+/**
+ * @func I2C_DelayUs
+ * @brief Busy-waits on the DWT cycle counter, SysTick may belong to a scheduler/kernel.
+ *
+ * @note STATIC FUNCTION
+ */
+static void I2C_DelayUs(uint32_t us){
+
+	uint32_t start = LIB_CycleCounterRead();
+	uint32_t cycles = us * (I2C_CPU_CLOCK / 1000000UL);
+
+	while((LIB_CycleCounterRead() - start) < cycles);
+}
+
+/**
+ * @func I2C_StartHead
+ * @brief Starts (or restarts) the transaction at the queue head with a START condition.
+ *
+ * @note STATIC FUNCTION, called with the queue not empty, from a critical section or an I2C/DMA ISR
+ */
+static void I2C_StartHead(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	const I2C_Transaction_t* transaction = &state->queue[state->head];
+
+	//an address probe (no data) is done as an empty write
+	state->phase = ((transaction->tx_len != 0) || (transaction->rx_len == 0)) ? I2C_PHASE_WRITE : I2C_PHASE_READ;
+	state->index = 0;
+	state->addressed = 0;
+	state->dma_active = 0;
+
+	instance->CR2 &= ~((1UL << I2C_CR2_ITBUFEN) | (1UL << I2C_CR2_DMAEN) | (1UL << I2C_CR2_LAST));
+	instance->CR2 |= (1UL << I2C_CR2_ITEVTEN) | (1UL << I2C_CR2_ITERREN);
+	CLEAR_BIT(instance->CR1, I2C_CR1_POS);
+	SET_BIT(instance->CR1, I2C_CR1_ACK);
+	SET_BIT(instance->CR1, I2C_CR1_START);
+}
+
+/**
+ * @func I2C_Complete
+ * @brief Ends the transaction at the queue head, starts the next one then invokes the callback.
+ * 		  After a bus error the next one is parked instead, the bus is recovered from thread context first.
+ *
+ * @note STATIC FUNCTION, the STOP (if any) must already be requested
+ */
+static void I2C_Complete(I2C_Peripheral_en i2c, uint8_t status){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	const I2C_Transaction_t* transaction = &state->queue[state->head];
+
+	instance->CR2 &= ~((1UL << I2C_CR2_ITEVTEN) | (1UL << I2C_CR2_ITBUFEN) | (1UL << I2C_CR2_ITERREN) |
+					   (1UL << I2C_CR2_DMAEN) | (1UL << I2C_CR2_LAST));
+	if(state->dma_active){
+		DMA_Stop(DMA_DMA1, g_I2C_RX_DMA[i2c].stream);
+		state->dma_active = 0;
+	}
+
+	I2C_Callback_t callback = transaction->callback;
+	void* context = transaction->context;
+
+	state->retries = 0;
+	state->head = (state->head + 1) % I2C_QUEUE_SIZE;
+	state->count--;
+	if(state->recover){
+		state->parked = (state->count != 0);
+	}else if(state->count != 0){
+		//a START requested before the pending STOP is sent would be a repeated start
+		I2C_WaitStopSent(instance);
+		I2C_StartHead(i2c);
+	}
+
+	if(callback != 0){
+		callback(context, status);
+	}
+}
+
+/**
+ * @func I2C_Init
+ * @brief Initializes the provided I2C as master and enables its interrupts.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	const I2C_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> I2C->CR2
+ * 				[♥] FREQ[0:5]	PCLK1 in MHz
+ * 			=> I2C->CCR
+ * 				[♥] F/S			Fast mode (> 100 kHz), DUTY = 0: t_low = 2 x t_high
+ * 				[♥] CCR[0:11]	Standard: PCLK1 / (2 x speed), fast: PCLK1 / (3 x speed), rounded up
+ * 			=> I2C->TRISE
+ * 				[♥] Max rise time + 1 in PCLK1 cycles: 1000 ns (standard) / 300 ns (fast)
+ *
+ * @return uint32_t		actual SCL frequency
+ */
+uint32_t I2C_Init(I2C_Peripheral_en i2c, const I2C_Config_t* config){
+
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	const I2C_DmaRequest_t* request = &g_I2C_RX_DMA[i2c];
+	DMA_StreamConfig_t dma_config = {
+			.channel = request->channel,
+			.direction = DMA_DIR_PERIPH_TO_MEM,
+			.priority = DMA_PRIORITY_HIGH,
+			.periph_size = DMA_SIZE_BYTE,
+			.mem_size = DMA_SIZE_BYTE,
+			.periph_inc = DMA_INCREMENT_DISABLED,
+			.mem_inc = DMA_INCREMENT_ENABLED,
+			.circular = DMA_CIRCULAR_DISABLED,
+			.fifo = DMA_FIFO_DIRECT,
+			.interrupts = DMA_IT_COMPLETE | DMA_IT_ERROR,
+			.callback = I2C_RxDmaCallback,
+			.context = state,
+	};
+
+	RCC_EnableAPB1Clock(g_I2C_RCC[i2c]);
+
+	//reads stay byte by byte if the stream is owned by another driver
+	state->dma_allocated = DMA_Allocate(DMA_DMA1, request->stream, request->channel);
+	if(state->dma_allocated){
+		DMA_Configure(DMA_DMA1, request->stream, &dma_config);
+	}
+
+	state->config = *config;
+	state->head = 0;
+	state->count = 0;
+	state->retries = 0;
+	state->parked = 0;
+	state->recover = 0;
+
+	//software reset: clears a BUSY flag left by a previous session
+	SET_BIT(instance->CR1, I2C_CR1_SWRST);
+	CLEAR_BIT(instance->CR1, I2C_CR1_SWRST);
+	uint32_t actual = I2C_Configure(i2c);
+
+	NVIC_EnableIRQ(g_I2C_EV_IRQ_NUM[i2c]);
+	NVIC_EnableIRQ(g_I2C_ER_IRQ_NUM[i2c]);
+
+	return actual;
+}
+
+/**
+ * @func I2C_Resume
+ * @brief Starts a parked queue head: waits for the bus, recovers it if a slave holds it (or after a bus error),
+ * 		  then sends the START.
+ *
+ * @note STATIC FUNCTION, thread context only: the wait and the recovery run with interrupts enabled
+ */
+static void I2C_Resume(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+
+	if(!state->parked){
+		return;
+	}
+
+	//only one caller takes the parked head, nothing else touches the queue head while it's parked
+	uint32_t primask = LIB_EnterCritical();
+	uint8_t owner = state->parked;
+	state->parked = 0;
+	LIB_ExitCritical(primask);
+	if(!owner){
+		return;
+	}
+
+	//the bus should be free once the last STOP is out, otherwise a slave is holding it
+	uint32_t i = 0;
+	while((i < I2C_WAIT_LOOPS) && GET_BIT(instance->SR2, I2C_SR2_BUSY)){
+		i++;
+	}
+	if(state->recover || (GET_BIT(instance->SR2, I2C_SR2_BUSY) && !GET_BIT(instance->SR2, I2C_SR2_MSL))){
+		state->recover = 0;
+		I2C_RecoverBus(i2c);
+	}
+
+	primask = LIB_EnterCritical();
+	I2C_StartHead(i2c);
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func I2C_Queue
+ * @brief Adds a transaction to the instance's queue, it starts at once if the I2C is idle.
+ * @note Thread context only, starting an idle queue may wait for the bus and recover it (interrupts enabled).
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	const I2C_Transaction_t* transaction[IN]	-> copied, can be a local variable
+ * @return uint8_t		1: queued, 0: the queue is full
+ */
+uint8_t I2C_Queue(I2C_Peripheral_en i2c, const I2C_Transaction_t* transaction){
+
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+
+	uint32_t primask = LIB_EnterCritical();
+	if(state->count >= I2C_QUEUE_SIZE){
+		LIB_ExitCritical(primask);
+		return 0;
+	}
+
+	state->queue[(state->head + state->count) % I2C_QUEUE_SIZE] = *transaction;
+	state->count++;
+
+	//idle: parked until the bus is checked, outside of the critical section
+	if(state->count == 1){
+		state->parked = 1;
+	}
+	LIB_ExitCritical(primask);
+
+	I2C_Resume(i2c);
+
+	return 1;
+}
+
+/**
+ * @func I2C_IsIdle
+ * @brief Checks if all the queued transactions are done, restarts a queue parked by a bus error.
+ * @note Thread context only (see I2C_Queue()).
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t I2C_IsIdle(I2C_Peripheral_en i2c){
+	I2C_Resume(i2c);
+	return (g_I2C_STATES[i2c].count == 0);
+}
+
+/**
+ * @func I2C_BlockingCallback
+ * @brief Stores the status of a blocking transaction.
+ *
+ * @note STATIC FUNCTION
+ */
+static void I2C_BlockingCallback(void* context, uint8_t status){
+	*(volatile uint8_t*)context = status;
+}
+
+/**
+ * @func I2C_WriteReadBlocking
+ * @brief Queues a transaction and waits for its completion.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	uint8_t address[IN]		-> 7-bit address
+ * @param	const uint8_t* tx[IN]
+ * @param	uint16_t tx_len[IN]
+ * @param	uint8_t* rx[OUT]
+ * @param	uint16_t rx_len[IN]
+ * @return uint8_t		@defgroup I2C_Status_Options
+ */
+uint8_t I2C_WriteReadBlocking(I2C_Peripheral_en i2c, uint8_t address, const uint8_t* tx, uint16_t tx_len,
+		uint8_t* rx, uint16_t rx_len){
+
+	volatile uint8_t status = 0xFF;
+	I2C_Transaction_t transaction = {address, tx, tx_len, rx, rx_len, I2C_BlockingCallback, (void*)&status};
+
+	while(!I2C_Queue(i2c, &transaction));
+	//a bus error ahead of this transaction parks the queue until a thread call restarts it
+	while(status == 0xFF){
+		I2C_Resume(i2c);
+	}
+
+	return status;
+}
+
+/**
+ * @func I2C_RecoverBus
+ * @brief Releases a bus held by a slave (9 SCL pulses then a STOP by GPIO) and resets the peripheral.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ *
+ * #Important Registers:
+ * 			=> I2C->CR1
+ * 				[♥] SWRST	Software reset, clears a BUSY flag stuck after a glitch
+ *
+ * @return void
+ */
+void I2C_RecoverBus(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	const I2C_Config_t* config = &g_I2C_STATES[i2c].config;
+
+	//the half bit delays use the DWT, enabled here if the application didn't (it's left running otherwise)
+	if(!GET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA)){
+		LIB_CycleCounterEnable();
+	}
+
+	CLEAR_BIT(instance->CR1, I2C_CR1_PE);
+
+	//the pins stay open-drain, only their mode changes
+	GPIO_SetPinState(config->scl_port, config->scl_pin, GPIO_HIGH);
+	GPIO_SetPinState(config->sda_port, config->sda_pin, GPIO_HIGH);
+	GPIO_SetPinMode(config->scl_port, config->scl_pin, GPIO_OUTPUT);
+	GPIO_SetPinMode(config->sda_port, config->sda_pin, GPIO_OUTPUT);
+
+	//a slave in the middle of a read releases SDA after at most 9 clocks
+	for(uint8_t i = 0; i < I2C_RECOVERY_CLOCKS; i++){
+		if(GPIO_GetPinState(config->sda_port, config->sda_pin) == GPIO_HIGH){
+			break;
+		}
+		GPIO_SetPinState(config->scl_port, config->scl_pin, GPIO_LOW);
+		I2C_DelayUs(I2C_RECOVERY_HALF_BIT_US);
+		GPIO_SetPinState(config->scl_port, config->scl_pin, GPIO_HIGH);
+		I2C_DelayUs(I2C_RECOVERY_HALF_BIT_US);
+	}
+
+	//STOP: SDA rising while SCL is high
+	GPIO_SetPinState(config->sda_port, config->sda_pin, GPIO_LOW);
+	I2C_DelayUs(I2C_RECOVERY_HALF_BIT_US);
+	GPIO_SetPinState(config->sda_port, config->sda_pin, GPIO_HIGH);
+	I2C_DelayUs(I2C_RECOVERY_HALF_BIT_US);
+
+	GPIO_SetPinMode(config->scl_port, config->scl_pin, GPIO_AF);
+	GPIO_SetPinMode(config->sda_port, config->sda_pin, GPIO_AF);
+
+	SET_BIT(instance->CR1, I2C_CR1_SWRST);
+	CLEAR_BIT(instance->CR1, I2C_CR1_SWRST);
+	I2C_Configure(i2c);
+}
+
+/**
+ * @func I2C_StartDmaRead
+ * @brief Hands the read phase to the RX DMA stream (called at ADDR, before clearing it).
+ *
+ * @note STATIC FUNCTION
+ */
+static void I2C_StartDmaRead(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	const I2C_Transaction_t* transaction = &state->queue[state->head];
+
+	//configured once by I2C_Init(): DR -> rx, bytes, TC/TE interrupts
+	DMA_Start(DMA_DMA1, g_I2C_RX_DMA[i2c].stream, (uint32_t)&instance->DR, (uint32_t)transaction->rx,
+			  transaction->rx_len);
+
+	state->dma_active = 1;
+	//LAST: the byte matching the DMA's last transfer is NACKed by hardware
+	instance->CR2 |= (1UL << I2C_CR2_DMAEN) | (1UL << I2C_CR2_LAST);
+}
+
+/**
+ * @func I2C_EventIRQHandler
+ * @brief Runs the master sequence of the transaction at the queue head.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void I2C_EventIRQHandler(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	uint32_t sr1 = instance->SR1;
+
+	if(state->count == 0){
+		CLEAR_BIT(instance->CR2, I2C_CR2_ITEVTEN);
+		return;
+	}
+	const I2C_Transaction_t* transaction = &state->queue[state->head];
+
+	/*Start sent: address + direction (SB cleared by reading SR1 then writing DR)*/
+	if(GET_BIT(sr1, I2C_SR1_SB)){
+		instance->DR = ((uint32_t)transaction->address << 1) | state->phase;
+		return;
+	}
+
+	/*Address acknowledged: prepare the phase before clearing ADDR (reading SR1 then SR2)*/
+	if(GET_BIT(sr1, I2C_SR1_ADDR)){
+		state->addressed = 1;
+
+		if(state->phase == I2C_PHASE_WRITE){
+			(void)instance->SR2;
+			if(transaction->tx_len == 0){
+				//address probe
+				SET_BIT(instance->CR1, I2C_CR1_STOP);
+				I2C_Complete(i2c, I2C_STATUS_OK);
+			}else{
+				instance->DR = transaction->tx[state->index++];
+				if(state->index < transaction->tx_len){
+					SET_BIT(instance->CR2, I2C_CR2_ITBUFEN);
+				}
+			}
+		}else if(state->dma_allocated && (transaction->rx_len >= I2C_DMA_THRESHOLD)){
+			I2C_StartDmaRead(i2c);
+			(void)instance->SR2;
+		}else if(transaction->rx_len == 1){
+			CLEAR_BIT(instance->CR1, I2C_CR1_ACK);
+			(void)instance->SR2;
+			SET_BIT(instance->CR1, I2C_CR1_STOP);
+			SET_BIT(instance->CR2, I2C_CR2_ITBUFEN);
+		}else if(transaction->rx_len == 2){
+			SET_BIT(instance->CR1, I2C_CR1_POS);
+			CLEAR_BIT(instance->CR1, I2C_CR1_ACK);
+			(void)instance->SR2;
+		}else{
+			(void)instance->SR2;
+			if(transaction->rx_len > 3){
+				SET_BIT(instance->CR2, I2C_CR2_ITBUFEN);
+			}
+		}
+		return;
+	}
+
+	if(!state->addressed){
+		return;
+	}
+
+	/*Write phase*/
+	if(state->phase == I2C_PHASE_WRITE){
+		if(state->index < transaction->tx_len){
+			if(GET_BIT(sr1, I2C_SR1_TXE)){
+				instance->DR = transaction->tx[state->index++];
+				if(state->index == transaction->tx_len){
+					//wait for BTF: the last byte fully shifted out
+					CLEAR_BIT(instance->CR2, I2C_CR2_ITBUFEN);
+				}
+			}
+		}else if(GET_BIT(sr1, I2C_SR1_BTF)){
+			if(transaction->rx_len != 0){
+				state->phase = I2C_PHASE_READ;
+				state->index = 0;
+				state->addressed = 0;
+				SET_BIT(instance->CR1, I2C_CR1_START);
+			}else{
+				SET_BIT(instance->CR1, I2C_CR1_STOP);
+				I2C_Complete(i2c, I2C_STATUS_OK);
+			}
+		}
+		return;
+	}
+
+	/*Read phase (byte by byte)*/
+	if(state->dma_active){
+		return;
+	}
+
+	uint16_t remaining = transaction->rx_len - state->index;
+
+	if(remaining > 3){
+		if(GET_BIT(sr1, I2C_SR1_RXNE)){
+			transaction->rx[state->index++] = (uint8_t)instance->DR;
+			if((transaction->rx_len - state->index) == 3){
+				CLEAR_BIT(instance->CR2, I2C_CR2_ITBUFEN);
+			}
+		}
+	}else if(remaining == 3){
+		if(GET_BIT(sr1, I2C_SR1_BTF)){
+			//N-2 in DR, N-1 in the shift register: NACK the last one
+			CLEAR_BIT(instance->CR1, I2C_CR1_ACK);
+			transaction->rx[state->index++] = (uint8_t)instance->DR;
+		}
+	}else if(remaining == 2){
+		if(GET_BIT(sr1, I2C_SR1_BTF)){
+			SET_BIT(instance->CR1, I2C_CR1_STOP);
+			transaction->rx[state->index++] = (uint8_t)instance->DR;
+			transaction->rx[state->index++] = (uint8_t)instance->DR;
+			CLEAR_BIT(instance->CR1, I2C_CR1_POS);
+			I2C_Complete(i2c, I2C_STATUS_OK);
+		}
+	}else{
+		if(GET_BIT(sr1, I2C_SR1_RXNE)){
+			transaction->rx[state->index++] = (uint8_t)instance->DR;
+			I2C_Complete(i2c, I2C_STATUS_OK);
+		}
+	}
+}
+
+/**
+ * @func I2C_ErrorIRQHandler
+ * @brief NACK, arbitration loss and bus error handling.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void I2C_ErrorIRQHandler(I2C_Peripheral_en i2c){
+
+	I2C_t* instance = g_I2C_INSTANCES[i2c];
+	I2C_State_t* state = &g_I2C_STATES[i2c];
+	uint32_t sr1 = instance->SR1;
+
+	//rc_w0 flags
+	instance->SR1 = ~(sr1 & ((1UL << I2C_SR1_BERR) | (1UL << I2C_SR1_ARLO) | (1UL << I2C_SR1_AF) |
+							 (1UL << I2C_SR1_OVR)));
+
+	if(state->count == 0){
+		return;
+	}
+
+	if(GET_BIT(sr1, I2C_SR1_BERR)){
+		//the recovery (~100 uS of GPIO clocking) is left to the next thread call, the queue is parked until then
+		state->recover = 1;
+		I2C_Complete(i2c, I2C_STATUS_BUS_ERROR);
+	}else if(GET_BIT(sr1, I2C_SR1_ARLO)){
+		//the peripheral is already back in slave mode, START waits for the bus to be free
+		if(state->retries < I2C_ARBITRATION_RETRIES){
+			state->retries++;
+			if(state->dma_active){
+				DMA_Stop(DMA_DMA1, g_I2C_RX_DMA[i2c].stream);
+			}
+			I2C_StartHead(i2c);
+		}else{
+			I2C_Complete(i2c, I2C_STATUS_ARBITRATION_LOST);
+		}
+	}else if(GET_BIT(sr1, I2C_SR1_AF)){
+		SET_BIT(instance->CR1, I2C_CR1_STOP);
+		I2C_Complete(i2c, I2C_STATUS_NACK);
+	}
+}
+
+/**
+ * @func I2C_RxDmaCallback
+ * @brief DMA read completion (DMA ISR): STOP and end of the transaction.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void I2C_RxDmaCallback(void* dma_context, uint8_t event){
+
+	I2C_State_t* state = (I2C_State_t*)dma_context;
+	I2C_Peripheral_en i2c = (I2C_Peripheral_en)(state - g_I2C_STATES);
+
+	if(!state->dma_active || (state->count == 0)){
+		return;
+	}
+
+	SET_BIT(g_I2C_INSTANCES[i2c]->CR1, I2C_CR1_STOP);
+	if(event == DMA_EVENT_ERROR){
+		//reported as a bus error: recovered the same way before the next START (from thread context)
+		state->recover = 1;
+		I2C_Complete(i2c, I2C_STATUS_BUS_ERROR);
+	}else{
+		I2C_Complete(i2c, I2C_STATUS_OK);
+	}
+}
+
+
+/******************************* ISR *******************************/
+void I2C1_EV_IRQHandler(void){
+	I2C_EventIRQHandler(I2C_I2C1);
+}
+
+void I2C1_ER_IRQHandler(void){
+	I2C_ErrorIRQHandler(I2C_I2C1);
+}
+
+void I2C2_EV_IRQHandler(void){
+	I2C_EventIRQHandler(I2C_I2C2);
+}
+
+void I2C2_ER_IRQHandler(void){
+	I2C_ErrorIRQHandler(I2C_I2C2);
+}
+
+void I2C3_EV_IRQHandler(void){
+	I2C_EventIRQHandler(I2C_I2C3);
+}
+
+void I2C3_ER_IRQHandler(void){
+	I2C_ErrorIRQHandler(I2C_I2C3);
+}
+
@@ -0,0 +1,220 @@
+/**
+ * @file i2c.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief I2C master module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which I2C Instance ?
+ * 		[♥] -> We choose which I2C instance to work with during whatever API we're working with by passing
+ * 				I2C_Peripheral_en of the dedicated instance.
+ * 			->I2C_Peripheral_en is used as an index of the g_I2C_INSTANCES that has the base addresses of
+ * 				All I2C instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] PCLK1 is configured @Configurations section in the header (i2c.h) file, it must match the RCC APB1
+ *			prescaler, FREQ/CCR/TRISE are computed from it (at least 2 MHz for standard mode, 4 MHz for fast mode).
+ *
+ * # Usage Work Flow ?
+ * 		1. Configure SCL/SDA as alternate function AF4, open-drain (with pull-ups), using GPIO_SetPinAF().
+ * 			(DISC board CS43L22: I2C1 on PB6/PB9, address 0x4A)
+ * 		2. Make a {I2C_Config_t} variable and call I2C_Init().
+ * 		3. Make a {I2C_Transaction_t} variable for each transaction and call I2C_Queue(),
+ * 			or use I2C_WriteReadBlocking().
+ *
+ * # Transactions queue ?
+ * 		[♥] A transaction is a write phase, then a repeated start and a read phase (any of them can be empty,
+ * 			both empty is an address probe). The whole sequence runs from the event/error interrupts, the
+ * 			callback gets the transaction's status and the next queued transaction starts right after.
+ * 		[♥] Reads of at least I2C_DMA_THRESHOLD bytes use DMA (LAST bit NACKs the final byte by hardware):
+ * 				I2C1 -> DMA1 stream 5 channel 1
+ * 				I2C2 -> DMA1 stream 2 channel 7
+ * 				I2C3 -> DMA1 stream 2 channel 3 (shared with I2C2)
+ * 			The stream is allocated by I2C_Init() through the DMA driver, if another driver already owns it
+ * 			(e.g. I2C2 and I2C3 both initialized) the instance falls back to byte by byte reads.
+ * 		[♥] The queue holds copies of the descriptors, the tx/rx buffers must stay valid until the callback.
+ *
+ * # Errors recovery ?
+ * 		[♥] NACK (AF)				-> STOP, the transaction completes with I2C_STATUS_NACK.
+ * 		[♥] Arbitration lost		-> retried up to I2C_ARBITRATION_RETRIES times, then I2C_STATUS_ARBITRATION_LOST.
+ * 		[♥] Bus error / stuck bus	-> I2C_RecoverBus(): 9 SCL pulses by GPIO to release a slave holding SDA, a STOP,
+ * 									   then a peripheral software reset (~100 uS). It only runs from thread context
+ * 									   with interrupts enabled: before the first transaction of an idle queue if the
+ * 									   bus is seen busy while nobody is master, and after a bus error (the error ISR
+ * 									   or a DMA read error completes the transaction with I2C_STATUS_BUS_ERROR and
+ * 									   parks the queue, the next I2C_Queue()/I2C_IsIdle() call recovers the bus and
+ * 									   restarts it).
+ * 		[♥] I2C_Queue() may wait for the bus and recover it, don't call it from an ISR or a critical section.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in i2c.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef I2C_I2C_H_
+#define I2C_I2C_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+#include "gpio.h"
+#include "dma.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup I2C_Speed_Options (any value up to 400 kHz is valid)
+ */
+#define I2C_SPEED_STANDARD			(100000UL)
+#define I2C_SPEED_FAST				(400000UL)
+
+/**
+ * @defgroup I2C_Status_Options (transaction completion status)
+ */
+#define I2C_STATUS_OK					(0)
+#define I2C_STATUS_NACK					(1)
+#define I2C_STATUS_BUS_ERROR			(2)
+#define I2C_STATUS_ARBITRATION_LOST		(3)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*I2C kernel clock (PCLK1)*/
+#define I2C_APB1_CLOCK				(16000000UL)
+
+/*CPU clock (HCLK), the bus recovery pulses are timed with the DWT cycle counter*/
+#define I2C_CPU_CLOCK				(16000000UL)
+
+/*Queued transactions per instance*/
+#define I2C_QUEUE_SIZE				(8)
+
+/*Reads of at least this number of bytes use DMA, shorter ones are served byte by byte from the event interrupt*/
+#define I2C_DMA_THRESHOLD			(4)
+
+/*Restarts of a transaction after losing the arbitration*/
+#define I2C_ARBITRATION_RETRIES		(3)
+
+
+/******************************* Types *******************************/
+typedef enum{
+	I2C_I2C1 = 0,
+	I2C_I2C2,
+	I2C_I2C3,
+}I2C_Peripheral_en;
+
+/**
+ * @brief Transaction completion callback, invoked from the I2C/DMA ISR.
+ *
+ * @param void* context		-> the transaction's context
+ * @param uint8_t status	-> @defgroup I2C_Status_Options
+ */
+typedef void (*I2C_Callback_t)(void* context, uint8_t status);
+
+/**
+ * @struct I2C_Config_t
+ * @brief Master configuration, the pins are only driven by the bus recovery.
+ */
+typedef struct{
+	uint32_t speed_hz;		/*choose out of @defgroup I2C_Speed_Options*/
+	GPIO_t* scl_port;
+	GPIO_Pin_en scl_pin;
+	GPIO_t* sda_port;
+	GPIO_Pin_en sda_pin;
+}I2C_Config_t;
+
+/**
+ * @struct I2C_Transaction_t
+ * @brief Write-then-read transaction with a 7-bit address.
+ */
+typedef struct{
+	uint8_t address;		/*7-bit address (not shifted)*/
+	const uint8_t* tx;
+	uint16_t tx_len;		/*0: no write phase*/
+	uint8_t* rx;
+	uint16_t rx_len;		/*0: no read phase*/
+	I2C_Callback_t callback;	/*0: none*/
+	void* context;
+}I2C_Transaction_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func I2C_Init
+ * @brief Initializes the provided I2C as master and enables its interrupts.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	const I2C_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> I2C->CR2
+ * 				[♥] FREQ[0:5]	PCLK1 in MHz
+ * 			=> I2C->CCR
+ * 				[♥] F/S			Fast mode (> 100 kHz), DUTY = 0: t_low = 2 x t_high
+ * 				[♥] CCR[0:11]	Standard: PCLK1 / (2 x speed), fast: PCLK1 / (3 x speed), rounded up
+ * 			=> I2C->TRISE
+ * 				[♥] Max rise time + 1 in PCLK1 cycles: 1000 ns (standard) / 300 ns (fast)
+ *
+ * @return uint32_t		actual SCL frequency
+ */
+uint32_t I2C_Init(I2C_Peripheral_en i2c, const I2C_Config_t* config);
+
+/**
+ * @func I2C_Queue
+ * @brief Adds a transaction to the instance's queue, it starts at once if the I2C is idle.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	const I2C_Transaction_t* transaction[IN]	-> copied, can be a local variable
+ * @return uint8_t		1: queued, 0: the queue is full
+ */
+uint8_t I2C_Queue(I2C_Peripheral_en i2c, const I2C_Transaction_t* transaction);
+
+/**
+ * @func I2C_IsIdle
+ * @brief Checks if all the queued transactions are done.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t I2C_IsIdle(I2C_Peripheral_en i2c);
+
+/**
+ * @func I2C_WriteReadBlocking
+ * @brief Queues a transaction and waits for its completion.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ * @param	uint8_t address[IN]		-> 7-bit address
+ * @param	const uint8_t* tx[IN]
+ * @param	uint16_t tx_len[IN]
+ * @param	uint8_t* rx[OUT]
+ * @param	uint16_t rx_len[IN]
+ * @return uint8_t		@defgroup I2C_Status_Options
+ */
+uint8_t I2C_WriteReadBlocking(I2C_Peripheral_en i2c, uint8_t address, const uint8_t* tx, uint16_t tx_len,
+		uint8_t* rx, uint16_t rx_len);
+
+/**
+ * @func I2C_RecoverBus
+ * @brief Releases a bus held by a slave (9 SCL pulses then a STOP by GPIO) and resets the peripheral.
+ * @note Busy-waits on the DWT cycle counter (SysTick is left alone), call it with no transaction running.
+ *
+ * @param	I2C_Peripheral_en i2c[IN]
+ *
+ * #Important Registers:
+ * 			=> I2C->CR1
+ * 				[♥] SWRST	Software reset, clears a BUSY flag stuck after a glitch
+ *
+ * @return void
+ */
+void I2C_RecoverBus(I2C_Peripheral_en i2c);
+
+
+#endif /* I2C_I2C_H_ */
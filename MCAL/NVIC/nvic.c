@@ -0,0 +1,360 @@
+/**
+ * @file nvic.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief NVIC/SCB module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # IRQ numbers ?
+ * 		[♥] -> Device interrupts are 0 - 81 (position in the vector table - 16, e.g. 54 for TIM6_DAC), the configurable
+ * 				system exceptions are negative (@NVIC_Exception_Options), like CMSIS IRQn_Type.
+ *
+ * # Priorities ?
+ * 		[♥] -> The STM32F4 implements 4 priority bits: 16 levels, 0 is the highest, all interrupts start at 0.
+ * 		[♥] -> NVIC_SetPriorityGrouping() splits these bits into a preemption part (an interrupt preempts a running one
+ * 				only with a strictly higher preemption level) and a sub-priority part (only orders the pending ones),
+ * 				NVIC_EncodePriority() builds the 4-bit priority from both parts with the current grouping.
+ * 		[♥] -> Deterministic preemption: give each ISR its own preemption level, the time-critical ones the lowest numbers.
+ *
+ * # Critical sections ?
+ * 		[♥] NVIC_EnterCritical(priority) masks the interrupts with a priority (number) >= priority through BASEPRI, the
+ * 			more urgent ones (e.g. a motor control PWM ISR at 0) keep running, while LIB_EnterCritical() (PRIMASK)
+ * 			masks everything.
+ * 		[♥] They nest (BASEPRI is only raised, never lowered) and must be exited in reverse order with the returned value.
+ * 		[♥] ISRs that run inside such a section (priority < the mask) must not touch the protected data.
+ *
+ * # Vector table relocation ?
+ * 		[♥] NVIC_RelocateVectorTable() copies the FLASH vector table to a RAM copy (NVIC_VECTOR_TABLE_MEMORY) and
+ * 			points VTOR to it, then NVIC_SetVector() swaps a handler at runtime.
+ * 		[♥] In SRAM (the default) the vector fetch on exception entry doesn't wait for the FLASH (wait states, ART
+ * 			misses), it goes over the S-bus and may only wait for a DMA accessing SRAM1 in the same cycle.
+ * 		[♥] CCM RAM (NVIC_VECTORS_IN_CCM) is only wired to the Cortex-M4 D-bus, while the vector fetch may be done
+ * 			over the ICode/S-bus, reading the table there can fault (or return garbage) on exception entry. It is
+ * 			opt-in: only select it once a relocated interrupt has been checked to run on the board.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "nvic.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define NVIC_AIRCR_VECTKEY			(0x05FAUL)
+#define NVIC_AIRCR_PRIGROUP_MASK	(0b111UL)
+
+/*VTOR alignment: 98 vectors x 4 bytes rounded up to a power of 2*/
+#define NVIC_VECTOR_TABLE_ALIGN		(512)
+
+#define NVIC_PRIORITY_SHIFT			(8 - NVIC_PRIO_BITS)
+
+
+/******************************* Configurations (if any) *******************************/
+#if NVIC_VECTOR_TABLE_MEMORY == NVIC_VECTORS_IN_CCM
+#define NVIC_VECTOR_TABLE_ATTRIBUTES	LIB_CCM_BSS __attribute__((aligned(NVIC_VECTOR_TABLE_ALIGN)))
+#else
+#define NVIC_VECTOR_TABLE_ATTRIBUTES	__attribute__((aligned(NVIC_VECTOR_TABLE_ALIGN)))
+#endif
+
+
+/******************************* privates *******************************/
+/*FLASH vector table (startup_stm32f407vgtx.s)*/
+extern uint32_t g_pfnVectors[];
+
+/*RAM copy, filled by NVIC_RelocateVectorTable()*/
+static uint32_t g_NVIC_VECTORS[NVIC_VECTORS_NUM] NVIC_VECTOR_TABLE_ATTRIBUTES;
+
+static inline void NVIC_DataSyncBarrier(void){
+	__asm volatile ("dsb" ::: "memory");
+	__asm volatile ("isb" ::: "memory");
+}
+
+
+/******************************* Functions Implementation *******************************/
+/**
+ * @func NVIC_EnableIRQ
+ * @brief Enables a device interrupt.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->ISER[x]		Write 1 to enable, 0 has no effect
+ *
+ * @return void
+ */
+void NVIC_EnableIRQ(int16_t irq){
+	NVIC->ISER[irq / 32] = (1UL << (irq % 32));
+}
+
+/**
+ * @func NVIC_DisableIRQ
+ * @brief Disables a device interrupt, it's guaranteed to not be entered anymore at the return.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->ICER[x]		Write 1 to disable, 0 has no effect
+ *
+ * @return void
+ */
+void NVIC_DisableIRQ(int16_t irq){
+	NVIC->ICER[irq / 32] = (1UL << (irq % 32));
+	NVIC_DataSyncBarrier();
+}
+
+/**
+ * @func NVIC_SetPending
+ * @brief Sets a device interrupt pending (software triggered).
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81], or NVIC_IRQ_PENDSV / NVIC_IRQ_SYSTICK
+ *
+ * #Important Registers:
+ * 			=> NVIC->ISPR[x]
+ * 			=> SCB->ICSR
+ * 				[♥] PENDSVSET / PENDSTSET
+ *
+ * @return void
+ */
+void NVIC_SetPending(int16_t irq){
+
+	if(irq >= 0){
+		NVIC->ISPR[irq / 32] = (1UL << (irq % 32));
+	}else if(irq == NVIC_IRQ_PENDSV){
+		SCB->ICSR = (1UL << SCB_ICSR_PENDSVSET);
+	}else if(irq == NVIC_IRQ_SYSTICK){
+		SCB->ICSR = (1UL << SCB_ICSR_PENDSTSET);
+	}
+}
+
+/**
+ * @func NVIC_ClearPending
+ * @brief Clears a pending interrupt.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81], or NVIC_IRQ_PENDSV / NVIC_IRQ_SYSTICK
+ *
+ * #Important Registers:
+ * 			=> NVIC->ICPR[x]
+ * 			=> SCB->ICSR
+ * 				[♥] PENDSVCLR / PENDSTCLR
+ *
+ * @return void
+ */
+void NVIC_ClearPending(int16_t irq){
+
+	if(irq >= 0){
+		NVIC->ICPR[irq / 32] = (1UL << (irq % 32));
+	}else if(irq == NVIC_IRQ_PENDSV){
+		SCB->ICSR = (1UL << SCB_ICSR_PENDSVCLR);
+	}else if(irq == NVIC_IRQ_SYSTICK){
+		SCB->ICSR = (1UL << SCB_ICSR_PENDSTCLR);
+	}
+}
+
+/**
+ * @func NVIC_IsPending
+ * @brief Checks if a device interrupt is pending.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ * @return uint8_t		1: pending, 0: not
+ */
+uint8_t NVIC_IsPending(int16_t irq){
+	return GET_BIT(NVIC->ISPR[irq / 32], (irq % 32));
+}
+
+/**
+ * @func NVIC_IsActive
+ * @brief Checks if a device interrupt is being handled (running or preempted).
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->IABR[x]
+ *
+ * @return uint8_t		1: active, 0: not
+ */
+uint8_t NVIC_IsActive(int16_t irq){
+	return GET_BIT(NVIC->IABR[irq / 32], (irq % 32));
+}
+
+/**
+ * @func NVIC_SetPriorityGrouping
+ * @brief Splits the priority bits into preemption and sub-priority parts (once, before setting priorities).
+ *
+ * @param	uint8_t group[IN]		-> choose out of @defgroup NVIC_PriorityGroup_Options
+ *
+ * #Important Registers:
+ * 			=> SCB->AIRCR
+ * 				[♥] VECTKEY[16-31]		0x05FA must be written with any change
+ * 				[♥] PRIGROUP[8-10]		Priority grouping
+ *
+ * @return void
+ */
+void NVIC_SetPriorityGrouping(uint8_t group){
+
+	uint32_t aircr = SCB->AIRCR;
+
+	aircr &= ~((0xFFFFUL << SCB_AIRCR_VECTKEY) | (NVIC_AIRCR_PRIGROUP_MASK << SCB_AIRCR_PRIGROUP));
+	aircr |= (NVIC_AIRCR_VECTKEY << SCB_AIRCR_VECTKEY) | ((uint32_t)(group & NVIC_AIRCR_PRIGROUP_MASK) << SCB_AIRCR_PRIGROUP);
+
+	SCB->AIRCR = aircr;
+}
+
+/**
+ * @func NVIC_EncodePriority
+ * @brief Builds a priority from its preemption and sub-priority parts with the current grouping.
+ *
+ * @param	uint8_t preempt[IN]		-> out of range values are truncated to the group bits
+ * @param	uint8_t sub[IN]
+ * @return uint8_t		priority [0 - NVIC_PRIORITY_LOWEST]
+ */
+uint8_t NVIC_EncodePriority(uint8_t preempt, uint8_t sub){
+
+	//PRIGROUP = 3 + sub-priority bits (for 4 implemented bits)
+	uint8_t group = (uint8_t)((SCB->AIRCR >> SCB_AIRCR_PRIGROUP) & NVIC_AIRCR_PRIGROUP_MASK);
+	uint8_t sub_bits = (group > NVIC_PRIORITY_GROUP_4_0) ? (uint8_t)(group - NVIC_PRIORITY_GROUP_4_0) : 0;
+	uint8_t preempt_bits = NVIC_PRIO_BITS - sub_bits;
+
+	return (uint8_t)(((preempt & ((1U << preempt_bits) - 1)) << sub_bits) | (sub & ((1U << sub_bits) - 1)));
+}
+
+/**
+ * @func NVIC_SetPriority
+ * @brief Sets the priority of a device interrupt or of a configurable system exception.
+ *
+ * @param	int16_t irq[IN]			-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @param	uint8_t priority[IN]	-> [0 (highest) - NVIC_PRIORITY_LOWEST]
+ *
+ * #Important Registers:
+ * 			=> NVIC->IPR[irq]		Priority in the upper 4 bits
+ * 			=> SCB->SHPR[x]			Same for the system exceptions
+ *
+ * @return void
+ */
+void NVIC_SetPriority(int16_t irq, uint8_t priority){
+
+	uint8_t value = (uint8_t)((priority & NVIC_PRIORITY_LOWEST) << NVIC_PRIORITY_SHIFT);
+
+	if(irq >= 0){
+		NVIC->IPR[irq] = value;
+	}else{
+		//SHPR[0] is exception 4 (MemManage), exception number = irq + 16
+		SCB->SHPR[irq + 16 - 4] = value;
+	}
+}
+
+/**
+ * @func NVIC_GetPriority
+ * @brief Returns the priority of a device interrupt or of a configurable system exception.
+ *
+ * @param	int16_t irq[IN]			-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @return uint8_t		[0 - NVIC_PRIORITY_LOWEST]
+ */
+uint8_t NVIC_GetPriority(int16_t irq){
+
+	uint8_t value = (irq >= 0) ? NVIC->IPR[irq] : SCB->SHPR[irq + 16 - 4];
+
+	return (uint8_t)(value >> NVIC_PRIORITY_SHIFT);
+}
+
+/**
+ * @func NVIC_EnterCritical
+ * @brief Masks the interrupts with a priority number >= priority, the more urgent ones keep running.
+ *
+ * @param	uint8_t priority[IN]	-> [1 - NVIC_PRIORITY_LOWEST] (0 would mask nothing, use LIB_EnterCritical())
+ *
+ * #Important Registers:
+ * 			=> BASEPRI (core register)		Written with BASEPRI_MAX, so it is only raised
+ *
+ * @return uint32_t		previous BASEPRI, to be passed to NVIC_ExitCritical()
+ */
+uint32_t NVIC_EnterCritical(uint8_t priority){
+
+	uint32_t basepri;
+	uint32_t value = (uint32_t)(priority & NVIC_PRIORITY_LOWEST) << NVIC_PRIORITY_SHIFT;
+
+	__asm volatile ("mrs %0, basepri" : "=r" (basepri));
+	__asm volatile ("msr basepri_max, %0" :: "r" (value) : "memory");
+
+	return basepri;
+}
+
+/**
+ * @func NVIC_ExitCritical
+ * @brief Restores the mask saved by NVIC_EnterCritical().
+ *
+ * @param	uint32_t basepri[IN]		-> value returned by the matching NVIC_EnterCritical()
+ * @return void
+ */
+void NVIC_ExitCritical(uint32_t basepri){
+	__asm volatile ("msr basepri, %0" :: "r" (basepri) : "memory");
+}
+
+/**
+ * @func NVIC_RelocateVectorTable
+ * @brief Copies the current vector table to RAM/CCM (NVIC_VECTOR_TABLE_MEMORY) and switches to it.
+ *
+ * #Important Registers:
+ * 			=> SCB->VTOR		Vector table address, aligned to its size rounded up to a power of 2 (512 bytes)
+ *
+ * @return void
+ */
+void NVIC_RelocateVectorTable(void){
+
+	uint32_t primask;
+
+	if(SCB->VTOR == (uint32_t)g_NVIC_VECTORS){
+		return;
+	}
+
+	for(uint16_t i = 0; i < NVIC_VECTORS_NUM; i++){
+		g_NVIC_VECTORS[i] = g_pfnVectors[i];
+	}
+
+	//no exception may be taken while the table is switched
+	__asm volatile ("mrs %0, primask" : "=r" (primask));
+	__asm volatile ("cpsid i" ::: "memory");
+	SCB->VTOR = (uint32_t)g_NVIC_VECTORS;
+	NVIC_DataSyncBarrier();
+	__asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+}
+
+/**
+ * @func NVIC_SetVector
+ * @brief Swaps the handler of an interrupt/exception (relocates the vector table first if needed).
+ *
+ * @param	int16_t irq[IN]				-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @param	NVIC_Handler_t handler[IN]
+ * @return NVIC_Handler_t		previous handler
+ */
+NVIC_Handler_t NVIC_SetVector(int16_t irq, NVIC_Handler_t handler){
+
+	NVIC_Handler_t previous;
+
+	NVIC_RelocateVectorTable();
+
+	previous = (NVIC_Handler_t)g_NVIC_VECTORS[irq + 16];
+	g_NVIC_VECTORS[irq + 16] = (uint32_t)handler;
+	NVIC_DataSyncBarrier();
+
+	return previous;
+}
+
+/**
+ * @func NVIC_SystemReset
+ * @brief Requests a system reset, doesn't return.
+ *
+ * #Important Registers:
+ * 			=> SCB->AIRCR
+ * 				[♥] SYSRESETREQ		System reset request
+ *
+ * @return void
+ */
+void NVIC_SystemReset(void){
+
+	NVIC_DataSyncBarrier();
+	SCB->AIRCR = (NVIC_AIRCR_VECTKEY << SCB_AIRCR_VECTKEY) | (SCB->AIRCR & (NVIC_AIRCR_PRIGROUP_MASK << SCB_AIRCR_PRIGROUP)) |
+				 (1UL << SCB_AIRCR_SYSRESETREQ);
+	NVIC_DataSyncBarrier();
+
+	while(1);
+}
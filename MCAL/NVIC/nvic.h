@@ -0,0 +1,285 @@
+/**
+ * @file nvic.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief NVIC/SCB module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # IRQ numbers ?
+ * 		[♥] -> Device interrupts are 0 - 81 (position in the vector table - 16, e.g. 54 for TIM6_DAC), the configurable
+ * 				system exceptions are negative (@NVIC_Exception_Options), like CMSIS IRQn_Type.
+ *
+ * # Priorities ?
+ * 		[♥] -> The STM32F4 implements 4 priority bits: 16 levels, 0 is the highest, all interrupts start at 0.
+ * 		[♥] -> NVIC_SetPriorityGrouping() splits these bits into a preemption part (an interrupt preempts a running one
+ * 				only with a strictly higher preemption level) and a sub-priority part (only orders the pending ones),
+ * 				NVIC_EncodePriority() builds the 4-bit priority from both parts with the current grouping.
+ * 		[♥] -> Deterministic preemption: give each ISR its own preemption level, the time-critical ones the lowest numbers.
+ *
+ * # Critical sections ?
+ * 		[♥] NVIC_EnterCritical(priority) masks the interrupts with a priority (number) >= priority through BASEPRI, the
+ * 			more urgent ones (e.g. a motor control PWM ISR at 0) keep running, while LIB_EnterCritical() (PRIMASK)
+ * 			masks everything.
+ * 		[♥] They nest (BASEPRI is only raised, never lowered) and must be exited in reverse order with the returned value.
+ * 		[♥] ISRs that run inside such a section (priority < the mask) must not touch the protected data.
+ *
+ * # Vector table relocation ?
+ * 		[♥] NVIC_RelocateVectorTable() copies the FLASH vector table to a RAM copy (NVIC_VECTOR_TABLE_MEMORY) and
+ * 			points VTOR to it, then NVIC_SetVector() swaps a handler at runtime.
+ * 		[♥] In SRAM (the default) the vector fetch on exception entry doesn't wait for the FLASH (wait states, ART
+ * 			misses), it goes over the S-bus and may only wait for a DMA accessing SRAM1 in the same cycle.
+ * 		[♥] CCM RAM (NVIC_VECTORS_IN_CCM) is only wired to the Cortex-M4 D-bus, while the vector fetch may be done
+ * 			over the ICode/S-bus, reading the table there can fault (or return garbage) on exception entry. It is
+ * 			opt-in: only select it once a relocated interrupt has been checked to run on the board.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in nvic.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef NVIC_NVIC_H_
+#define NVIC_NVIC_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup NVIC_Exception_Options (configurable system exceptions)
+ */
+#define NVIC_IRQ_MEM_MANAGE			(-12)
+#define NVIC_IRQ_BUS_FAULT			(-11)
+#define NVIC_IRQ_USAGE_FAULT		(-10)
+#define NVIC_IRQ_SVCALL				(-5)
+#define NVIC_IRQ_DEBUG_MONITOR		(-4)
+#define NVIC_IRQ_PENDSV				(-2)
+#define NVIC_IRQ_SYSTICK			(-1)
+
+/**
+ * @defgroup NVIC_PriorityGroup_Options (preemption bits - sub-priority bits)
+ */
+#define NVIC_PRIORITY_GROUP_4_0		(0b011)		/*16 preemption levels, same split as the reset value 0b000 (0 - 3 are alike with 4 bits)*/
+#define NVIC_PRIORITY_GROUP_3_1		(0b100)
+#define NVIC_PRIORITY_GROUP_2_2		(0b101)
+#define NVIC_PRIORITY_GROUP_1_3		(0b110)
+#define NVIC_PRIORITY_GROUP_0_4		(0b111)		/*no preemption between interrupts*/
+
+/**
+ * @defgroup NVIC_VectorMemory_Options
+ */
+#define NVIC_VECTORS_IN_SRAM		(0)
+#define NVIC_VECTORS_IN_CCM			(1)
+
+/*Implemented priority bits (the upper bits of each 8-bit priority field)*/
+#define NVIC_PRIO_BITS				(4)
+#define NVIC_PRIORITY_LOWEST		((1 << NVIC_PRIO_BITS) - 1)
+
+/*16 system exceptions + 82 interrupts*/
+#define NVIC_IRQS_NUM				(82)
+#define NVIC_VECTORS_NUM			(16 + NVIC_IRQS_NUM)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Memory of the vector table copy, choose out of @defgroup NVIC_VectorMemory_Options (CCM: see HOW TO USE)*/
+#define NVIC_VECTOR_TABLE_MEMORY	NVIC_VECTORS_IN_SRAM
+
+
+/******************************* Types *******************************/
+typedef void (*NVIC_Handler_t)(void);
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func NVIC_EnableIRQ
+ * @brief Enables a device interrupt.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->ISER[x]		Write 1 to enable, 0 has no effect
+ *
+ * @return void
+ */
+void NVIC_EnableIRQ(int16_t irq);
+
+/**
+ * @func NVIC_DisableIRQ
+ * @brief Disables a device interrupt, it's guaranteed to not be entered anymore at the return.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->ICER[x]		Write 1 to disable, 0 has no effect
+ *
+ * @return void
+ */
+void NVIC_DisableIRQ(int16_t irq);
+
+/**
+ * @func NVIC_SetPending
+ * @brief Sets a device interrupt pending (software triggered).
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81], or NVIC_IRQ_PENDSV / NVIC_IRQ_SYSTICK
+ *
+ * #Important Registers:
+ * 			=> NVIC->ISPR[x]
+ * 			=> SCB->ICSR
+ * 				[♥] PENDSVSET / PENDSTSET
+ *
+ * @return void
+ */
+void NVIC_SetPending(int16_t irq);
+
+/**
+ * @func NVIC_ClearPending
+ * @brief Clears a pending interrupt.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81], or NVIC_IRQ_PENDSV / NVIC_IRQ_SYSTICK
+ *
+ * #Important Registers:
+ * 			=> NVIC->ICPR[x]
+ * 			=> SCB->ICSR
+ * 				[♥] PENDSVCLR / PENDSTCLR
+ *
+ * @return void
+ */
+void NVIC_ClearPending(int16_t irq);
+
+/**
+ * @func NVIC_IsPending
+ * @brief Checks if a device interrupt is pending.
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ * @return uint8_t		1: pending, 0: not
+ */
+uint8_t NVIC_IsPending(int16_t irq);
+
+/**
+ * @func NVIC_IsActive
+ * @brief Checks if a device interrupt is being handled (running or preempted).
+ *
+ * @param	int16_t irq[IN]		-> [0 - 81]
+ *
+ * #Important Registers:
+ * 			=> NVIC->IABR[x]
+ *
+ * @return uint8_t		1: active, 0: not
+ */
+uint8_t NVIC_IsActive(int16_t irq);
+
+/**
+ * @func NVIC_SetPriorityGrouping
+ * @brief Splits the priority bits into preemption and sub-priority parts (once, before setting priorities).
+ *
+ * @param	uint8_t group[IN]		-> choose out of @defgroup NVIC_PriorityGroup_Options
+ *
+ * #Important Registers:
+ * 			=> SCB->AIRCR
+ * 				[♥] VECTKEY[16-31]		0x05FA must be written with any change
+ * 				[♥] PRIGROUP[8-10]		Priority grouping
+ *
+ * @return void
+ */
+void NVIC_SetPriorityGrouping(uint8_t group);
+
+/**
+ * @func NVIC_EncodePriority
+ * @brief Builds a priority from its preemption and sub-priority parts with the current grouping.
+ *
+ * @param	uint8_t preempt[IN]		-> out of range values are truncated to the group bits
+ * @param	uint8_t sub[IN]
+ * @return uint8_t		priority [0 - NVIC_PRIORITY_LOWEST]
+ */
+uint8_t NVIC_EncodePriority(uint8_t preempt, uint8_t sub);
+
+/**
+ * @func NVIC_SetPriority
+ * @brief Sets the priority of a device interrupt or of a configurable system exception.
+ *
+ * @param	int16_t irq[IN]			-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @param	uint8_t priority[IN]	-> [0 (highest) - NVIC_PRIORITY_LOWEST]
+ *
+ * #Important Registers:
+ * 			=> NVIC->IPR[irq]		Priority in the upper 4 bits
+ * 			=> SCB->SHPR[x]			Same for the system exceptions
+ *
+ * @return void
+ */
+void NVIC_SetPriority(int16_t irq, uint8_t priority);
+
+/**
+ * @func NVIC_GetPriority
+ * @brief Returns the priority of a device interrupt or of a configurable system exception.
+ *
+ * @param	int16_t irq[IN]			-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @return uint8_t		[0 - NVIC_PRIORITY_LOWEST]
+ */
+uint8_t NVIC_GetPriority(int16_t irq);
+
+/**
+ * @func NVIC_EnterCritical
+ * @brief Masks the interrupts with a priority number >= priority, the more urgent ones keep running.
+ *
+ * @param	uint8_t priority[IN]	-> [1 - NVIC_PRIORITY_LOWEST] (0 would mask nothing, use LIB_EnterCritical())
+ *
+ * #Important Registers:
+ * 			=> BASEPRI (core register)		Written with BASEPRI_MAX, so it is only raised
+ *
+ * @return uint32_t		previous BASEPRI, to be passed to NVIC_ExitCritical()
+ */
+uint32_t NVIC_EnterCritical(uint8_t priority);
+
+/**
+ * @func NVIC_ExitCritical
+ * @brief Restores the mask saved by NVIC_EnterCritical().
+ *
+ * @param	uint32_t basepri[IN]		-> value returned by the matching NVIC_EnterCritical()
+ * @return void
+ */
+void NVIC_ExitCritical(uint32_t basepri);
+
+/**
+ * @func NVIC_RelocateVectorTable
+ * @brief Copies the current vector table to RAM/CCM (NVIC_VECTOR_TABLE_MEMORY) and switches to it.
+ *
+ * #Important Registers:
+ * 			=> SCB->VTOR		Vector table address, aligned to its size rounded up to a power of 2 (512 bytes)
+ *
+ * @return void
+ */
+void NVIC_RelocateVectorTable(void);
+
+/**
+ * @func NVIC_SetVector
+ * @brief Swaps the handler of an interrupt/exception (relocates the vector table first if needed).
+ *
+ * @param	int16_t irq[IN]				-> [0 - 81] or choose out of @defgroup NVIC_Exception_Options
+ * @param	NVIC_Handler_t handler[IN]
+ * @return NVIC_Handler_t		previous handler
+ */
+NVIC_Handler_t NVIC_SetVector(int16_t irq, NVIC_Handler_t handler);
+
+/**
+ * @func NVIC_SystemReset
+ * @brief Requests a system reset, doesn't return.
+ *
+ * #Important Registers:
+ * 			=> SCB->AIRCR
+ * 				[♥] SYSRESETREQ		System reset request
+ *
+ * @return void
+ */
+void NVIC_SystemReset(void);
+
+
+#endif /* NVIC_NVIC_H_ */
@@ -0,0 +1,327 @@
+/**
+ * @file pwr.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief PWR module source file (low-power modes and RTC wakeup timer).
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which low-power mode ?
+ * 		[♥] -> Sleep: only the CPU clock is stopped, every peripheral (SysTick included) keeps running and any
+ * 				enabled interrupt wakes the CPU at once.
+ * 		[♥] -> Stop: all the 1.2 V domain clocks are stopped (PLL, HSI, HSE, SysTick, DWT), SRAM and registers are kept.
+ * 				Only an EXTI line wakes it up (RTC wakeup timer, pins, ...), a few us with the main regulator,
+ * 				more with the low-power one. The CPU restarts on HSI, PWR_EnterStop() restores the clocks
+ * 				that were running before (HSE, PLL and the system clock switch).
+ *
+ * # Wakeup timer ?
+ * 		[♥] The RTC runs from LSI (~PWR_LSI_HZ, not trimmed: +/- ~50 %) even in Stop mode, PWR_WakeupTimerStart()
+ * 			arms its wakeup timer (EXTI line 22) and PWR_WakeupTimerStop() returns the time actually elapsed,
+ * 			measured with the RTC time and sub-second registers (1 ms) in case another interrupt woke the CPU first.
+ *
+ * # Usage Work Flow ?
+ * 		1. PWR_Init() once (starts LSI and the RTC).
+ * 		2. Optionally PWR_WakeupTimerStart().
+ * 		3. PWR_EnterSleep() / PWR_EnterStop(), called with the interrupts masked (PRIMASK) the pending interrupt
+ * 			still wakes the CPU and is taken once they're unmasked, after the caller updated its time base.
+ * 		4. PWR_WakeupTimerStop().
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "pwr.h"
+
+/*******************************  Macros *******************************/
+#define PWR_RTC_WKUP_IRQ_NUM		(3)
+#define PWR_EXTI_LINE_RTC_WAKEUP	(22)
+
+#define PWR_RTC_SELECT_LSI			(0b10UL)
+#define PWR_RTC_KEY1				(0xCAUL)
+#define PWR_RTC_KEY2				(0x53UL)
+#define PWR_RTC_LOCK				(0xFFUL)
+
+/*RTC->ISR implemented bits: the rc_w0 flags are left untouched by writing 1, INIT is read/write*/
+#define PWR_RTC_ISR_BITS			(0x1FFFFUL)
+
+/*ck_apre = 1 kHz (sub-seconds counter), ck_spre = 1 Hz*/
+#define PWR_RTC_SUBSECOND_HZ		(1000UL)
+#define PWR_RTC_PREDIV_A			((PWR_LSI_HZ / PWR_RTC_SUBSECOND_HZ) - 1UL)
+#define PWR_RTC_PREDIV_S			(PWR_RTC_SUBSECOND_HZ - 1UL)
+
+/*Wakeup timer clock = RTC/16*/
+#define PWR_WAKEUP_HZ				(PWR_LSI_HZ / 16UL)
+
+#define PWR_MS_PER_DAY				(86400000UL)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static uint32_t g_PWR_WAKEUP_START_MS = 0;
+static uint32_t g_PWR_WAKEUP_PERIOD_MS = 0;
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func PWR_RtcUnlock
+ * @brief Disables the RTC registers write protection.
+ *
+ * @note STATIC FUNCTION
+ */
+static inline void PWR_RtcUnlock(void){
+	RTC->WPR = PWR_RTC_KEY1;
+	RTC->WPR = PWR_RTC_KEY2;
+}
+
+/**
+ * @func PWR_RtcLock
+ * @brief Enables the RTC registers write protection.
+ *
+ * @note STATIC FUNCTION
+ */
+static inline void PWR_RtcLock(void){
+	RTC->WPR = PWR_RTC_LOCK;
+}
+
+/**
+ * @func PWR_RtcReadMs
+ * @brief Returns the RTC time of day in ms (time register in BCD and sub-seconds counting down).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint32_t PWR_RtcReadMs(void){
+
+	uint32_t tr;
+	uint32_t ssr;
+	uint32_t seconds;
+
+	//BYPSHAD: the counters are read directly, read again if the seconds changed in between
+	do{
+		tr = RTC->TR;
+		ssr = RTC->SSR;
+	}while(tr != RTC->TR);
+
+	seconds  = (((tr >> RTC_TR_HT) & 0x3UL) * 10UL + ((tr >> RTC_TR_HU) & 0xFUL)) * 3600UL;
+	seconds += (((tr >> RTC_TR_MNT) & 0x7UL) * 10UL + ((tr >> RTC_TR_MNU) & 0xFUL)) * 60UL;
+	seconds += ((tr >> RTC_TR_ST) & 0x7UL) * 10UL + ((tr >> RTC_TR_SU) & 0xFUL);
+
+	return (seconds * 1000UL) + (PWR_RTC_PREDIV_S - (ssr & 0xFFFFUL));
+}
+
+/**
+ * @func PWR_RtcClearWakeupFlag
+ * @brief Clears WUTF only: the other flags are written 1 and INIT keeps its current value.
+ *
+ * @note STATIC FUNCTION
+ */
+static inline void PWR_RtcClearWakeupFlag(void){
+	RTC->ISR = (~((1UL << RTC_ISR_WUTF) | (1UL << RTC_ISR_INIT)) & PWR_RTC_ISR_BITS) |
+			   (RTC->ISR & (1UL << RTC_ISR_INIT));
+}
+
+/**
+ * @func PWR_RestoreClocks
+ * @brief Restarts the oscillators/PLL that were on before Stop mode and switches the system clock back.
+ *
+ * @note STATIC FUNCTION
+ */
+static void PWR_RestoreClocks(uint32_t cr, uint32_t cfgr){
+
+	if(GET_BIT(cr, RCC_CR_HSEON)){
+		SET_BIT(RCC->CR, RCC_CR_HSEON);
+		while(GET_BIT(RCC->CR, RCC_CR_HSERDY) != 1);
+	}
+
+	//PLLCFGR is kept in Stop mode
+	if(GET_BIT(cr, RCC_CR_PLLON)){
+		SET_BIT(RCC->CR, RCC_CR_PLLON);
+		while(GET_BIT(RCC->CR, RCC_CR_PLLRDY) != 1);
+	}
+
+	if((cfgr & 0b11UL) != (RCC->CFGR & 0b11UL)){
+		RCC->CFGR = (RCC->CFGR & ~(0b11UL << RCC_CFGR_SW0)) | (cfgr & (0b11UL << RCC_CFGR_SW0));
+		while(((RCC->CFGR >> RCC_CFGR_SWS0) & 0b11UL) != (cfgr & 0b11UL));
+	}
+}
+
+/**
+ * @func PWR_Init
+ * @brief Enables the PWR clock and the backup domain access, starts LSI and the RTC from it (1 ms sub-seconds).
+ *
+ * #Important Registers:
+ * 			=> PWR->CR
+ * 				[♥] DBP			Backup domain (RTC) write protection disable
+ * 			=> RCC->BDCR
+ * 				[♥] RTCSEL[8-9]	10: LSI
+ * 				[♥] RTCEN		RTC clock enable
+ * 			=> RTC->PRER
+ * 				[♥] PREDIV_A	ck_apre = LSI / (PREDIV_A + 1) = 1 kHz, the sub-seconds counter clock
+ * 				[♥] PREDIV_S	ck_spre = ck_apre / (PREDIV_S + 1) = 1 Hz, the calendar clock
+ *
+ * @return void
+ */
+void PWR_Init(void){
+
+	RCC_EnableAPB1Clock(RCC_APB1_PWR);
+	SET_BIT(PWR->CR, PWR_CR_DBP);
+
+	SET_BIT(RCC->CSR, RCC_CSR_LSION);
+	while(GET_BIT(RCC->CSR, RCC_CSR_LSIRDY) != 1);
+
+	//the RTC clock source can only be changed by a backup domain reset
+	if(((RCC->BDCR >> RCC_BDCR_RTCSEL) & 0b11UL) != PWR_RTC_SELECT_LSI){
+		SET_BIT(RCC->BDCR, RCC_BDCR_BDRST);
+		CLEAR_BIT(RCC->BDCR, RCC_BDCR_BDRST);
+		RCC->BDCR |= (PWR_RTC_SELECT_LSI << RCC_BDCR_RTCSEL);
+	}
+	SET_BIT(RCC->BDCR, RCC_BDCR_RTCEN);
+
+	PWR_RtcUnlock();
+	SET_BIT(RTC->ISR, RTC_ISR_INIT);
+	while(GET_BIT(RTC->ISR, RTC_ISR_INITF) != 1);
+
+	//the two prescalers are written with two separate accesses
+	RTC->PRER = (PWR_RTC_PREDIV_S << RTC_PRER_PREDIV_S);
+	RTC->PRER |= (PWR_RTC_PREDIV_A << RTC_PRER_PREDIV_A);
+	SET_BIT(RTC->CR, RTC_CR_BYPSHAD);
+
+	CLEAR_BIT(RTC->ISR, RTC_ISR_INIT);
+	PWR_RtcLock();
+
+	//wakeup timer interrupt: EXTI line 22 rising edge
+	SET_BIT(EXTI->IMR, PWR_EXTI_LINE_RTC_WAKEUP);
+	SET_BIT(EXTI->RTSR, PWR_EXTI_LINE_RTC_WAKEUP);
+	NVIC_EnableIRQ(PWR_RTC_WKUP_IRQ_NUM);
+}
+
+/**
+ * @func PWR_EnterSleep
+ * @brief Stops the CPU clock until an interrupt (WFI).
+ *
+ * #Important Registers:
+ * 			=> SCB->SCR
+ * 				[♥] SLEEPDEEP	0: Sleep mode
+ *
+ * @return void
+ */
+void PWR_EnterSleep(void){
+
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP);
+	__asm volatile ("dsb" ::: "memory");
+	__asm volatile ("wfi");
+}
+
+/**
+ * @func PWR_EnterStop
+ * @brief Enters Stop mode until an EXTI line wakes the CPU, then restores the clocks.
+ *
+ * @param	uint8_t regulator[IN]		-> choose out of @defgroup PWR_Regulator_Options
+ *
+ * #Important Registers:
+ * 			=> SCB->SCR
+ * 				[♥] SLEEPDEEP	1: Stop mode (PWR->CR PDDS = 0)
+ * 			=> PWR->CR
+ * 				[♥] PDDS		0: Stop, 1: Standby
+ * 				[♥] LPDS		Low-power regulator in Stop mode
+ *
+ * @return void
+ */
+void PWR_EnterStop(uint8_t regulator){
+
+	uint32_t cr = RCC->CR;
+	uint32_t cfgr = RCC->CFGR;
+
+	CLEAR_BIT(PWR->CR, PWR_CR_PDDS);
+	if(regulator == PWR_REGULATOR_LOW_POWER){
+		SET_BIT(PWR->CR, PWR_CR_LPDS);
+	}else{
+		CLEAR_BIT(PWR->CR, PWR_CR_LPDS);
+	}
+
+	SET_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP);
+	__asm volatile ("dsb" ::: "memory");
+	__asm volatile ("wfi");
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP);
+
+	//woken up on HSI
+	PWR_RestoreClocks(cr, cfgr);
+}
+
+/**
+ * @func PWR_WakeupTimerStart
+ * @brief Arms the RTC wakeup timer (interrupt through EXTI line 22) and starts measuring the elapsed time.
+ *
+ * @param	uint32_t ms[IN]			-> [1 - PWR_WAKEUP_MAX_MS], longer periods are clipped
+ *
+ * #Important Registers:
+ * 			=> RTC->CR
+ * 				[♥] WUCKSEL[0-2]	000: RTC/16
+ * 				[♥] WUTE / WUTIE	Wakeup timer / interrupt enable
+ * 			=> RTC->WUTR		Wakeup period - 1
+ *
+ * @return uint32_t		programmed period in ms
+ */
+uint32_t PWR_WakeupTimerStart(uint32_t ms){
+
+	if(ms == 0){
+		ms = 1;
+	}else if(ms > PWR_WAKEUP_MAX_MS){
+		ms = PWR_WAKEUP_MAX_MS;
+	}
+
+	PWR_RtcUnlock();
+	RTC->CR &= ~((1UL << RTC_CR_WUTE) | (1UL << RTC_CR_WUTIE));
+	while(GET_BIT(RTC->ISR, RTC_ISR_WUTWF) != 1);
+
+	RTC->WUTR = ((ms * PWR_WAKEUP_HZ) / 1000UL) - 1UL;
+	RTC->CR &= ~(0b111UL << RTC_CR_WUCKSEL);
+	PWR_RtcClearWakeupFlag();
+	EXTI->PR = (1UL << PWR_EXTI_LINE_RTC_WAKEUP);
+
+	g_PWR_WAKEUP_START_MS = PWR_RtcReadMs();
+	g_PWR_WAKEUP_PERIOD_MS = ms;
+	RTC->CR |= (1UL << RTC_CR_WUTE) | (1UL << RTC_CR_WUTIE);
+	PWR_RtcLock();
+
+	return ms;
+}
+
+/**
+ * @func PWR_WakeupTimerStop
+ * @brief Disarms the wakeup timer.
+ *
+ * @return uint32_t		ms elapsed since PWR_WakeupTimerStart(), at least the programmed period if the timer expired
+ */
+uint32_t PWR_WakeupTimerStop(void){
+
+	uint32_t now = PWR_RtcReadMs();
+	uint8_t expired = GET_BIT(RTC->ISR, RTC_ISR_WUTF);
+	uint32_t elapsed;
+
+	PWR_RtcUnlock();
+	RTC->CR &= ~((1UL << RTC_CR_WUTE) | (1UL << RTC_CR_WUTIE));
+	PWR_RtcLock();
+
+	PWR_RtcClearWakeupFlag();
+	EXTI->PR = (1UL << PWR_EXTI_LINE_RTC_WAKEUP);
+	NVIC_ClearPending(PWR_RTC_WKUP_IRQ_NUM);
+
+	//time of day wraps at midnight, the timer and the sub-seconds counter aren't in phase (up to 1 ms apart)
+	elapsed = (now + PWR_MS_PER_DAY - g_PWR_WAKEUP_START_MS) % PWR_MS_PER_DAY;
+	if(expired && (elapsed < g_PWR_WAKEUP_PERIOD_MS)){
+		elapsed = g_PWR_WAKEUP_PERIOD_MS;
+	}
+
+	return elapsed;
+}
+
+
+/******************************* ISR *******************************/
+void RTC_WKUP_IRQHandler(void){
+
+	//only wakes the CPU up, the elapsed time is read by PWR_WakeupTimerStop()
+	PWR_RtcClearWakeupFlag();
+	EXTI->PR = (1UL << PWR_EXTI_LINE_RTC_WAKEUP);
+}
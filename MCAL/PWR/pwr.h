@@ -0,0 +1,143 @@
+/**
+ * @file pwr.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief PWR module header file (low-power modes and RTC wakeup timer).
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which low-power mode ?
+ * 		[♥] -> Sleep: only the CPU clock is stopped, every peripheral (SysTick included) keeps running and any
+ * 				enabled interrupt wakes the CPU at once.
+ * 		[♥] -> Stop: all the 1.2 V domain clocks are stopped (PLL, HSI, HSE, SysTick, DWT), SRAM and registers are kept.
+ * 				Only an EXTI line wakes it up (RTC wakeup timer, pins, ...), a few us with the main regulator,
+ * 				more with the low-power one. The CPU restarts on HSI, PWR_EnterStop() restores the clocks
+ * 				that were running before (HSE, PLL and the system clock switch).
+ *
+ * # Wakeup timer ?
+ * 		[♥] The RTC runs from LSI (~PWR_LSI_HZ, not trimmed: +/- ~50 %) even in Stop mode, PWR_WakeupTimerStart()
+ * 			arms its wakeup timer (EXTI line 22) and PWR_WakeupTimerStop() returns the time actually elapsed,
+ * 			measured with the RTC time and sub-second registers (1 ms) in case another interrupt woke the CPU first.
+ *
+ * # Usage Work Flow ?
+ * 		1. PWR_Init() once (starts LSI and the RTC).
+ * 		2. Optionally PWR_WakeupTimerStart().
+ * 		3. PWR_EnterSleep() / PWR_EnterStop(), called with the interrupts masked (PRIMASK) the pending interrupt
+ * 			still wakes the CPU and is taken once they're unmasked, after the caller updated its time base.
+ * 		4. PWR_WakeupTimerStop().
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in pwr.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef PWR_PWR_H_
+#define PWR_PWR_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup PWR_Regulator_Options (in Stop mode)
+ */
+#define PWR_REGULATOR_MAIN			(0)		/*faster wakeup*/
+#define PWR_REGULATOR_LOW_POWER		(1)		/*lower consumption, longer wakeup*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Nominal LSI frequency, the RTC prescalers are computed from it*/
+#define PWR_LSI_HZ					(32000UL)
+
+/*Longest wakeup timer period (RTC/16 clock, 16-bit counter)*/
+#define PWR_WAKEUP_MAX_MS			((0x10000UL * 1000UL) / (PWR_LSI_HZ / 16UL))
+
+
+/******************************* Types *******************************/
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func PWR_Init
+ * @brief Enables the PWR clock and the backup domain access, starts LSI and the RTC from it (1 ms sub-seconds).
+ *
+ * #Important Registers:
+ * 			=> PWR->CR
+ * 				[♥] DBP			Backup domain (RTC) write protection disable
+ * 			=> RCC->BDCR
+ * 				[♥] RTCSEL[8-9]	10: LSI
+ * 				[♥] RTCEN		RTC clock enable
+ * 			=> RTC->PRER
+ * 				[♥] PREDIV_A	ck_apre = LSI / (PREDIV_A + 1) = 1 kHz, the sub-seconds counter clock
+ * 				[♥] PREDIV_S	ck_spre = ck_apre / (PREDIV_S + 1) = 1 Hz, the calendar clock
+ *
+ * @return void
+ */
+void PWR_Init(void);
+
+/**
+ * @func PWR_EnterSleep
+ * @brief Stops the CPU clock until an interrupt (WFI).
+ *
+ * #Important Registers:
+ * 			=> SCB->SCR
+ * 				[♥] SLEEPDEEP	0: Sleep mode
+ *
+ * @return void
+ */
+void PWR_EnterSleep(void);
+
+/**
+ * @func PWR_EnterStop
+ * @brief Enters Stop mode until an EXTI line wakes the CPU, then restores the clocks.
+ *
+ * @param	uint8_t regulator[IN]		-> choose out of @defgroup PWR_Regulator_Options
+ *
+ * #Important Registers:
+ * 			=> SCB->SCR
+ * 				[♥] SLEEPDEEP	1: Stop mode (PWR->CR PDDS = 0)
+ * 			=> PWR->CR
+ * 				[♥] PDDS		0: Stop, 1: Standby
+ * 				[♥] LPDS		Low-power regulator in Stop mode
+ *
+ * @return void
+ */
+void PWR_EnterStop(uint8_t regulator);
+
+/**
+ * @func PWR_WakeupTimerStart
+ * @brief Arms the RTC wakeup timer (interrupt through EXTI line 22) and starts measuring the elapsed time.
+ *
+ * @param	uint32_t ms[IN]			-> [1 - PWR_WAKEUP_MAX_MS], longer periods are clipped
+ *
+ * #Important Registers:
+ * 			=> RTC->CR
+ * 				[♥] WUCKSEL[0-2]	000: RTC/16
+ * 				[♥] WUTE / WUTIE	Wakeup timer / interrupt enable
+ * 			=> RTC->WUTR		Wakeup period - 1
+ *
+ * @return uint32_t		programmed period in ms
+ */
+uint32_t PWR_WakeupTimerStart(uint32_t ms);
+
+/**
+ * @func PWR_WakeupTimerStop
+ * @brief Disarms the wakeup timer.
+ *
+ * @return uint32_t		ms elapsed since PWR_WakeupTimerStart(), at least the programmed period if the timer expired
+ */
+uint32_t PWR_WakeupTimerStop(void);
+
+
+#endif /* PWR_PWR_H_ */
@@ -10,6 +10,11 @@
 #include "rcc.h"
 #include "bit_math.h"
 
+/*PLL48CK = (16 MHz / M) x N / Q*/
+#define RCC_PLL48_M		(8UL)
+#define RCC_PLL48_N		(168UL)
+#define RCC_PLL48_Q		(7UL)
+
 /*******************************Functions Implementation*******************************/
 
 /**
@@ -110,6 +115,42 @@ void RCC_EnableHSI(){
 	while(GET_BIT(RCC->CR, RCC_CR_HSIRDY) != 1);
 }
 
+/**
+ * @func RCC_EnablePLL48Clock
+ * @brief Starts the main PLL from HSI to provide the 48 MHz PLL48CK (RNG, USB OTG FS, SDIO), the system clock
+ * 			source is left unchanged.
+ * @note Nothing is done if the PLL is already on (PLLCFGR can't be written while it runs), it's assumed to provide 48 MHz.
+ *
+ * @param void
+ * @return void
+ *
+ * - Important Registers:
+ * 		# RCC->PLLCFGR:
+ * 			[♥]	PLLSRC			->	0: HSI
+ * 			[♥]	PLLM[6bits]		->	VCO input = 16 MHz / 8 = 2 MHz			(must be 1 - 2 MHz)
+ * 			[♥]	PLLN[9bits]		->	VCO output = 2 MHz x 168 = 336 MHz		(must be 100 - 432 MHz)
+ * 			[♥]	PLLP[2bits]		->	PLLCLK = 336 MHz / 2 = 168 MHz			(unused while SW selects HSI)
+ * 			[♥]	PLLQ[4bits]		->	PLL48CK = 336 MHz / 7 = 48 MHz
+ *
+ * 		# RCC->CR:
+ * 			[♥]	PLLON / PLLRDY
+ */
+void RCC_EnablePLL48Clock(){
+
+	if(GET_BIT(RCC->CR, RCC_CR_PLLON)){
+		return;
+	}
+
+	/*HSI source, P = 2 (PLLP = 0b00)*/
+	RCC->PLLCFGR = (RCC_PLL48_M << RCC_PLLCFGR_PLLM0) | (RCC_PLL48_N << RCC_PLLCFGR_PLLN) |
+				   (RCC_PLL48_Q << RCC_PLLCFGR_PLLQ0);
+
+	SET_BIT(RCC->CR, RCC_CR_PLLON);
+
+	/*Polling and waiting for the PLL to lock*/
+	while(GET_BIT(RCC->CR, RCC_CR_PLLRDY) != 1);
+}
+
 
 
 /**
@@ -175,6 +175,28 @@ void RCC_EnableAPB2Clock(RCC_APB2PERIPH_en periph);
  */
 void RCC_EnableHSI();
 
+/**
+ * @func RCC_EnablePLL48Clock
+ * @brief Starts the main PLL from HSI to provide the 48 MHz PLL48CK (RNG, USB OTG FS, SDIO), the system clock
+ * 			source is left unchanged.
+ * @note Nothing is done if the PLL is already on (PLLCFGR can't be written while it runs), it's assumed to provide 48 MHz.
+ *
+ * @param void
+ * @return void
+ *
+ * - Important Registers:
+ * 		# RCC->PLLCFGR:
+ * 			[♥]	PLLSRC			->	0: HSI
+ * 			[♥]	PLLM[6bits]		->	VCO input = 16 MHz / 8 = 2 MHz			(must be 1 - 2 MHz)
+ * 			[♥]	PLLN[9bits]		->	VCO output = 2 MHz x 168 = 336 MHz		(must be 100 - 432 MHz)
+ * 			[♥]	PLLP[2bits]		->	PLLCLK = 336 MHz / 2 = 168 MHz			(unused while SW selects HSI)
+ * 			[♥]	PLLQ[4bits]		->	PLL48CK = 336 MHz / 7 = 48 MHz
+ *
+ * 		# RCC->CR:
+ * 			[♥]	PLLON / PLLRDY
+ */
+void RCC_EnablePLL48Clock();
+
 
 /**
  * @func RCC_SetAHBPrescaler
@@ -0,0 +1,199 @@
+/**
+ * @file rng.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief RNG module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # How does the RNG work ?
+ * 		[♥] -> An analog noise source (ring oscillators) clocked by the 48 MHz PLL48CK gives a new 32-bit random
+ * 				number every 40 RNG clock cycles (~0.8 us), RNG_Init() starts the PLL for it (the system clock is kept).
+ * 		[♥] -> Errors:
+ * 				- Clock error (CECS): the RNG clock is too slow compared to HCLK (< HCLK / 16).
+ * 				- Seed error (SECS): the noise source stuck (too many identical bits), the RNG is restarted.
+ *
+ * # Entropy pool ?
+ * 		[♥] The RNG interrupt moves each new number into a pool of RNG_POOL_WORDS words, RNG_Read() takes words
+ * 			from it without waiting (it returns how many were available).
+ * 		[♥] The interrupt is disabled once the pool is full and re-enabled by RNG_Read(), so a full pool costs nothing.
+ * 		[♥] As required by FIPS PUB 140-2, the first number after each (re)start is discarded and a number equal to
+ * 			the previous one is rejected (counted in RNG_Stats_t).
+ *
+ * # Usage Work Flow ?
+ * 		1. RNG_Init() once, the pool fills up in ~RNG_POOL_WORDS us.
+ * 		2. RNG_Read() whenever random words are needed.
+ * 		3. RNG_GetStatus() / RNG_GetStats() for the health of the source.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "rng.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define RNG_POOL_MASK				(RNG_POOL_WORDS - 1)
+
+#define RNG_IRQ_NUM					(80)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+/*Single producer (ISR) single consumer ring, free-running indexes, CPU only (CCM RAM)*/
+static uint32_t g_RNG_POOL[RNG_POOL_WORDS] LIB_CCM_BSS;
+static volatile uint32_t g_RNG_HEAD = 0;
+static volatile uint32_t g_RNG_TAIL = 0;
+
+static uint32_t g_RNG_LAST = 0;
+static uint8_t g_RNG_DISCARD_NEXT = 1;
+
+static RNG_Stats_t g_RNG_STATS;
+
+
+/******************************* Functions Implementation *******************************/
+/**
+ * @func RNG_Init
+ * @brief Starts PLL48CK and the RNG, the pool is filled by interrupt.
+ *
+ * #Important Registers:
+ * 			=> RNG->CR
+ * 				[♥] RNGEN		RNG enable
+ * 				[♥] IE			Interrupt enable (DRDY, CEIS, SEIS)
+ *
+ * @return void
+ */
+void RNG_Init(void){
+
+	RCC_EnablePLL48Clock();
+	RCC_EnableAHB2Clock(RCC_AHB2_RNG);
+
+	g_RNG_HEAD = 0;
+	g_RNG_TAIL = 0;
+	g_RNG_DISCARD_NEXT = 1;
+	g_RNG_STATS = (RNG_Stats_t){0};
+
+	RNG->CR = (1UL << RNG_CR_RNGEN) | (1UL << RNG_CR_IE);
+	NVIC_EnableIRQ(RNG_IRQ_NUM);
+}
+
+/**
+ * @func RNG_Read
+ * @brief Takes up to count random words from the pool, doesn't wait.
+ *
+ * @param	uint32_t* words[OUT]
+ * @param	uint32_t count[IN]
+ * @return uint32_t		number of words written
+ */
+uint32_t RNG_Read(uint32_t* words, uint32_t count){
+
+	uint32_t tail = g_RNG_TAIL;
+	uint32_t available = g_RNG_HEAD - tail;
+	uint32_t n = (count < available) ? count : available;
+
+	for(uint32_t i = 0; i < n; i++){
+		words[i] = g_RNG_POOL[(tail + i) & RNG_POOL_MASK];
+	}
+	g_RNG_TAIL = tail + n;
+
+	//the ISR disables itself on a full pool, CR is also written by the ISR on a seed error
+	if(n && !GET_BIT(RNG->CR, RNG_CR_IE)){
+		uint32_t primask = LIB_EnterCritical();
+		SET_BIT(RNG->CR, RNG_CR_IE);
+		LIB_ExitCritical(primask);
+	}
+
+	return n;
+}
+
+/**
+ * @func RNG_Available
+ * @brief Returns the number of words ready in the pool.
+ *
+ * @return uint32_t
+ */
+uint32_t RNG_Available(void){
+	return g_RNG_HEAD - g_RNG_TAIL;
+}
+
+/**
+ * @func RNG_GetStatus
+ * @brief Returns the current error state of the RNG.
+ *
+ * #Important Registers:
+ * 			=> RNG->SR
+ * 				[♥] CECS		Clock error current status
+ * 				[♥] SECS		Seed error current status
+ *
+ * @return uint8_t		@defgroup RNG_Status_Options flags
+ */
+uint8_t RNG_GetStatus(void){
+
+	uint32_t sr = RNG->SR;
+	uint8_t status = RNG_STATUS_OK;
+
+	if(GET_BIT(sr, RNG_SR_CECS)){
+		status |= RNG_STATUS_CLOCK_ERROR;
+	}
+	if(GET_BIT(sr, RNG_SR_SECS)){
+		status |= RNG_STATUS_SEED_ERROR;
+	}
+
+	return status;
+}
+
+/**
+ * @func RNG_GetStats
+ * @brief Copies the health counters.
+ *
+ * @param	RNG_Stats_t* stats[OUT]
+ * @return void
+ */
+void RNG_GetStats(RNG_Stats_t* stats){
+	*stats = g_RNG_STATS;
+}
+
+
+/******************************* ISR *******************************/
+void HASH_RNG_IRQHandler(void){
+
+	uint32_t sr = RNG->SR;
+
+	//CEIS/SEIS are rc_w0
+	if(GET_BIT(sr, RNG_SR_CEIS)){
+		RNG->SR = (uint32_t)~(1UL << RNG_SR_CEIS);
+		g_RNG_STATS.clock_errors++;
+	}
+
+	if(GET_BIT(sr, RNG_SR_SEIS)){
+		//RM0090: clear SEIS then restart the RNG, the number in DR isn't used
+		RNG->SR = (uint32_t)~(1UL << RNG_SR_SEIS);
+		g_RNG_STATS.seed_errors++;
+		CLEAR_BIT(RNG->CR, RNG_CR_RNGEN);
+		SET_BIT(RNG->CR, RNG_CR_RNGEN);
+		g_RNG_DISCARD_NEXT = 1;
+		return;
+	}
+
+	if(!GET_BIT(sr, RNG_SR_DRDY)){
+		return;
+	}
+
+	uint32_t value = RNG->DR;
+
+	if(g_RNG_DISCARD_NEXT){
+		g_RNG_DISCARD_NEXT = 0;
+	}else if(value == g_RNG_LAST){
+		g_RNG_STATS.repeats++;
+	}else{
+		g_RNG_POOL[g_RNG_HEAD & RNG_POOL_MASK] = value;
+		g_RNG_HEAD++;
+	}
+	g_RNG_LAST = value;
+
+	//full pool: stop the interrupts until RNG_Read() makes room
+	if((g_RNG_HEAD - g_RNG_TAIL) >= RNG_POOL_WORDS){
+		CLEAR_BIT(RNG->CR, RNG_CR_IE);
+	}
+}
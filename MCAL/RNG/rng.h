@@ -0,0 +1,131 @@
+/**
+ * @file rng.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief RNG module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # How does the RNG work ?
+ * 		[♥] -> An analog noise source (ring oscillators) clocked by the 48 MHz PLL48CK gives a new 32-bit random
+ * 				number every 40 RNG clock cycles (~0.8 us), RNG_Init() starts the PLL for it (the system clock is kept).
+ * 		[♥] -> Errors:
+ * 				- Clock error (CECS): the RNG clock is too slow compared to HCLK (< HCLK / 16).
+ * 				- Seed error (SECS): the noise source stuck (too many identical bits), the RNG is restarted.
+ *
+ * # Entropy pool ?
+ * 		[♥] The RNG interrupt moves each new number into a pool of RNG_POOL_WORDS words, RNG_Read() takes words
+ * 			from it without waiting (it returns how many were available).
+ * 		[♥] The interrupt is disabled once the pool is full and re-enabled by RNG_Read(), so a full pool costs nothing.
+ * 		[♥] As required by FIPS PUB 140-2, the first number after each (re)start is discarded and a number equal to
+ * 			the previous one is rejected (counted in RNG_Stats_t).
+ *
+ * # Usage Work Flow ?
+ * 		1. RNG_Init() once, the pool fills up in ~RNG_POOL_WORDS us.
+ * 		2. RNG_Read() whenever random words are needed.
+ * 		3. RNG_GetStatus() / RNG_GetStats() for the health of the source.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in rng.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef RNG_RNG_H_
+#define RNG_RNG_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup RNG_Status_Options (flags)
+ */
+#define RNG_STATUS_OK				(0)
+#define RNG_STATUS_CLOCK_ERROR		(1 << 0)	/*RNG clock too slow, no new numbers*/
+#define RNG_STATUS_SEED_ERROR		(1 << 1)	/*noise source stuck, being restarted*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Pool size in 32-bit words (power of 2)*/
+#define RNG_POOL_WORDS				(64)
+
+
+/******************************* Types *******************************/
+/**
+ * @struct RNG_Stats_t
+ * @brief Health counters since RNG_Init().
+ */
+typedef struct{
+	uint32_t clock_errors;		/*clock error interrupts*/
+	uint32_t seed_errors;		/*seed error interrupts (RNG restarted)*/
+	uint32_t repeats;			/*numbers rejected for being equal to the previous one*/
+}RNG_Stats_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func RNG_Init
+ * @brief Starts PLL48CK and the RNG, the pool is filled by interrupt.
+ *
+ * #Important Registers:
+ * 			=> RNG->CR
+ * 				[♥] RNGEN		RNG enable
+ * 				[♥] IE			Interrupt enable (DRDY, CEIS, SEIS)
+ *
+ * @return void
+ */
+void RNG_Init(void);
+
+/**
+ * @func RNG_Read
+ * @brief Takes up to count random words from the pool, doesn't wait.
+ *
+ * @param	uint32_t* words[OUT]
+ * @param	uint32_t count[IN]
+ * @return uint32_t		number of words written
+ */
+uint32_t RNG_Read(uint32_t* words, uint32_t count);
+
+/**
+ * @func RNG_Available
+ * @brief Returns the number of words ready in the pool.
+ *
+ * @return uint32_t
+ */
+uint32_t RNG_Available(void);
+
+/**
+ * @func RNG_GetStatus
+ * @brief Returns the current error state of the RNG.
+ *
+ * #Important Registers:
+ * 			=> RNG->SR
+ * 				[♥] CECS		Clock error current status
+ * 				[♥] SECS		Seed error current status
+ *
+ * @return uint8_t		@defgroup RNG_Status_Options flags
+ */
+uint8_t RNG_GetStatus(void);
+
+/**
+ * @func RNG_GetStats
+ * @brief Copies the health counters.
+ *
+ * @param	RNG_Stats_t* stats[OUT]
+ * @return void
+ */
+void RNG_GetStats(RNG_Stats_t* stats);
+
+
+#endif /* RNG_RNG_H_ */
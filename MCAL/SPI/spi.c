@@ -0,0 +1,347 @@
+/**
+ * @file spi.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief SPI master module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which SPI Instance ?
+ * 		[♥] -> We choose which SPI instance to work with during whatever API we're working with by passing
+ * 				SPI_Peripheral_en of the dedicated instance.
+ * 			->SPI_Peripheral_en is used as an index of the g_SPI_INSTANCES that has the base addresses of
+ * 				All SPI instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] The SPIs' kernel clocks (PCLK1/PCLK2) are configured @Configurations section in the header (spi.h) file,
+ *			they must match the RCC APB1/APB2 prescalers. The baud prescaler is computed from them.
+ *		[♥] Each transfer's chip select is a GPIO driven by the driver, the SPI NSS pin isn't used (software NSS).
+ *
+ * # Usage Work Flow ?
+ * 		1. Configure SCK/MISO/MOSI as alternate function (SPI1/SPI2: AF5, SPI3: AF6) using GPIO_SetPinAF(),
+ * 			and each chip select pin as a push-pull output driven high.
+ * 			(DISC board LIS3DSH: SPI1 on PA5/PA6/PA7, CS on PE3)
+ * 		2. Make a {SPI_Config_t} variable and call SPI_Init().
+ * 		3. Make a {SPI_Transfer_t} variable for each transfer and call SPI_Queue(), or use SPI_TransferBlocking().
+ *
+ * # Transaction queue ?
+ * 		[♥] Every transfer is full-duplex DMA (RX and TX streams), the CPU only runs once per transfer: the RX stream
+ * 			completion interrupt releases the chip select, invokes the transfer's callback and starts the next queued
+ * 			transfer right away, so several chip-selected transfers run back-to-back.
+ * 		[♥] The queue holds copies of the descriptors, the tx/rx buffers must stay valid until the callback.
+ * 		[♥] A null tx sends SPI_DUMMY_FRAME, a null rx drops the received frames.
+ * 		[♥] DMA streams (RM0090 request mapping, allocated by SPI_Init() through the DMA driver):
+ * 				SPI1 -> DMA2 RX stream 0 / TX stream 3 (channel 3)
+ * 				SPI2 -> DMA1 RX stream 3 / TX stream 4 (channel 0)
+ * 				SPI3 -> DMA1 RX stream 0 / TX stream 7 (channel 0)
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "spi.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define SPI_INSTANCES_NUM			(3)
+
+#define SPI_MAX_BAUD_PRESCALER		(7)		/*f_PCLK / 256*/
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+static SPI_t* const g_SPI_INSTANCES[SPI_INSTANCES_NUM] = {SPI1, SPI2, SPI3};
+
+/*RX/TX DMA requests of each SPI: controller, streams and channel*/
+typedef struct{
+	DMA_Peripheral_en dma;
+	DMA_Stream_en rx_stream;
+	DMA_Stream_en tx_stream;
+	uint8_t channel;
+}SPI_DmaRequest_t;
+
+static const SPI_DmaRequest_t g_SPI_DMA[SPI_INSTANCES_NUM] = {
+		{DMA_DMA2, DMA_STREAM0, DMA_STREAM3, 3},		/*SPI1*/
+		{DMA_DMA1, DMA_STREAM3, DMA_STREAM4, 0},		/*SPI2*/
+		{DMA_DMA1, DMA_STREAM0, DMA_STREAM7, 0},		/*SPI3*/
+};
+
+/*Transfers queue and accounting of each instance*/
+typedef struct{
+	SPI_Transfer_t queue[SPI_QUEUE_SIZE];
+	uint8_t head;
+	volatile uint8_t count;		/*queued transfers, the one at head is running while count != 0*/
+	uint8_t frame;				/*SPI_FRAME_8BIT / SPI_FRAME_16BIT*/
+	SPI_Stats_t stats;
+}SPI_State_t;
+
+static SPI_State_t g_SPI_STATES[SPI_INSTANCES_NUM];
+
+/*Source/sink of the transfers without tx/rx buffers*/
+static const uint16_t g_SPI_DUMMY_TX = SPI_DUMMY_FRAME;
+static uint16_t g_SPI_DUMMY_RX;
+
+static void SPI_DmaCallback(void* dma_context, uint8_t event);
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func SPI_StartHead
+ * @brief Asserts the chip select of the transfer at the queue head and starts its RX/TX streams.
+ *
+ * @note STATIC FUNCTION, called with the queue not empty, from a critical section or the DMA ISR
+ */
+static void SPI_StartHead(SPI_Peripheral_en spi){
+
+	SPI_t* instance = g_SPI_INSTANCES[spi];
+	SPI_State_t* state = &g_SPI_STATES[spi];
+	const SPI_DmaRequest_t* request = &g_SPI_DMA[spi];
+	const SPI_Transfer_t* transfer = &state->queue[state->head];
+	uint8_t size = (state->frame == SPI_FRAME_16BIT) ? DMA_SIZE_HALF_WORD : DMA_SIZE_BYTE;
+	DMA_StreamConfig_t config = {
+			.channel = request->channel,
+			.periph_size = size,
+			.mem_size = size,
+			.periph_inc = DMA_INCREMENT_DISABLED,
+			.circular = DMA_CIRCULAR_DISABLED,
+			.fifo = DMA_FIFO_DIRECT,
+	};
+
+	if(transfer->cs_port != 0){
+		//BSRR reset half: chip select low
+		transfer->cs_port->BSRR = (1UL << (transfer->cs_pin + 16));
+	}
+
+	//RX first and with the higher priority, so no received frame is overrun
+	config.direction = DMA_DIR_PERIPH_TO_MEM;
+	config.priority = DMA_PRIORITY_VERY_HIGH;
+	config.mem_inc = (transfer->rx != 0) ? DMA_INCREMENT_ENABLED : DMA_INCREMENT_DISABLED;
+	config.interrupts = DMA_IT_COMPLETE | DMA_IT_ERROR;
+	config.callback = SPI_DmaCallback;
+	config.context = state;
+	DMA_Configure(request->dma, request->rx_stream, &config);
+
+	//TX completion isn't needed (RX completes last), but a TX error starves RX: it must end the transfer too
+	config.direction = DMA_DIR_MEM_TO_PERIPH;
+	config.priority = DMA_PRIORITY_HIGH;
+	config.mem_inc = (transfer->tx != 0) ? DMA_INCREMENT_ENABLED : DMA_INCREMENT_DISABLED;
+	config.interrupts = DMA_IT_ERROR;
+	DMA_Configure(request->dma, request->tx_stream, &config);
+
+	//RM0090 order: RXDMAEN, streams, then TXDMAEN which issues the first TX request
+	SET_BIT(instance->CR2, SPI_CR2_RXDMAEN);
+	DMA_Start(request->dma, request->rx_stream, (uint32_t)&instance->DR,
+			  (transfer->rx != 0) ? (uint32_t)transfer->rx : (uint32_t)&g_SPI_DUMMY_RX, transfer->frames);
+	DMA_Start(request->dma, request->tx_stream, (uint32_t)&instance->DR,
+			  (transfer->tx != 0) ? (uint32_t)transfer->tx : (uint32_t)&g_SPI_DUMMY_TX, transfer->frames);
+	SET_BIT(instance->CR2, SPI_CR2_TXDMAEN);
+}
+
+/**
+ * @func SPI_Init
+ * @brief Initializes the provided SPI as master with DMA transfers.
+ *
+ * @param	SPI_Peripheral_en spi[IN]			-> specifies which SPI
+ * @param	const SPI_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> SPI->CR1
+ * 				[♥] MSTR		Master
+ * 				[♥] BR[3:5]		f_PCLK / 2^(BR + 1)
+ * 				[♥] SSM/SSI		Software NSS held high (no mode fault)
+ * 				[♥] DFF			8/16-bit frames
+ * 				[♥] CPOL/CPHA	Clock mode
+ *
+ * @return uint32_t		actual SCK frequency, 0: the RX/TX DMA streams are used by another driver
+ */
+uint32_t SPI_Init(SPI_Peripheral_en spi, const SPI_Config_t* config){
+
+	SPI_t* instance = g_SPI_INSTANCES[spi];
+	SPI_State_t* state = &g_SPI_STATES[spi];
+	const SPI_DmaRequest_t* request = &g_SPI_DMA[spi];
+	uint32_t pclk;
+
+	if(!DMA_Allocate(request->dma, request->rx_stream, request->channel) ||
+	   !DMA_Allocate(request->dma, request->tx_stream, request->channel)){
+		DMA_Free(request->dma, request->rx_stream, request->channel);
+		return 0;
+	}
+
+	switch(spi){
+	case SPI_SPI1:
+		RCC_EnableAPB2Clock(RCC_APB2_SPI1);
+		pclk = SPI_APB2_CLOCK;
+		break;
+	case SPI_SPI2:
+		RCC_EnableAPB1Clock(RCC_APB1_SPI2);
+		pclk = SPI_APB1_CLOCK;
+		break;
+	case SPI_SPI3:
+	default:
+		RCC_EnableAPB1Clock(RCC_APB1_SPI3);
+		pclk = SPI_APB1_CLOCK;
+		break;
+	}
+
+	//fastest SCK = f_PCLK / 2^(BR + 1) not exceeding max_hz
+	uint32_t baud = 0;
+	while((baud < SPI_MAX_BAUD_PRESCALER) && ((pclk >> (baud + 1)) > config->max_hz)){
+		baud++;
+	}
+
+	state->head = 0;
+	state->count = 0;
+	state->frame = config->frame;
+
+	instance->CR1 = 0;
+	instance->CR2 = 0;
+	instance->CR1 = (1UL << SPI_CR1_MSTR) |
+					(1UL << SPI_CR1_SSM) |
+					(1UL << SPI_CR1_SSI) |
+					(baud << SPI_CR1_BR) |
+					((uint32_t)(config->frame & 1) << SPI_CR1_DFF) |
+					((uint32_t)(config->bit_order & 1) << SPI_CR1_LSBFIRST) |
+					((uint32_t)((config->mode >> 1) & 1) << SPI_CR1_CPOL) |
+					((uint32_t)(config->mode & 1) << SPI_CR1_CPHA);
+	SET_BIT(instance->CR1, SPI_CR1_SPE);
+
+	return pclk >> (baud + 1);
+}
+
+/**
+ * @func SPI_Queue
+ * @brief Adds a transfer to the instance's queue, it starts at once if the SPI is idle.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	const SPI_Transfer_t* transfer[IN]	-> copied, can be a local variable
+ *
+ * #Important Registers:
+ * 			=> SPI->CR2
+ * 				[♥] RXDMAEN/TXDMAEN		DMA requests at each RXNE/TXE
+ *
+ * @return uint8_t		1: queued, 0: the queue is full
+ */
+uint8_t SPI_Queue(SPI_Peripheral_en spi, const SPI_Transfer_t* transfer){
+
+	SPI_State_t* state = &g_SPI_STATES[spi];
+
+	if(transfer->frames == 0){
+		return 1;
+	}
+
+	uint32_t primask = LIB_EnterCritical();
+	if(state->count >= SPI_QUEUE_SIZE){
+		state->stats.rejected++;
+		LIB_ExitCritical(primask);
+		return 0;
+	}
+
+	state->queue[(state->head + state->count) % SPI_QUEUE_SIZE] = *transfer;
+	state->count++;
+	if(state->count == 1){
+		SPI_StartHead(spi);
+	}
+	LIB_ExitCritical(primask);
+
+	return 1;
+}
+
+/**
+ * @func SPI_IsIdle
+ * @brief Checks if all the queued transfers are done.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t SPI_IsIdle(SPI_Peripheral_en spi){
+	return (g_SPI_STATES[spi].count == 0);
+}
+
+/**
+ * @func SPI_TransferBlocking
+ * @brief Queues a transfer and waits until the queue is empty.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	GPIO_t* cs_port[IN]		-> 0: no chip select
+ * @param	GPIO_Pin_en cs_pin[IN]
+ * @param	const void* tx[IN]		-> 0: SPI_DUMMY_FRAME
+ * @param	void* rx[OUT]			-> 0: dropped
+ * @param	uint16_t frames[IN]
+ * @return void
+ */
+void SPI_TransferBlocking(SPI_Peripheral_en spi, GPIO_t* cs_port, GPIO_Pin_en cs_pin, const void* tx, void* rx,
+		uint16_t frames){
+
+	SPI_Transfer_t transfer = {cs_port, cs_pin, tx, rx, frames, 0, 0};
+
+	while(!SPI_Queue(spi, &transfer));
+	while(!SPI_IsIdle(spi));
+}
+
+/**
+ * @func SPI_GetStats
+ * @brief Copies the throughput accounting of the provided SPI.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	SPI_Stats_t* stats[OUT]
+ * @return void
+ */
+void SPI_GetStats(SPI_Peripheral_en spi, SPI_Stats_t* stats){
+
+	uint32_t primask = LIB_EnterCritical();
+	*stats = g_SPI_STATES[spi].stats;
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func SPI_DmaCallback
+ * @brief RX stream completion or RX/TX stream error (DMA ISR): the transfer is over, releases the chip select,
+ * 		  invokes the callback and chains the next queued transfer.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+static void SPI_DmaCallback(void* dma_context, uint8_t event){
+
+	SPI_State_t* state = (SPI_State_t*)dma_context;
+	SPI_Peripheral_en spi = (SPI_Peripheral_en)(state - g_SPI_STATES);
+	SPI_t* instance = g_SPI_INSTANCES[spi];
+	const SPI_DmaRequest_t* request = &g_SPI_DMA[spi];
+
+	if(state->count == 0){
+		return;
+	}
+	const SPI_Transfer_t* transfer = &state->queue[state->head];
+
+	if(event == DMA_EVENT_ERROR){
+		//stopping both streams also clears their flags, so the other stream can't end this transfer twice
+		state->stats.errors++;
+		DMA_Stop(request->dma, request->rx_stream);
+		DMA_Stop(request->dma, request->tx_stream);
+	}
+
+	//the RX stream completes after the last SCK edge, BSY only lasts a few PCLK cycles
+	while(GET_BIT(instance->SR, SPI_SR_BSY));
+	instance->CR2 &= ~((1UL << SPI_CR2_RXDMAEN) | (1UL << SPI_CR2_TXDMAEN));
+
+	if(transfer->cs_port != 0){
+		transfer->cs_port->BSRR = (1UL << transfer->cs_pin);
+	}
+
+	state->stats.transfers++;
+	state->stats.frames += transfer->frames - DMA_GetRemaining(request->dma, request->rx_stream);
+
+	SPI_Callback_t callback = transfer->callback;
+	void* context = transfer->context;
+
+	state->head = (state->head + 1) % SPI_QUEUE_SIZE;
+	state->count--;
+	if(state->count != 0){
+		SPI_StartHead(spi);
+	}
+
+	if(callback != 0){
+		callback(context);
+	}
+}
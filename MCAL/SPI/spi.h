@@ -0,0 +1,214 @@
+/**
+ * @file spi.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief SPI master module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which SPI Instance ?
+ * 		[♥] -> We choose which SPI instance to work with during whatever API we're working with by passing
+ * 				SPI_Peripheral_en of the dedicated instance.
+ * 			->SPI_Peripheral_en is used as an index of the g_SPI_INSTANCES that has the base addresses of
+ * 				All SPI instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] The SPIs' kernel clocks (PCLK1/PCLK2) are configured @Configurations section in the header (spi.h) file,
+ *			they must match the RCC APB1/APB2 prescalers. The baud prescaler is computed from them.
+ *		[♥] Each transfer's chip select is a GPIO driven by the driver, the SPI NSS pin isn't used (software NSS).
+ *
+ * # Usage Work Flow ?
+ * 		1. Configure SCK/MISO/MOSI as alternate function (SPI1/SPI2: AF5, SPI3: AF6) using GPIO_SetPinAF(),
+ * 			and each chip select pin as a push-pull output driven high.
+ * 			(DISC board LIS3DSH: SPI1 on PA5/PA6/PA7, CS on PE3)
+ * 		2. Make a {SPI_Config_t} variable and call SPI_Init().
+ * 		3. Make a {SPI_Transfer_t} variable for each transfer and call SPI_Queue(), or use SPI_TransferBlocking().
+ *
+ * # Transaction queue ?
+ * 		[♥] Every transfer is full-duplex DMA (RX and TX streams), the CPU only runs once per transfer: the RX stream
+ * 			completion interrupt releases the chip select, invokes the transfer's callback and starts the next queued
+ * 			transfer right away, so several chip-selected transfers run back-to-back.
+ * 		[♥] The queue holds copies of the descriptors, the tx/rx buffers must stay valid until the callback.
+ * 		[♥] A null tx sends SPI_DUMMY_FRAME, a null rx drops the received frames.
+ * 		[♥] DMA streams (RM0090 request mapping, allocated by SPI_Init() through the DMA driver):
+ * 				SPI1 -> DMA2 RX stream 0 / TX stream 3 (channel 3)
+ * 				SPI2 -> DMA1 RX stream 3 / TX stream 4 (channel 0)
+ * 				SPI3 -> DMA1 RX stream 0 / TX stream 7 (channel 0)
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in spi.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef SPI_SPI_H_
+#define SPI_SPI_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "gpio.h"
+#include "dma.h"
+
+
+/*******************************  Macros *******************************/
+/**
+ * @defgroup SPI_Mode_Options {CPOL, CPHA}
+ */
+#define SPI_MODE0				(0b00)		/*idle low, sample on the rising edge*/
+#define SPI_MODE1				(0b01)		/*idle low, sample on the falling edge*/
+#define SPI_MODE2				(0b10)		/*idle high, sample on the falling edge*/
+#define SPI_MODE3				(0b11)		/*idle high, sample on the rising edge*/
+
+/**
+ * @defgroup SPI_Frame_Options
+ */
+#define SPI_FRAME_8BIT			(0)
+#define SPI_FRAME_16BIT			(1)
+
+/**
+ * @defgroup SPI_Bit_Order_Options
+ */
+#define SPI_MSB_FIRST			(0)
+#define SPI_LSB_FIRST			(1)
+
+/*Frame sent when a transfer has no tx buffer*/
+#define SPI_DUMMY_FRAME			(0xFFFFU)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*SPIs' kernel clock: SPI1 on APB2, SPI2/SPI3 on APB1*/
+#define SPI_APB1_CLOCK			(16000000UL)
+#define SPI_APB2_CLOCK			(16000000UL)
+
+/*Queued transfers per instance*/
+#define SPI_QUEUE_SIZE			(8)
+
+
+/******************************* Types *******************************/
+typedef enum{
+	SPI_SPI1 = 0,
+	SPI_SPI2,
+	SPI_SPI3,
+}SPI_Peripheral_en;
+
+/**
+ * @brief Transfer completion callback, invoked from the DMA ISR with the transfer's context.
+ */
+typedef void (*SPI_Callback_t)(void* context);
+
+/**
+ * @struct SPI_Config_t
+ * @brief Master configuration.
+ */
+typedef struct{
+	uint32_t max_hz;		/*highest allowed SCK, the fastest prescaler not exceeding it is used*/
+	uint8_t mode;			/*choose out of @defgroup SPI_Mode_Options*/
+	uint8_t frame;			/*choose out of @defgroup SPI_Frame_Options*/
+	uint8_t bit_order;		/*choose out of @defgroup SPI_Bit_Order_Options*/
+}SPI_Config_t;
+
+/**
+ * @struct SPI_Transfer_t
+ * @brief One chip-selected full-duplex transfer.
+ */
+typedef struct{
+	GPIO_t* cs_port;		/*0: no chip select*/
+	GPIO_Pin_en cs_pin;
+	const void* tx;			/*frames to send (uint8_t or uint16_t), 0: SPI_DUMMY_FRAME*/
+	void* rx;				/*received frames, 0: dropped*/
+	uint16_t frames;		/*[1 - 65535]*/
+	SPI_Callback_t callback;	/*0: none*/
+	void* context;
+}SPI_Transfer_t;
+
+/**
+ * @struct SPI_Stats_t
+ * @brief Throughput accounting of one instance.
+ */
+typedef struct{
+	uint32_t transfers;		/*completed transfers*/
+	uint32_t frames;		/*completed frames*/
+	uint32_t rejected;		/*SPI_Queue() calls refused because the queue was full*/
+	uint32_t errors;		/*DMA transfer errors*/
+}SPI_Stats_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func SPI_Init
+ * @brief Initializes the provided SPI as master with DMA transfers.
+ *
+ * @param	SPI_Peripheral_en spi[IN]			-> specifies which SPI
+ * @param	const SPI_Config_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> SPI->CR1
+ * 				[♥] MSTR		Master
+ * 				[♥] BR[3:5]		f_PCLK / 2^(BR + 1)
+ * 				[♥] SSM/SSI		Software NSS held high (no mode fault)
+ * 				[♥] DFF			8/16-bit frames
+ * 				[♥] CPOL/CPHA	Clock mode
+ *
+ * @return uint32_t		actual SCK frequency, 0: the RX/TX DMA streams are used by another driver
+ */
+uint32_t SPI_Init(SPI_Peripheral_en spi, const SPI_Config_t* config);
+
+/**
+ * @func SPI_Queue
+ * @brief Adds a transfer to the instance's queue, it starts at once if the SPI is idle.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	const SPI_Transfer_t* transfer[IN]	-> copied, can be a local variable
+ *
+ * #Important Registers:
+ * 			=> SPI->CR2
+ * 				[♥] RXDMAEN/TXDMAEN		DMA requests at each RXNE/TXE
+ *
+ * @return uint8_t		1: queued, 0: the queue is full
+ */
+uint8_t SPI_Queue(SPI_Peripheral_en spi, const SPI_Transfer_t* transfer);
+
+/**
+ * @func SPI_IsIdle
+ * @brief Checks if all the queued transfers are done.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @return uint8_t		1: idle, 0: busy
+ */
+uint8_t SPI_IsIdle(SPI_Peripheral_en spi);
+
+/**
+ * @func SPI_TransferBlocking
+ * @brief Queues a transfer and waits until the queue is empty.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	GPIO_t* cs_port[IN]		-> 0: no chip select
+ * @param	GPIO_Pin_en cs_pin[IN]
+ * @param	const void* tx[IN]		-> 0: SPI_DUMMY_FRAME
+ * @param	void* rx[OUT]			-> 0: dropped
+ * @param	uint16_t frames[IN]
+ * @return void
+ */
+void SPI_TransferBlocking(SPI_Peripheral_en spi, GPIO_t* cs_port, GPIO_Pin_en cs_pin, const void* tx, void* rx,
+		uint16_t frames);
+
+/**
+ * @func SPI_GetStats
+ * @brief Copies the throughput accounting of the provided SPI.
+ *
+ * @param	SPI_Peripheral_en spi[IN]
+ * @param	SPI_Stats_t* stats[OUT]
+ * @return void
+ */
+void SPI_GetStats(SPI_Peripheral_en spi, SPI_Stats_t* stats);
+
+
+#endif /* SPI_SPI_H_ */
@@ -0,0 +1,1180 @@
+/**
+ * @file tim.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Timers' module source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which TIM Instance ?
+ * 		[♥] -> We choose which timer instance to work with during whatever API we're working with by passing
+ * 				TIM_Peripheral_en of the dedicated instance.
+ * 			->TIM_Peripheral_en is used as an index of the g_TIM_INSTANCES that has the base addresses of
+ * 				All timer instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] The timers' kernel clocks are configured @Configurations section in the header (tim.h) file,
+ *			they must match the RCC APB1/APB2 prescalers (x2 when the APB prescaler is not 1).
+ *
+ * # Basic (one-shot) timing ?
+ * 		[♥] Used as a timing engine for drivers that need to wait without blocking the CPU (e.g. the LCD async mode).
+ * 		1. Call TIM_BasicInit() once with the tick frequency and an update callback.
+ * 		2. Call TIM_BasicStartOneShot() with the number of ticks to wait, the counter stops by itself and
+ * 			the callback is invoked from the timer's ISR, it can re-arm the timer from there.
+ * 		[♥] TIM_BasicStartPeriodic() keeps the counter reloading instead (one update every period, no re-arm
+ * 			latency in it) until TIM_Stop().
+ *
+ * # PWM ?
+ * 		[♥] Up-counting edge aligned PWM: period = (period + 1) counter ticks, duty = CCRx ticks.
+ * 		1. Configure the channel pins as alternate function (AF1: TIM1/TIM2, AF2: TIM3/TIM4/TIM5, AF3: TIM8 - TIM11,
+ * 			AF9: TIM12 - TIM14) using GPIO_SetPinAF().
+ * 		2. Make a {TIM_PwmConfig_t} variable and call TIM_PwmInit().
+ * 		3. Make a {TIM_PwmChannelConfig_t} variable for each channel and call TIM_PwmConfigureChannel().
+ * 		4. Call TIM_Start(), then TIM_PwmSetDuty() to change a duty (applied at the next period, preloaded).
+ * 		[♥] TIM1/TIM8 (advanced timers) also drive the complementary outputs CH1N - CH3N with dead-time insertion.
+ *
+ * # PWM waveform by DMA burst ?
+ * 		[♥] TIM_PwmStartDmaBurst() makes each update event (every period) load the next {channels_num} duties from a
+ * 			RAM/FLASH table into CCRx through DMAR, the DMA stream runs in circular mode so the waveform repeats
+ * 			forever with zero CPU per period.
+ * 		[♥] Available on the timers that have an update DMA request: TIM1, TIM2, TIM3, TIM4, TIM5, TIM8
+ * 			(it uses the stream listed @g_TIM_UP_DMA in tim.c, don't use that stream for something else).
+ *
+ * # Input capture ?
+ * 		[♥] TIM2/TIM5 (32-bit counters) capture TI1 (CH1 pin) edges, the DMA moves every capture into a caller RAM
+ * 			ring (circular), so hundreds of kHz are measured with no CPU per edge.
+ * 		[♥] TIM_CAPTURE_TIMESTAMPS	-> the ring receives the counter value at each captured edge.
+ * 		[♥] TIM_CAPTURE_PWM_INPUT	-> the counter is reset at each period start (slave reset mode), CH2 captures the
+ * 			opposite edge of the same pin, so the ring receives {period, pulse width} pairs (DMA burst of CCR1-CCR2).
+ * 		1. Configure the CH1 pin as alternate function (TIM2: AF1, TIM5: AF2).
+ * 		2. Make a {TIM_CaptureConfig_t} variable and call TIM_CaptureStart() with a static ring.
+ * 		3. Call TIM_CaptureGetStats() whenever the statistics are needed (it only reads the ring).
+ * 		[♥] Uses the CH1 DMA request: TIM2 -> DMA1 stream 5, TIM5 -> DMA1 stream 2.
+ *
+ * # Quadrature encoder ?
+ * 		[♥] TIM1/TIM2/TIM3/TIM4/TIM5/TIM8 count the TI1/TI2 (CH1/CH2 pins) quadrature edges in hardware, no ISR per edge.
+ * 		[♥] TIM2/TIM5 are 32-bit, TIM_EncoderGetPosition() is a single CNT load. The 16-bit timers are extended to
+ * 			32 bits by their update (overflow/underflow) interrupt, once every 65536 counts.
+ * 		[♥] The wrap direction comes from the CNT half (below/above 0x8000) at the previous update and now, and from
+ * 			CC3 (compare at 0x8000, no pin) telling whether CNT went through the middle in between: back and forth
+ * 			across the 0x0000/0xFFFF wrap is counted right even when several wraps are served by one interrupt.
+ * 			CH3 of a 16-bit encoder timer can't be used for something else.
+ * 		1. Configure the CH1/CH2 pins as alternate function (same AF as PWM).
+ * 		2. Make a {TIM_EncoderConfig_t} variable and call TIM_EncoderInit().
+ * 		3. Optionally call TIM_EncoderVelocityInit() once with a free timer (e.g. TIM6) as the sampling timebase,
+ * 			then read TIM_EncoderGetVelocity() (counts per second) at any time.
+ *
+ * # ISR timing ?
+ * 		[♥] With TIM_ISR_MEMORY = TIM_ISR_IN_RAM the timers' ISRs run from SRAM (LIB_RAMFUNC): no FLASH wait states nor
+ * 			ART misses, so the latency doesn't depend on what the interrupted code was fetching.
+ * 		[♥] With TIM_ISR_JITTER = TIM_ISR_JITTER_ENABLE each update ISR records its period with the cycle counter
+ * 			(LIB_CycleCounterEnable()), TIM_GetIsrJitter() returns min/max: compare both memories on a periodic timer.
+ * 			TIM_BasicInit() restarts the statistics of its timer.
+ * 		[♥] APP_IsrJitterBenchmark() (APP/ISR_JITTER_BENCHMARK.c) prints them for the built TIM_ISR_MEMORY.
+ *
+ */
+
+/******************************* Includes *******************************/
+#include "tim.h"
+#include "common_lib.h"
+
+/*******************************  Macros *******************************/
+#define TIM_INSTANCES_NUM		(14)
+
+/*CCR1 word offset from the timer base (DCR.DBA)*/
+#define TIM_DMA_BURST_CCR1_OFFSET	(13)
+
+/*No DMA request (TIM_DmaRequest_t.dma)*/
+#define TIM_DMA_NONE				(0xFF)
+
+#define TIM_32BIT_MAX_VALUE			(0xFFFFFFFFUL)
+
+/*CCxS input selections*/
+#define TIM_CCS_INPUT_DIRECT		(0b01)		/*ICx on TIx*/
+#define TIM_CCS_INPUT_INDIRECT		(0b10)		/*IC1 on TI2, IC2 on TI1*/
+
+/*Half of the 16-bit range: CNT halves and CC3 middle marker of the encoder extension (TIM_EncoderWrapStep())*/
+#define TIM_16BIT_HALF_RANGE		(0x8000UL)
+#define TIM_16BIT_RANGE				(0x10000L)
+
+/*Master mode: update event as TRGO*/
+#define TIM_CR2_MMS_UPDATE			(0b010)
+
+/*Slave mode: reset on TI1FP1*/
+#define TIM_SMCR_TS_TI1FP1			(0b101)
+#define TIM_SMCR_SMS_RESET			(0b100)
+
+
+/******************************* Configurations (if any) *******************************/
+#if TIM_ISR_MEMORY == TIM_ISR_IN_RAM
+#define TIM_ISR_ATTRIBUTES			LIB_RAMFUNC
+#else
+#define TIM_ISR_ATTRIBUTES
+#endif
+
+
+/******************************* privates *******************************/
+static TIM_t* const g_TIM_INSTANCES[TIM_INSTANCES_NUM] = {
+		TIM1, TIM2, TIM3, TIM4, TIM5, TIM6, TIM7, TIM8, TIM9, TIM10, TIM11, TIM12, TIM13, TIM14
+};
+
+/*NVIC line carrying each timer's update interrupt (some lines are shared by two timers)*/
+static const uint8_t g_TIM_UPDATE_IRQ_NUM[TIM_INSTANCES_NUM] = {
+		25, 28, 29, 30, 50, 54, 55, 44, 24, 25, 26, 43, 44, 45
+};
+
+static volatile TIM_Callback_t g_TIM_UPDATE_CALLBACKS[TIM_INSTANCES_NUM] = {0};
+
+/*DAC underrun handler sharing the TIM6 NVIC line*/
+static volatile TIM_Callback_t g_TIM_DAC_IRQ_HOOK = 0;
+
+/*Update (TIMx_UP) DMA request of each timer: controller, stream and channel (RM0090 DMA1/DMA2 request mapping)*/
+typedef struct{
+	uint8_t dma;		/*DMA_Peripheral_en, TIM_DMA_NONE: no update DMA request*/
+	uint8_t stream;		/*DMA_Stream_en*/
+	uint8_t channel;
+}TIM_DmaRequest_t;
+
+static const TIM_DmaRequest_t g_TIM_UP_DMA[TIM_INSTANCES_NUM] = {
+		{DMA_DMA2, DMA_STREAM5, 6},		/*TIM1*/
+		{DMA_DMA1, DMA_STREAM1, 3},		/*TIM2*/
+		{DMA_DMA1, DMA_STREAM2, 5},		/*TIM3*/
+		{DMA_DMA1, DMA_STREAM6, 2},		/*TIM4*/
+		{DMA_DMA1, DMA_STREAM0, 6},		/*TIM5*/
+		{DMA_DMA1, DMA_STREAM1, 7},		/*TIM6*/
+		{DMA_DMA1, DMA_STREAM4, 1},		/*TIM7*/
+		{DMA_DMA2, DMA_STREAM1, 7},		/*TIM8*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM9*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM10*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM11*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM12*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM13*/
+		{TIM_DMA_NONE, 0, 0},			/*TIM14*/
+};
+
+/*CH1 DMA request of the 32-bit timers used for input capture*/
+static const TIM_DmaRequest_t g_TIM_CC1_DMA_TIM2 = {DMA_DMA1, DMA_STREAM5, 3};
+static const TIM_DmaRequest_t g_TIM_CC1_DMA_TIM5 = {DMA_DMA1, DMA_STREAM2, 6};
+
+/*Input capture sessions*/
+typedef struct{
+	uint32_t* ring;
+	uint16_t ring_len;
+	uint16_t last_pos;		/*DMA write position seen by the last TIM_CaptureGetStats()*/
+	uint8_t mode;
+	uint8_t filled;			/*the DMA has wrapped around the ring at least once*/
+}TIM_CaptureSession_t;
+
+static TIM_CaptureSession_t g_TIM_CAPTURE[TIM_INSTANCES_NUM];
+
+/*Encoder interfaces*/
+typedef struct{
+	volatile int32_t high;		/*16-bit timers: position - CNT, moved by +/-65536 at each overflow/underflow*/
+	volatile uint8_t upper_half;	/*16-bit timers: CNT was at or above TIM_16BIT_HALF_RANGE at the last update*/
+	int32_t last_position;		/*velocity estimator*/
+	volatile int32_t velocity;	/*counts per second*/
+	uint8_t enabled;
+	uint8_t extended;			/*16-bit counter extended by the update interrupt*/
+}TIM_EncoderState_t;
+
+static TIM_EncoderState_t g_TIM_ENCODERS[TIM_INSTANCES_NUM];
+static uint32_t g_TIM_ENCODER_SAMPLE_HZ = 0;
+
+#if TIM_ISR_JITTER == TIM_ISR_JITTER_ENABLE
+static LIB_Jitter_t g_TIM_ISR_JITTER[TIM_INSTANCES_NUM];
+#endif
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func TIM_EncoderWrapStep
+ * @brief Extension change of the 16-bit encoders for the wraps since the last update interrupt.
+ *
+ * # A single wrap moves CNT to the other half (overflow: lower, underflow: upper). Still in the same half, it
+ * 	 either went back and forth across the wrap (0) or made a full turn through the middle (CC3IF, away from the
+ * 	 half it is in).
+ *
+ * @note STATIC FUNCTION
+ * @param	uint8_t upper_half[IN]	-> CNT half at the last update
+ * @param	uint32_t count[IN]		-> CNT now
+ * @param	uint8_t middle[IN]		-> CC3IF: CNT went through TIM_16BIT_HALF_RANGE since the last update
+ * @return int32_t					-> 0, +/-TIM_16BIT_RANGE
+ */
+TIM_ISR_ATTRIBUTES static int32_t TIM_EncoderWrapStep(uint8_t upper_half, uint32_t count, uint8_t middle){
+
+	uint8_t upper = (count >= TIM_16BIT_HALF_RANGE);
+
+	if((upper == upper_half) && !middle){
+		return 0;
+	}
+	return upper ? -TIM_16BIT_RANGE : TIM_16BIT_RANGE;
+}
+
+/**
+ * @func TIM_IRQDispatch
+ * @brief Serves the pending, enabled events of one timer.
+ *
+ * @note STATIC FUNCTION
+ * @return void
+ */
+TIM_ISR_ATTRIBUTES static void TIM_IRQDispatch(TIM_Peripheral_en tim){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+
+	if(GET_BIT(instance->SR, TIM_SR_UIF) && GET_BIT(instance->DIER, TIM_DIER_UIE)){
+#if TIM_ISR_JITTER == TIM_ISR_JITTER_ENABLE
+		LIB_JitterRecord(&g_TIM_ISR_JITTER[tim]);
+#endif
+		if(g_TIM_ENCODERS[tim].extended){
+			//16-bit encoder extension, CNT is read after the clear: a wrap in between raises the interrupt again
+			//and is seen as none by it (same half, CNT far from the middle)
+			TIM_EncoderState_t* encoder = &g_TIM_ENCODERS[tim];
+			uint8_t middle = GET_BIT(instance->SR, TIM_SR_CC3IF);
+			instance->SR = ~(uint32_t)((1UL << TIM_SR_UIF) | (1UL << TIM_SR_CC3IF));
+			uint32_t count = instance->CNT;
+			encoder->high += TIM_EncoderWrapStep(encoder->upper_half, count, middle);
+			encoder->upper_half = (count >= TIM_16BIT_HALF_RANGE);
+		}else{
+			//rc_w0 flags: write 0 only to the served flag so other pending flags aren't lost
+			instance->SR = ~(uint32_t)(1UL << TIM_SR_UIF);
+		}
+
+		if(g_TIM_UPDATE_CALLBACKS[tim] != 0){
+			g_TIM_UPDATE_CALLBACKS[tim]();
+		}
+	}
+}
+
+/**
+ * @func TIM_EnableClock
+ * @brief Enables the bus clock of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_EnableClock(TIM_Peripheral_en tim){
+
+	switch(tim){
+	case TIM_TIM1:	RCC_EnableAPB2Clock(RCC_APB2_TIM1);		break;
+	case TIM_TIM2:	RCC_EnableAPB1Clock(RCC_APB1_TIM2);		break;
+	case TIM_TIM3:	RCC_EnableAPB1Clock(RCC_APB1_TIM3);		break;
+	case TIM_TIM4:	RCC_EnableAPB1Clock(RCC_APB1_TIM4);		break;
+	case TIM_TIM5:	RCC_EnableAPB1Clock(RCC_APB1_TIM5);		break;
+	case TIM_TIM6:	RCC_EnableAPB1Clock(RCC_APB1_TIM6);		break;
+	case TIM_TIM7:	RCC_EnableAPB1Clock(RCC_APB1_TIM7);		break;
+	case TIM_TIM8:	RCC_EnableAPB2Clock(RCC_APB2_TIM8);		break;
+	case TIM_TIM9:	RCC_EnableAPB2Clock(RCC_APB2_TIM9);		break;
+	case TIM_TIM10:	RCC_EnableAPB2Clock(RCC_APB2_TIM10);	break;
+	case TIM_TIM11:	RCC_EnableAPB2Clock(RCC_APB2_TIM11);	break;
+	case TIM_TIM12:	RCC_EnableAPB1Clock(RCC_APB1_TIM12);	break;
+	case TIM_TIM13:	RCC_EnableAPB1Clock(RCC_APB1_TIM13);	break;
+	case TIM_TIM14:	RCC_EnableAPB1Clock(RCC_APB1_TIM14);	break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @func TIM_GetKernelClock
+ * @brief Returns the kernel clock (before the prescaler) of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return uint32_t	clock in Hz
+ */
+uint32_t TIM_GetKernelClock(TIM_Peripheral_en tim){
+
+	uint32_t clock = TIM_APB1_TIMER_CLOCK;
+
+	switch(tim){
+	case TIM_TIM1:
+	case TIM_TIM8:
+	case TIM_TIM9:
+	case TIM_TIM10:
+	case TIM_TIM11:
+		clock = TIM_APB2_TIMER_CLOCK;
+		break;
+	default:
+		break;
+	}
+	return clock;
+}
+
+/**
+ * @func TIM_BasicInit
+ * @brief Configures a timer as a one-shot up-counter with the provided tick frequency and update interrupt.
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> specifies which timer (TIM6/TIM7 are the intended basic timers)
+ * @param	uint32_t tick_hz[IN]				-> counter tick frequency, e.g. 1000000 for 1 us ticks
+ * @param	TIM_Callback_t update_callback[IN]	-> invoked from the ISR when the one-shot period elapses
+ *
+ * #Important Registers:
+ * 			=> TIM->CR1
+ * 				[♥] OPM[3]		One-pulse mode, counter stops at the next update event
+ * 				[♥] URS[2]		Only counter overflow generates an update interrupt (not UG)
+ * 			=> TIM->PSC		Prescaler, loaded at the next update event (forced using EGR.UG)
+ * 			=> TIM->DIER
+ * 				[♥] UIE[0]		Update interrupt enable
+ *
+ * @return void
+ */
+void TIM_BasicInit(TIM_Peripheral_en tim, uint32_t tick_hz, TIM_Callback_t update_callback){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	uint32_t prescaler = (TIM_GetKernelClock(tim) / tick_hz) - 1;
+	if(prescaler > TIM_MAX_16BIT_VALUE){
+		prescaler = TIM_MAX_16BIT_VALUE;
+	}
+
+	TIM_EnableClock(tim);
+
+	instance->CR1 = 0;
+	SET_BIT(instance->CR1, TIM_CR1_OPM);
+	SET_BIT(instance->CR1, TIM_CR1_URS);
+
+	instance->PSC = prescaler;
+	//load the prescaler now, URS keeps this update event from raising an interrupt
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+	instance->SR = 0;
+
+	g_TIM_UPDATE_CALLBACKS[tim] = update_callback;
+#if TIM_ISR_JITTER == TIM_ISR_JITTER_ENABLE
+	LIB_JitterReset(&g_TIM_ISR_JITTER[tim]);
+#endif
+	SET_BIT(instance->DIER, TIM_DIER_UIE);
+
+	NVIC_EnableIRQ(g_TIM_UPDATE_IRQ_NUM[tim]);
+}
+
+/**
+ * @func TIM_BasicStartOneShot
+ * @brief Starts a single period of the provided number of ticks, the update callback is invoked at its end.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @param	uint16_t ticks[IN]			-> period in ticks [2 - 65535], smaller values wait 2 ticks
+ * @return void
+ */
+void TIM_BasicStartOneShot(TIM_Peripheral_en tim, uint16_t ticks){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+
+	/*counting 0 -> ARR takes ARR + 1 ticks, ARR = 0 would keep the counter stopped*/
+	instance->ARR = (ticks > 2) ? (ticks - 1U) : 1U;
+	instance->CNT = 0;
+	SET_BIT(instance->CR1, TIM_CR1_OPM);
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+}
+
+/**
+ * @func TIM_BasicStartPeriodic
+ * @brief Starts a free-running period of the provided number of ticks, the update callback is invoked at the end
+ * 		  of every period until TIM_Stop().
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer (initialized by TIM_BasicInit())
+ * @param	uint16_t ticks[IN]			-> period in ticks [2 - 65535], smaller values are 2 ticks
+ * @return void
+ */
+void TIM_BasicStartPeriodic(TIM_Peripheral_en tim, uint16_t ticks){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+
+	instance->ARR = (ticks > 2) ? (ticks - 1U) : 1U;
+	instance->CNT = 0;
+	CLEAR_BIT(instance->CR1, TIM_CR1_OPM);
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+}
+
+/**
+ * @func TIM_TriggerInit
+ * @brief Configures a free-running up-counter whose update event drives TRGO at the provided rate (no interrupt).
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> TIM1 - TIM8 (TIM6/TIM7 are the intended ones)
+ * @param	uint32_t rate_hz[IN]		-> update (TRGO) frequency
+ *
+ * #Important Registers:
+ * 			=> TIM->CR2
+ * 				[♥] MMS[4-6] = 010		Update event as TRGO
+ * 			=> TIM->PSC, TIM->ARR		rate = kernel clock / ((PSC + 1) x (ARR + 1))
+ *
+ * @return uint32_t		actual rate (the counter is started)
+ */
+uint32_t TIM_TriggerInit(TIM_Peripheral_en tim, uint32_t rate_hz){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	uint32_t clock = TIM_GetKernelClock(tim);
+	uint32_t ticks = clock / rate_hz;
+	uint32_t prescaler = 0;
+
+	if(ticks == 0){
+		ticks = 1;
+	}
+	//smallest prescaler keeping ARR in 16 bits, for the finest rate resolution
+	while((ticks / (prescaler + 1)) > (TIM_MAX_16BIT_VALUE + 1)){
+		prescaler++;
+	}
+	uint32_t period = ticks / (prescaler + 1);
+
+	TIM_EnableClock(tim);
+
+	instance->CR1 = 0;
+	instance->DIER = 0;
+	instance->PSC = prescaler;
+	instance->ARR = period - 1;
+	instance->CR2 = ((uint32_t)TIM_CR2_MMS_UPDATE << TIM_CR2_MMS);
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+	instance->SR = 0;
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+
+	return clock / ((prescaler + 1) * period);
+}
+
+/**
+ * @func TIM_SetDacIRQHook
+ * @brief Registers the handler invoked from TIM6_DAC_IRQHandler for the DAC underrun events.
+ *
+ * @param	TIM_Callback_t hook[IN]		-> 0: none
+ * @return void
+ */
+void TIM_SetDacIRQHook(TIM_Callback_t hook){
+	g_TIM_DAC_IRQ_HOOK = hook;
+}
+
+/**
+ * @func TIM_Stop
+ * @brief Stops the counter of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_Stop(TIM_Peripheral_en tim){
+	CLEAR_BIT(g_TIM_INSTANCES[tim]->CR1, TIM_CR1_CEN);
+}
+
+/**
+ * @func TIM_Start
+ * @brief Starts the counter of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_Start(TIM_Peripheral_en tim){
+	SET_BIT(g_TIM_INSTANCES[tim]->CR1, TIM_CR1_CEN);
+}
+
+/**
+ * @func TIM_IsAdvanced
+ * @brief Checks if the timer is an advanced-control timer (complementary outputs, dead-time, BDTR.MOE).
+ *
+ * @note STATIC FUNCTION
+ * @return uint8_t	1: TIM1/TIM8
+ */
+static uint8_t TIM_IsAdvanced(TIM_Peripheral_en tim){
+	return (tim == TIM_TIM1) || (tim == TIM_TIM8);
+}
+
+/**
+ * @func TIM_PwmInit
+ * @brief Configures a timer as an up-counting PWM time base (auto-reload preloaded), the counter isn't started.
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> specifies which timer (TIM1 - TIM5, TIM8 - TIM14)
+ * @param	const TIM_PwmConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->CR1
+ * 				[♥] ARPE[7]		ARR is buffered, a new period applies at the next update event
+ * 			=> TIM->PSC, TIM->ARR
+ * 			=> TIM->BDTR (TIM1/TIM8)
+ * 				[♥] MOE[15]		Main output enable, advanced timers' outputs are off without it
+ * 				[♥] DTG[0-7]	Dead-time generator
+ *
+ * @return void
+ */
+void TIM_PwmInit(TIM_Peripheral_en tim, const TIM_PwmConfig_t* config){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	uint32_t prescaler = (TIM_GetKernelClock(tim) / config->counter_hz) - 1;
+	if(prescaler > TIM_MAX_16BIT_VALUE){
+		prescaler = TIM_MAX_16BIT_VALUE;
+	}
+
+	TIM_EnableClock(tim);
+
+	//edge aligned, up-counting, ARR preloaded
+	instance->CR1 = 0;
+	SET_BIT(instance->CR1, TIM_CR1_ARPE);
+
+	instance->PSC = prescaler;
+	instance->ARR = config->period;
+	instance->CCER = 0;
+
+	if(TIM_IsAdvanced(tim)){
+		instance->RCR = 0;
+		instance->BDTR = ((uint32_t)config->dead_time << TIM_BDTR_DTG);
+		SET_BIT(instance->BDTR, TIM_BDTR_MOE);
+	}
+
+	//load PSC/ARR now
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+}
+
+/**
+ * @func TIM_PwmConfigureChannel
+ * @brief Configures a channel as PWM output (and its complementary output on TIM1/TIM8).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	const TIM_PwmChannelConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->CCMRx
+ * 				[♥] OCxM		PWM mode 1/2
+ * 				[♥] OCxPE		CCRx is buffered, a new duty applies at the next update event (no glitches)
+ * 			=> TIM->CCER
+ * 				[♥] CCxE/CCxP	Output enable/polarity
+ * 				[♥] CCxNE/CCxNP	Complementary output enable/polarity
+ *
+ * @return void
+ */
+void TIM_PwmConfigureChannel(TIM_Peripheral_en tim, const TIM_PwmChannelConfig_t* config){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	volatile uint32_t* ccmr = (config->channel < TIM_CHANNEL3) ? &instance->CCMR1 : &instance->CCMR2;
+	//channels 1/3 use the low half of their CCMR, channels 2/4 the high half
+	uint8_t ccmr_shift = (config->channel & 1) ? TIM_CCMR1_CC2S : TIM_CCMR1_CC1S;
+	uint8_t ccer_shift = config->channel * 4;
+
+	//output (CCxS = 00), PWM mode, preload
+	*ccmr &= ~(0xFFUL << ccmr_shift);
+	*ccmr |= ((uint32_t)(config->mode & 0b111) << (ccmr_shift + TIM_CCMR1_OC1M));
+	*ccmr |= (1UL << (ccmr_shift + TIM_CCMR1_OC1PE));
+
+	TIM_PwmSetDuty(tim, config->channel, config->duty);
+
+	instance->CCER &= ~(0xFUL << ccer_shift);
+	instance->CCER |= ((uint32_t)(config->polarity & 1) << (ccer_shift + TIM_CCER_CC1P));
+	SET_BIT(instance->CCER, (ccer_shift + TIM_CCER_CC1E));
+
+	if(TIM_IsAdvanced(tim) && (config->channel != TIM_CHANNEL4) &&
+	   (config->complementary == TIM_COMPLEMENTARY_ENABLED)){
+		instance->CCER |= ((uint32_t)(config->complementary_polarity & 1) << (ccer_shift + TIM_CCER_CC1NP));
+		SET_BIT(instance->CCER, (ccer_shift + TIM_CCER_CC1NE));
+	}
+}
+
+/**
+ * @func TIM_PwmSetDuty
+ * @brief Changes the duty of a channel (applied at the next period).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	TIM_Channel_en channel[IN]
+ * @param	uint32_t duty[IN]		-> CCRx in ticks, [0 - period + 1] (period + 1 is 100%)
+ * @return void
+ */
+void TIM_PwmSetDuty(TIM_Peripheral_en tim, TIM_Channel_en channel, uint32_t duty){
+	(&g_TIM_INSTANCES[tim]->CCR1)[channel] = duty;
+}
+
+/**
+ * @func TIM_DmaStartCircular
+ * @brief Allocates the request's stream and starts it (32-bit words, circular, direct mode, no interrupts).
+ *
+ * @note STATIC FUNCTION
+ * @return uint8_t		1: started, 0: the stream is owned by another request
+ */
+static uint8_t TIM_DmaStartCircular(const TIM_DmaRequest_t* request, uint8_t direction, uint8_t priority,
+		uint32_t periph_addr, uint32_t mem_addr, uint16_t count){
+
+	DMA_StreamConfig_t config = {
+			.channel = request->channel,
+			.direction = direction,
+			.priority = priority,
+			.periph_size = DMA_SIZE_WORD,
+			.mem_size = DMA_SIZE_WORD,
+			.periph_inc = DMA_INCREMENT_DISABLED,
+			.mem_inc = DMA_INCREMENT_ENABLED,
+			.circular = DMA_CIRCULAR_ENABLED,
+			.fifo = DMA_FIFO_DIRECT,
+			.interrupts = DMA_IT_NONE,
+	};
+
+	if(!DMA_Allocate(request->dma, request->stream, request->channel)){
+		return 0;
+	}
+	DMA_Configure(request->dma, request->stream, &config);
+	DMA_Start(request->dma, request->stream, periph_addr, mem_addr, count);
+
+	return 1;
+}
+
+/**
+ * @func TIM_PwmStartDmaBurst
+ * @brief Starts reloading consecutive CCRx from a waveform table at each update event using DMA burst (circular).
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> TIM1, TIM2, TIM3, TIM4, TIM5 or TIM8
+ * @param	TIM_Channel_en first_channel[IN]	-> first CCRx reloaded
+ * @param	uint8_t channels_num[IN]			-> number of consecutive CCRx reloaded each period [1 - 4]
+ * @param	const uint32_t* table[IN]			-> duties, {channels_num} per period, must stay valid while running
+ * @param	uint16_t table_len[IN]				-> number of words in table, a multiple of channels_num
+ *
+ * #Important Registers:
+ * 			=> TIM->DCR
+ * 				[♥] DBA[0-4]	First register of the burst (CCR1 + first_channel) as a word offset
+ * 				[♥] DBL[8-12]	Burst length - 1
+ * 			=> TIM->DIER
+ * 				[♥] UDE[8]		Update DMA request
+ * 			=> DMA->STREAM[x].CR
+ * 				[♥] CHSEL		Request channel of the timer's update
+ * 				[♥] CIRC		NDTR reloads at the end of the table
+ *
+ * @return uint8_t		1: started, 0: the timer has no update DMA request or its stream is used by another request
+ */
+uint8_t TIM_PwmStartDmaBurst(TIM_Peripheral_en tim, TIM_Channel_en first_channel, uint8_t channels_num,
+							 const uint32_t* table, uint16_t table_len){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	const TIM_DmaRequest_t* request = &g_TIM_UP_DMA[tim];
+
+	if((request->dma == TIM_DMA_NONE) || (tim == TIM_TIM6) || (tim == TIM_TIM7) ||
+	   (channels_num == 0) || ((first_channel + channels_num) > 4) || (table_len < channels_num)){
+		return 0;
+	}
+
+	/*Stream: memory (table) -> TIMx_DMAR, 32-bit, circular*/
+	if(!TIM_DmaStartCircular(request, DMA_DIR_MEM_TO_PERIPH, DMA_PRIORITY_HIGH,
+							 (uint32_t)&instance->DMAR, (uint32_t)table, table_len)){
+		return 0;
+	}
+
+	/*Timer: each update event requests {channels_num} transfers through DMAR starting at CCRx*/
+	instance->DCR = ((uint32_t)(TIM_DMA_BURST_CCR1_OFFSET + first_channel) << TIM_DCR_DBA) |
+					((uint32_t)(channels_num - 1) << TIM_DCR_DBL);
+	SET_BIT(instance->DIER, TIM_DIER_UDE);
+
+	return 1;
+}
+
+/**
+ * @func TIM_PwmStopDmaBurst
+ * @brief Stops the DMA burst reloads, the last loaded duties are kept.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return void
+ */
+void TIM_PwmStopDmaBurst(TIM_Peripheral_en tim){
+
+	const TIM_DmaRequest_t* request = &g_TIM_UP_DMA[tim];
+
+	CLEAR_BIT(g_TIM_INSTANCES[tim]->DIER, TIM_DIER_UDE);
+	if(request->dma != TIM_DMA_NONE){
+		DMA_Free(request->dma, request->stream, request->channel);
+	}
+}
+
+/**
+ * @func TIM_CaptureGetDma
+ * @brief Returns the CH1 DMA request of TIM2/TIM5, 0 for the other timers.
+ *
+ * @note STATIC FUNCTION
+ */
+static const TIM_DmaRequest_t* TIM_CaptureGetDma(TIM_Peripheral_en tim){
+	switch(tim){
+	case TIM_TIM2:	return &g_TIM_CC1_DMA_TIM2;
+	case TIM_TIM5:	return &g_TIM_CC1_DMA_TIM5;
+	default:		return 0;
+	}
+}
+
+/**
+ * @func TIM_CaptureStart
+ * @brief Starts capturing TI1 edges of TIM2/TIM5 into a RAM ring using DMA (circular).
+ *
+ * @param	TIM_Peripheral_en tim[IN]				-> TIM2 or TIM5
+ * @param	const TIM_CaptureConfig_t* config[IN]
+ * @param	uint32_t* ring[IN]						-> static buffer written by the DMA
+ * @param	uint16_t ring_len[IN]					-> words in ring (even in TIM_CAPTURE_PWM_INPUT), at least 4
+ *
+ * #Important Registers:
+ * 			=> TIM->CCMR1
+ * 				[♥] CC1S/CC2S	01: ICx mapped on TIx, 10: IC2 mapped on TI1 (PWM input)
+ * 				[♥] IC1PSC		Capture once every 1/2/4/8 edges
+ * 				[♥] IC1F		Digital filter
+ * 			=> TIM->CCER
+ * 				[♥] CC1P/CC1NP	Edge(s) captured
+ * 			=> TIM->SMCR
+ * 				[♥] TS = 101 (TI1FP1), SMS = 100 (reset mode)	PWM input: counter reset at each period start
+ * 			=> TIM->DIER
+ * 				[♥] CC1DE		DMA request at each CH1 capture
+ *
+ * @return uint8_t		1: started, 0: not TIM2/TIM5, invalid ring or its stream is used by another request
+ */
+uint8_t TIM_CaptureStart(TIM_Peripheral_en tim, const TIM_CaptureConfig_t* config, uint32_t* ring, uint16_t ring_len){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	const TIM_DmaRequest_t* request = TIM_CaptureGetDma(tim);
+	TIM_CaptureSession_t* session = &g_TIM_CAPTURE[tim];
+	uint8_t pwm_input = (config->mode == TIM_CAPTURE_PWM_INPUT);
+
+	if((request == 0) || (ring_len < 4) || (pwm_input && (ring_len & 1))){
+		return 0;
+	}
+
+	uint32_t prescaler = (TIM_GetKernelClock(tim) / config->counter_hz) - 1;
+	if(prescaler > TIM_MAX_16BIT_VALUE){
+		prescaler = TIM_MAX_16BIT_VALUE;
+	}
+
+	TIM_EnableClock(tim);
+	TIM_CaptureStop(tim);
+
+	session->ring = ring;
+	session->ring_len = ring_len;
+	session->last_pos = 0;
+	session->mode = config->mode;
+	session->filled = 0;
+
+	/*Time base: free running over the whole 32-bit range*/
+	instance->CR1 = 0;
+	instance->SMCR = 0;
+	instance->DIER = 0;
+	instance->CCER = 0;
+	instance->PSC = prescaler;
+	instance->ARR = TIM_32BIT_MAX_VALUE;
+
+	/*IC1 on TI1 with its prescaler and filter*/
+	instance->CCMR1 = ((uint32_t)TIM_CCS_INPUT_DIRECT << TIM_CCMR1_CC1S) |
+					  ((uint32_t)(config->filter & 0xF) << TIM_CCMR1_IC1F);
+	instance->CCER = ((uint32_t)(config->edge & 1) << TIM_CCER_CC1P) |
+					 ((uint32_t)((config->edge >> 1) & 1) << TIM_CCER_CC1NP);
+
+	if(pwm_input){
+		//IC2 on TI1 too, opposite edge, same filter (the prescaler would break the pairing)
+		instance->CCMR1 |= ((uint32_t)TIM_CCS_INPUT_INDIRECT << TIM_CCMR1_CC2S) |
+						   ((uint32_t)(config->filter & 0xF) << TIM_CCMR1_IC2F);
+		instance->CCER |= ((uint32_t)((config->edge & 1) ^ 1) << TIM_CCER_CC2P);
+		SET_BIT(instance->CCER, TIM_CCER_CC2E);
+
+		//counter reset at each period start, CCR1 = period, CCR2 = pulse width
+		instance->SMCR = ((uint32_t)TIM_SMCR_TS_TI1FP1 << TIM_SMCR_TS) |
+						 ((uint32_t)TIM_SMCR_SMS_RESET << TIM_SMCR_SMS);
+
+		//each CH1 capture moves CCR1 then CCR2 through DMAR
+		instance->DCR = ((uint32_t)TIM_DMA_BURST_CCR1_OFFSET << TIM_DCR_DBA) | (1UL << TIM_DCR_DBL);
+	}else{
+		instance->CCMR1 |= ((uint32_t)(config->prescaler & 0b11) << TIM_CCMR1_IC1PSC);
+	}
+	SET_BIT(instance->CCER, TIM_CCER_CC1E);
+
+	/*Stream: CCR1 (or DMAR) -> ring, 32-bit, circular*/
+	if(!TIM_DmaStartCircular(request, DMA_DIR_PERIPH_TO_MEM, DMA_PRIORITY_VERY_HIGH,
+							 pwm_input ? (uint32_t)&instance->DMAR : (uint32_t)&instance->CCR1,
+							 (uint32_t)ring, ring_len)){
+		session->ring = 0;
+		return 0;
+	}
+
+	/*Start*/
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+	instance->SR = 0;
+	SET_BIT(instance->DIER, TIM_DIER_CC1DE);
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+
+	return 1;
+}
+
+/**
+ * @func TIM_CaptureStop
+ * @brief Stops the capture and its DMA stream.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return void
+ */
+void TIM_CaptureStop(TIM_Peripheral_en tim){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	const TIM_DmaRequest_t* request = TIM_CaptureGetDma(tim);
+
+	CLEAR_BIT(instance->CR1, TIM_CR1_CEN);
+	CLEAR_BIT(instance->DIER, TIM_DIER_CC1DE);
+
+	if(request != 0){
+		DMA_Free(request->dma, request->stream, request->channel);
+	}
+}
+
+/**
+ * @func TIM_CaptureGetStats
+ * @brief Computes period (and pulse width) statistics over the most recent captures in the ring.
+ *
+ * # The DMA write position is (ring_len - NDTR). The ring is known to be full once the position has been seen
+ * 	 going backwards, until then only the entries before the position are used, so unwritten entries are never read.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	uint16_t samples_num[IN]			-> number of most recent periods wanted (less are used if not captured yet)
+ * @param	TIM_CaptureStats_t* stats[OUT]
+ * @return uint8_t		1: at least one period available, 0: nothing captured yet
+ */
+uint8_t TIM_CaptureGetStats(TIM_Peripheral_en tim, uint16_t samples_num, TIM_CaptureStats_t* stats){
+
+	TIM_CaptureSession_t* session = &g_TIM_CAPTURE[tim];
+	const TIM_DmaRequest_t* request = TIM_CaptureGetDma(tim);
+
+	stats->samples = 0;
+	if((request == 0) || (session->ring == 0)){
+		return 0;
+	}
+
+	uint16_t len = session->ring_len;
+	uint16_t pos = (uint16_t)((len - DMA_GetRemaining(request->dma, request->stream)) % len);
+	if(pos < session->last_pos){
+		session->filled = 1;
+	}
+	session->last_pos = pos;
+
+	uint64_t period_sum = 0;
+	uint64_t width_sum = 0;
+	uint32_t period_min = TIM_32BIT_MAX_VALUE;
+	uint32_t period_max = 0;
+	uint16_t available;
+
+	if(session->mode == TIM_CAPTURE_PWM_INPUT){
+		//{period, width} pairs, a pair being written (odd position) isn't complete yet
+		uint16_t pairs = len / 2;
+		uint16_t newest = pos / 2;
+		available = session->filled ? (pairs - 1) : newest;
+		if(samples_num > available){
+			samples_num = available;
+		}
+		for(uint16_t i = 0; i < samples_num; i++){
+			uint16_t pair = (uint16_t)((newest + pairs - 1 - i) % pairs);
+			uint32_t period = session->ring[pair * 2];
+			period_sum += period;
+			width_sum += session->ring[(pair * 2) + 1];
+			if(period < period_min) period_min = period;
+			if(period > period_max) period_max = period;
+		}
+	}else{
+		//timestamps, a period is the (modulo 2^32) difference of consecutive ones
+		available = session->filled ? (len - 1) : ((pos > 0) ? (pos - 1) : 0);
+		if(samples_num > available){
+			samples_num = available;
+		}
+		for(uint16_t i = 0; i < samples_num; i++){
+			uint16_t index = (uint16_t)((pos + len - 1 - i) % len);
+			uint16_t previous = (uint16_t)((index + len - 1) % len);
+			uint32_t period = session->ring[index] - session->ring[previous];
+			period_sum += period;
+			if(period < period_min) period_min = period;
+			if(period > period_max) period_max = period;
+		}
+	}
+
+	if(samples_num == 0){
+		return 0;
+	}
+
+	stats->samples = samples_num;
+	stats->period_min = period_min;
+	stats->period_max = period_max;
+	stats->period_avg = (uint32_t)(period_sum / samples_num);
+	stats->width_avg = (uint32_t)(width_sum / samples_num);
+	stats->duty_permille = (period_sum != 0) ? (uint16_t)((width_sum * 1000) / period_sum) : 0;
+
+	return 1;
+}
+
+/**
+ * @func TIM_HasEncoder
+ * @brief Checks if the timer has the encoder interface (slave mode controller with TI1/TI2).
+ *
+ * @note STATIC FUNCTION
+ */
+static uint8_t TIM_HasEncoder(TIM_Peripheral_en tim){
+	return (tim <= TIM_TIM5) || (tim == TIM_TIM8);
+}
+
+/**
+ * @func TIM_Is32Bit
+ * @brief Checks if the timer has a 32-bit counter.
+ *
+ * @note STATIC FUNCTION
+ */
+static uint8_t TIM_Is32Bit(TIM_Peripheral_en tim){
+	return (tim == TIM_TIM2) || (tim == TIM_TIM5);
+}
+
+/**
+ * @func TIM_EncoderInit
+ * @brief Puts the timer in encoder interface mode and starts counting from position 0.
+ *
+ * @param	TIM_Peripheral_en tim[IN]				-> TIM1, TIM2, TIM3, TIM4, TIM5 or TIM8
+ * @param	const TIM_EncoderConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->SMCR
+ * 				[♥] SMS		001/010/011 Encoder mode 1/2/3
+ * 			=> TIM->CCMR1
+ * 				[♥] CC1S/CC2S = 01	IC1 on TI1, IC2 on TI2
+ * 				[♥] IC1F/IC2F		Digital filters
+ * 			=> TIM->CCER
+ * 				[♥] CC1P			Inverts TI1, i.e. the counting direction
+ * 			=> TIM->DIER
+ * 				[♥] UIE				Overflow/underflow interrupt (16-bit timers only)
+ * 			=> TIM->CCR3
+ * 				[♥] Half-range marker of the 16-bit timers (CC3IF, frozen output compare)
+ *
+ * @return uint8_t		1: started, 0: the timer has no encoder interface
+ */
+uint8_t TIM_EncoderInit(TIM_Peripheral_en tim, const TIM_EncoderConfig_t* config){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	TIM_EncoderState_t* encoder = &g_TIM_ENCODERS[tim];
+
+	if(!TIM_HasEncoder(tim)){
+		return 0;
+	}
+
+	TIM_EnableClock(tim);
+
+	instance->CR1 = 0;
+	instance->DIER = 0;
+	instance->CCER = 0;
+	//URS: only counter overflow/underflow raise the update interrupt
+	SET_BIT(instance->CR1, TIM_CR1_URS);
+	instance->PSC = 0;
+	instance->ARR = TIM_Is32Bit(tim) ? TIM_32BIT_MAX_VALUE : TIM_MAX_16BIT_VALUE;
+
+	instance->CCMR1 = ((uint32_t)TIM_CCS_INPUT_DIRECT << TIM_CCMR1_CC1S) |
+					  ((uint32_t)(config->filter & 0xF) << TIM_CCMR1_IC1F) |
+					  ((uint32_t)TIM_CCS_INPUT_DIRECT << TIM_CCMR1_CC2S) |
+					  ((uint32_t)(config->filter & 0xF) << TIM_CCMR1_IC2F);
+	if(config->direction == TIM_ENCODER_DIRECTION_INVERTED){
+		SET_BIT(instance->CCER, TIM_CCER_CC1P);
+	}
+	instance->SMCR = ((uint32_t)(config->mode & 0b111) << TIM_SMCR_SMS);
+
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+	instance->SR = 0;
+	instance->CNT = 0;
+
+	encoder->high = 0;
+	encoder->upper_half = 0;
+	encoder->last_position = 0;
+	encoder->velocity = 0;
+	//TIM2/TIM5 wrap at 32 bits by themselves, no extension needed
+	encoder->extended = !TIM_Is32Bit(tim);
+	encoder->enabled = 1;
+
+	if(encoder->extended){
+		//CC3 frozen output compare: only sets CC3IF when CNT goes through the middle, polled by the update ISR
+		instance->CCMR2 = 0;
+		instance->CCR3 = TIM_16BIT_HALF_RANGE;
+		g_TIM_UPDATE_CALLBACKS[tim] = 0;
+		SET_BIT(instance->DIER, TIM_DIER_UIE);
+		NVIC_EnableIRQ(g_TIM_UPDATE_IRQ_NUM[tim]);
+	}
+
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+
+	return 1;
+}
+
+/**
+ * @func TIM_EncoderGetPosition
+ * @brief Returns the 32-bit position in counts.
+ *
+ * # 16-bit timers: an overflow may happen between reading the extension and CNT, or be pending (UIF set) while
+ * 	 the update interrupt can't run (masked or called from a higher priority), so the read is repeated until
+ * 	 the extension and UIF are stable around the CNT read, and a pending UIF is accounted here.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return int32_t
+ */
+int32_t TIM_EncoderGetPosition(TIM_Peripheral_en tim){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	TIM_EncoderState_t* encoder = &g_TIM_ENCODERS[tim];
+
+	if(TIM_Is32Bit(tim)){
+		return (int32_t)instance->CNT;
+	}
+
+	int32_t high;
+	uint8_t upper_half;
+	uint32_t count;
+	uint32_t sr;
+
+	do{
+		high = encoder->high;
+		upper_half = encoder->upper_half;
+		sr = instance->SR;
+		count = instance->CNT;
+	}while((high != encoder->high) || (GET_BIT(sr, TIM_SR_UIF) != GET_BIT(instance->SR, TIM_SR_UIF)));
+
+	if(GET_BIT(sr, TIM_SR_UIF)){
+		high += TIM_EncoderWrapStep(upper_half, count, GET_BIT(sr, TIM_SR_CC3IF));
+	}
+	return high + (int32_t)count;
+}
+
+/**
+ * @func TIM_EncoderSetPosition
+ * @brief Overwrites the position (e.g. homing).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	int32_t position[IN]
+ * @return void
+ */
+void TIM_EncoderSetPosition(TIM_Peripheral_en tim, int32_t position){
+
+	TIM_t* instance = g_TIM_INSTANCES[tim];
+	TIM_EncoderState_t* encoder = &g_TIM_ENCODERS[tim];
+
+	uint32_t primask = LIB_EnterCritical();
+	if(TIM_Is32Bit(tim)){
+		instance->CNT = (uint32_t)position;
+	}else{
+		instance->CNT = (uint32_t)position & TIM_MAX_16BIT_VALUE;
+		instance->SR = ~(uint32_t)((1UL << TIM_SR_UIF) | (1UL << TIM_SR_CC3IF));
+		encoder->high = position - (int32_t)((uint32_t)position & TIM_MAX_16BIT_VALUE);
+		encoder->upper_half = (((uint32_t)position & TIM_MAX_16BIT_VALUE) >= TIM_16BIT_HALF_RANGE);
+	}
+	encoder->last_position = position;
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func TIM_EncoderVelocityTick
+ * @brief Timebase update callback: velocity = position change per sample x sample rate, then smoothed.
+ *
+ * @note STATIC FUNCTION
+ */
+static void TIM_EncoderVelocityTick(void){
+
+	for(uint8_t tim = 0; tim < TIM_INSTANCES_NUM; tim++){
+		TIM_EncoderState_t* encoder = &g_TIM_ENCODERS[tim];
+		if(!encoder->enabled){
+			continue;
+		}
+
+		int32_t position = TIM_EncoderGetPosition(tim);
+		int32_t sample = (position - encoder->last_position) * (int32_t)g_TIM_ENCODER_SAMPLE_HZ;
+		encoder->last_position = position;
+		encoder->velocity += (sample - encoder->velocity) >> TIM_ENCODER_VELOCITY_FILTER_SHIFT;
+	}
+}
+
+/**
+ * @func TIM_EncoderVelocityInit
+ * @brief Samples the position of every encoder at a fixed rate to estimate their velocities.
+ *
+ * @param	TIM_Peripheral_en timebase[IN]	-> free timer used as the sampling timebase (e.g. TIM6/TIM7)
+ * @param	uint32_t sample_hz[IN]			-> sampling frequency
+ * @return void
+ */
+void TIM_EncoderVelocityInit(TIM_Peripheral_en timebase, uint32_t sample_hz){
+
+	TIM_t* instance = g_TIM_INSTANCES[timebase];
+	uint32_t ticks = TIM_GetKernelClock(timebase) / sample_hz;
+	//smallest prescaler that makes the period fit 16 bits
+	uint32_t prescaler = (ticks >> 16) + 1;
+
+	g_TIM_ENCODER_SAMPLE_HZ = sample_hz;
+
+	TIM_EnableClock(timebase);
+
+	instance->CR1 = 0;
+	SET_BIT(instance->CR1, TIM_CR1_URS);
+	instance->PSC = prescaler - 1;
+	instance->ARR = (ticks / prescaler) - 1;
+	SET_BIT(instance->EGR, TIM_EGR_UG);
+	instance->SR = 0;
+
+	g_TIM_UPDATE_CALLBACKS[timebase] = TIM_EncoderVelocityTick;
+	SET_BIT(instance->DIER, TIM_DIER_UIE);
+	NVIC_EnableIRQ(g_TIM_UPDATE_IRQ_NUM[timebase]);
+
+	SET_BIT(instance->CR1, TIM_CR1_CEN);
+}
+
+/**
+ * @func TIM_EncoderGetVelocity
+ * @brief Returns the last velocity estimate in counts per second (smoothed, @TIM_ENCODER_VELOCITY_FILTER_SHIFT).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return int32_t
+ */
+int32_t TIM_EncoderGetVelocity(TIM_Peripheral_en tim){
+	return g_TIM_ENCODERS[tim].velocity;
+}
+
+/**
+ * @func TIM_GetIsrJitter
+ * @brief Copies the update ISR period statistics of a timer (TIM_ISR_JITTER_ENABLE), jitter = max - min period.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	LIB_Jitter_t* jitter[OUT]		-> periods in CPU cycles
+ * @return void
+ */
+void TIM_GetIsrJitter(TIM_Peripheral_en tim, LIB_Jitter_t* jitter){
+#if TIM_ISR_JITTER == TIM_ISR_JITTER_ENABLE
+	uint32_t primask = LIB_EnterCritical();
+	*jitter = g_TIM_ISR_JITTER[tim];
+	LIB_ExitCritical(primask);
+#else
+	(void)tim;
+	*jitter = (LIB_Jitter_t){0};
+#endif
+}
+
+
+/******************************* ISR *******************************/
+TIM_ISR_ATTRIBUTES void TIM1_BRK_TIM9_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM9);
+}
+
+TIM_ISR_ATTRIBUTES void TIM1_UP_TIM10_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM1);
+	TIM_IRQDispatch(TIM_TIM10);
+}
+
+TIM_ISR_ATTRIBUTES void TIM1_TRG_COM_TIM11_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM11);
+}
+
+TIM_ISR_ATTRIBUTES void TIM2_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM2);
+}
+
+TIM_ISR_ATTRIBUTES void TIM3_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM3);
+}
+
+TIM_ISR_ATTRIBUTES void TIM4_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM4);
+}
+
+TIM_ISR_ATTRIBUTES void TIM5_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM5);
+}
+
+TIM_ISR_ATTRIBUTES void TIM6_DAC_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM6);
+	if(g_TIM_DAC_IRQ_HOOK != 0){
+		g_TIM_DAC_IRQ_HOOK();
+	}
+}
+
+TIM_ISR_ATTRIBUTES void TIM7_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM7);
+}
+
+TIM_ISR_ATTRIBUTES void TIM8_BRK_TIM12_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM12);
+}
+
+TIM_ISR_ATTRIBUTES void TIM8_UP_TIM13_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM8);
+	TIM_IRQDispatch(TIM_TIM13);
+}
+
+TIM_ISR_ATTRIBUTES void TIM8_TRG_COM_TIM14_IRQHandler(void){
+	TIM_IRQDispatch(TIM_TIM14);
+}
@@ -0,0 +1,577 @@
+/**
+ * @file tim.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Timers' module header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Which TIM Instance ?
+ * 		[♥] -> We choose which timer instance to work with during whatever API we're working with by passing
+ * 				TIM_Peripheral_en of the dedicated instance.
+ * 			->TIM_Peripheral_en is used as an index of the g_TIM_INSTANCES that has the base addresses of
+ * 				All timer instances.
+ *
+ * # HOW to Configure ?
+ *		[♥] The timers' kernel clocks are configured @Configurations section in the header (tim.h) file,
+ *			they must match the RCC APB1/APB2 prescalers (x2 when the APB prescaler is not 1).
+ *
+ * # Basic (one-shot) timing ?
+ * 		[♥] Used as a timing engine for drivers that need to wait without blocking the CPU (e.g. the LCD async mode).
+ * 		1. Call TIM_BasicInit() once with the tick frequency and an update callback.
+ * 		2. Call TIM_BasicStartOneShot() with the number of ticks to wait, the counter stops by itself and
+ * 			the callback is invoked from the timer's ISR, it can re-arm the timer from there.
+ * 		[♥] TIM_BasicStartPeriodic() keeps the counter reloading instead (one update every period, no re-arm
+ * 			latency in it) until TIM_Stop().
+ *
+ * # Trigger output (TRGO) ?
+ * 		[♥] TIM_TriggerInit() makes a timer free-running at a sample rate with TRGO pulsed at each update event,
+ * 			used to pace other peripherals with no CPU (e.g. the DAC's TIM6/TIM7 triggers, @dac.h).
+ * 		[♥] TIM6 shares its NVIC line with the DAC underrun, the DAC driver registers its handler using
+ * 			TIM_SetDacIRQHook().
+ *
+ * # PWM ?
+ * 		[♥] Up-counting edge aligned PWM: period = (period + 1) counter ticks, duty = CCRx ticks.
+ * 		1. Configure the channel pins as alternate function (AF1: TIM1/TIM2, AF2: TIM3/TIM4/TIM5, AF3: TIM8 - TIM11,
+ * 			AF9: TIM12 - TIM14) using GPIO_SetPinAF().
+ * 		2. Make a {TIM_PwmConfig_t} variable and call TIM_PwmInit().
+ * 		3. Make a {TIM_PwmChannelConfig_t} variable for each channel and call TIM_PwmConfigureChannel().
+ * 		4. Call TIM_Start(), then TIM_PwmSetDuty() to change a duty (applied at the next period, preloaded).
+ * 		[♥] TIM1/TIM8 (advanced timers) also drive the complementary outputs CH1N - CH3N with dead-time insertion.
+ *
+ * # PWM waveform by DMA burst ?
+ * 		[♥] TIM_PwmStartDmaBurst() makes each update event (every period) load the next {channels_num} duties from a
+ * 			RAM/FLASH table into CCRx through DMAR, the DMA stream runs in circular mode so the waveform repeats
+ * 			forever with zero CPU per period.
+ * 		[♥] Available on the timers that have an update DMA request: TIM1, TIM2, TIM3, TIM4, TIM5, TIM8
+ * 			(it uses the stream listed @g_TIM_UP_DMA in tim.c, don't use that stream for something else).
+ *
+ * # Input capture ?
+ * 		[♥] TIM2/TIM5 (32-bit counters) capture TI1 (CH1 pin) edges, the DMA moves every capture into a caller RAM
+ * 			ring (circular), so hundreds of kHz are measured with no CPU per edge.
+ * 		[♥] TIM_CAPTURE_TIMESTAMPS	-> the ring receives the counter value at each captured edge.
+ * 		[♥] TIM_CAPTURE_PWM_INPUT	-> the counter is reset at each period start (slave reset mode), CH2 captures the
+ * 			opposite edge of the same pin, so the ring receives {period, pulse width} pairs (DMA burst of CCR1-CCR2).
+ * 		1. Configure the CH1 pin as alternate function (TIM2: AF1, TIM5: AF2).
+ * 		2. Make a {TIM_CaptureConfig_t} variable and call TIM_CaptureStart() with a static ring.
+ * 		3. Call TIM_CaptureGetStats() whenever the statistics are needed (it only reads the ring).
+ * 		[♥] Uses the CH1 DMA request: TIM2 -> DMA1 stream 5, TIM5 -> DMA1 stream 2.
+ *
+ * # Quadrature encoder ?
+ * 		[♥] TIM1/TIM2/TIM3/TIM4/TIM5/TIM8 count the TI1/TI2 (CH1/CH2 pins) quadrature edges in hardware, no ISR per edge.
+ * 		[♥] TIM2/TIM5 are 32-bit, TIM_EncoderGetPosition() is a single CNT load. The 16-bit timers are extended to
+ * 			32 bits by their update (overflow/underflow) interrupt, once every 65536 counts.
+ * 		[♥] The wrap direction comes from the CNT half (below/above 0x8000) at the previous update and now, and from
+ * 			CC3 (compare at 0x8000, no pin) telling whether CNT went through the middle in between: back and forth
+ * 			across the 0x0000/0xFFFF wrap is counted right even when several wraps are served by one interrupt.
+ * 			CH3 of a 16-bit encoder timer can't be used for something else.
+ * 		1. Configure the CH1/CH2 pins as alternate function (same AF as PWM).
+ * 		2. Make a {TIM_EncoderConfig_t} variable and call TIM_EncoderInit().
+ * 		3. Optionally call TIM_EncoderVelocityInit() once with a free timer (e.g. TIM6) as the sampling timebase,
+ * 			then read TIM_EncoderGetVelocity() (counts per second) at any time.
+ *
+ * # ISR timing ?
+ * 		[♥] With TIM_ISR_MEMORY = TIM_ISR_IN_RAM the timers' ISRs run from SRAM (LIB_RAMFUNC): no FLASH wait states nor
+ * 			ART misses, so the latency doesn't depend on what the interrupted code was fetching.
+ * 		[♥] With TIM_ISR_JITTER = TIM_ISR_JITTER_ENABLE each update ISR records its period with the cycle counter
+ * 			(LIB_CycleCounterEnable()), TIM_GetIsrJitter() returns min/max: compare both memories on a periodic timer.
+ * 			TIM_BasicInit() restarts the statistics of its timer.
+ * 		[♥] APP_IsrJitterBenchmark() (APP/ISR_JITTER_BENCHMARK.c) prints them for the built TIM_ISR_MEMORY.
+ *
+ * # Adding more Features ?
+ * 		[♥] New configurations options need to be added for each new configuration parameter in tim.h @macros
+ * 		[♥] Then, each of these new configuration parameters is applied through the related APIs.
+ */
+#ifndef TIM_TIM_H_
+#define TIM_TIM_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "bit_math.h"
+#include "memory_map.h"
+#include "rcc.h"
+#include "nvic.h"
+#include "dma.h"
+#include "common_lib.h"
+
+
+/*******************************  Macros *******************************/
+#define TIM_MAX_16BIT_VALUE		(0xFFFFUL)
+
+/**
+ * @defgroup TIM_PWM_Mode_Options
+ */
+#define TIM_PWM_MODE1			(0b110)		/*active while CNT < CCRx*/
+#define TIM_PWM_MODE2			(0b111)		/*inactive while CNT < CCRx*/
+
+/**
+ * @defgroup TIM_Polarity_Options
+ */
+#define TIM_POLARITY_ACTIVE_HIGH	(0)
+#define TIM_POLARITY_ACTIVE_LOW		(1)
+
+/**
+ * @defgroup TIM_Capture_Mode_Options
+ */
+#define TIM_CAPTURE_TIMESTAMPS		(0)
+#define TIM_CAPTURE_PWM_INPUT		(1)
+
+/**
+ * @defgroup TIM_Capture_Edge_Options
+ * @note TIM_CAPTURE_PWM_INPUT: the edge starting a period (rising or falling)
+ */
+#define TIM_CAPTURE_RISING			(0b00)
+#define TIM_CAPTURE_FALLING			(0b01)
+#define TIM_CAPTURE_BOTH_EDGES		(0b11)
+
+/**
+ * @defgroup TIM_Capture_Prescaler_Options (capture once every N edges, TIM_CAPTURE_TIMESTAMPS only)
+ */
+#define TIM_CAPTURE_PSC_DIV1		(0b00)
+#define TIM_CAPTURE_PSC_DIV2		(0b01)
+#define TIM_CAPTURE_PSC_DIV4		(0b10)
+#define TIM_CAPTURE_PSC_DIV8		(0b11)
+
+/**
+ * @defgroup TIM_Encoder_Mode_Options (SMCR.SMS)
+ */
+#define TIM_ENCODER_TI1				(0b001)		/*x2: counts on TI1 edges*/
+#define TIM_ENCODER_TI2				(0b010)		/*x2: counts on TI2 edges*/
+#define TIM_ENCODER_TI12			(0b011)		/*x4: counts on TI1 and TI2 edges*/
+
+/**
+ * @defgroup TIM_Encoder_Direction_Options
+ */
+#define TIM_ENCODER_DIRECTION_NORMAL	(0)
+#define TIM_ENCODER_DIRECTION_INVERTED	(1)
+
+/**
+ * @defgroup TIM_Complementary_Options (TIM1/TIM8 channels 1 - 3 only)
+ */
+#define TIM_COMPLEMENTARY_DISABLED	(0)
+#define TIM_COMPLEMENTARY_ENABLED	(1)
+
+/**
+ * @defgroup TIM_ISR_Memory_Options
+ */
+#define TIM_ISR_IN_FLASH			(0)
+#define TIM_ISR_IN_RAM				(1)		/*LIB_RAMFUNC*/
+
+/**
+ * @defgroup TIM_ISR_Jitter_Options
+ */
+#define TIM_ISR_JITTER_DISABLE		(0)
+#define TIM_ISR_JITTER_ENABLE		(1)
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Timers' kernel clock: TIMxCLK = PCLKx if the APBx prescaler is 1, otherwise 2 x PCLKx*/
+#define TIM_APB1_TIMER_CLOCK		(16000000UL)
+#define TIM_APB2_TIMER_CLOCK		(16000000UL)
+
+/*Velocity smoothing: v += (sample - v) >> TIM_ENCODER_VELOCITY_FILTER_SHIFT, 0: raw samples*/
+#define TIM_ENCODER_VELOCITY_FILTER_SHIFT	(2)
+
+/*Where the timers' ISRs execute from, choose out of @defgroup TIM_ISR_Memory_Options*/
+#define TIM_ISR_MEMORY				TIM_ISR_IN_RAM
+
+/*Update ISRs period measurement (TIM_GetIsrJitter()), choose out of @defgroup TIM_ISR_Jitter_Options*/
+#define TIM_ISR_JITTER				TIM_ISR_JITTER_ENABLE
+
+
+/******************************* Types *******************************/
+typedef enum{
+	TIM_TIM1 = 0,
+	TIM_TIM2,
+	TIM_TIM3,
+	TIM_TIM4,
+	TIM_TIM5,
+	TIM_TIM6,
+	TIM_TIM7,
+	TIM_TIM8,
+	TIM_TIM9,
+	TIM_TIM10,
+	TIM_TIM11,
+	TIM_TIM12,
+	TIM_TIM13,
+	TIM_TIM14,
+}TIM_Peripheral_en;
+
+typedef enum{
+	TIM_CHANNEL1 = 0,
+	TIM_CHANNEL2,
+	TIM_CHANNEL3,
+	TIM_CHANNEL4,
+}TIM_Channel_en;
+
+/**
+ * @brief Timer event callback, invoked from the timer's ISR.
+ */
+typedef void (*TIM_Callback_t)(void);
+
+/**
+ * @struct TIM_PwmConfig_t
+ * @brief Time base of a PWM timer.
+ */
+typedef struct{
+	uint32_t counter_hz;	/*counter tick frequency (prescaled kernel clock)*/
+	uint32_t period;		/*ARR, the PWM period is (period + 1) ticks - 16-bit except TIM2/TIM5*/
+	uint8_t dead_time;		/*TIM1/TIM8: BDTR.DTG raw value, inserted before each complementary edge*/
+}TIM_PwmConfig_t;
+
+/**
+ * @struct TIM_CaptureConfig_t
+ * @brief Input capture of TI1 (TIM2/TIM5).
+ */
+typedef struct{
+	uint32_t counter_hz;	/*timestamps' resolution (prescaled kernel clock)*/
+	uint8_t mode;			/*choose out of @defgroup TIM_Capture_Mode_Options*/
+	uint8_t edge;			/*choose out of @defgroup TIM_Capture_Edge_Options*/
+	uint8_t prescaler;		/*choose out of @defgroup TIM_Capture_Prescaler_Options*/
+	uint8_t filter;			/*ICxF digital filter [0 - 15], 0: no filter (RM0090 TIMx_CCMR1)*/
+}TIM_CaptureConfig_t;
+
+/**
+ * @struct TIM_CaptureStats_t
+ * @brief Statistics over the most recent captures (ticks of counter_hz).
+ */
+typedef struct{
+	uint16_t samples;		/*number of periods used*/
+	uint32_t period_min;
+	uint32_t period_max;
+	uint32_t period_avg;
+	uint32_t width_avg;		/*TIM_CAPTURE_PWM_INPUT only*/
+	uint16_t duty_permille;	/*TIM_CAPTURE_PWM_INPUT only, width_avg / period_avg in 0.1%*/
+}TIM_CaptureStats_t;
+
+/**
+ * @struct TIM_EncoderConfig_t
+ * @brief Quadrature encoder interface.
+ */
+typedef struct{
+	uint8_t mode;			/*choose out of @defgroup TIM_Encoder_Mode_Options*/
+	uint8_t filter;			/*ICxF digital filter of TI1/TI2 [0 - 15], 0: no filter (RM0090 TIMx_CCMR1)*/
+	uint8_t direction;		/*choose out of @defgroup TIM_Encoder_Direction_Options*/
+}TIM_EncoderConfig_t;
+
+/**
+ * @struct TIM_PwmChannelConfig_t
+ * @brief One PWM output channel.
+ */
+typedef struct{
+	TIM_Channel_en channel;
+	uint8_t mode;			/*choose out of @defgroup TIM_PWM_Mode_Options*/
+	uint8_t polarity;		/*choose out of @defgroup TIM_Polarity_Options*/
+	uint8_t complementary;	/*choose out of @defgroup TIM_Complementary_Options*/
+	uint8_t complementary_polarity;	/*choose out of @defgroup TIM_Polarity_Options*/
+	uint32_t duty;			/*initial CCRx value in ticks*/
+}TIM_PwmChannelConfig_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func TIM_EnableClock
+ * @brief Enables the bus clock of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_EnableClock(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_GetKernelClock
+ * @brief Returns the kernel clock (before the prescaler) of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return uint32_t	clock in Hz
+ */
+uint32_t TIM_GetKernelClock(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_BasicInit
+ * @brief Configures a timer as a one-shot up-counter with the provided tick frequency and update interrupt.
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> specifies which timer (TIM6/TIM7 are the intended basic timers)
+ * @param	uint32_t tick_hz[IN]				-> counter tick frequency, e.g. 1000000 for 1 us ticks
+ * @param	TIM_Callback_t update_callback[IN]	-> invoked from the ISR when the one-shot period elapses
+ *
+ * #Important Registers:
+ * 			=> TIM->CR1
+ * 				[♥] OPM[3]		One-pulse mode, counter stops at the next update event
+ * 				[♥] URS[2]		Only counter overflow generates an update interrupt (not UG)
+ * 			=> TIM->PSC		Prescaler, loaded at the next update event (forced using EGR.UG)
+ * 			=> TIM->DIER
+ * 				[♥] UIE[0]		Update interrupt enable
+ *
+ * @return void
+ */
+void TIM_BasicInit(TIM_Peripheral_en tim, uint32_t tick_hz, TIM_Callback_t update_callback);
+
+/**
+ * @func TIM_BasicStartOneShot
+ * @brief Starts a single period of the provided number of ticks, the update callback is invoked at its end.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @param	uint16_t ticks[IN]			-> period in ticks [2 - 65535], smaller values wait 2 ticks
+ * @return void
+ */
+void TIM_BasicStartOneShot(TIM_Peripheral_en tim, uint16_t ticks);
+
+/**
+ * @func TIM_BasicStartPeriodic
+ * @brief Starts a free-running period of the provided number of ticks, the update callback is invoked at the end
+ * 		  of every period until TIM_Stop().
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer (initialized by TIM_BasicInit())
+ * @param	uint16_t ticks[IN]			-> period in ticks [2 - 65535], smaller values are 2 ticks
+ * @return void
+ */
+void TIM_BasicStartPeriodic(TIM_Peripheral_en tim, uint16_t ticks);
+
+/**
+ * @func TIM_TriggerInit
+ * @brief Configures a free-running up-counter whose update event drives TRGO at the provided rate (no interrupt).
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> TIM1 - TIM8 (TIM6/TIM7 are the intended ones)
+ * @param	uint32_t rate_hz[IN]		-> update (TRGO) frequency
+ *
+ * #Important Registers:
+ * 			=> TIM->CR2
+ * 				[♥] MMS[4-6] = 010		Update event as TRGO
+ * 			=> TIM->PSC, TIM->ARR		rate = kernel clock / ((PSC + 1) x (ARR + 1))
+ *
+ * @return uint32_t		actual rate (the counter is started)
+ */
+uint32_t TIM_TriggerInit(TIM_Peripheral_en tim, uint32_t rate_hz);
+
+/**
+ * @func TIM_SetDacIRQHook
+ * @brief Registers the handler invoked from TIM6_DAC_IRQHandler for the DAC underrun events.
+ *
+ * @param	TIM_Callback_t hook[IN]		-> 0: none
+ * @return void
+ */
+void TIM_SetDacIRQHook(TIM_Callback_t hook);
+
+/**
+ * @func TIM_Stop
+ * @brief Stops the counter of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_Stop(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_Start
+ * @brief Starts the counter of the provided timer.
+ *
+ * @param	TIM_Peripheral_en tim[IN]	-> specifies which timer
+ * @return void
+ */
+void TIM_Start(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_PwmInit
+ * @brief Configures a timer as an up-counting PWM time base (auto-reload preloaded), the counter isn't started.
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> specifies which timer (TIM1 - TIM5, TIM8 - TIM14)
+ * @param	const TIM_PwmConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->CR1
+ * 				[♥] ARPE[7]		ARR is buffered, a new period applies at the next update event
+ * 			=> TIM->PSC, TIM->ARR
+ * 			=> TIM->BDTR (TIM1/TIM8)
+ * 				[♥] MOE[15]		Main output enable, advanced timers' outputs are off without it
+ * 				[♥] DTG[0-7]	Dead-time generator
+ *
+ * @return void
+ */
+void TIM_PwmInit(TIM_Peripheral_en tim, const TIM_PwmConfig_t* config);
+
+/**
+ * @func TIM_PwmConfigureChannel
+ * @brief Configures a channel as PWM output (and its complementary output on TIM1/TIM8).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	const TIM_PwmChannelConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->CCMRx
+ * 				[♥] OCxM		PWM mode 1/2
+ * 				[♥] OCxPE		CCRx is buffered, a new duty applies at the next update event (no glitches)
+ * 			=> TIM->CCER
+ * 				[♥] CCxE/CCxP	Output enable/polarity
+ * 				[♥] CCxNE/CCxNP	Complementary output enable/polarity
+ *
+ * @return void
+ */
+void TIM_PwmConfigureChannel(TIM_Peripheral_en tim, const TIM_PwmChannelConfig_t* config);
+
+/**
+ * @func TIM_PwmSetDuty
+ * @brief Changes the duty of a channel (applied at the next period).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	TIM_Channel_en channel[IN]
+ * @param	uint32_t duty[IN]		-> CCRx in ticks, [0 - period + 1] (period + 1 is 100%)
+ * @return void
+ */
+void TIM_PwmSetDuty(TIM_Peripheral_en tim, TIM_Channel_en channel, uint32_t duty);
+
+/**
+ * @func TIM_PwmStartDmaBurst
+ * @brief Starts reloading consecutive CCRx from a waveform table at each update event using DMA burst (circular).
+ *
+ * @param	TIM_Peripheral_en tim[IN]			-> TIM1, TIM2, TIM3, TIM4, TIM5 or TIM8
+ * @param	TIM_Channel_en first_channel[IN]	-> first CCRx reloaded
+ * @param	uint8_t channels_num[IN]			-> number of consecutive CCRx reloaded each period [1 - 4]
+ * @param	const uint32_t* table[IN]			-> duties, {channels_num} per period, must stay valid while running
+ * @param	uint16_t table_len[IN]				-> number of words in table, a multiple of channels_num
+ *
+ * #Important Registers:
+ * 			=> TIM->DCR
+ * 				[♥] DBA[0-4]	First register of the burst (CCR1 + first_channel) as a word offset
+ * 				[♥] DBL[8-12]	Burst length - 1
+ * 			=> TIM->DIER
+ * 				[♥] UDE[8]		Update DMA request
+ *
+ * @return uint8_t		1: started, 0: the timer has no update DMA request or its stream is used by another request
+ */
+uint8_t TIM_PwmStartDmaBurst(TIM_Peripheral_en tim, TIM_Channel_en first_channel, uint8_t channels_num,
+							 const uint32_t* table, uint16_t table_len);
+
+/**
+ * @func TIM_PwmStopDmaBurst
+ * @brief Stops the DMA burst reloads, the last loaded duties are kept.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return void
+ */
+void TIM_PwmStopDmaBurst(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_CaptureStart
+ * @brief Starts capturing TI1 edges of TIM2/TIM5 into a RAM ring using DMA (circular).
+ *
+ * @param	TIM_Peripheral_en tim[IN]				-> TIM2 or TIM5
+ * @param	const TIM_CaptureConfig_t* config[IN]
+ * @param	uint32_t* ring[IN]						-> static buffer written by the DMA
+ * @param	uint16_t ring_len[IN]					-> words in ring (even in TIM_CAPTURE_PWM_INPUT), at least 4
+ *
+ * #Important Registers:
+ * 			=> TIM->CCMR1
+ * 				[♥] CC1S/CC2S	01: ICx mapped on TIx, 10: IC2 mapped on TI1 (PWM input)
+ * 				[♥] IC1PSC		Capture once every 1/2/4/8 edges
+ * 				[♥] IC1F		Digital filter
+ * 			=> TIM->CCER
+ * 				[♥] CC1P/CC1NP	Edge(s) captured
+ * 			=> TIM->SMCR
+ * 				[♥] TS = 101 (TI1FP1), SMS = 100 (reset mode)	PWM input: counter reset at each period start
+ * 			=> TIM->DIER
+ * 				[♥] CC1DE		DMA request at each CH1 capture
+ *
+ * @return uint8_t		1: started, 0: not TIM2/TIM5, invalid ring or its stream is used by another request
+ */
+uint8_t TIM_CaptureStart(TIM_Peripheral_en tim, const TIM_CaptureConfig_t* config, uint32_t* ring, uint16_t ring_len);
+
+/**
+ * @func TIM_CaptureStop
+ * @brief Stops the capture and its DMA stream.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return void
+ */
+void TIM_CaptureStop(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_CaptureGetStats
+ * @brief Computes period (and pulse width) statistics over the most recent captures in the ring.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	uint16_t samples_num[IN]			-> number of most recent periods wanted (less are used if not captured yet)
+ * @param	TIM_CaptureStats_t* stats[OUT]
+ * @return uint8_t		1: at least one period available, 0: nothing captured yet
+ */
+uint8_t TIM_CaptureGetStats(TIM_Peripheral_en tim, uint16_t samples_num, TIM_CaptureStats_t* stats);
+/**
+ * @func TIM_EncoderInit
+ * @brief Puts the timer in encoder interface mode and starts counting from position 0.
+ *
+ * @param	TIM_Peripheral_en tim[IN]				-> TIM1, TIM2, TIM3, TIM4, TIM5 or TIM8
+ * @param	const TIM_EncoderConfig_t* config[IN]
+ *
+ * #Important Registers:
+ * 			=> TIM->SMCR
+ * 				[♥] SMS		001/010/011 Encoder mode 1/2/3
+ * 			=> TIM->CCMR1
+ * 				[♥] CC1S/CC2S = 01	IC1 on TI1, IC2 on TI2
+ * 				[♥] IC1F/IC2F		Digital filters
+ * 			=> TIM->CCER
+ * 				[♥] CC1P			Inverts TI1, i.e. the counting direction
+ * 			=> TIM->DIER
+ * 				[♥] UIE				Overflow/underflow interrupt (16-bit timers only)
+ * 			=> TIM->CCR3
+ * 				[♥] Half-range marker of the 16-bit timers (CC3IF, frozen output compare)
+ *
+ * @return uint8_t		1: started, 0: the timer has no encoder interface
+ */
+uint8_t TIM_EncoderInit(TIM_Peripheral_en tim, const TIM_EncoderConfig_t* config);
+
+/**
+ * @func TIM_EncoderGetPosition
+ * @brief Returns the 32-bit position in counts.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return int32_t
+ */
+int32_t TIM_EncoderGetPosition(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_EncoderSetPosition
+ * @brief Overwrites the position (e.g. homing).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	int32_t position[IN]
+ * @return void
+ */
+void TIM_EncoderSetPosition(TIM_Peripheral_en tim, int32_t position);
+
+/**
+ * @func TIM_EncoderVelocityInit
+ * @brief Samples the position of every encoder at a fixed rate to estimate their velocities.
+ *
+ * @param	TIM_Peripheral_en timebase[IN]	-> free timer used as the sampling timebase (e.g. TIM6/TIM7)
+ * @param	uint32_t sample_hz[IN]			-> sampling frequency
+ * @return void
+ */
+void TIM_EncoderVelocityInit(TIM_Peripheral_en timebase, uint32_t sample_hz);
+
+/**
+ * @func TIM_EncoderGetVelocity
+ * @brief Returns the last velocity estimate in counts per second (smoothed, @TIM_ENCODER_VELOCITY_FILTER_SHIFT).
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @return int32_t
+ */
+int32_t TIM_EncoderGetVelocity(TIM_Peripheral_en tim);
+
+/**
+ * @func TIM_GetIsrJitter
+ * @brief Copies the update ISR period statistics of a timer (TIM_ISR_JITTER_ENABLE), jitter = max - min period.
+ *
+ * @param	TIM_Peripheral_en tim[IN]
+ * @param	LIB_Jitter_t* jitter[OUT]		-> periods in CPU cycles
+ * @return void
+ */
+void TIM_GetIsrJitter(TIM_Peripheral_en tim, LIB_Jitter_t* jitter);
+
+#endif /* TIM_TIM_H_ */
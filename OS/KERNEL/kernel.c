@@ -0,0 +1,1109 @@
+/**
+ * @file kernel.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Preemptive fixed-priority kernel source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Unlike the run-to-completion scheduler (sched.h), a thread can block in the middle of its work (waiting for
+ * 			a DMA completion, a mutex, a delay) and a higher priority thread preempts a running one at once, so a long
+ * 			DSP job in a low priority thread doesn't delay the latency-critical I/O threads.
+ *
+ * # Threads ?
+ * 		[♥] Fixed priorities [0 (highest) - KERNEL_IDLE_PRIORITY - 1], the highest priority ready thread always runs,
+ * 			threads of the same priority share the CPU round robin at each tick (or KERNEL_Yield()).
+ * 		[♥] Each thread has its own stack (a static uint32_t array owned by the caller), filled with a pattern at
+ * 			creation so its high water mark can be measured (KERNEL_GetThreadStats()).
+ * 		[♥] Stacks are best placed in CCM RAM (LIB_CCM_BSS) unless the thread gives local buffers to the DMA.
+ * 		[♥] A thread returning from its entry function is terminated.
+ *
+ * # Context switch ?
+ * 		[♥] The switch runs in PendSV (lowest priority): it is only taken once no other ISR is running, SysTick
+ * 			(the tick) and the kernel calls just pend it.
+ * 		[♥] Lazy FPU stacking: the FPU registers (S16 - S31 by PendSV, S0 - S15 + FPSCR by the hardware) are only
+ * 			saved for a thread that used the FPU since its last switch (EXC_RETURN bit 4), others switch as fast as
+ * 			without FPU.
+ * 		[♥] The latency from the switch request (tick, KERNEL_SemGive() ...) to the new thread selection in PendSV is
+ * 			measured with the DWT cycle counter (KERNEL_GetStats(), KERNEL_ReportStats()).
+ *
+ * # Synchronization ?
+ * 		[♥] Semaphores: KERNEL_SemGive() can be called from ISRs, and KERNEL_SemGiveCallback() matches the drivers'
+ * 			completion callbacks (DMA_Callback_t, LIB_DmaMemCallback_t ...) with the semaphore as context.
+ * 		[♥] Mutexes with priority inheritance: the owner runs at the priority of its highest priority waiter until it
+ * 			unlocks, so a medium priority thread can't hold a high priority one waiting for a low priority one.
+ *
+ * # Interrupt priorities ?
+ * 		[♥] The kernel masks the interrupts with a priority number >= KERNEL_MAX_SYSCALL_PRIORITY (BASEPRI) in its
+ * 			critical sections, ISRs calling KERNEL_SemGive() must have such a priority (NVIC_SetPriority()), the more
+ * 			urgent ones are never masked but must not call the kernel.
+ * 		[♥] The kernel owns SysTick, PendSV and SVCall: don't use LIB_SysTickDelay_us()/ms() once it runs.
+ *
+ * # Low-power idle ?
+ * 		[♥] The idle thread always sleeps (WFI), with KERNEL_IDLE_MODE:
+ * 				KERNEL_IDLE_WFI				-> Sleep mode, woken up by every tick.
+ * 				KERNEL_IDLE_TICKLESS_SLEEP	-> SysTick is reprogrammed to expire at the next thread timeout/sleep
+ * 												deadline (up to ~1 s), the skipped ticks are added at wakeup.
+ * 				KERNEL_IDLE_TICKLESS_STOP	-> Stop mode until the next deadline (up to PWR_WAKEUP_MAX_MS), woken by the
+ * 												RTC wakeup timer (PWR_Init() is called by KERNEL_Init()), the clocks
+ * 												are restored before any thread runs. Only EXTI lines wake the CPU
+ * 												up: interrupts of peripherals without one are delayed until then.
+ * 		[♥] Tickless idle is only used if the next deadline is at least KERNEL_TICKLESS_MIN_TICKS away, and an
+ * 			interrupt waking the CPU earlier is handled as usual (the elapsed ticks are added first).
+ * 		[♥] The time spent in each power state (run, sleep, stop) is reported by KERNEL_GetStats()/KERNEL_ReportStats().
+ *
+ * # Usage Work Flow ?
+ * 		1. KERNEL_Init().
+ * 		2. KERNEL_ThreadCreate() for each thread, KERNEL_SemInit()/KERNEL_MutexInit() for the sync objects.
+ * 		3. KERNEL_Start() (never returns), blocking calls are only allowed from threads.
+ */
+
+/******************************* Includes *******************************/
+#include "kernel.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+/*Cortex-M4 port (context switch, barriers), the host build (Test/host) keeps the scheduling logic only*/
+#if defined(__arm__)
+#define KERNEL_ARM_PORT				1
+#else
+#define KERNEL_ARM_PORT				0
+#endif
+
+#define KERNEL_STATE_READY			(0)		/*ready or running*/
+#define KERNEL_STATE_BLOCKED		(1)
+#define KERNEL_STATE_DEAD			(2)
+
+#define KERNEL_WAIT_NONE			(0)		/*sleep*/
+#define KERNEL_WAIT_SEM				(1)
+#define KERNEL_WAIT_MUTEX			(2)
+
+#define KERNEL_STACK_FILL			(0xA5A5A5A5UL)
+
+/*Initial context: xPSR with the Thumb bit, EXC_RETURN to thread mode on PSP without FPU frame*/
+#define KERNEL_INITIAL_XPSR			(0x01000000UL)
+#define KERNEL_EXC_RETURN_THREAD	(0xFFFFFFFDUL)
+
+/*BASEPRI value of the kernel critical sections (PendSV_Handler, written as an assembler expression)*/
+#define KERNEL_BASEPRI				(KERNEL_MAX_SYSCALL_PRIORITY << (8 - NVIC_PRIO_BITS))
+#define KERNEL_STRINGIFY(x)			#x
+#define KERNEL_TO_STRING(x)			KERNEL_STRINGIFY(x)
+
+#define KERNEL_IDLE_STACK_WORDS		(KERNEL_MIN_STACK_WORDS)
+
+#define KERNEL_CYCLES_PER_TICK		(KERNEL_CPU_HZ / KERNEL_TICK_HZ)
+
+/*Longest tickless idle: SysTick 24-bit counter (Sleep), RTC wakeup timer (Stop)*/
+#define KERNEL_TICKLESS_SLEEP_MAX	(0xFFFFFFUL / KERNEL_CYCLES_PER_TICK)
+#define KERNEL_TICKLESS_STOP_MAX	((PWR_WAKEUP_MAX_MS * KERNEL_TICK_HZ) / 1000UL)
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+/*FLASH vector table (startup_stm32f407vgtx.s), its first word is the initial MSP*/
+extern uint32_t g_pfnVectors[];
+
+/*Scanned at each tick and switch (CCM RAM)*/
+static KERNEL_Thread_t* g_KERNEL_THREADS[KERNEL_MAX_THREADS + 1] LIB_CCM_BSS;
+static uint8_t g_KERNEL_THREADS_NUM = 0;
+
+/*Used by the PendSV/SVC assembly*/
+static KERNEL_Thread_t* volatile g_KERNEL_CURRENT __attribute__((used)) = 0;
+
+static volatile uint32_t g_KERNEL_TICKS = 0;
+static uint8_t g_KERNEL_RUNNING = 0;
+
+/*Rotate among the same priority at the next switch (tick, yield)*/
+static uint8_t g_KERNEL_ROTATE = 0;
+
+/*Pending switch request timestamp (DWT) for the latency*/
+static uint8_t g_KERNEL_SWITCH_PENDING = 0;
+static uint32_t g_KERNEL_PEND_CYCLES = 0;
+static uint32_t g_KERNEL_RUN_START = 0;
+
+static KERNEL_Stats_t g_KERNEL_STATS;
+
+static KERNEL_Thread_t g_KERNEL_IDLE_THREAD;
+static uint32_t g_KERNEL_IDLE_STACK[KERNEL_IDLE_STACK_WORDS] LIB_CCM_BSS;
+
+static void KERNEL_SwitchContext(void) __attribute__((used));
+
+
+/******************************* Functions Implementation *******************************/
+
+/**
+ * @func KERNEL_Lock
+ * @brief Masks the interrupts that may call the kernel (BASEPRI).
+ *
+ * @note STATIC FUNCTION
+ */
+static inline uint32_t KERNEL_Lock(void){
+	return NVIC_EnterCritical(KERNEL_MAX_SYSCALL_PRIORITY);
+}
+
+/**
+ * @func KERNEL_Unlock
+ * @brief Restores the mask, a switch requested meanwhile (PendSV) is taken right after.
+ *
+ * @note STATIC FUNCTION
+ */
+static inline void KERNEL_Unlock(uint32_t basepri){
+	NVIC_ExitCritical(basepri);
+}
+
+/**
+ * @func KERNEL_RequestSwitch
+ * @brief Pends PendSV and timestamps the first request for the latency statistics.
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static void KERNEL_RequestSwitch(void){
+
+	if(!g_KERNEL_RUNNING){
+		return;
+	}
+	if(!g_KERNEL_SWITCH_PENDING){
+		g_KERNEL_SWITCH_PENDING = 1;
+		g_KERNEL_PEND_CYCLES = LIB_CycleCounterRead();
+	}
+	NVIC_SetPending(NVIC_IRQ_PENDSV);
+}
+
+/**
+ * @func KERNEL_PickNext
+ * @brief Returns the highest priority ready thread, the current one keeps the CPU among equals unless rotating.
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static KERNEL_Thread_t* KERNEL_PickNext(void){
+
+	KERNEL_Thread_t* current = g_KERNEL_CURRENT;
+	KERNEL_Thread_t* best = 0;
+	uint8_t start = 0;
+
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		if(g_KERNEL_THREADS[i] == current){
+			start = i;
+		}
+	}
+	if(current && (current->state == KERNEL_STATE_READY) && !g_KERNEL_ROTATE){
+		best = current;
+	}
+
+	//scan from the thread after the current one, the current one last: equal priorities rotate
+	for(uint8_t i = 1; i <= g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* thread = g_KERNEL_THREADS[(start + i) % g_KERNEL_THREADS_NUM];
+
+		if((thread->state == KERNEL_STATE_READY) && (!best || (thread->priority < best->priority))){
+			best = thread;
+		}
+	}
+	g_KERNEL_ROTATE = 0;
+
+	return best;
+}
+
+/**
+ * @func KERNEL_SwitchContext
+ * @brief Selects the next thread and updates the statistics.
+ *
+ * @note STATIC FUNCTION, called by PendSV_Handler with the kernel locked
+ */
+static void KERNEL_SwitchContext(void){
+
+	uint32_t now = LIB_CycleCounterRead();
+	KERNEL_Thread_t* previous = g_KERNEL_CURRENT;
+	KERNEL_Thread_t* next = KERNEL_PickNext();
+
+	previous->run_cycles += now - g_KERNEL_RUN_START;
+	g_KERNEL_RUN_START = now;
+
+	if(g_KERNEL_SWITCH_PENDING){
+		uint32_t latency = now - g_KERNEL_PEND_CYCLES;
+
+		g_KERNEL_SWITCH_PENDING = 0;
+		g_KERNEL_STATS.last_latency_cycles = latency;
+		g_KERNEL_STATS.total_latency_cycles += latency;
+		g_KERNEL_STATS.latency_samples++;
+		if(latency > g_KERNEL_STATS.max_latency_cycles){
+			g_KERNEL_STATS.max_latency_cycles = latency;
+		}
+	}
+
+	if(next != previous){
+		g_KERNEL_STATS.context_switches++;
+		next->switches++;
+	}
+	g_KERNEL_CURRENT = next;
+}
+
+/**
+ * @func KERNEL_UpdatePriority
+ * @brief Effective priority = the best of its own and of the threads waiting for a mutex it owns.
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static void KERNEL_UpdatePriority(KERNEL_Thread_t* thread){
+
+	uint8_t priority = thread->base_priority;
+
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* waiter = g_KERNEL_THREADS[i];
+
+		if((waiter->state == KERNEL_STATE_BLOCKED) && (waiter->wait_kind == KERNEL_WAIT_MUTEX) &&
+		   (((KERNEL_Mutex_t*)waiter->wait_object)->owner == thread) && (waiter->priority < priority)){
+			priority = waiter->priority;
+		}
+	}
+	thread->priority = priority;
+}
+
+/**
+ * @func KERNEL_HighestWaiter
+ * @brief Returns the highest priority thread blocked on an object, 0 if none.
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static KERNEL_Thread_t* KERNEL_HighestWaiter(uint8_t kind, const void* object){
+
+	KERNEL_Thread_t* best = 0;
+
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* thread = g_KERNEL_THREADS[i];
+
+		if((thread->state == KERNEL_STATE_BLOCKED) && (thread->wait_kind == kind) && (thread->wait_object == object) &&
+		   (!best || (thread->priority < best->priority))){
+			best = thread;
+		}
+	}
+
+	return best;
+}
+
+/**
+ * @func KERNEL_Block
+ * @brief Blocks the current thread, the switch happens at KERNEL_Unlock().
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static void KERNEL_Block(uint8_t kind, void* object, uint32_t timeout){
+
+	KERNEL_Thread_t* current = g_KERNEL_CURRENT;
+
+	current->state = KERNEL_STATE_BLOCKED;
+	current->wait_kind = kind;
+	current->wait_object = object;
+	current->wait_result = 0;
+	current->timed = (timeout != KERNEL_WAIT_FOREVER);
+	current->wake_tick = g_KERNEL_TICKS + timeout;
+
+	KERNEL_RequestSwitch();
+}
+
+/**
+ * @func KERNEL_Wake
+ * @brief Makes a blocked thread ready, requests a switch if it is more urgent than the current one.
+ *
+ * @note STATIC FUNCTION, kernel locked
+ */
+static void KERNEL_Wake(KERNEL_Thread_t* thread, uint8_t result){
+
+	thread->state = KERNEL_STATE_READY;
+	thread->wait_kind = KERNEL_WAIT_NONE;
+	thread->wait_object = 0;
+	thread->timed = 0;
+	thread->wait_result = result;
+
+	if(thread->priority < g_KERNEL_CURRENT->priority){
+		KERNEL_RequestSwitch();
+	}
+}
+
+/**
+ * @func KERNEL_ThreadExit
+ * @brief Return address of the threads entry functions: terminates the thread.
+ *
+ * @note STATIC FUNCTION
+ */
+static void KERNEL_ThreadExit(void){
+
+	KERNEL_Lock();
+	g_KERNEL_CURRENT->state = KERNEL_STATE_DEAD;
+	KERNEL_RequestSwitch();
+	KERNEL_Unlock(0);
+
+	while(1);
+}
+
+/**
+ * @func KERNEL_IdleTicks
+ * @brief Returns the ticks until the nearest timeout/sleep deadline, 0 if a thread is ready.
+ *
+ * @note STATIC FUNCTION, interrupts masked
+ */
+static uint32_t KERNEL_IdleTicks(void){
+
+	uint32_t idle_ticks = KERNEL_WAIT_FOREVER;
+
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* thread = g_KERNEL_THREADS[i];
+
+		if((thread != &g_KERNEL_IDLE_THREAD) && (thread->state == KERNEL_STATE_READY)){
+			return 0;
+		}
+		if((thread->state == KERNEL_STATE_BLOCKED) && thread->timed){
+			int32_t left = (int32_t)(thread->wake_tick - g_KERNEL_TICKS);
+
+			if(left <= 0){
+				return 0;
+			}
+			if((uint32_t)left < idle_ticks){
+				idle_ticks = (uint32_t)left;
+			}
+		}
+	}
+
+	return idle_ticks;
+}
+
+/**
+ * @func KERNEL_IdleWfi
+ * @brief Sleeps until the next interrupt (a tick at the latest), the sleep time is measured with SysTick.
+ *
+ * @note STATIC FUNCTION, interrupts masked
+ */
+static void KERNEL_IdleWfi(void){
+
+	uint32_t before;
+	uint32_t after;
+
+	(void)SysTick->CSR;		/*clears COUNTFLAG*/
+	before = SysTick->CVR;
+
+	PWR_EnterSleep();
+
+	after = SysTick->CVR;
+	if(GET_BIT(SysTick->CSR, SysTick_CSR_COUNTFLAG)){
+		g_KERNEL_STATS.sleep_cycles += before + (KERNEL_CYCLES_PER_TICK - after);
+	}else{
+		g_KERNEL_STATS.sleep_cycles += before - after;
+	}
+	g_KERNEL_STATS.sleep_entries++;
+}
+
+#if (KERNEL_IDLE_MODE != KERNEL_IDLE_WFI)
+/**
+ * @func KERNEL_TickRestart
+ * @brief Restarts SysTick with the first tick period shortened to the provided cycles, the next ones are normal.
+ *
+ * @note STATIC FUNCTION, interrupts masked
+ */
+static void KERNEL_TickRestart(uint32_t first_cycles){
+
+	if(first_cycles < 2){
+		first_cycles = 2;
+	}
+
+	//the counter loads RVR from 0 at the first clock, the new RVR is only used at the next wrap
+	SysTick->RVR = first_cycles - 1;
+	SysTick->CVR = 0;
+	SET_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+	SysTick->RVR = KERNEL_CYCLES_PER_TICK - 1;
+}
+#endif
+
+#if (KERNEL_IDLE_MODE == KERNEL_IDLE_TICKLESS_SLEEP)
+/**
+ * @func KERNEL_IdleTickless
+ * @brief Sleep mode with one SysTick period covering all the idle ticks, then adds the ticks that elapsed.
+ *
+ * @note STATIC FUNCTION, interrupts masked
+ */
+static void KERNEL_IdleTickless(uint32_t idle_ticks){
+
+	uint32_t remaining;
+	uint32_t reload;
+	uint32_t elapsed;
+	uint32_t ticks;
+
+	if(idle_ticks > KERNEL_TICKLESS_SLEEP_MAX){
+		idle_ticks = KERNEL_TICKLESS_SLEEP_MAX;
+	}
+
+	CLEAR_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+	remaining = SysTick->CVR;
+	if(GET_BIT(SysTick->CSR, SysTick_CSR_COUNTFLAG) || (remaining == 0)){
+		//a tick is being pended, handle it first
+		SET_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+		return;
+	}
+
+	//the rest of the current tick and the whole next ones up to the deadline
+	reload = remaining + ((idle_ticks - 1) * KERNEL_CYCLES_PER_TICK);
+	SysTick->RVR = reload - 1;
+	SysTick->CVR = 0;
+	SET_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+
+	PWR_EnterSleep();
+
+	CLEAR_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+	if(GET_BIT(SysTick->CSR, SysTick_CSR_COUNTFLAG)){
+		//deadline reached, the pending SysTick interrupt counts the last tick
+		elapsed = reload;
+		ticks = idle_ticks - 1;
+		KERNEL_TickRestart(KERNEL_CYCLES_PER_TICK - ((reload - 1) - SysTick->CVR));
+	}else{
+		//woken up earlier by another interrupt
+		elapsed = reload - SysTick->CVR;
+		if(elapsed < remaining){
+			ticks = 0;
+			KERNEL_TickRestart(remaining - elapsed);
+		}else{
+			ticks = 1 + ((elapsed - remaining) / KERNEL_CYCLES_PER_TICK);
+			KERNEL_TickRestart(KERNEL_CYCLES_PER_TICK - ((elapsed - remaining) % KERNEL_CYCLES_PER_TICK));
+		}
+	}
+
+	//no deadline is in the skipped ticks
+	g_KERNEL_TICKS += ticks;
+	g_KERNEL_STATS.sleep_cycles += elapsed;
+	g_KERNEL_STATS.sleep_entries++;
+}
+#elif (KERNEL_IDLE_MODE == KERNEL_IDLE_TICKLESS_STOP)
+/**
+ * @func KERNEL_IdleTickless
+ * @brief Stop mode until the RTC wakeup timer expires at the deadline, then adds the ticks that elapsed.
+ *
+ * @note STATIC FUNCTION, interrupts masked
+ */
+static void KERNEL_IdleTickless(uint32_t idle_ticks){
+
+	uint32_t elapsed_ms;
+	uint32_t ticks;
+
+	if(idle_ticks > KERNEL_TICKLESS_STOP_MAX){
+		idle_ticks = KERNEL_TICKLESS_STOP_MAX;
+	}
+
+	//SysTick is stopped in Stop mode anyway
+	CLEAR_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+	if(GET_BIT(SysTick->CSR, SysTick_CSR_COUNTFLAG)){
+		SET_BIT(SysTick->CSR, SysTick_CSR_ENABLE);
+		return;
+	}
+
+	PWR_WakeupTimerStart((idle_ticks * 1000UL) / KERNEL_TICK_HZ);
+	PWR_EnterStop(KERNEL_STOP_REGULATOR);
+	elapsed_ms = PWR_WakeupTimerStop();
+
+	ticks = (elapsed_ms * KERNEL_TICK_HZ) / 1000UL;
+	if(ticks >= idle_ticks){
+		//deadline reached, SysTick_Handler counts the last tick and wakes the threads up
+		ticks = idle_ticks - 1;
+		NVIC_SetPending(NVIC_IRQ_SYSTICK);
+	}
+	KERNEL_TickRestart(KERNEL_CYCLES_PER_TICK);
+
+	g_KERNEL_TICKS += ticks;
+	g_KERNEL_STATS.stop_cycles += (uint64_t)elapsed_ms * (KERNEL_CPU_HZ / 1000UL);
+	g_KERNEL_STATS.stop_entries++;
+}
+#endif
+
+/**
+ * @func KERNEL_IdleThread
+ * @brief Runs when no thread is ready, sleeps until the next interrupt or deadline (KERNEL_IDLE_MODE).
+ *
+ * @note STATIC FUNCTION
+ */
+static void KERNEL_IdleThread(void* arg){
+
+	uint32_t idle_ticks;
+
+	(void)arg;
+
+	while(1){
+		//PRIMASK: the waking interrupt is pending but only taken once the time base is up to date
+#if KERNEL_ARM_PORT == 1
+		__asm volatile ("cpsid i" ::: "memory");
+#endif
+
+		idle_ticks = KERNEL_IdleTicks();
+		if(idle_ticks){
+#if (KERNEL_IDLE_MODE != KERNEL_IDLE_WFI)
+			if(idle_ticks >= KERNEL_TICKLESS_MIN_TICKS){
+				KERNEL_IdleTickless(idle_ticks);
+			}else
+#endif
+			{
+				KERNEL_IdleWfi();
+			}
+		}
+
+#if KERNEL_ARM_PORT == 1
+		__asm volatile ("cpsie i" ::: "memory");
+#endif
+	}
+}
+
+/**
+ * @func KERNEL_ThreadSetup
+ * @brief Fills the stack, builds the initial context and registers the thread.
+ *
+ * @note STATIC FUNCTION
+ */
+static uint8_t KERNEL_ThreadSetup(KERNEL_Thread_t* thread, const char* name, KERNEL_Entry_t entry, void* arg,
+		uint8_t priority, uint32_t* stack, uint32_t stack_words){
+
+	uint32_t* sp;
+	uint32_t basepri;
+
+	if((g_KERNEL_THREADS_NUM > KERNEL_MAX_THREADS) || (stack_words < KERNEL_MIN_STACK_WORDS)){
+		return 0;
+	}
+
+	for(uint32_t i = 0; i < stack_words; i++){
+		stack[i] = KERNEL_STACK_FILL;
+	}
+
+	//exception frame (popped by the hardware), 8-byte aligned
+	sp = (uint32_t*)((uintptr_t)(stack + stack_words) & ~(uintptr_t)0x7);
+	*(--sp) = KERNEL_INITIAL_XPSR;
+	*(--sp) = (uint32_t)entry;					/*PC*/
+	*(--sp) = (uint32_t)KERNEL_ThreadExit;		/*LR*/
+	*(--sp) = 0;								/*R12*/
+	*(--sp) = 0;								/*R3*/
+	*(--sp) = 0;								/*R2*/
+	*(--sp) = 0;								/*R1*/
+	*(--sp) = (uint32_t)arg;					/*R0*/
+
+	//software frame (popped by PendSV/SVC): EXC_RETURN, R11 - R4
+	*(--sp) = KERNEL_EXC_RETURN_THREAD;
+	for(uint8_t i = 0; i < 8; i++){
+		*(--sp) = 0;
+	}
+
+	*thread = (KERNEL_Thread_t){0};
+	thread->sp = sp;
+	thread->stack = stack;
+	thread->stack_words = stack_words;
+	thread->name = name;
+	thread->base_priority = priority;
+	thread->priority = priority;
+	thread->state = KERNEL_STATE_READY;
+
+	basepri = KERNEL_Lock();
+	g_KERNEL_THREADS[g_KERNEL_THREADS_NUM++] = thread;
+	if(g_KERNEL_CURRENT && (priority < g_KERNEL_CURRENT->priority)){
+		KERNEL_RequestSwitch();
+	}
+	KERNEL_Unlock(basepri);
+
+	return 1;
+}
+
+/**
+ * @func KERNEL_Init
+ * @brief Enables the FPU with lazy stacking, starts the cycle counter and creates the idle thread.
+ *
+ * #Important Registers:
+ * 			=> SCB->CPACR
+ * 				[♥] CP10/CP11		FPU full access
+ * 			=> FPU->FPCCR
+ * 				[♥] ASPEN		FPU context saved automatically on exception entry
+ * 				[♥] LSPEN		Lazy: space reserved, registers only saved if the handler uses the FPU
+ *
+ * @return void
+ */
+void KERNEL_Init(void){
+
+	SCB->CPACR |= (0b11UL << SCB_CPACR_CP10) | (0b11UL << SCB_CPACR_CP11);
+	FPU->FPCCR |= (1UL << FPU_FPCCR_ASPEN) | (1UL << FPU_FPCCR_LSPEN);
+#if KERNEL_ARM_PORT == 1
+	__asm volatile ("dsb" ::: "memory");
+	__asm volatile ("isb" ::: "memory");
+#endif
+
+	LIB_CycleCounterEnable();
+#if (KERNEL_IDLE_MODE == KERNEL_IDLE_TICKLESS_STOP)
+	PWR_Init();
+#endif
+
+	g_KERNEL_THREADS_NUM = 0;
+	g_KERNEL_CURRENT = 0;
+	g_KERNEL_TICKS = 0;
+	g_KERNEL_STATS = (KERNEL_Stats_t){0};
+
+	KERNEL_ThreadSetup(&g_KERNEL_IDLE_THREAD, "idle", KERNEL_IdleThread, 0, KERNEL_IDLE_PRIORITY,
+			g_KERNEL_IDLE_STACK, KERNEL_IDLE_STACK_WORDS);
+}
+
+/**
+ * @func KERNEL_ThreadCreate
+ * @brief Creates a ready thread (before or after KERNEL_Start()).
+ *
+ * @param	KERNEL_Thread_t* thread[OUT]		-> caller-owned, must stay valid
+ * @param	const char* name[IN]
+ * @param	KERNEL_Entry_t entry[IN]
+ * @param	void* arg[IN]						-> passed to entry
+ * @param	uint8_t priority[IN]				-> [0 (highest) - KERNEL_IDLE_PRIORITY - 1]
+ * @param	uint32_t* stack[IN]					-> caller-owned
+ * @param	uint32_t stack_words[IN]			-> >= KERNEL_MIN_STACK_WORDS
+ * @return uint8_t		1: created, 0: no room, wrong priority or stack too small
+ */
+uint8_t KERNEL_ThreadCreate(KERNEL_Thread_t* thread, const char* name, KERNEL_Entry_t entry, void* arg,
+		uint8_t priority, uint32_t* stack, uint32_t stack_words){
+
+	if(priority >= KERNEL_IDLE_PRIORITY){
+		return 0;
+	}
+
+	return KERNEL_ThreadSetup(thread, name, entry, arg, priority, stack, stack_words);
+}
+
+/**
+ * @func KERNEL_Start
+ * @brief Starts the tick and switches to the highest priority thread, never returns.
+ *
+ * #Important Registers:
+ * 			=> SysTick->RVR/CVR/CSR		Tick at KERNEL_TICK_HZ from HCLK
+ * 			=> SCB->SHPR				PendSV and SysTick at the lowest priority
+ *
+ * @return void
+ */
+void KERNEL_Start(void){
+
+#if KERNEL_ARM_PORT == 1
+	__asm volatile ("cpsid i" ::: "memory");
+#endif
+
+	NVIC_SetPriority(NVIC_IRQ_PENDSV, NVIC_PRIORITY_LOWEST);
+	NVIC_SetPriority(NVIC_IRQ_SYSTICK, NVIC_PRIORITY_LOWEST);
+
+	SysTick->CSR = 0;
+	SysTick->RVR = KERNEL_CYCLES_PER_TICK - 1;
+	SysTick->CVR = 0;
+	SysTick->CSR = (1UL << SysTick_CSR_CLKSOURCE) | (1UL << SysTick_CSR_TICKINT) | (1UL << SysTick_CSR_ENABLE);
+
+	g_KERNEL_CURRENT = KERNEL_PickNext();
+	g_KERNEL_CURRENT->switches++;
+	g_KERNEL_RUN_START = LIB_CycleCounterRead();
+	g_KERNEL_RUNNING = 1;
+
+	//main's stack is given back to the ISRs (MSP reset to its initial value), then SVC starts the first thread
+#if KERNEL_ARM_PORT == 1
+	__asm volatile (
+			"ldr r0, =g_pfnVectors	\n"
+			"ldr r0, [r0]			\n"
+			"msr msp, r0			\n"
+			"cpsie i				\n"
+			"dsb					\n"
+			"isb					\n"
+			"svc 0					\n"
+			::: "r0", "memory");
+#endif
+
+	while(1);
+}
+
+/**
+ * @func KERNEL_Sleep
+ * @brief Blocks the calling thread for a number of ticks (0: same as KERNEL_Yield()).
+ *
+ * @param	uint32_t ticks[IN]
+ * @return void
+ */
+void KERNEL_Sleep(uint32_t ticks){
+
+	uint32_t basepri;
+
+	if(ticks == 0){
+		KERNEL_Yield();
+		return;
+	}
+
+	basepri = KERNEL_Lock();
+	KERNEL_Block(KERNEL_WAIT_NONE, 0, ticks);
+	KERNEL_Unlock(basepri);
+}
+
+/**
+ * @func KERNEL_Yield
+ * @brief Lets the other ready threads of the same priority run.
+ *
+ * @return void
+ */
+void KERNEL_Yield(void){
+
+	uint32_t basepri = KERNEL_Lock();
+	g_KERNEL_ROTATE = 1;
+	KERNEL_RequestSwitch();
+	KERNEL_Unlock(basepri);
+}
+
+/**
+ * @func KERNEL_GetTicks
+ * @brief Returns the ticks since KERNEL_Start().
+ *
+ * @return uint32_t
+ */
+uint32_t KERNEL_GetTicks(void){
+	return g_KERNEL_TICKS;
+}
+
+/**
+ * @func KERNEL_SemInit
+ * @brief Initializes a counting semaphore (max 1 for a binary one).
+ *
+ * @param	KERNEL_Sem_t* sem[OUT]
+ * @param	uint32_t initial[IN]
+ * @param	uint32_t max[IN]
+ * @return void
+ */
+void KERNEL_SemInit(KERNEL_Sem_t* sem, uint32_t initial, uint32_t max){
+	sem->count = initial;
+	sem->max = max;
+}
+
+/**
+ * @func KERNEL_SemTake
+ * @brief Takes the semaphore, blocks up to timeout ticks while it is 0 (threads only).
+ *
+ * @param	KERNEL_Sem_t* sem[IN]
+ * @param	uint32_t timeout[IN]		-> ticks, 0: don't wait, KERNEL_WAIT_FOREVER
+ * @return uint8_t		1: taken, 0: timeout
+ */
+uint8_t KERNEL_SemTake(KERNEL_Sem_t* sem, uint32_t timeout){
+
+	uint32_t basepri = KERNEL_Lock();
+
+	if(sem->count){
+		sem->count--;
+		KERNEL_Unlock(basepri);
+		return 1;
+	}
+	if(timeout == 0){
+		KERNEL_Unlock(basepri);
+		return 0;
+	}
+
+	KERNEL_Block(KERNEL_WAIT_SEM, sem, timeout);
+	KERNEL_Unlock(basepri);
+
+	//resumed by KERNEL_SemGive() (the count is handed over directly) or by the timeout
+	return g_KERNEL_CURRENT->wait_result;
+}
+
+/**
+ * @func KERNEL_SemGive
+ * @brief Gives the semaphore, wakes its highest priority waiter (threads and ISRs).
+ *
+ * @param	KERNEL_Sem_t* sem[IN]
+ * @return void
+ */
+void KERNEL_SemGive(KERNEL_Sem_t* sem){
+
+	uint32_t basepri = KERNEL_Lock();
+	KERNEL_Thread_t* waiter = KERNEL_HighestWaiter(KERNEL_WAIT_SEM, sem);
+
+	if(waiter){
+		KERNEL_Wake(waiter, 1);
+	}else if(sem->count < sem->max){
+		sem->count++;
+	}
+
+	KERNEL_Unlock(basepri);
+}
+
+/**
+ * @func KERNEL_SemGiveCallback
+ * @brief KERNEL_SemGive() with the driver callbacks signature, pass the semaphore as the callback context.
+ *
+ * @param	void* context[IN]		-> KERNEL_Sem_t*
+ * @param	uint8_t event[IN]		-> ignored
+ * @return void
+ */
+void KERNEL_SemGiveCallback(void* context, uint8_t event){
+	(void)event;
+	KERNEL_SemGive((KERNEL_Sem_t*)context);
+}
+
+/**
+ * @func KERNEL_MutexInit
+ * @brief Initializes an unlocked mutex.
+ *
+ * @param	KERNEL_Mutex_t* mutex[OUT]
+ * @return void
+ */
+void KERNEL_MutexInit(KERNEL_Mutex_t* mutex){
+	mutex->owner = 0;
+}
+
+/**
+ * @func KERNEL_MutexLock
+ * @brief Locks the mutex, blocks up to timeout ticks while it is owned (threads only).
+ *
+ * @param	KERNEL_Mutex_t* mutex[IN]
+ * @param	uint32_t timeout[IN]		-> ticks, 0: don't wait, KERNEL_WAIT_FOREVER
+ * @return uint8_t		1: locked, 0: timeout
+ */
+uint8_t KERNEL_MutexLock(KERNEL_Mutex_t* mutex, uint32_t timeout){
+
+	uint32_t basepri = KERNEL_Lock();
+	KERNEL_Thread_t* current = g_KERNEL_CURRENT;
+	KERNEL_Thread_t* owner = mutex->owner;
+
+	if(!owner){
+		mutex->owner = current;
+		KERNEL_Unlock(basepri);
+		return 1;
+	}
+	if((timeout == 0) || (owner == current)){
+		KERNEL_Unlock(basepri);
+		return 0;
+	}
+
+	//priority inheritance, along the chain of owners blocked on other mutexes
+	while(owner && (owner->priority > current->priority)){
+		owner->priority = current->priority;
+		if((owner->state != KERNEL_STATE_BLOCKED) || (owner->wait_kind != KERNEL_WAIT_MUTEX)){
+			break;
+		}
+		owner = ((KERNEL_Mutex_t*)owner->wait_object)->owner;
+	}
+
+	KERNEL_Block(KERNEL_WAIT_MUTEX, mutex, timeout);
+	KERNEL_Unlock(basepri);
+
+	//resumed as the new owner (KERNEL_MutexUnlock()) or by the timeout
+	return g_KERNEL_CURRENT->wait_result;
+}
+
+/**
+ * @func KERNEL_MutexUnlock
+ * @brief Unlocks the mutex (owner only) and hands it to its highest priority waiter.
+ *
+ * @param	KERNEL_Mutex_t* mutex[IN]
+ * @return void
+ */
+void KERNEL_MutexUnlock(KERNEL_Mutex_t* mutex){
+
+	uint32_t basepri = KERNEL_Lock();
+	KERNEL_Thread_t* current = g_KERNEL_CURRENT;
+	KERNEL_Thread_t* waiter;
+
+	if(mutex->owner != current){
+		KERNEL_Unlock(basepri);
+		return;
+	}
+
+	waiter = KERNEL_HighestWaiter(KERNEL_WAIT_MUTEX, mutex);
+	mutex->owner = waiter;
+	if(waiter){
+		KERNEL_Wake(waiter, 1);
+		//the remaining waiters now wait for the new owner
+		KERNEL_UpdatePriority(waiter);
+	}
+
+	//drop the inherited priority, a more urgent thread may be ready now
+	KERNEL_UpdatePriority(current);
+	KERNEL_RequestSwitch();
+
+	KERNEL_Unlock(basepri);
+}
+
+/**
+ * @func KERNEL_GetThreadStats
+ * @brief Copies a thread's statistics, the stack high water mark is measured at the call.
+ *
+ * @param	const KERNEL_Thread_t* thread[IN]
+ * @param	KERNEL_ThreadStats_t* stats[OUT]
+ * @return void
+ */
+void KERNEL_GetThreadStats(const KERNEL_Thread_t* thread, KERNEL_ThreadStats_t* stats){
+
+	uint32_t unused = 0;
+
+	//the stack grows down, the words never written keep the fill pattern
+	while((unused < thread->stack_words) && (thread->stack[unused] == KERNEL_STACK_FILL)){
+		unused++;
+	}
+
+	stats->switches = thread->switches;
+	stats->run_cycles = thread->run_cycles;
+	stats->stack_words = thread->stack_words;
+	stats->stack_high_water = thread->stack_words - unused;
+}
+
+/**
+ * @func KERNEL_GetStats
+ * @brief Copies the context switch statistics.
+ *
+ * @param	KERNEL_Stats_t* stats[OUT]
+ * @return void
+ */
+void KERNEL_GetStats(KERNEL_Stats_t* stats){
+
+	uint32_t basepri = KERNEL_Lock();
+	*stats = g_KERNEL_STATS;
+	stats->elapsed_cycles = (uint64_t)g_KERNEL_TICKS * KERNEL_CYCLES_PER_TICK;
+	KERNEL_Unlock(basepri);
+}
+
+/**
+ * @func KERNEL_PrintField
+ * @brief Prints a label then a decimal value on USART_DEBUGGING_CHANNEL.
+ *
+ * @note STATIC FUNCTION
+ */
+static void KERNEL_PrintField(const char* label, uint32_t value){
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)label);
+	LIB_PrintUint32(LIB_FormatDebugSink, value);
+}
+
+/**
+ * @func KERNEL_ReportStats
+ * @brief Prints the context switch latency and each thread's statistics (num_format, USART_DEBUGGING_CHANNEL).
+ *
+ * @return void
+ */
+void KERNEL_ReportStats(void){
+
+	KERNEL_Stats_t stats;
+	KERNEL_ThreadStats_t thread_stats;
+
+	KERNEL_GetStats(&stats);
+	KERNEL_PrintField("switches: ", stats.context_switches);
+	KERNEL_PrintField(", latency (cycles) last: ", stats.last_latency_cycles);
+	KERNEL_PrintField(", max: ", stats.max_latency_cycles);
+	KERNEL_PrintField(", avg: ",
+			(uint32_t)(stats.latency_samples ? (stats.total_latency_cycles / stats.latency_samples) : 0));
+	KERNEL_PrintField("\n\rrun: ",
+			(uint32_t)((stats.elapsed_cycles - stats.sleep_cycles - stats.stop_cycles) / (KERNEL_CPU_HZ / 1000UL)));
+	KERNEL_PrintField(" ms, sleep: ", (uint32_t)(stats.sleep_cycles / (KERNEL_CPU_HZ / 1000UL)));
+	KERNEL_PrintField(" ms (", stats.sleep_entries);
+	KERNEL_PrintField("), stop: ", (uint32_t)(stats.stop_cycles / (KERNEL_CPU_HZ / 1000UL)));
+	KERNEL_PrintField(" ms (", stats.stop_entries);
+	LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)")\n\r");
+
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_GetThreadStats(g_KERNEL_THREADS[i], &thread_stats);
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)g_KERNEL_THREADS[i]->name);
+		KERNEL_PrintField(": prio ", g_KERNEL_THREADS[i]->priority);
+		KERNEL_PrintField(", switches ", thread_stats.switches);
+		KERNEL_PrintField(", run ", (uint32_t)(thread_stats.run_cycles / 1000));
+		KERNEL_PrintField(" Kcycles, stack ", thread_stats.stack_high_water);
+		KERNEL_PrintField("/", thread_stats.stack_words);
+		LIB_PrintString(LIB_FormatDebugSink, (const uint8_t*)" words\n\r");
+	}
+}
+
+
+/******************************* ISR *******************************/
+void SysTick_Handler(void){
+
+	uint32_t basepri = KERNEL_Lock();
+	KERNEL_Thread_t* current = g_KERNEL_CURRENT;
+
+	g_KERNEL_TICKS++;
+
+	//timeouts and sleeps
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* thread = g_KERNEL_THREADS[i];
+
+		if((thread->state == KERNEL_STATE_BLOCKED) && thread->timed &&
+		   ((int32_t)(g_KERNEL_TICKS - thread->wake_tick) >= 0)){
+			uint8_t kind = thread->wait_kind;
+			KERNEL_Mutex_t* mutex = (KERNEL_Mutex_t*)thread->wait_object;
+
+			KERNEL_Wake(thread, 0);
+			//the owners along the chain lose the priority inherited from this waiter, which may preempt them now
+			if(kind == KERNEL_WAIT_MUTEX){
+				KERNEL_Thread_t* owner = mutex->owner;
+
+				while(owner){
+					KERNEL_UpdatePriority(owner);
+					if((owner->state != KERNEL_STATE_BLOCKED) || (owner->wait_kind != KERNEL_WAIT_MUTEX)){
+						break;
+					}
+					owner = ((KERNEL_Mutex_t*)owner->wait_object)->owner;
+				}
+				if(thread->priority < current->priority){
+					KERNEL_RequestSwitch();
+				}
+			}
+		}
+	}
+
+	//time slice among the ready threads of the current priority
+	for(uint8_t i = 0; i < g_KERNEL_THREADS_NUM; i++){
+		KERNEL_Thread_t* thread = g_KERNEL_THREADS[i];
+
+		if((thread != current) && (thread->state == KERNEL_STATE_READY) && (thread->priority == current->priority)){
+			g_KERNEL_ROTATE = 1;
+			KERNEL_RequestSwitch();
+			break;
+		}
+	}
+
+	KERNEL_Unlock(basepri);
+}
+
+#if KERNEL_ARM_PORT == 1
+/**
+ * PendSV: saves R4 - R11, EXC_RETURN (and S16 - S31 if the thread used the FPU) on the thread stack, selects the
+ * next thread with the kernel locked, then restores its context. The hardware saves/restores the rest.
+ */
+__attribute__((naked)) void PendSV_Handler(void){
+	__asm volatile (
+			"mrs r0, psp						\n"
+			"isb								\n"
+			"tst lr, #0x10						\n"
+			"it eq								\n"
+			"vstmdbeq r0!, {s16-s31}			\n"
+			"stmdb r0!, {r4-r11, lr}			\n"
+			"ldr r3, =g_KERNEL_CURRENT			\n"
+			"ldr r2, [r3]						\n"
+			"str r0, [r2]						\n"
+
+			"mov r0, #" KERNEL_TO_STRING(KERNEL_BASEPRI) "	\n"
+			"msr basepri, r0					\n"
+			"dsb								\n"
+			"isb								\n"
+			"bl KERNEL_SwitchContext			\n"
+			"mov r0, #0							\n"
+			"msr basepri, r0					\n"
+
+			"ldr r3, =g_KERNEL_CURRENT			\n"
+			"ldr r2, [r3]						\n"
+			"ldr r0, [r2]						\n"
+			"ldmia r0!, {r4-r11, lr}			\n"
+			"tst lr, #0x10						\n"
+			"it eq								\n"
+			"vldmiaeq r0!, {s16-s31}			\n"
+			"msr psp, r0						\n"
+			"isb								\n"
+			"bx lr								\n"
+	);
+}
+
+/**
+ * SVC 0 (KERNEL_Start()): restores the first thread's context and returns to it in thread mode on PSP.
+ */
+__attribute__((naked)) void SVC_Handler(void){
+	__asm volatile (
+			"ldr r3, =g_KERNEL_CURRENT			\n"
+			"ldr r2, [r3]						\n"
+			"ldr r0, [r2]						\n"
+			"ldmia r0!, {r4-r11, lr}			\n"
+			"msr psp, r0						\n"
+			"isb								\n"
+			"mov r0, #0							\n"
+			"msr basepri, r0					\n"
+			"bx lr								\n"
+	);
+}
+#endif
@@ -0,0 +1,357 @@
+/**
+ * @file kernel.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Preemptive fixed-priority kernel header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Unlike the run-to-completion scheduler (sched.h), a thread can block in the middle of its work (waiting for
+ * 			a DMA completion, a mutex, a delay) and a higher priority thread preempts a running one at once, so a long
+ * 			DSP job in a low priority thread doesn't delay the latency-critical I/O threads.
+ *
+ * # Threads ?
+ * 		[♥] Fixed priorities [0 (highest) - KERNEL_IDLE_PRIORITY - 1], the highest priority ready thread always runs,
+ * 			threads of the same priority share the CPU round robin at each tick (or KERNEL_Yield()).
+ * 		[♥] Each thread has its own stack (a static uint32_t array owned by the caller), filled with a pattern at
+ * 			creation so its high water mark can be measured (KERNEL_GetThreadStats()).
+ * 		[♥] Stacks are best placed in CCM RAM (LIB_CCM_BSS) unless the thread gives local buffers to the DMA.
+ * 		[♥] A thread returning from its entry function is terminated.
+ *
+ * # Context switch ?
+ * 		[♥] The switch runs in PendSV (lowest priority): it is only taken once no other ISR is running, SysTick
+ * 			(the tick) and the kernel calls just pend it.
+ * 		[♥] Lazy FPU stacking: the FPU registers (S16 - S31 by PendSV, S0 - S15 + FPSCR by the hardware) are only
+ * 			saved for a thread that used the FPU since its last switch (EXC_RETURN bit 4), others switch as fast as
+ * 			without FPU.
+ * 		[♥] The latency from the switch request (tick, KERNEL_SemGive() ...) to the new thread selection in PendSV is
+ * 			measured with the DWT cycle counter (KERNEL_GetStats(), KERNEL_ReportStats()).
+ *
+ * # Synchronization ?
+ * 		[♥] Semaphores: KERNEL_SemGive() can be called from ISRs, and KERNEL_SemGiveCallback() matches the drivers'
+ * 			completion callbacks (DMA_Callback_t, LIB_DmaMemCallback_t ...) with the semaphore as context.
+ * 		[♥] Mutexes with priority inheritance: the owner runs at the priority of its highest priority waiter until it
+ * 			unlocks, so a medium priority thread can't hold a high priority one waiting for a low priority one.
+ *
+ * # Interrupt priorities ?
+ * 		[♥] The kernel masks the interrupts with a priority number >= KERNEL_MAX_SYSCALL_PRIORITY (BASEPRI) in its
+ * 			critical sections, ISRs calling KERNEL_SemGive() must have such a priority (NVIC_SetPriority()), the more
+ * 			urgent ones are never masked but must not call the kernel.
+ * 		[♥] The kernel owns SysTick, PendSV and SVCall: don't use LIB_SysTickDelay_us()/ms() once it runs.
+ *
+ * # Low-power idle ?
+ * 		[♥] The idle thread always sleeps (WFI), with KERNEL_IDLE_MODE:
+ * 				KERNEL_IDLE_WFI				-> Sleep mode, woken up by every tick.
+ * 				KERNEL_IDLE_TICKLESS_SLEEP	-> SysTick is reprogrammed to expire at the next thread timeout/sleep
+ * 												deadline (up to ~1 s), the skipped ticks are added at wakeup.
+ * 				KERNEL_IDLE_TICKLESS_STOP	-> Stop mode until the next deadline (up to PWR_WAKEUP_MAX_MS), woken by the
+ * 												RTC wakeup timer (PWR_Init() is called by KERNEL_Init()), the clocks
+ * 												are restored before any thread runs. Only EXTI lines wake the CPU
+ * 												up: interrupts of peripherals without one are delayed until then.
+ * 		[♥] Tickless idle is only used if the next deadline is at least KERNEL_TICKLESS_MIN_TICKS away, and an
+ * 			interrupt waking the CPU earlier is handled as usual (the elapsed ticks are added first).
+ * 		[♥] The time spent in each power state (run, sleep, stop) is reported by KERNEL_GetStats()/KERNEL_ReportStats().
+ *
+ * # Usage Work Flow ?
+ * 		1. KERNEL_Init().
+ * 		2. KERNEL_ThreadCreate() for each thread, KERNEL_SemInit()/KERNEL_MutexInit() for the sync objects.
+ * 		3. KERNEL_Start() (never returns), blocking calls are only allowed from threads.
+ */
+#ifndef KERNEL_KERNEL_H_
+#define KERNEL_KERNEL_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "memory_map.h"
+#include "nvic.h"
+#include "common_lib.h"
+#include "pwr.h"
+
+
+/*******************************  Macros *******************************/
+/*Timeout of the blocking calls: wait without limit*/
+#define KERNEL_WAIT_FOREVER			(0xFFFFFFFFUL)
+
+/*Lowest priority, reserved for the idle thread*/
+#define KERNEL_IDLE_PRIORITY		(31)
+
+/*Room for the initial context (16 words) and an FPU exception frame (26 words)*/
+#define KERNEL_MIN_STACK_WORDS		(64)
+
+/**
+ * @defgroup KERNEL_Idle_Options
+ */
+#define KERNEL_IDLE_WFI				(0)		/*Sleep mode, woken up by each tick*/
+#define KERNEL_IDLE_TICKLESS_SLEEP	(1)		/*Sleep mode until the next deadline*/
+#define KERNEL_IDLE_TICKLESS_STOP	(2)		/*Stop mode until the next deadline*/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Threads, the idle thread excluded*/
+#define KERNEL_MAX_THREADS			(8)
+
+/*Tick frequency and CPU clock (HCLK, SysTick clock source)*/
+#define KERNEL_TICK_HZ				(1000UL)
+#define KERNEL_CPU_HZ				(16000000UL)
+
+/*Highest NVIC priority (lowest number) of the ISRs calling the kernel [1 - 15]*/
+#define KERNEL_MAX_SYSCALL_PRIORITY	(5)
+
+/*Idle thread low-power mode, choose out of @defgroup KERNEL_Idle_Options*/
+#define KERNEL_IDLE_MODE			(KERNEL_IDLE_TICKLESS_SLEEP)
+
+/*Shortest idle period (ticks) worth stopping the tick for*/
+#define KERNEL_TICKLESS_MIN_TICKS	(2)
+
+/*Regulator in Stop mode, choose out of @defgroup PWR_Regulator_Options*/
+#define KERNEL_STOP_REGULATOR		(PWR_REGULATOR_LOW_POWER)
+
+
+/******************************* Types *******************************/
+typedef void (*KERNEL_Entry_t)(void* arg);
+
+/**
+ * @struct KERNEL_Thread_t
+ * @brief Thread control block, caller-owned, its members are private to the kernel.
+ */
+typedef struct{
+	uint32_t* sp;				/*saved stack pointer, MUST stay the first member (PendSV_Handler)*/
+	uint32_t* stack;
+	uint32_t stack_words;
+	const char* name;
+	uint8_t base_priority;		/*creation priority*/
+	uint8_t priority;			/*effective priority (raised by priority inheritance)*/
+	uint8_t state;
+	uint8_t wait_kind;
+	uint8_t wait_result;
+	uint8_t timed;
+	void* wait_object;
+	uint32_t wake_tick;
+	uint32_t switches;
+	uint64_t run_cycles;
+}KERNEL_Thread_t;
+
+/**
+ * @struct KERNEL_Sem_t
+ * @brief Counting semaphore.
+ * @note Initialize using KERNEL_SemInit().
+ */
+typedef struct{
+	uint32_t count;
+	uint32_t max;
+}KERNEL_Sem_t;
+
+/**
+ * @struct KERNEL_Mutex_t
+ * @brief Mutex with priority inheritance (not recursive).
+ * @note Initialize using KERNEL_MutexInit().
+ */
+typedef struct{
+	KERNEL_Thread_t* owner;
+}KERNEL_Mutex_t;
+
+/**
+ * @struct KERNEL_ThreadStats_t
+ * @brief Thread statistics.
+ */
+typedef struct{
+	uint32_t switches;			/*times switched in*/
+	uint64_t run_cycles;		/*CPU cycles spent running (ISRs included)*/
+	uint32_t stack_words;		/*stack size*/
+	uint32_t stack_high_water;	/*most stack words ever used*/
+}KERNEL_ThreadStats_t;
+
+/**
+ * @struct KERNEL_Stats_t
+ * @brief Context switch statistics, latencies in CPU cycles from the switch request to the selection in PendSV.
+ * 			Time in each power state in CPU cycles (KERNEL_CPU_HZ), run = elapsed - sleep - stop.
+ */
+typedef struct{
+	uint32_t context_switches;
+	uint32_t last_latency_cycles;
+	uint32_t max_latency_cycles;
+	uint64_t total_latency_cycles;	/*average = total / latency_samples*/
+	uint32_t latency_samples;
+	uint64_t elapsed_cycles;		/*since KERNEL_Start(), from the ticks count*/
+	uint64_t sleep_cycles;
+	uint64_t stop_cycles;
+	uint32_t sleep_entries;
+	uint32_t stop_entries;
+}KERNEL_Stats_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func KERNEL_Init
+ * @brief Enables the FPU with lazy stacking, starts the cycle counter and creates the idle thread.
+ *
+ * #Important Registers:
+ * 			=> SCB->CPACR
+ * 				[♥] CP10/CP11		FPU full access
+ * 			=> FPU->FPCCR
+ * 				[♥] ASPEN		FPU context saved automatically on exception entry
+ * 				[♥] LSPEN		Lazy: space reserved, registers only saved if the handler uses the FPU
+ *
+ * @return void
+ */
+void KERNEL_Init(void);
+
+/**
+ * @func KERNEL_ThreadCreate
+ * @brief Creates a ready thread (before or after KERNEL_Start()).
+ *
+ * @param	KERNEL_Thread_t* thread[OUT]		-> caller-owned, must stay valid
+ * @param	const char* name[IN]
+ * @param	KERNEL_Entry_t entry[IN]
+ * @param	void* arg[IN]						-> passed to entry
+ * @param	uint8_t priority[IN]				-> [0 (highest) - KERNEL_IDLE_PRIORITY - 1]
+ * @param	uint32_t* stack[IN]					-> caller-owned
+ * @param	uint32_t stack_words[IN]			-> >= KERNEL_MIN_STACK_WORDS
+ * @return uint8_t		1: created, 0: no room, wrong priority or stack too small
+ */
+uint8_t KERNEL_ThreadCreate(KERNEL_Thread_t* thread, const char* name, KERNEL_Entry_t entry, void* arg,
+		uint8_t priority, uint32_t* stack, uint32_t stack_words);
+
+/**
+ * @func KERNEL_Start
+ * @brief Starts the tick and switches to the highest priority thread, never returns.
+ *
+ * #Important Registers:
+ * 			=> SysTick->RVR/CVR/CSR		Tick at KERNEL_TICK_HZ from HCLK
+ * 			=> SCB->SHPR				PendSV and SysTick at the lowest priority
+ *
+ * @return void
+ */
+void KERNEL_Start(void);
+
+/**
+ * @func KERNEL_Sleep
+ * @brief Blocks the calling thread for a number of ticks (0: same as KERNEL_Yield()).
+ *
+ * @param	uint32_t ticks[IN]
+ * @return void
+ */
+void KERNEL_Sleep(uint32_t ticks);
+
+/**
+ * @func KERNEL_Yield
+ * @brief Lets the other ready threads of the same priority run.
+ *
+ * @return void
+ */
+void KERNEL_Yield(void);
+
+/**
+ * @func KERNEL_GetTicks
+ * @brief Returns the ticks since KERNEL_Start().
+ *
+ * @return uint32_t
+ */
+uint32_t KERNEL_GetTicks(void);
+
+/**
+ * @func KERNEL_SemInit
+ * @brief Initializes a counting semaphore (max 1 for a binary one).
+ *
+ * @param	KERNEL_Sem_t* sem[OUT]
+ * @param	uint32_t initial[IN]
+ * @param	uint32_t max[IN]
+ * @return void
+ */
+void KERNEL_SemInit(KERNEL_Sem_t* sem, uint32_t initial, uint32_t max);
+
+/**
+ * @func KERNEL_SemTake
+ * @brief Takes the semaphore, blocks up to timeout ticks while it is 0 (threads only).
+ *
+ * @param	KERNEL_Sem_t* sem[IN]
+ * @param	uint32_t timeout[IN]		-> ticks, 0: don't wait, KERNEL_WAIT_FOREVER
+ * @return uint8_t		1: taken, 0: timeout
+ */
+uint8_t KERNEL_SemTake(KERNEL_Sem_t* sem, uint32_t timeout);
+
+/**
+ * @func KERNEL_SemGive
+ * @brief Gives the semaphore, wakes its highest priority waiter (threads and ISRs).
+ *
+ * @param	KERNEL_Sem_t* sem[IN]
+ * @return void
+ */
+void KERNEL_SemGive(KERNEL_Sem_t* sem);
+
+/**
+ * @func KERNEL_SemGiveCallback
+ * @brief KERNEL_SemGive() with the driver callbacks signature, pass the semaphore as the callback context.
+ *
+ * @param	void* context[IN]		-> KERNEL_Sem_t*
+ * @param	uint8_t event[IN]		-> ignored
+ * @return void
+ */
+void KERNEL_SemGiveCallback(void* context, uint8_t event);
+
+/**
+ * @func KERNEL_MutexInit
+ * @brief Initializes an unlocked mutex.
+ *
+ * @param	KERNEL_Mutex_t* mutex[OUT]
+ * @return void
+ */
+void KERNEL_MutexInit(KERNEL_Mutex_t* mutex);
+
+/**
+ * @func KERNEL_MutexLock
+ * @brief Locks the mutex, blocks up to timeout ticks while it is owned (threads only).
+ *
+ * @param	KERNEL_Mutex_t* mutex[IN]
+ * @param	uint32_t timeout[IN]		-> ticks, 0: don't wait, KERNEL_WAIT_FOREVER
+ * @return uint8_t		1: locked, 0: timeout
+ */
+uint8_t KERNEL_MutexLock(KERNEL_Mutex_t* mutex, uint32_t timeout);
+
+/**
+ * @func KERNEL_MutexUnlock
+ * @brief Unlocks the mutex (owner only) and hands it to its highest priority waiter.
+ *
+ * @param	KERNEL_Mutex_t* mutex[IN]
+ * @return void
+ */
+void KERNEL_MutexUnlock(KERNEL_Mutex_t* mutex);
+
+/**
+ * @func KERNEL_GetThreadStats
+ * @brief Copies a thread's statistics, the stack high water mark is measured at the call.
+ *
+ * @param	const KERNEL_Thread_t* thread[IN]
+ * @param	KERNEL_ThreadStats_t* stats[OUT]
+ * @return void
+ */
+void KERNEL_GetThreadStats(const KERNEL_Thread_t* thread, KERNEL_ThreadStats_t* stats);
+
+/**
+ * @func KERNEL_GetStats
+ * @brief Copies the context switch statistics.
+ *
+ * @param	KERNEL_Stats_t* stats[OUT]
+ * @return void
+ */
+void KERNEL_GetStats(KERNEL_Stats_t* stats);
+
+/**
+ * @func KERNEL_ReportStats
+ * @brief Prints the context switch latency, the time in each power state and each thread's statistics
+ * 			(num_format, USART_DEBUGGING_CHANNEL).
+ *
+ * @return void
+ */
+void KERNEL_ReportStats(void);
+
+
+#endif /* KERNEL_KERNEL_H_ */
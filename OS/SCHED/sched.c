@@ -0,0 +1,273 @@
+/**
+ * @file sched.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Cooperative run-to-completion scheduler source file .
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Instead of a while(1) superloop with busy waits, each job is a task that handles one event at a time and
+ * 			returns (run to completion), drivers' callbacks/ISRs post events (e.g. "ADC block ready") to the tasks,
+ * 			the CPU sleeps (WFI) when no event is pending. No RTOS, no per-task stack: all tasks share the main stack.
+ *
+ * # Tasks and priorities ?
+ * 		[♥] A task is a handler + its own event queue (a static array owned by the caller, 2^n events), one task per
+ * 			priority [0 (highest) - SCHED_MAX_TASKS - 1].
+ * 		[♥] The scheduler always dispatches the oldest event of the highest priority ready task, a handler is never
+ * 			interrupted by another task (only by ISRs), so a long handler delays all the others: split long jobs by
+ * 			posting an event to itself.
+ *
+ * # Posting from ISRs ?
+ * 		[♥] SCHED_Post() is lock-free (LDREX/STREX): it never masks interrupts, any ISR at any priority and the tasks
+ * 			can post at the same time. It returns 0 (and counts a drop) when the task queue is full.
+ * 		[♥] Events are only consumed by SCHED_Run() in thread mode, an ISR always completes its post before the
+ * 			scheduler runs again.
+ *
+ * # Statistics ?
+ * 		[♥] Each dispatch is timed with the DWT cycle counter: runs, total/max cycles, queue high water mark and
+ * 			drops per task (SCHED_GetTaskStats()), and the cycles spent sleeping (SCHED_GetIdleCycles()) for the CPU load.
+ *
+ * # Usage Work Flow ?
+ * 		1. SCHED_Init().
+ * 		2. SCHED_TaskCreate() for each task with a static queue.
+ * 		3. Enable the interrupts posting events, then SCHED_Run() (never returns).
+ */
+
+/******************************* Includes *******************************/
+#include "sched.h"
+
+/*******************************  Macros *******************************/
+/*Ready bit of a priority: CLZ of the ready mask gives the highest ready priority at once*/
+#define SCHED_READY_BIT(priority)	(0x80000000UL >> (priority))
+
+
+/******************************* Configurations (if any) *******************************/
+
+
+/******************************* privates *******************************/
+typedef struct{
+	SCHED_Handler_t handler;
+	void* context;
+	SCHED_Event_t* queue;
+	uint32_t mask;					/*queue_len - 1, 0xFFFFFFFF: no task*/
+	volatile uint32_t head;			/*free-running, reserved by the producers*/
+	volatile uint32_t tail;			/*free-running, only advanced by SCHED_Run()*/
+	SCHED_TaskStats_t stats;
+}SCHED_Task_t;
+
+/*Touched by every post and dispatch (CCM RAM)*/
+static SCHED_Task_t g_SCHED_TASKS[SCHED_MAX_TASKS] LIB_CCM_BSS;
+
+/*One bit per task with pending events*/
+static volatile uint32_t g_SCHED_READY = 0;
+
+static uint64_t g_SCHED_IDLE_CYCLES = 0;
+
+/*An exception entry/return clears the exclusive monitor, so an interrupted LDREX/STREX pair just retries*/
+static inline uint32_t SCHED_LoadExclusive(volatile uint32_t* address){
+	uint32_t value;
+	__asm volatile ("ldrex %0, [%1]" : "=r" (value) : "r" (address) : "memory");
+	return value;
+}
+
+/*returns 0 on success*/
+static inline uint32_t SCHED_StoreExclusive(volatile uint32_t* address, uint32_t value){
+	uint32_t failed;
+	__asm volatile ("strex %0, %2, [%1]" : "=&r" (failed) : "r" (address), "r" (value) : "memory");
+	return failed;
+}
+
+static inline void SCHED_ClearExclusive(void){
+	__asm volatile ("clrex" ::: "memory");
+}
+
+static inline uint32_t SCHED_CountLeadingZeros(uint32_t value){
+	uint32_t result;
+	__asm volatile ("clz %0, %1" : "=r" (result) : "r" (value));
+	return result;
+}
+
+
+/******************************* Functions Implementation *******************************/
+/**
+ * @func SCHED_Init
+ * @brief Clears the tasks and starts the cycle counter used for the statistics.
+ *
+ * @return void
+ */
+void SCHED_Init(void){
+
+	for(uint8_t i = 0; i < SCHED_MAX_TASKS; i++){
+		g_SCHED_TASKS[i] = (SCHED_Task_t){0};
+		g_SCHED_TASKS[i].mask = 0xFFFFFFFFUL;
+	}
+	g_SCHED_READY = 0;
+	g_SCHED_IDLE_CYCLES = 0;
+
+	LIB_CycleCounterEnable();
+}
+
+/**
+ * @func SCHED_TaskCreate
+ * @brief Creates a task at a free priority.
+ *
+ * @param	uint8_t priority[IN]			-> [0 (highest) - SCHED_MAX_TASKS - 1]
+ * @param	SCHED_Handler_t handler[IN]
+ * @param	void* context[IN]
+ * @param	SCHED_Event_t* queue[IN]		-> static storage of queue_len events
+ * @param	uint16_t queue_len[IN]			-> power of 2
+ * @return uint8_t		1: created, 0: priority used/out of range or queue_len not a power of 2
+ */
+uint8_t SCHED_TaskCreate(uint8_t priority, SCHED_Handler_t handler, void* context, SCHED_Event_t* queue,
+		uint16_t queue_len){
+
+	if((priority >= SCHED_MAX_TASKS) || (g_SCHED_TASKS[priority].mask != 0xFFFFFFFFUL) ||
+	   (queue_len == 0) || (queue_len & (queue_len - 1))){
+		return 0;
+	}
+
+	SCHED_Task_t* task = &g_SCHED_TASKS[priority];
+
+	task->handler = handler;
+	task->context = context;
+	task->queue = queue;
+	task->head = 0;
+	task->tail = 0;
+	task->stats = (SCHED_TaskStats_t){0};
+	task->mask = queue_len - 1UL;
+
+	return 1;
+}
+
+/**
+ * @func SCHED_Post
+ * @brief Queues an event to a task, lock-free, callable from ISRs and tasks.
+ *
+ * @param	uint8_t priority[IN]		-> task
+ * @param	uint16_t signal[IN]
+ * @param	uint32_t param[IN]
+ * @return uint8_t		1: queued, 0: queue full (event dropped) or no such task
+ */
+uint8_t SCHED_Post(uint8_t priority, uint16_t signal, uint32_t param){
+
+	SCHED_Task_t* task;
+	uint32_t head;
+	uint32_t used;
+
+	if((priority >= SCHED_MAX_TASKS) || (g_SCHED_TASKS[priority].mask == 0xFFFFFFFFUL)){
+		return 0;
+	}
+	task = &g_SCHED_TASKS[priority];
+
+	//reserve a slot
+	do{
+		head = SCHED_LoadExclusive(&task->head);
+		if((head - task->tail) > task->mask){
+			SCHED_ClearExclusive();
+			do{
+				used = SCHED_LoadExclusive(&task->stats.dropped);
+			}while(SCHED_StoreExclusive(&task->stats.dropped, used + 1));
+			return 0;
+		}
+	}while(SCHED_StoreExclusive(&task->head, head + 1));
+
+	task->queue[head & task->mask].signal = signal;
+	task->queue[head & task->mask].param = param;
+
+	used = head + 1 - task->tail;
+	if(used > task->stats.queue_high_water){
+		task->stats.queue_high_water = used;
+	}
+
+	do{
+		head = SCHED_LoadExclusive(&g_SCHED_READY);
+	}while(SCHED_StoreExclusive(&g_SCHED_READY, head | SCHED_READY_BIT(priority)));
+
+	return 1;
+}
+
+/**
+ * @func SCHED_Run
+ * @brief Dispatches the events forever, sleeps when none is pending.
+ *
+ * @return void		never returns
+ */
+void SCHED_Run(void){
+
+	uint32_t ready;
+	uint32_t start;
+	uint32_t cycles;
+
+	while(1){
+		ready = g_SCHED_READY;
+
+		if(ready == 0){
+			//interrupts masked between the check and WFI: an event posted meanwhile still wakes the CPU up
+			__asm volatile ("cpsid i" ::: "memory");
+			if(g_SCHED_READY == 0){
+				start = LIB_CycleCounterRead();
+#if SCHED_IDLE_WFI == SCHED_IDLE_WFI_ENABLE
+				__asm volatile ("dsb" ::: "memory");
+				__asm volatile ("wfi");
+#endif
+				g_SCHED_IDLE_CYCLES += LIB_CycleCounterRead() - start;
+			}
+			__asm volatile ("cpsie i" ::: "memory");
+			continue;
+		}
+
+		uint8_t priority = (uint8_t)SCHED_CountLeadingZeros(ready);
+		SCHED_Task_t* task = &g_SCHED_TASKS[priority];
+
+		//copy then free the slot, so the queue accepts a new event while the handler runs
+		SCHED_Event_t event = task->queue[task->tail & task->mask];
+		task->tail++;
+
+		//clear the ready bit, then set it again if events are left (a post in between sets it by itself)
+		do{
+			ready = SCHED_LoadExclusive(&g_SCHED_READY);
+		}while(SCHED_StoreExclusive(&g_SCHED_READY, ready & ~SCHED_READY_BIT(priority)));
+		if(task->head != task->tail){
+			do{
+				ready = SCHED_LoadExclusive(&g_SCHED_READY);
+			}while(SCHED_StoreExclusive(&g_SCHED_READY, ready | SCHED_READY_BIT(priority)));
+		}
+
+		start = LIB_CycleCounterRead();
+		task->handler(task->context, &event);
+		cycles = LIB_CycleCounterRead() - start;
+
+		task->stats.runs++;
+		task->stats.total_cycles += cycles;
+		if(cycles > task->stats.max_cycles){
+			task->stats.max_cycles = cycles;
+		}
+	}
+}
+
+/**
+ * @func SCHED_GetTaskStats
+ * @brief Copies a task's statistics.
+ *
+ * @param	uint8_t priority[IN]
+ * @param	SCHED_TaskStats_t* stats[OUT]
+ * @return void
+ */
+void SCHED_GetTaskStats(uint8_t priority, SCHED_TaskStats_t* stats){
+
+	//copied with the interrupts masked, so the counters updated by the ISRs are consistent
+	uint32_t primask = LIB_EnterCritical();
+	*stats = g_SCHED_TASKS[priority].stats;
+	LIB_ExitCritical(primask);
+}
+
+/**
+ * @func SCHED_GetIdleCycles
+ * @brief Returns the CPU cycles spent sleeping (CPU load = 1 - idle / elapsed).
+ *
+ * @return uint64_t
+ */
+uint64_t SCHED_GetIdleCycles(void){
+	return g_SCHED_IDLE_CYCLES;
+}
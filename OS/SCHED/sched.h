@@ -0,0 +1,162 @@
+/**
+ * @file sched.h
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Cooperative run-to-completion scheduler header file .
+ *
+ *
+ * ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣ HOW TO USE ♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣♣
+ * # Why ?
+ * 		[♥] Instead of a while(1) superloop with busy waits, each job is a task that handles one event at a time and
+ * 			returns (run to completion), drivers' callbacks/ISRs post events (e.g. "ADC block ready") to the tasks,
+ * 			the CPU sleeps (WFI) when no event is pending. No RTOS, no per-task stack: all tasks share the main stack.
+ *
+ * # Tasks and priorities ?
+ * 		[♥] A task is a handler + its own event queue (a static array owned by the caller, 2^n events), one task per
+ * 			priority [0 (highest) - SCHED_MAX_TASKS - 1].
+ * 		[♥] The scheduler always dispatches the oldest event of the highest priority ready task, a handler is never
+ * 			interrupted by another task (only by ISRs), so a long handler delays all the others: split long jobs by
+ * 			posting an event to itself.
+ *
+ * # Posting from ISRs ?
+ * 		[♥] SCHED_Post() is lock-free (LDREX/STREX): it never masks interrupts, any ISR at any priority and the tasks
+ * 			can post at the same time. It returns 0 (and counts a drop) when the task queue is full.
+ * 		[♥] Events are only consumed by SCHED_Run() in thread mode, an ISR always completes its post before the
+ * 			scheduler runs again.
+ *
+ * # Statistics ?
+ * 		[♥] Each dispatch is timed with the DWT cycle counter: runs, total/max cycles, queue high water mark and
+ * 			drops per task (SCHED_GetTaskStats()), and the cycles spent sleeping (SCHED_GetIdleCycles()) for the CPU load.
+ *
+ * # Usage Work Flow ?
+ * 		1. SCHED_Init().
+ * 		2. SCHED_TaskCreate() for each task with a static queue.
+ * 		3. Enable the interrupts posting events, then SCHED_Run() (never returns).
+ */
+#ifndef SCHED_SCHED_H_
+#define SCHED_SCHED_H_
+
+
+
+
+/******************************* Includes *******************************/
+#include "stdint.h"
+#include "common_lib.h"
+
+
+/*******************************  Macros *******************************/
+
+
+/******************************* globals *******************************/
+
+
+/******************************* Configurations *******************************/
+/*Number of priorities/tasks [1 - 32]*/
+#define SCHED_MAX_TASKS				(8)
+
+/**
+ * @brief Configuring if the CPU sleeps (WFI) when no event is pending.
+ *
+ * #Choose Between
+ * 		- SCHED_IDLE_WFI_ENABLE
+ * 		- SCHED_IDLE_WFI_DISABLE	(busy idle, e.g. when a debugger loses the core in sleep)
+ */
+#define SCHED_IDLE_WFI_ENABLE		1
+#define SCHED_IDLE_WFI_DISABLE		0
+#define SCHED_IDLE_WFI				SCHED_IDLE_WFI_ENABLE
+
+
+/******************************* Types *******************************/
+/**
+ * @struct SCHED_Event_t
+ * @brief Event delivered to a task.
+ */
+typedef struct{
+	uint16_t signal;		/*what happened, defined by the application*/
+	uint32_t param;			/*event data (a value, an index or a pointer)*/
+}SCHED_Event_t;
+
+/**
+ * @brief Task handler, runs to completion in thread mode.
+ *
+ * @param void* context					-> the task's context
+ * @param const SCHED_Event_t* event	-> valid during the call only
+ */
+typedef void (*SCHED_Handler_t)(void* context, const SCHED_Event_t* event);
+
+/**
+ * @struct SCHED_TaskStats_t
+ * @brief Task statistics since its creation.
+ */
+typedef struct{
+	uint32_t runs;				/*handled events*/
+	uint64_t total_cycles;		/*CPU cycles spent in the handler*/
+	uint32_t max_cycles;		/*longest handler run*/
+	uint32_t queue_high_water;	/*most events waiting at once*/
+	uint32_t dropped;			/*posts refused (queue full)*/
+}SCHED_TaskStats_t;
+
+
+/******************************* Functions prototypes *******************************/
+/**
+ * @func SCHED_Init
+ * @brief Clears the tasks and starts the cycle counter used for the statistics.
+ *
+ * @return void
+ */
+void SCHED_Init(void);
+
+/**
+ * @func SCHED_TaskCreate
+ * @brief Creates a task at a free priority.
+ *
+ * @param	uint8_t priority[IN]			-> [0 (highest) - SCHED_MAX_TASKS - 1]
+ * @param	SCHED_Handler_t handler[IN]
+ * @param	void* context[IN]
+ * @param	SCHED_Event_t* queue[IN]		-> static storage of queue_len events
+ * @param	uint16_t queue_len[IN]			-> power of 2
+ * @return uint8_t		1: created, 0: priority used/out of range or queue_len not a power of 2
+ */
+uint8_t SCHED_TaskCreate(uint8_t priority, SCHED_Handler_t handler, void* context, SCHED_Event_t* queue,
+		uint16_t queue_len);
+
+/**
+ * @func SCHED_Post
+ * @brief Queues an event to a task, lock-free, callable from ISRs and tasks.
+ *
+ * @param	uint8_t priority[IN]		-> task
+ * @param	uint16_t signal[IN]
+ * @param	uint32_t param[IN]
+ * @return uint8_t		1: queued, 0: queue full (event dropped) or no such task
+ */
+uint8_t SCHED_Post(uint8_t priority, uint16_t signal, uint32_t param);
+
+/**
+ * @func SCHED_Run
+ * @brief Dispatches the events forever, sleeps when none is pending.
+ *
+ * @return void		never returns
+ */
+void SCHED_Run(void);
+
+/**
+ * @func SCHED_GetTaskStats
+ * @brief Copies a task's statistics.
+ *
+ * @param	uint8_t priority[IN]
+ * @param	SCHED_TaskStats_t* stats[OUT]
+ * @return void
+ */
+void SCHED_GetTaskStats(uint8_t priority, SCHED_TaskStats_t* stats);
+
+/**
+ * @func SCHED_GetIdleCycles
+ * @brief Returns the CPU cycles spent sleeping (CPU load = 1 - idle / elapsed).
+ *
+ * @return uint64_t
+ */
+uint64_t SCHED_GetIdleCycles(void);
+
+
+#endif /* SCHED_SCHED_H_ */
@@ -41,6 +41,18 @@ defined in linker script */
 .word _sbss
 /* end address for the .bss section. defined in linker script */
 .word _ebss
+/* start address for the initialization values of the .ramfunc section. defined in linker script */
+.word _siramfunc
+/* start/end addresses for the .ramfunc section. defined in linker script */
+.word _sramfunc
+.word _eramfunc
+/* start address for the initialization values of the .ccmram section. defined in linker script */
+.word _siccmram
+/* start/end addresses for the .ccmram and .ccmbss sections. defined in linker script */
+.word _sccmram
+.word _eccmram
+.word _sccmbss
+.word _eccmbss
 
 /**
  * @brief  This is the code that gets called when the processor first
@@ -57,6 +69,13 @@ defined in linker script */
 Reset_Handler:
   ldr   r0, =_estack
   mov   sp, r0          /* set stack pointer */
+
+/* Enable the CCM RAM clock (RCC->AHB1ENR CCMDATARAMEN, set at reset), the stack may be there */
+  ldr r0, =0x40023830
+  ldr r1, [r0]
+  orr r1, r1, #0x00100000
+  str r1, [r0]
+
 /* Call the clock system initialization function.*/
   bl  SystemInit
 
@@ -77,6 +96,23 @@ LoopCopyDataInit:
   cmp r4, r1
   bcc CopyDataInit
 
+/* Copy the RAM functions from flash to SRAM */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  movs r3, #0
+  b LoopCopyRamFunc
+
+CopyRamFunc:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyRamFunc:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyRamFunc
+
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
   ldr r4, =_ebss
@@ -91,6 +127,37 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Copy the CCM data segment initializers from flash to CCM RAM */
+  ldr r0, =_sccmram
+  ldr r1, =_eccmram
+  ldr r2, =_siccmram
+  movs r3, #0
+  b LoopCopyCcmDataInit
+
+CopyCcmDataInit:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyCcmDataInit:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyCcmDataInit
+
+/* Zero fill the CCM bss segment. */
+  ldr r2, =_sccmbss
+  ldr r4, =_eccmbss
+  movs r3, #0
+  b LoopFillZeroCcmbss
+
+FillZeroCcmbss:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroCcmbss:
+  cmp r2, r4
+  bcc FillZeroCcmbss
+
 /* Call static constructors */
   bl __libc_init_array
 /* Call the application's entry point.*/
@@ -0,0 +1,19 @@
+/**
+ * @file dsp_filter_model.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host build of the dsp_filter DSP (SMLAD/QADD/QSUB/SMMULR) path, with the instructions modelled in C.
+ * 		  Every public symbol gets a "Model" suffix so it links next to the portable C build of the same file.
+ */
+/******************************* Includes *******************************/
+#define LIB_FILTER_DSP_HOST_MODEL
+
+#define LIB_FilterCicInit				LIB_FilterCicInitModel
+#define LIB_FilterCicDecimate_q15		LIB_FilterCicDecimate_q15Model
+#define LIB_FilterMovingAverageInit		LIB_FilterMovingAverageInitModel
+#define LIB_FilterMovingAverage_q15		LIB_FilterMovingAverage_q15Model
+#define LIB_FilterIir_q15				LIB_FilterIir_q15Model
+#define LIB_FilterIir_q31				LIB_FilterIir_q31Model
+
+#include "../../Lib/dsp_filter.c"
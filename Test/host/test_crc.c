@@ -0,0 +1,290 @@
+/**
+ * @file test_crc.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of the MCAL/CRC DMA feed: asynchronous completion, chunking, busy rejection and transfer errors.
+ *
+ * # How ?
+ * 		[♥] crc.c is included with CRC pointing at a RAM register block, the DMA driver is stubbed: the test feeds the
+ * 			stream's source items to a software model of the CRC unit (MSB first words) then raises the stream
+ * 			events the real DMA ISR would, including a transfer error in the middle of a chunk.
+ * 		[♥] The driver hands the DMA 32-bit addresses, on a 64-bit host they're mapped back to the test buffers.
+ *
+ * # Running ?
+ * 		make -C Test/host test
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include "crc.h"
+
+static CRC_t g_TEST_CRC;
+
+#undef CRC
+#define CRC		(&g_TEST_CRC)
+
+#include "../../MCAL/CRC/crc.c"
+
+/*******************************  Macros *******************************/
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define TEST_LONG_WORDS		(70000UL)		/*more than one chunk*/
+#define TEST_NO_ERROR		(0xFFFFFFFFUL)
+
+/******************************* DMA stub *******************************/
+typedef struct{
+	DMA_StreamConfig_t config;
+	uint32_t src_addr;
+	uint16_t count;
+	uint8_t enabled;
+	uint8_t allocated;
+	uint8_t foreign;		/*owned by another driver*/
+	uint32_t starts;
+}TEST_Stream_t;
+
+static TEST_Stream_t g_TEST_STREAM;
+static void* g_TEST_BUFFERS[8];
+static uint32_t g_TEST_BUFFER_SIZES[8];
+static uint8_t g_TEST_BUFFERS_NUM = 0;
+static int failures = 0;
+
+uint8_t DMA_Allocate(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)dma;
+	(void)channel;
+	if((stream != CRC_DMA_STREAM) || g_TEST_STREAM.foreign){
+		return 0;
+	}
+	g_TEST_STREAM.allocated = 1;
+	return 1;
+}
+
+void DMA_Free(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)dma;
+	(void)stream;
+	(void)channel;
+	g_TEST_STREAM.allocated = 0;
+	g_TEST_STREAM.enabled = 0;
+}
+
+void DMA_Configure(DMA_Peripheral_en dma, DMA_Stream_en stream, const DMA_StreamConfig_t* config){
+	(void)dma;
+	(void)stream;
+	g_TEST_STREAM.config = *config;
+}
+
+void DMA_Start(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem_addr, uint16_t count){
+	(void)dma;
+	(void)stream;
+	TEST_CHECK(mem_addr == (uint32_t)(uintptr_t)&g_TEST_CRC.DR);
+	g_TEST_STREAM.src_addr = periph_addr;
+	g_TEST_STREAM.count = count;
+	g_TEST_STREAM.enabled = 1;
+	g_TEST_STREAM.starts++;
+}
+
+void DMA_Stop(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	(void)dma;
+	(void)stream;
+	g_TEST_STREAM.enabled = 0;
+}
+
+void RCC_EnableAHB1Clock(RCC_AHB1PERIPH_en periph){
+	(void)periph;
+}
+
+uint32_t LIB_EnterCritical(void){
+	return 0;
+}
+
+void LIB_ExitCritical(uint32_t primask){
+	(void)primask;
+}
+
+/******************************* CRC unit model *******************************/
+static uint32_t TEST_CrcWord(uint32_t crc, uint32_t word){
+	crc ^= word;
+	for(uint8_t bit = 0; bit < 32; bit++){
+		crc = (crc & 0x80000000UL) ? ((crc << 1) ^ 0x04C11DB7UL) : (crc << 1);
+	}
+	return crc;
+}
+
+static uint32_t TEST_CrcWords(const uint8_t* p, uint32_t words){
+	uint32_t crc = 0xFFFFFFFFUL;
+	for(uint32_t i = 0; i < words; i++, p += 4){
+		crc = TEST_CrcWord(crc, (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+	}
+	return crc;
+}
+
+static void TEST_Register(void* buffer, uint32_t size){
+	g_TEST_BUFFER_SIZES[g_TEST_BUFFERS_NUM] = size;
+	g_TEST_BUFFERS[g_TEST_BUFFERS_NUM++] = buffer;
+}
+
+/*any address inside a registered buffer (the driver moves through the buffer chunk by chunk)*/
+static const uint8_t* TEST_Pointer(uint32_t addr){
+	for(uint8_t i = 0; i < g_TEST_BUFFERS_NUM; i++){
+		uint32_t base = (uint32_t)(uintptr_t)g_TEST_BUFFERS[i];
+		if((addr >= base) && (addr < (base + g_TEST_BUFFER_SIZES[i]))){
+			return (const uint8_t*)g_TEST_BUFFERS[i] + (addr - base);
+		}
+	}
+	TEST_CHECK(!"DMA address of an unknown buffer");
+	return 0;
+}
+
+/**
+ * @brief Runs the stream until the feed ends: each chunk's items are written to the model, then the completion is
+ * 		  raised (or a transfer error after error_after items). Returns the number of chunks run.
+ */
+static uint32_t TEST_RunDma(uint32_t error_after){
+
+	uint32_t chunks = 0;
+	uint32_t items_done = 0;
+
+	while(g_TEST_STREAM.enabled){
+		TEST_Stream_t* s = &g_TEST_STREAM;
+		uint8_t size = (s->config.periph_size == DMA_SIZE_BYTE) ? 1 : 4;
+		const uint8_t* src = TEST_Pointer(s->src_addr);
+		uint32_t bytes = (uint32_t)s->count * size;
+
+		TEST_CHECK(s->config.direction == DMA_DIR_MEM_TO_MEM);
+		TEST_CHECK((bytes & 0x3) == 0);
+		for(uint32_t i = 0; i < (bytes / 4); i++){
+			if(items_done >= error_after){
+				s->enabled = 0;
+				if(!(s->config.interrupts & DMA_IT_ERROR)){
+					//error not reported: the stream stops and the feed never ends
+					return chunks;
+				}
+				s->config.callback(s->config.context, DMA_EVENT_ERROR);
+				return chunks + 1;
+			}
+			const uint8_t* p = &src[i * 4];
+			g_TEST_CRC.DR = TEST_CrcWord(g_TEST_CRC.DR,
+					(uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24));
+			items_done += 4 / size;
+		}
+		s->enabled = 0;
+		chunks++;
+		TEST_CHECK(s->config.interrupts & DMA_IT_COMPLETE);
+		s->config.callback(s->config.context, DMA_EVENT_COMPLETE);
+	}
+
+	return chunks;
+}
+
+static uint8_t g_TEST_STATUS;
+static uint32_t g_TEST_CALLS;
+static uint32_t g_TEST_CRC_AT_CALLBACK;
+
+static void TEST_Done(void* context, uint8_t status){
+	TEST_CHECK(context == (void*)&g_TEST_CALLS);
+	/*the stream is released before the callback*/
+	TEST_CHECK(!g_TEST_STREAM.allocated && CRC_DmaIsIdle());
+	g_TEST_STATUS = status;
+	g_TEST_CRC_AT_CALLBACK = CRC_Read(CRC_INPUT_WORDS);
+	g_TEST_CALLS++;
+}
+
+static void TEST_Begin(void){
+	g_TEST_CRC.DR = 0xFFFFFFFFUL;
+	g_TEST_STREAM.starts = 0;
+	g_TEST_CALLS = 0;
+	g_TEST_STATUS = 0xFF;
+}
+
+/******************************* Tests *******************************/
+static void TEST_Async(void){
+
+	static uint8_t data[4 * 16 + 1];
+	for(uint32_t i = 0; i < sizeof(data); i++){
+		data[i] = (uint8_t)((i * 37) + 11);
+	}
+	TEST_Register(data, sizeof(data));
+
+	/*aligned: word items, returns before any word is fed*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(data, 16, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_CHECK(!CRC_DmaIsIdle() && (g_TEST_CALLS == 0) && (g_TEST_CRC.DR == 0xFFFFFFFFUL));
+	TEST_CHECK(g_TEST_STREAM.config.periph_size == DMA_SIZE_WORD);
+	/*one feed at a time*/
+	TEST_CHECK(CRC_AccumulateDma(data, 4, TEST_Done, &g_TEST_CALLS) == 0);
+	TEST_CHECK(TEST_RunDma(TEST_NO_ERROR) == 1);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK));
+	TEST_CHECK(g_TEST_CRC_AT_CALLBACK == TEST_CrcWords(data, 16));
+
+	/*unaligned: byte items packed into words by the FIFO*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(&data[1], 16, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_CHECK(g_TEST_STREAM.config.periph_size == DMA_SIZE_BYTE);
+	TEST_RunDma(TEST_NO_ERROR);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK));
+	TEST_CHECK(g_TEST_CRC_AT_CALLBACK == TEST_CrcWords(&data[1], 16));
+
+	/*nothing to feed: done at once*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(data, 0, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK) && (g_TEST_STREAM.starts == 0));
+}
+
+static void TEST_Chunks(void){
+
+	static uint8_t data[(TEST_LONG_WORDS * 4) + 4];
+	for(uint32_t i = 0; i < sizeof(data); i++){
+		data[i] = (uint8_t)((i * 2654435761UL) >> 13);
+	}
+	TEST_Register(data, sizeof(data));
+
+	/*65535 words then the rest, chained from the DMA ISR*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(data, TEST_LONG_WORDS, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_CHECK(TEST_RunDma(TEST_NO_ERROR) == 2);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK));
+	TEST_CHECK(g_TEST_CRC_AT_CALLBACK == TEST_CrcWords(data, TEST_LONG_WORDS));
+
+	/*unaligned: NDTR counts bytes, 16383 words per chunk*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(&data[3], TEST_LONG_WORDS, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_CHECK(TEST_RunDma(TEST_NO_ERROR) == ((TEST_LONG_WORDS + CRC_DMA_MAX_WORDS_PACKED - 1) / CRC_DMA_MAX_WORDS_PACKED));
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK));
+	TEST_CHECK(g_TEST_CRC_AT_CALLBACK == TEST_CrcWords(&data[3], TEST_LONG_WORDS));
+}
+
+static void TEST_Errors(void){
+
+	static uint8_t data[4 * 100];
+	TEST_Register(data, sizeof(data));
+
+	/*transfer error in the middle: reported, the stream released*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(data, 100, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_RunDma(10);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_DMA_ERROR));
+	TEST_CHECK(CRC_DmaIsIdle() && !g_TEST_STREAM.allocated);
+
+	/*the next feed is accepted*/
+	TEST_Begin();
+	TEST_CHECK(CRC_AccumulateDma(data, 100, TEST_Done, &g_TEST_CALLS) == 1);
+	TEST_RunDma(TEST_NO_ERROR);
+	TEST_CHECK((g_TEST_CALLS == 1) && (g_TEST_STATUS == CRC_STATUS_OK));
+
+	/*stream owned by another driver: nothing fed, no callback*/
+	TEST_Begin();
+	g_TEST_STREAM.foreign = 1;
+	TEST_CHECK(CRC_AccumulateDma(data, 100, TEST_Done, &g_TEST_CALLS) == 0);
+	TEST_CHECK(CRC_DmaIsIdle() && (g_TEST_CALLS == 0) && (g_TEST_STREAM.starts == 0));
+	g_TEST_STREAM.foreign = 0;
+}
+
+/******************************* main *******************************/
+int main(void){
+
+	TEST_Async();
+	TEST_Chunks();
+	TEST_Errors();
+
+	printf("test_crc: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
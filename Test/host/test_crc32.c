@@ -0,0 +1,215 @@
+/**
+ * @file test_crc32.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of Lib/crc32 (slicing-by-4 path) against bitwise references, and a benchmark of slicing-by-4
+ * 		  vs the bytewise table vs the bitwise loop.
+ *
+ * # Running ?
+ * 		make -C Test/host test			(or "make bench" for the timing only)
+ * 		[♥] The CRC unit (CPU and DMA fed) is timed on the board by APP/CRC_BENCHMARK.c.
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "crc32.h"
+
+/*******************************  Macros *******************************/
+#define TEST_RANDOM_BUFFERS		(20000)
+#define TEST_BENCH_BYTES		(64UL * 1024UL)
+#define TEST_BENCH_RUNS			(200)
+
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+/******************************* privates *******************************/
+static int failures = 0;
+static uint32_t lcg_state = 2026;
+static volatile uint32_t bench_sink = 0;
+static uint32_t g_TEST_TABLE[256];
+
+static uint32_t TEST_Random(void){
+	lcg_state = (lcg_state * 1664525UL) + 1013904223UL;
+	return lcg_state;
+}
+
+static double TEST_Seconds(void){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/*CRC unit order: each little endian word MSB first, i.e. its bytes 3, 2, 1, 0, then the tail bytes in order*/
+static uint32_t TEST_BitwiseByte(uint32_t crc, uint8_t byte){
+	crc ^= (uint32_t)byte << 24;
+	for(uint8_t bit = 0; bit < 8; bit++){
+		crc = (crc & 0x80000000UL) ? ((crc << 1) ^ 0x04C11DB7UL) : (crc << 1);
+	}
+	return crc;
+}
+
+__attribute__((noinline)) static uint32_t TEST_Bitwise(const uint8_t* p, uint32_t len){
+	uint32_t crc = 0xFFFFFFFFUL;
+	for(; len >= 4; len -= 4, p += 4){
+		for(int8_t k = 3; k >= 0; k--){
+			crc = TEST_BitwiseByte(crc, p[k]);
+		}
+	}
+	while(len--){
+		crc = TEST_BitwiseByte(crc, *p++);
+	}
+	return crc;
+}
+
+__attribute__((noinline)) static uint32_t TEST_BitwiseZlib(const uint8_t* p, uint32_t len){
+	uint32_t crc = 0xFFFFFFFFUL;
+	while(len--){
+		crc ^= *p++;
+		for(uint8_t bit = 0; bit < 8; bit++){
+			crc = (crc & 1UL) ? ((crc >> 1) ^ 0xEDB88320UL) : (crc >> 1);
+		}
+	}
+	return crc ^ 0xFFFFFFFFUL;
+}
+
+/*the usual one table, one lookup per byte*/
+__attribute__((noinline)) static uint32_t TEST_Bytewise(const uint8_t* p, uint32_t len){
+	uint32_t crc = 0xFFFFFFFFUL;
+	for(; len >= 4; len -= 4, p += 4){
+		for(int8_t k = 3; k >= 0; k--){
+			crc = (crc << 8) ^ g_TEST_TABLE[(crc >> 24) ^ p[k]];
+		}
+	}
+	while(len--){
+		crc = (crc << 8) ^ g_TEST_TABLE[(crc >> 24) ^ *p++];
+	}
+	return crc;
+}
+
+static void TEST_BuildTable(void){
+	for(uint32_t b = 0; b < 256; b++){
+		g_TEST_TABLE[b] = TEST_BitwiseByte(0, (uint8_t)b);
+	}
+}
+
+static uint32_t g_TEST_ASYNC_CALLS;
+static uint32_t g_TEST_ASYNC_CRC;
+
+static void TEST_AsyncDone(void* context, uint8_t status, uint32_t crc){
+	TEST_CHECK((context == (void*)&g_TEST_ASYNC_CALLS) && (status == LIB_CRC_STATUS_OK));
+	g_TEST_ASYNC_CRC = crc;
+	g_TEST_ASYNC_CALLS++;
+}
+
+/******************************* Tests *******************************/
+static void TEST_KnownValues(void){
+
+	static const uint8_t check[] = "123456789";
+	/*0x12345678 stored little endian: the CRC unit reference value*/
+	static const uint8_t word[] = {0x78, 0x56, 0x34, 0x12};
+
+	TEST_CHECK(LIB_Crc32Zlib(check, 9) == 0xCBF43926UL);
+	TEST_CHECK(LIB_Crc32(word, 4) == 0xDF8A8A2BUL);
+	TEST_CHECK(LIB_Crc32(word, 0) == 0xFFFFFFFFUL);
+	TEST_CHECK(LIB_Crc32Zlib(word, 0) == 0);
+}
+
+static void TEST_RandomBuffers(void){
+
+	static uint8_t buf[512 + 3];
+	for(uint32_t i = 0; i < sizeof(buf); i++){
+		buf[i] = (uint8_t)TEST_Random();
+	}
+
+	/*every length and alignment, the tails included*/
+	for(uint32_t i = 0; i < TEST_RANDOM_BUFFERS; i++){
+		uint32_t offset = TEST_Random() % 4;
+		uint32_t len = TEST_Random() % 513;
+		const uint8_t* p = &buf[offset];
+
+		TEST_CHECK(LIB_Crc32(p, len) == TEST_Bitwise(p, len));
+		TEST_CHECK(LIB_Crc32Zlib(p, len) == TEST_BitwiseZlib(p, len));
+	}
+}
+
+static void TEST_Async(void){
+
+	static uint8_t buf[LIB_CRC_DMA_THRESHOLD + 7];
+	for(uint32_t i = 0; i < sizeof(buf); i++){
+		buf[i] = (uint8_t)TEST_Random();
+	}
+
+	/*host build: done by the CPU, the callback runs before returning*/
+	g_TEST_ASYNC_CALLS = 0;
+	TEST_CHECK(LIB_Crc32Async(&buf[1], sizeof(buf) - 1, TEST_AsyncDone, &g_TEST_ASYNC_CALLS) == 1);
+	TEST_CHECK((g_TEST_ASYNC_CALLS == 1) && (g_TEST_ASYNC_CRC == TEST_Bitwise(&buf[1], sizeof(buf) - 1)));
+	TEST_CHECK(LIB_Crc32Async(buf, 5, TEST_AsyncDone, &g_TEST_ASYNC_CALLS) == 1);
+	TEST_CHECK((g_TEST_ASYNC_CALLS == 2) && (g_TEST_ASYNC_CRC == TEST_Bitwise(buf, 5)));
+}
+
+/******************************* Benchmark *******************************/
+static void TEST_Benchmark(void){
+
+	static uint8_t buf[TEST_BENCH_BYTES];
+	for(uint32_t i = 0; i < TEST_BENCH_BYTES; i++){
+		buf[i] = (uint8_t)TEST_Random();
+	}
+	double mb = (double)TEST_BENCH_BYTES * TEST_BENCH_RUNS / 1e6;
+
+	/*tables built outside of the timing*/
+	bench_sink += LIB_Crc32(buf, 4);
+
+	double start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_RUNS; i++){
+		bench_sink += LIB_Crc32(buf, TEST_BENCH_BYTES);
+	}
+	double slice = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_RUNS; i++){
+		bench_sink += TEST_Bytewise(buf, TEST_BENCH_BYTES);
+	}
+	double bytewise = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < (TEST_BENCH_RUNS / 10); i++){
+		bench_sink += TEST_Bitwise(buf, TEST_BENCH_BYTES);
+	}
+	double bitwise = (TEST_Seconds() - start) * 10;
+
+	printf("crc32   slicing-by-4 %.0f MB/s   bytewise table %.0f MB/s   bitwise %.0f MB/s\n",
+			mb / slice, mb / bytewise, mb / bitwise);
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_RUNS; i++){
+		bench_sink += LIB_Crc32Zlib(buf, TEST_BENCH_BYTES);
+	}
+	slice = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < (TEST_BENCH_RUNS / 10); i++){
+		bench_sink += TEST_BitwiseZlib(buf, TEST_BENCH_BYTES);
+	}
+	bitwise = (TEST_Seconds() - start) * 10;
+
+	printf("zlib    slicing-by-4 %.0f MB/s   bitwise %.0f MB/s\n", mb / slice, mb / bitwise);
+}
+
+/******************************* main *******************************/
+int main(int argc, char** argv){
+
+	TEST_BuildTable();
+
+	if((argc > 1) && (strcmp(argv[1], "bench") == 0)){
+		TEST_Benchmark();
+		return 0;
+	}
+
+	TEST_KnownValues();
+	TEST_RandomBuffers();
+	TEST_Async();
+
+	printf("test_crc32: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
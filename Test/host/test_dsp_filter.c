@@ -0,0 +1,259 @@
+/**
+ * @file test_dsp_filter.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of Lib/dsp_filter: the DSP path (instructions modelled in C) against the portable C path,
+ * 		  both checked against hand computed vectors, plus a cycle benchmark of the two paths.
+ *
+ * # Running ?
+ * 		make -C Test/host test			(or "make bench" for the timing only)
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "dsp_filter.h"
+
+/*******************************  Macros *******************************/
+#define TEST_BLOCK_LEN		(1024)
+#define TEST_BENCH_ROUNDS	(2000)
+
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+/******************************* privates *******************************/
+/*DSP path, see dsp_filter_model.c*/
+void LIB_FilterCicInitModel(LIB_CicFilter_t* filter, uint8_t order, uint8_t log2_factor);
+uint32_t LIB_FilterCicDecimate_q15Model(LIB_CicFilter_t* filter, LIB_q15_t* buf, uint32_t len);
+void LIB_FilterMovingAverageInitModel(LIB_MovingAverage_t* filter, LIB_q15_t* history, uint8_t log2_length);
+void LIB_FilterMovingAverage_q15Model(LIB_MovingAverage_t* filter, LIB_q15_t* buf, uint32_t len);
+void LIB_FilterIir_q15Model(LIB_IirQ15_t* filter, LIB_q15_t* buf, uint32_t len);
+void LIB_FilterIir_q31Model(LIB_IirQ31_t* filter, LIB_q31_t* buf, uint32_t len);
+
+static int failures = 0;
+static uint32_t lcg_state = 12345;
+
+/*deterministic full-scale noise so the vectors are reproducible on every host*/
+static int32_t TEST_Random(void){
+	lcg_state = (lcg_state * 1664525UL) + 1013904223UL;
+	return (int32_t)lcg_state;
+}
+
+static void TEST_FillQ15(LIB_q15_t* buf, uint32_t len){
+	for(uint32_t i = 0; i < len; i++){
+		buf[i] = (LIB_q15_t)(TEST_Random() >> 16);
+	}
+}
+
+static void TEST_FillQ31(LIB_q31_t* buf, uint32_t len){
+	for(uint32_t i = 0; i < len; i++){
+		buf[i] = TEST_Random();
+	}
+	/*hit both saturation corners*/
+	buf[0] = INT32_MAX;
+	buf[1] = INT32_MIN;
+	buf[2] = INT32_MAX;
+}
+
+static double TEST_Seconds(void){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/******************************* Known vectors *******************************/
+static void TEST_KnownVectors(void){
+
+	/*Boxcar R = 4: (1+2+3+4)/4 = 2.5 -> 3, (5+6+7+8)/4 = 6.5 -> 7, -(1+2+3+4)/4 = -2.5 -> -2 (half up)*/
+	{
+		LIB_q15_t in[12] = {1, 2, 3, 4, 5, 6, 7, 8, -1, -2, -3, -4};
+		LIB_q15_t expected[3] = {3, 7, -2};
+		LIB_CicFilter_t c, d;
+		LIB_q15_t a[12], b[12];
+		memcpy(a, in, sizeof(in));
+		memcpy(b, in, sizeof(in));
+		LIB_FilterCicInit(&c, 1, 2);
+		LIB_FilterCicInitModel(&d, 1, 2);
+		TEST_CHECK(LIB_FilterCicDecimate_q15(&c, a, 12) == 3);
+		TEST_CHECK(LIB_FilterCicDecimate_q15Model(&d, b, 12) == 3);
+		TEST_CHECK(memcmp(a, expected, sizeof(expected)) == 0);
+		TEST_CHECK(memcmp(b, expected, sizeof(expected)) == 0);
+	}
+
+	/*CIC order 2, R = 2 is the [1 2 1] / 4 kernel, a step of 100 gives (100*2 + 100) / 4 = 75 then 100*/
+	{
+		LIB_q15_t in[6] = {100, 100, 100, 100, 100, 100};
+		LIB_q15_t expected[3] = {75, 100, 100};
+		LIB_CicFilter_t c, d;
+		LIB_q15_t a[6], b[6];
+		memcpy(a, in, sizeof(in));
+		memcpy(b, in, sizeof(in));
+		LIB_FilterCicInit(&c, 2, 1);
+		LIB_FilterCicInitModel(&d, 2, 1);
+		TEST_CHECK(LIB_FilterCicDecimate_q15(&c, a, 6) == 3);
+		TEST_CHECK(LIB_FilterCicDecimate_q15Model(&d, b, 6) == 3);
+		TEST_CHECK(memcmp(a, expected, sizeof(expected)) == 0);
+		TEST_CHECK(memcmp(b, expected, sizeof(expected)) == 0);
+	}
+
+	/*Moving average of 4: running sums 4, 12, 24, 40, 52 -> /4*/
+	{
+		LIB_q15_t in[5] = {4, 8, 12, 16, 16};
+		LIB_q15_t expected[5] = {1, 3, 6, 10, 13};
+		LIB_q15_t h1[4], h2[4];
+		LIB_MovingAverage_t c, d;
+		LIB_FilterMovingAverageInit(&c, h1, 2);
+		LIB_FilterMovingAverageInitModel(&d, h2, 2);
+		LIB_q15_t a[5], b[5];
+		memcpy(a, in, sizeof(in));
+		memcpy(b, in, sizeof(in));
+		LIB_FilterMovingAverage_q15(&c, a, 5);
+		LIB_FilterMovingAverage_q15Model(&d, b, 5);
+		TEST_CHECK(memcmp(a, expected, sizeof(expected)) == 0);
+		TEST_CHECK(memcmp(b, expected, sizeof(expected)) == 0);
+	}
+
+	/*IIR Q15 alpha = 0.5: y = 0 -> 5000 -> 7500 -> 8750*/
+	{
+		LIB_q15_t expected[3] = {5000, 7500, 8750};
+		LIB_IirQ15_t c = {.alpha = 0x4000, .state = 0}, d = c;
+		LIB_q15_t a[3] = {10000, 10000, 10000}, b[3] = {10000, 10000, 10000};
+		LIB_FilterIir_q15(&c, a, 3);
+		LIB_FilterIir_q15Model(&d, b, 3);
+		TEST_CHECK(memcmp(a, expected, sizeof(expected)) == 0);
+		TEST_CHECK(memcmp(b, expected, sizeof(expected)) == 0);
+	}
+
+	/*IIR Q31 alpha = 0.5 from INT32_MIN to INT32_MAX: the error saturates at INT32_MAX, so each step moves 2^30*/
+	{
+		LIB_q31_t expected[2] = {-0x40000000, 0};
+		LIB_IirQ31_t c = {.alpha = 0x40000000, .state = INT32_MIN}, d = c;
+		LIB_q31_t a[2] = {INT32_MAX, INT32_MAX}, b[2] = {INT32_MAX, INT32_MAX};
+		LIB_FilterIir_q31(&c, a, 2);
+		LIB_FilterIir_q31Model(&d, b, 2);
+		TEST_CHECK(memcmp(a, expected, sizeof(expected)) == 0);
+		TEST_CHECK(memcmp(b, expected, sizeof(expected)) == 0);
+	}
+}
+
+/******************************* DSP vs C path *******************************/
+static void TEST_PathsMatch(void){
+
+	/*odd lengths and a misaligned start exercise the SMLAD tail and the unaligned fallback*/
+	static const uint32_t lengths[] = {TEST_BLOCK_LEN, 1023, 17, 3};
+
+	for(uint8_t order = 1; order <= LIB_FILTER_CIC_MAX_ORDER; order++){
+		for(uint8_t log2_factor = 0; log2_factor <= 5; log2_factor++){
+			LIB_CicFilter_t c, d;
+			LIB_FilterCicInit(&c, order, log2_factor);
+			LIB_FilterCicInitModel(&d, order, log2_factor);
+			for(uint32_t k = 0; k < (sizeof(lengths) / sizeof(lengths[0])); k++){
+				LIB_q15_t a[TEST_BLOCK_LEN + 1], b[TEST_BLOCK_LEN + 1];
+				uint32_t offset = k & 1U;
+				TEST_FillQ15(&a[offset], lengths[k]);
+				memcpy(&b[offset], &a[offset], lengths[k] * sizeof(LIB_q15_t));
+				uint32_t n1 = LIB_FilterCicDecimate_q15(&c, &a[offset], lengths[k]);
+				uint32_t n2 = LIB_FilterCicDecimate_q15Model(&d, &b[offset], lengths[k]);
+				TEST_CHECK(n1 == n2);
+				TEST_CHECK(memcmp(&a[offset], &b[offset], n1 * sizeof(LIB_q15_t)) == 0);
+			}
+		}
+	}
+
+	{
+		static LIB_q15_t h1[1UL << 6], h2[1UL << 6];
+		LIB_MovingAverage_t c, d;
+		LIB_FilterMovingAverageInit(&c, h1, 6);
+		LIB_FilterMovingAverageInitModel(&d, h2, 6);
+		for(uint32_t k = 0; k < (sizeof(lengths) / sizeof(lengths[0])); k++){
+			LIB_q15_t a[TEST_BLOCK_LEN], b[TEST_BLOCK_LEN];
+			TEST_FillQ15(a, lengths[k]);
+			memcpy(b, a, lengths[k] * sizeof(LIB_q15_t));
+			LIB_FilterMovingAverage_q15(&c, a, lengths[k]);
+			LIB_FilterMovingAverage_q15Model(&d, b, lengths[k]);
+			TEST_CHECK(memcmp(a, b, lengths[k] * sizeof(LIB_q15_t)) == 0);
+		}
+	}
+
+	{
+		LIB_IirQ15_t c = {.alpha = 0x0CCD, .state = 0}, d = c;
+		LIB_q15_t a[TEST_BLOCK_LEN], b[TEST_BLOCK_LEN];
+		TEST_FillQ15(a, TEST_BLOCK_LEN);
+		memcpy(b, a, sizeof(a));
+		LIB_FilterIir_q15(&c, a, TEST_BLOCK_LEN);
+		LIB_FilterIir_q15Model(&d, b, TEST_BLOCK_LEN);
+		TEST_CHECK(memcmp(a, b, sizeof(a)) == 0);
+	}
+
+	for(uint32_t k = 0; k < 4; k++){
+		/*alpha up to 1.0 and full scale steps push QADD/QSUB into saturation*/
+		LIB_IirQ31_t c = {.alpha = (k == 3) ? INT32_MAX : TEST_Random() & INT32_MAX, .state = INT32_MIN}, d = c;
+		LIB_q31_t a[TEST_BLOCK_LEN], b[TEST_BLOCK_LEN];
+		TEST_FillQ31(a, TEST_BLOCK_LEN);
+		memcpy(b, a, sizeof(a));
+		LIB_FilterIir_q31(&c, a, TEST_BLOCK_LEN);
+		LIB_FilterIir_q31Model(&d, b, TEST_BLOCK_LEN);
+		TEST_CHECK(memcmp(a, b, sizeof(a)) == 0);
+	}
+}
+
+/******************************* Benchmark *******************************/
+/**
+ * @brief ns per sample of both paths on the host. The model path only shows the algorithmic cost of the
+ * 		  packed loop, the real SMLAD/QADD gain is measured on target (one instruction per pair/saturation).
+ */
+static void TEST_Benchmark(void){
+
+	static LIB_q15_t source[TEST_BLOCK_LEN], work[TEST_BLOCK_LEN];
+	static LIB_q31_t source31[TEST_BLOCK_LEN], work31[TEST_BLOCK_LEN];
+	TEST_FillQ15(source, TEST_BLOCK_LEN);
+	TEST_FillQ31(source31, TEST_BLOCK_LEN);
+	double samples = (double)TEST_BLOCK_LEN * TEST_BENCH_ROUNDS;
+
+	LIB_CicFilter_t cic;
+	double start = TEST_Seconds();
+	LIB_FilterCicInit(&cic, 1, 4);
+	for(uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++){
+		memcpy(work, source, sizeof(work));
+		LIB_FilterCicDecimate_q15(&cic, work, TEST_BLOCK_LEN);
+	}
+	double c_path = TEST_Seconds() - start;
+	start = TEST_Seconds();
+	LIB_FilterCicInitModel(&cic, 1, 4);
+	for(uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++){
+		memcpy(work, source, sizeof(work));
+		LIB_FilterCicDecimate_q15Model(&cic, work, TEST_BLOCK_LEN);
+	}
+	double dsp_path = TEST_Seconds() - start;
+	printf("boxcar R=16   C %.2f ns/sample   DSP model %.2f ns/sample\n", c_path * 1e9 / samples, dsp_path * 1e9 / samples);
+
+	LIB_IirQ31_t iir = {.alpha = 0x0CCCCCCD, .state = 0};
+	start = TEST_Seconds();
+	for(uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++){
+		memcpy(work31, source31, sizeof(work31));
+		LIB_FilterIir_q31(&iir, work31, TEST_BLOCK_LEN);
+	}
+	c_path = TEST_Seconds() - start;
+	start = TEST_Seconds();
+	for(uint32_t r = 0; r < TEST_BENCH_ROUNDS; r++){
+		memcpy(work31, source31, sizeof(work31));
+		LIB_FilterIir_q31Model(&iir, work31, TEST_BLOCK_LEN);
+	}
+	dsp_path = TEST_Seconds() - start;
+	printf("IIR Q31       C %.2f ns/sample   DSP model %.2f ns/sample\n", c_path * 1e9 / samples, dsp_path * 1e9 / samples);
+}
+
+/******************************* main *******************************/
+int main(int argc, char** argv){
+
+	if((argc > 1) && (strcmp(argv[1], "bench") == 0)){
+		TEST_Benchmark();
+		return 0;
+	}
+
+	TEST_KnownVectors();
+	TEST_PathsMatch();
+
+	printf("test_dsp_filter: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,366 @@
+/**
+ * @file test_kernel.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of OS/KERNEL scheduling decisions: KERNEL_PickNext() (priorities, round robin), the mutex
+ * 		  priority inheritance (KERNEL_MutexLock()/KERNEL_MutexUnlock(), owner chains) and the timeout wake-ups of
+ * 		  SysTick_Handler(), and the KERNEL_ReportStats() output.
+ *
+ * # How ?
+ * 		[♥] kernel.c is included with SCB/FPU/SysTick pointing at RAM register blocks, the port (PendSV/SVC assembly)
+ * 			is left out of the host build, so no thread code ever runs: the test plays every thread itself, calling
+ * 			the kernel as the thread g_KERNEL_CURRENT.
+ * 		[♥] The NVIC stub keeps the BASEPRI level, a PendSV pended by the kernel is taken when the outermost
+ * 			KERNEL_Unlock() restores it (as on the target) and runs KERNEL_SwitchContext().
+ * 		[♥] A blocking call returns at once on the host, its result is read from the thread's wait_result once the
+ * 			thread is woken up.
+ *
+ * # Running ?
+ * 		make -C Test/host test
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include "kernel.h"
+
+static SCB_t g_TEST_SCB;
+static FPU_t g_TEST_FPU;
+static SysTick_t g_TEST_SYSTICK;
+
+#undef SCB
+#undef FPU
+#undef SysTick
+#define SCB			(&g_TEST_SCB)
+#define FPU			(&g_TEST_FPU)
+#define SysTick		(&g_TEST_SYSTICK)
+
+#include "../../OS/KERNEL/kernel.c"
+
+/*******************************  Macros *******************************/
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define TEST_REPORT_SIZE	(1024)
+
+/******************************* Stubs *******************************/
+static int failures = 0;
+static uint32_t g_TEST_BASEPRI = 0;
+static uint8_t g_TEST_PENDSV = 0;
+static uint32_t g_TEST_CYCLES = 0;
+static char g_TEST_REPORT[TEST_REPORT_SIZE];
+static uint32_t g_TEST_REPORT_LEN = 0;
+
+uint32_t NVIC_EnterCritical(uint8_t priority){
+	uint32_t previous = g_TEST_BASEPRI;
+	if((previous == 0) || (priority < previous)){
+		g_TEST_BASEPRI = priority;
+	}
+	return previous;
+}
+
+/*PendSV has the lowest priority: taken once nothing masks it anymore*/
+void NVIC_ExitCritical(uint32_t basepri){
+	g_TEST_BASEPRI = basepri;
+	if((g_TEST_BASEPRI == 0) && g_TEST_PENDSV){
+		g_TEST_PENDSV = 0;
+		KERNEL_SwitchContext();
+	}
+}
+
+void NVIC_SetPending(int16_t irq){
+	TEST_CHECK(irq == NVIC_IRQ_PENDSV);
+	/*the kernel pends the switch from its critical sections only*/
+	TEST_CHECK(g_TEST_BASEPRI == KERNEL_MAX_SYSCALL_PRIORITY);
+	g_TEST_PENDSV = 1;
+}
+
+void NVIC_SetPriority(int16_t irq, uint8_t priority){
+	(void)irq;
+	(void)priority;
+}
+
+void LIB_CycleCounterEnable(void){
+	g_TEST_CYCLES = 0;
+}
+
+uint32_t LIB_CycleCounterRead(void){
+	g_TEST_CYCLES += 100;
+	return g_TEST_CYCLES;
+}
+
+void PWR_EnterSleep(void){
+}
+
+void USART_SendChar(USART_Peripheral_en usart, uint8_t ch){
+	TEST_CHECK(usart == USART_DEBUGGING_CHANNEL);
+	if(g_TEST_REPORT_LEN < (TEST_REPORT_SIZE - 1)){
+		g_TEST_REPORT[g_TEST_REPORT_LEN++] = (char)ch;
+		g_TEST_REPORT[g_TEST_REPORT_LEN] = '\0';
+	}
+}
+
+/******************************* Helpers *******************************/
+static KERNEL_Thread_t g_TEST_THREADS[4];
+static uint32_t g_TEST_STACKS[4][KERNEL_MIN_STACK_WORDS] __attribute__((aligned(8)));
+
+static void TEST_Entry(void* arg){
+	(void)arg;
+}
+
+/*KERNEL_Init() then the creation of the threads and the first selection of KERNEL_Start()*/
+static void TEST_Start(const uint8_t* priorities, uint8_t count){
+
+	static const char* names[] = {"t0", "t1", "t2", "t3"};
+
+	g_KERNEL_RUNNING = 0;
+	g_KERNEL_ROTATE = 0;
+	g_KERNEL_SWITCH_PENDING = 0;
+	g_TEST_PENDSV = 0;
+	KERNEL_Init();
+
+	for(uint8_t i = 0; i < count; i++){
+		TEST_CHECK(KERNEL_ThreadCreate(&g_TEST_THREADS[i], names[i], TEST_Entry, 0, priorities[i],
+				g_TEST_STACKS[i], KERNEL_MIN_STACK_WORDS) == 1);
+	}
+	TEST_CHECK(g_TEST_PENDSV == 0);
+
+	g_KERNEL_CURRENT = KERNEL_PickNext();
+	g_KERNEL_CURRENT->switches++;
+	g_KERNEL_RUN_START = LIB_CycleCounterRead();
+	g_KERNEL_RUNNING = 1;
+}
+
+static void TEST_Ticks(uint32_t ticks){
+	while(ticks--){
+		SysTick_Handler();
+	}
+}
+
+/******************************* Tests *******************************/
+static void TEST_PickNext(void){
+
+	static const uint8_t priorities[] = {2, 1, 2};
+	KERNEL_Thread_t* a = &g_TEST_THREADS[0];
+	KERNEL_Thread_t* b = &g_TEST_THREADS[1];
+	KERNEL_Thread_t* c = &g_TEST_THREADS[2];
+	KERNEL_Thread_t* d = &g_TEST_THREADS[3];
+
+	TEST_Start(priorities, 3);
+	TEST_CHECK(g_KERNEL_CURRENT == b);
+
+	//b blocks: the first priority 2 thread after b in the table runs
+	KERNEL_Sleep(5);
+	TEST_CHECK((b->state == KERNEL_STATE_BLOCKED) && (g_KERNEL_CURRENT == c));
+
+	//same priority: the current thread keeps the CPU until it yields
+	g_KERNEL_ROTATE = 0;
+	TEST_CHECK(KERNEL_PickNext() == c);
+	KERNEL_Yield();
+	TEST_CHECK(g_KERNEL_CURRENT == a);
+
+	//time slice: round robin at each tick, then b's sleep ends and it preempts
+	TEST_Ticks(1);
+	TEST_CHECK(g_KERNEL_CURRENT == c);
+	TEST_Ticks(1);
+	TEST_CHECK(g_KERNEL_CURRENT == a);
+	TEST_Ticks(2);
+	TEST_CHECK((g_KERNEL_CURRENT == a) && (b->state == KERNEL_STATE_BLOCKED));
+	TEST_Ticks(1);
+	TEST_CHECK((g_KERNEL_CURRENT == b) && (b->state == KERNEL_STATE_READY) && (b->wait_result == 0));
+
+	//alone at its priority: no rotation request
+	TEST_Ticks(1);
+	TEST_CHECK((g_KERNEL_CURRENT == b) && (g_TEST_PENDSV == 0));
+
+	//a new thread preempts only if more urgent
+	TEST_CHECK(KERNEL_ThreadCreate(d, "t3", TEST_Entry, 0, 1, g_TEST_STACKS[3], KERNEL_MIN_STACK_WORDS) == 1);
+	TEST_CHECK(g_KERNEL_CURRENT == b);
+	KERNEL_Sleep(KERNEL_WAIT_FOREVER);
+	TEST_CHECK(g_KERNEL_CURRENT == d);
+
+	//nothing ready: idle
+	KERNEL_Sleep(KERNEL_WAIT_FOREVER);
+	TEST_CHECK((g_KERNEL_CURRENT == a) || (g_KERNEL_CURRENT == c));
+	KERNEL_Sleep(KERNEL_WAIT_FOREVER);
+	KERNEL_Sleep(KERNEL_WAIT_FOREVER);
+	TEST_CHECK(g_KERNEL_CURRENT == &g_KERNEL_IDLE_THREAD);
+	TEST_Ticks(100);
+	TEST_CHECK(g_KERNEL_CURRENT == &g_KERNEL_IDLE_THREAD);
+
+	//wrong priority, too small stack
+	TEST_CHECK(KERNEL_ThreadCreate(d, "t3", TEST_Entry, 0, KERNEL_IDLE_PRIORITY, g_TEST_STACKS[3],
+			KERNEL_MIN_STACK_WORDS) == 0);
+	TEST_CHECK(KERNEL_ThreadCreate(d, "t3", TEST_Entry, 0, 1, g_TEST_STACKS[3], KERNEL_MIN_STACK_WORDS - 1) == 0);
+}
+
+static void TEST_MutexInheritance(void){
+
+	static const uint8_t priorities[] = {5, 3, 1};
+	KERNEL_Thread_t* low = &g_TEST_THREADS[0];
+	KERNEL_Thread_t* mid = &g_TEST_THREADS[1];
+	KERNEL_Thread_t* high = &g_TEST_THREADS[2];
+	KERNEL_Mutex_t mutex;
+
+	TEST_Start(priorities, 3);
+	KERNEL_MutexInit(&mutex);
+
+	KERNEL_Sleep(10);
+	TEST_CHECK(g_KERNEL_CURRENT == mid);
+	KERNEL_Sleep(10);
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+	TEST_CHECK((KERNEL_MutexLock(&mutex, KERNEL_WAIT_FOREVER) == 1) && (mutex.owner == low));
+	TEST_CHECK(KERNEL_MutexLock(&mutex, KERNEL_WAIT_FOREVER) == 0);
+
+	TEST_Ticks(10);
+	TEST_CHECK(g_KERNEL_CURRENT == high);
+
+	//high waits for low: low inherits its priority and runs before mid
+	KERNEL_MutexLock(&mutex, KERNEL_WAIT_FOREVER);
+	TEST_CHECK((high->state == KERNEL_STATE_BLOCKED) && (low->priority == 1) && (low->base_priority == 5));
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+	TEST_Ticks(3);
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+
+	//unlock: handed over to high, low back to its own priority
+	KERNEL_MutexUnlock(&mutex);
+	TEST_CHECK((mutex.owner == high) && (high->state == KERNEL_STATE_READY) && (high->wait_result == 1));
+	TEST_CHECK((low->priority == 5) && (g_KERNEL_CURRENT == high));
+
+	//not the owner: ignored
+	KERNEL_Sleep(KERNEL_WAIT_FOREVER);
+	TEST_CHECK(g_KERNEL_CURRENT == mid);
+	KERNEL_MutexUnlock(&mutex);
+	TEST_CHECK(mutex.owner == high);
+}
+
+static void TEST_MutexChain(void){
+
+	static const uint8_t priorities[] = {5, 3, 1};
+	KERNEL_Thread_t* low = &g_TEST_THREADS[0];
+	KERNEL_Thread_t* mid = &g_TEST_THREADS[1];
+	KERNEL_Thread_t* high = &g_TEST_THREADS[2];
+	KERNEL_Mutex_t first;
+	KERNEL_Mutex_t second;
+
+	TEST_Start(priorities, 3);
+	KERNEL_MutexInit(&first);
+	KERNEL_MutexInit(&second);
+
+	KERNEL_Sleep(20);
+	TEST_CHECK(KERNEL_MutexLock(&second, KERNEL_WAIT_FOREVER) == 1);
+	KERNEL_Sleep(10);
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+	TEST_CHECK(KERNEL_MutexLock(&first, KERNEL_WAIT_FOREVER) == 1);
+
+	//mid (owning second) waits for first (owned by low)
+	TEST_Ticks(10);
+	TEST_CHECK(g_KERNEL_CURRENT == mid);
+	KERNEL_MutexLock(&first, KERNEL_WAIT_FOREVER);
+	TEST_CHECK((g_KERNEL_CURRENT == low) && (low->priority == 3));
+
+	//high waits for second: inherited along the chain mid -> low
+	TEST_Ticks(10);
+	TEST_CHECK(g_KERNEL_CURRENT == high);
+	KERNEL_MutexLock(&second, KERNEL_WAIT_FOREVER);
+	TEST_CHECK((mid->priority == 1) && (low->priority == 1) && (g_KERNEL_CURRENT == low));
+
+	//first to mid, which keeps high's priority while owning second
+	KERNEL_MutexUnlock(&first);
+	TEST_CHECK((first.owner == mid) && (mid->wait_result == 1) && (mid->priority == 1));
+	TEST_CHECK((low->priority == 5) && (g_KERNEL_CURRENT == mid));
+
+	KERNEL_MutexUnlock(&second);
+	TEST_CHECK((second.owner == high) && (high->wait_result == 1) && (mid->priority == 3));
+	TEST_CHECK(g_KERNEL_CURRENT == high);
+}
+
+static void TEST_Timeouts(void){
+
+	static const uint8_t priorities[] = {5, 1};
+	KERNEL_Thread_t* low = &g_TEST_THREADS[0];
+	KERNEL_Thread_t* high = &g_TEST_THREADS[1];
+	KERNEL_Mutex_t mutex;
+	KERNEL_Sem_t sem;
+
+	TEST_Start(priorities, 2);
+	KERNEL_MutexInit(&mutex);
+	KERNEL_SemInit(&sem, 0, 1);
+
+	//semaphore: no wait, then a timeout
+	TEST_CHECK(KERNEL_SemTake(&sem, 0) == 0);
+	TEST_CHECK(g_KERNEL_CURRENT == high);
+	KERNEL_SemTake(&sem, 4);
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+	TEST_Ticks(3);
+	TEST_CHECK(high->state == KERNEL_STATE_BLOCKED);
+	TEST_Ticks(1);
+	TEST_CHECK((high->state == KERNEL_STATE_READY) && (high->wait_result == 0) && (g_KERNEL_CURRENT == high));
+	TEST_CHECK(sem.count == 0);
+
+	//given before the timeout: handed over, the count stays 0
+	KERNEL_SemTake(&sem, 4);
+	TEST_Ticks(2);
+	KERNEL_SemGive(&sem);
+	TEST_CHECK((high->wait_result == 1) && (high->timed == 0) && (sem.count == 0) && (g_KERNEL_CURRENT == high));
+	TEST_Ticks(10);
+	TEST_CHECK(high->wait_result == 1);
+	KERNEL_SemGive(&sem);
+	KERNEL_SemGive(&sem);
+	TEST_CHECK(sem.count == 1);
+	TEST_CHECK(KERNEL_SemTake(&sem, 0) == 1);
+
+	//mutex timeout: the owner loses the inherited priority
+	KERNEL_Sleep(1);
+	TEST_CHECK(g_KERNEL_CURRENT == low);
+	TEST_CHECK(KERNEL_MutexLock(&mutex, 0) == 1);
+	TEST_Ticks(1);
+	TEST_CHECK(g_KERNEL_CURRENT == high);
+	TEST_CHECK(KERNEL_MutexLock(&mutex, 0) == 0);
+	KERNEL_MutexLock(&mutex, 3);
+	TEST_CHECK((low->priority == 1) && (g_KERNEL_CURRENT == low));
+	TEST_Ticks(2);
+	TEST_CHECK((high->state == KERNEL_STATE_BLOCKED) && (low->priority == 1));
+	TEST_Ticks(1);
+	TEST_CHECK((high->state == KERNEL_STATE_READY) && (high->wait_result == 0));
+	TEST_CHECK((low->priority == 5) && (mutex.owner == low) && (g_KERNEL_CURRENT == high));
+
+	//deadline across the tick counter wrap
+	g_KERNEL_TICKS = 0xFFFFFFFEUL;
+	KERNEL_Sleep(3);
+	TEST_Ticks(2);
+	TEST_CHECK((g_KERNEL_TICKS == 0) && (high->state == KERNEL_STATE_BLOCKED));
+	TEST_Ticks(1);
+	TEST_CHECK((high->state == KERNEL_STATE_READY) && (g_KERNEL_CURRENT == high));
+}
+
+static void TEST_ReportStats(void){
+
+	static const uint8_t priorities[] = {4, 2};
+	static const char first_line[] = "switches: 2, latency (cycles) last: 100, max: 100, avg: 100\n\r";
+
+	TEST_Start(priorities, 2);
+	KERNEL_Sleep(2);
+	TEST_Ticks(2);
+
+	g_TEST_REPORT_LEN = 0;
+	KERNEL_ReportStats();
+
+	TEST_CHECK(strncmp(g_TEST_REPORT, first_line, sizeof(first_line) - 1) == 0);
+	TEST_CHECK(strstr(g_TEST_REPORT, "\n\rrun: 2 ms, sleep: 0 ms (0), stop: 0 ms (0)\n\r") != 0);
+	TEST_CHECK(strstr(g_TEST_REPORT, "\n\ridle: prio 31, switches 0, run 0 Kcycles, stack 17/64 words\n\r") != 0);
+	TEST_CHECK(strstr(g_TEST_REPORT, "\n\rt1: prio 2, switches 2, run 0 Kcycles, stack 17/64 words\n\r") != 0);
+	TEST_CHECK(strstr(g_TEST_REPORT, "\n\rt0: prio 4, switches 1, ") != 0);
+}
+
+/******************************* main *******************************/
+int main(void){
+
+	TEST_PickNext();
+	TEST_MutexInheritance();
+	TEST_MutexChain();
+	TEST_Timeouts();
+	TEST_ReportStats();
+
+	printf("test_kernel: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,520 @@
+/**
+ * @file test_lcd.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of HAL/LCD (LCD_ASYNC_MODE) against a simulated HD44780.
+ *
+ * # How ?
+ * 		[♥] GPIO/TIM/RCC are stubbed: the GPIO stub forwards every pin change to a model of the HD44780 bus
+ * 			interface (E falling edge latches, RW = 1 reads BF & AC) and the one-shot timer stub advances a
+ * 			simulated clock by the armed period before calling the driver's update callback.
+ * 		[♥] The model keeps the instruction execution times (37 uS / 1.52 mS at 270 KHz, scaled for slow clones),
+ * 			any byte latched while the controller is busy or before the power-on time is a timing violation.
+ *
+ * # Running ?
+ * 		make -C Test/host test
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include "lcd.h"
+#include "num_format.h"
+
+/*******************************  Macros *******************************/
+#define SIM_DISPLAYS			LCD_MAX_DISPLAYS
+#define SIM_EXEC_TIME_US		(37)
+#define SIM_EXEC_TIME_LONG_US	(1520)
+#define SIM_POWER_ON_US			(40000)
+
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+/******************************* Simulated HD44780 *******************************/
+typedef struct{
+	/*wiring*/
+	GPIO_t* data_gpio;
+	GPIO_t* control_gpio;
+	uint8_t data_pins[8];
+	uint8_t rs, rw, e;
+	uint8_t wired_d0_d3;		/*0: 4-bit wiring, D0-D3 read as 0 by the controller*/
+	uint8_t present;			/*0: display missing, the pulled up bus reads 0xFF*/
+	uint32_t exec_scale_pct;	/*100: 270 KHz oscillator, more for slower clones*/
+
+	/*bus levels*/
+	uint8_t level_rs, level_rw, level_e;
+	uint8_t level_data;
+	uint8_t data_input;			/*MCU data pins are inputs*/
+	uint8_t read_value;			/*driven on D0-D7 while E is high in a read*/
+
+	/*controller*/
+	uint8_t eight_bit;
+	uint8_t nibble_pending;		/*4-bit: high nibble latched, waiting for the low one*/
+	uint8_t nibble_high;
+	uint8_t read_low_next;		/*4-bit read: next E pulse returns the low nibble*/
+	uint8_t two_lines;
+	uint8_t display_on;
+	uint8_t increment;
+	uint8_t address;
+	uint8_t in_cgram;
+	uint8_t ddram[128];
+	uint8_t cgram[64];
+	uint32_t busy_until;
+
+	/*bookkeeping*/
+	uint32_t writes;			/*instructions + data bytes executed*/
+	uint32_t violations;
+}SIM_Hd44780_t;
+
+static SIM_Hd44780_t sim[SIM_DISPLAYS];
+static uint32_t sim_us = 0;
+static uint32_t sim_timer_ticks = 0;		/*0: stopped*/
+static uint32_t sim_interrupts = 0;
+static TIM_Callback_t sim_timer_callback = 0;
+static int failures = 0;
+
+static SIM_Hd44780_t* SIM_Find(GPIO_t* port, uint8_t pin, int8_t* data_bit){
+	for(uint8_t i = 0; i < SIM_DISPLAYS; i++){
+		SIM_Hd44780_t* lcd = &sim[i];
+		if(port == lcd->control_gpio && (pin == lcd->rs || pin == lcd->rw || pin == lcd->e)){
+			*data_bit = -1;
+			return lcd;
+		}
+		if(port == lcd->data_gpio){
+			for(uint8_t bit = 0; bit < 8; bit++){
+				if(lcd->data_pins[bit] == pin){
+					*data_bit = (int8_t)bit;
+					return lcd;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+static void SIM_Execute(SIM_Hd44780_t* lcd, uint8_t rs, uint8_t value){
+
+	uint32_t exec_us = SIM_EXEC_TIME_US;
+
+	if((sim_us < SIM_POWER_ON_US) || (sim_us < lcd->busy_until)){
+		lcd->violations++;
+	}
+	lcd->writes++;
+
+	if(rs){
+		if(lcd->in_cgram){
+			lcd->cgram[lcd->address & 0x3F] = value;
+			lcd->address = (lcd->address + 1) & 0x3F;
+		}else{
+			lcd->ddram[lcd->address & 0x7F] = value;
+			lcd->address = (lcd->address + (lcd->increment ? 1 : -1)) & 0x7F;
+		}
+	}else if(value & 0x80){
+		lcd->address = value & 0x7F;
+		lcd->in_cgram = 0;
+	}else if(value & 0x40){
+		lcd->address = value & 0x3F;
+		lcd->in_cgram = 1;
+	}else if(value & 0x20){
+		lcd->eight_bit = (value >> 4) & 1;
+		lcd->two_lines = (value >> 3) & 1;
+		lcd->nibble_pending = 0;
+	}else if(value & 0x10){
+		/*cursor/display shift, not used by the driver*/
+	}else if(value & 0x08){
+		lcd->display_on = (value >> 2) & 1;
+	}else if(value & 0x04){
+		lcd->increment = (value >> 1) & 1;
+	}else if(value & 0x02){
+		lcd->address = 0;
+		lcd->in_cgram = 0;
+		exec_us = SIM_EXEC_TIME_LONG_US;
+	}else if(value & 0x01){
+		memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+		lcd->address = 0;
+		lcd->in_cgram = 0;
+		lcd->increment = 1;
+		exec_us = SIM_EXEC_TIME_LONG_US;
+	}
+
+	lcd->busy_until = sim_us + ((exec_us * lcd->exec_scale_pct) / 100);
+}
+
+static void SIM_EdgeE(SIM_Hd44780_t* lcd, uint8_t rising){
+
+	if(!lcd->present){
+		return;
+	}
+	if(lcd->level_rw){
+		if(rising){
+			if(lcd->level_rs){
+				lcd->violations++;	/*the driver never reads data*/
+			}
+			uint8_t bf_ac = (uint8_t)(((sim_us < lcd->busy_until) ? 0x80 : 0) | (lcd->address & 0x7F));
+			if(lcd->eight_bit){
+				lcd->read_value = bf_ac;
+			}else{
+				lcd->read_value = lcd->read_low_next ? (uint8_t)(bf_ac << 4) : bf_ac;
+				lcd->read_low_next ^= 1;
+			}
+		}
+		return;
+	}
+
+	if(rising){
+		return;
+	}
+
+	/*falling edge: latch*/
+	uint8_t bus = lcd->level_data;
+	if(!lcd->wired_d0_d3){
+		bus &= 0xF0;
+	}
+	if(lcd->eight_bit){
+		SIM_Execute(lcd, lcd->level_rs, bus);
+	}else if(!lcd->nibble_pending){
+		lcd->nibble_high = bus & 0xF0;
+		lcd->nibble_pending = 1;
+	}else{
+		lcd->nibble_pending = 0;
+		SIM_Execute(lcd, lcd->level_rs, (uint8_t)(lcd->nibble_high | (bus >> 4)));
+	}
+}
+
+static void SIM_Reset(SIM_Hd44780_t* lcd, GPIO_t* data_gpio, GPIO_t* control_gpio, uint8_t wired_d0_d3){
+	memset(lcd, 0, sizeof(*lcd));
+	lcd->data_gpio = data_gpio;
+	lcd->control_gpio = control_gpio;
+	for(uint8_t bit = 0; bit < 8; bit++){
+		lcd->data_pins[bit] = bit;
+	}
+	lcd->rs = 8;
+	lcd->rw = 9;
+	lcd->e = 10;
+	lcd->wired_d0_d3 = wired_d0_d3;
+	lcd->present = 1;
+	lcd->exec_scale_pct = 100;
+	/*power on state: 8-bit, 1 line, random DDRAM*/
+	lcd->eight_bit = 1;
+	memset(lcd->ddram, 0xA5, sizeof(lcd->ddram));
+}
+
+/******************************* Stubs *******************************/
+void GPIO_SetPinMode(GPIO_t* port, GPIO_Pin_en pin, GPIO_Mode_en mode){
+	int8_t bit;
+	SIM_Hd44780_t* lcd = SIM_Find(port, (uint8_t)pin, &bit);
+	if(lcd && (bit >= 0)){
+		lcd->data_input = (mode == GPIO_INPUT);
+	}
+}
+
+void GPIO_SetPinState(GPIO_t* port, GPIO_Pin_en pin, GPIO_Pin_State_en state){
+	int8_t bit;
+	SIM_Hd44780_t* lcd = SIM_Find(port, (uint8_t)pin, &bit);
+	if(lcd == 0){
+		return;
+	}
+	if(bit >= 0){
+		lcd->level_data = (uint8_t)((lcd->level_data & ~(1U << bit)) | ((state ? 1U : 0U) << bit));
+	}else if(pin == lcd->rs){
+		lcd->level_rs = (uint8_t)state;
+	}else if(pin == lcd->rw){
+		lcd->level_rw = (uint8_t)state;
+	}else if(state != lcd->level_e){
+		lcd->level_e = (uint8_t)state;
+		SIM_EdgeE(lcd, (uint8_t)state);
+	}
+}
+
+GPIO_Pin_State_en GPIO_GetPinState(GPIO_t* port, GPIO_Pin_en pin){
+	int8_t bit;
+	SIM_Hd44780_t* lcd = SIM_Find(port, (uint8_t)pin, &bit);
+	if((lcd == 0) || (bit < 0) || !lcd->data_input){
+		return GPIO_LOW;
+	}
+	if(!lcd->present){
+		/*nobody drives the bus, pulled up*/
+		return GPIO_HIGH;
+	}
+	return (lcd->level_e && lcd->level_rw) ? (GPIO_Pin_State_en)((lcd->read_value >> bit) & 1) : GPIO_LOW;
+}
+
+void RCC_EnableAHB1Clock(RCC_AHB1PERIPH_en periph){
+	(void)periph;
+}
+
+void TIM_BasicInit(TIM_Peripheral_en tim, uint32_t tick_hz, TIM_Callback_t update_callback){
+	(void)tim;
+	TEST_CHECK(tick_hz == 1000000UL);
+	sim_timer_callback = update_callback;
+}
+
+void TIM_BasicStartOneShot(TIM_Peripheral_en tim, uint16_t ticks){
+	(void)tim;
+	/*same period as the driver: ARR = ticks - 1 clamped to 1*/
+	sim_timer_ticks = (ticks > 2) ? ticks : 2;
+}
+
+uint32_t LIB_EnterCritical(void){
+	return 0;
+}
+
+void LIB_ExitCritical(uint32_t primask){
+	(void)primask;
+}
+
+void LIB_SysTickDelay_us(uint16_t usec){
+	sim_us += usec;
+}
+
+void LIB_SysTickDelay_ms(uint32_t msec){
+	sim_us += msec * 1000UL;
+}
+
+void USART_SendChar(USART_Peripheral_en usart, uint8_t ch){
+	(void)usart;
+	(void)ch;
+}
+
+/******************************* Helpers *******************************/
+/*runs the timer interrupts until every display is idle, returns the simulated time it took*/
+static uint32_t TEST_Drain(void){
+	uint32_t start = sim_us;
+	while(sim_timer_ticks != 0){
+		uint32_t ticks = sim_timer_ticks;
+		sim_timer_ticks = 0;
+		sim_us += ticks;
+		sim_interrupts++;
+		sim_timer_callback();
+		if((sim_us - start) > 10000000UL){
+			TEST_CHECK(!"engine never stops");
+			break;
+		}
+	}
+	return sim_us - start;
+}
+
+static void TEST_Config(LCD_Handle_t* lcd, SIM_Hd44780_t* model, LCD_BusWidth_en width, uint8_t rows, uint8_t columns){
+	static const uint8_t rows2[LCD_MAX_ROWS] = {0x00, 0x40, 0x14, 0x54};
+	memset(lcd, 0, sizeof(*lcd));
+	lcd->configs.data_gpio = model->data_gpio;
+	lcd->configs.control_gpio = model->control_gpio;
+	for(uint8_t bit = 0; bit < 8; bit++){
+		lcd->configs.data_pins[bit] = (GPIO_Pin_en)model->data_pins[bit];
+	}
+	lcd->configs.rs = (GPIO_Pin_en)model->rs;
+	lcd->configs.rw = (GPIO_Pin_en)model->rw;
+	lcd->configs.e = (GPIO_Pin_en)model->e;
+	lcd->configs.bus_width = width;
+	lcd->configs.rows = rows;
+	lcd->configs.columns = columns;
+	memcpy(lcd->configs.row_address, rows2, sizeof(rows2));
+}
+
+static uint8_t TEST_DdramIs(SIM_Hd44780_t* model, uint8_t address, const char* text){
+	return memcmp(&model->ddram[address], text, strlen(text)) == 0;
+}
+
+/******************************* Tests *******************************/
+static LCD_Handle_t lcd8, lcd4;
+
+static void TEST_InitBothDisplays(void){
+
+	SIM_Reset(&sim[0], GPIOD, GPIOE, 1);
+	SIM_Reset(&sim[1], GPIOA, GPIOB, 0);
+	TEST_Config(&lcd8, &sim[0], LCD_BUS_8BIT, 2, 16);
+	TEST_Config(&lcd4, &sim[1], LCD_BUS_4BIT, 4, 20);
+
+	TEST_CHECK(LCD_Init(&lcd8) == 1);
+	TEST_CHECK(LCD_Init(&lcd4) == 1);
+	TEST_CHECK(!LCD_IsIdle(&lcd8));
+	TEST_Drain();
+
+	for(uint8_t i = 0; i < 2; i++){
+		TEST_CHECK(sim[i].violations == 0);
+		TEST_CHECK(sim[i].display_on == 1);
+		TEST_CHECK(sim[i].increment == 1);
+		TEST_CHECK(sim[i].ddram[0] == ' ' && sim[i].ddram[0x67] == ' ');
+	}
+	TEST_CHECK(sim[0].eight_bit == 1 && sim[0].two_lines == 1);
+	TEST_CHECK(sim[1].eight_bit == 0 && sim[1].two_lines == 1);
+	TEST_CHECK(LCD_IsIdle(&lcd8) && LCD_IsIdle(&lcd4));
+	TEST_CHECK(lcd8.bf_available == 1 && lcd4.bf_available == 1);
+}
+
+static void TEST_Print(void){
+
+	LCD_PrintString(&lcd8, (uint8_t*)"Hello");
+	LCD_SetCursor(&lcd4, 3, 2);
+	LCD_PrintInt32(&lcd4, INT32_MIN);
+	LCD_SetCursor(&lcd8, 1, 15);
+	LCD_PrintChar(&lcd8, '!');
+	uint32_t elapsed = TEST_Drain();
+
+	TEST_CHECK(TEST_DdramIs(&sim[0], 0x00, "Hello"));
+	TEST_CHECK(sim[0].ddram[0x4F] == '!');
+	TEST_CHECK(TEST_DdramIs(&sim[1], 0x54 + 2, "-2147483648"));
+	TEST_CHECK(sim[0].violations == 0 && sim[1].violations == 0);
+	/*both displays written concurrently: about the longer one's time, not the sum*/
+	TEST_CHECK(elapsed < (13 * 200));
+
+	LCD_SetSinkTarget(&lcd8);
+	LCD_SetCursor(&lcd8, 1, 0);
+	LIB_PrintHex32(LCD_SinkChar, 0xBEEF, 4);
+	TEST_Drain();
+	TEST_CHECK(TEST_DdramIs(&sim[0], 0x40, "BEEF"));
+}
+
+static void TEST_Glyphs(void){
+
+	static const uint8_t bell[8] = {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0xE0};
+	static const uint8_t heart[8] = {0x00, 0x0A, 0x1F, 0x1F, 0x0E, 0x04, 0x00, 0x00};
+
+	uint8_t bell_code = LCD_GlyphGet(&lcd8, bell);
+	uint8_t heart_code = LCD_GlyphGet(&lcd8, heart);
+	TEST_Drain();
+	uint32_t writes = sim[0].writes;
+
+	TEST_CHECK(bell_code == LCD_GLYPH_CODE_BASE && heart_code == LCD_GLYPH_CODE_BASE + 1);
+	TEST_CHECK(sim[0].cgram[0] == 0x04 && sim[0].cgram[7] == 0x00);	/*only the 5 LSBs are sent*/
+	TEST_CHECK(memcmp(&sim[0].cgram[8], heart, 8) == 0);
+
+	/*cached: no byte sent*/
+	TEST_CHECK(LCD_GlyphGet(&lcd8, bell) == bell_code);
+	TEST_Drain();
+	TEST_CHECK(sim[0].writes == writes);
+	TEST_CHECK(sim[0].violations == 0);
+}
+
+static void TEST_Framebuffer(void){
+
+	/*the queue isn't drained while the test thread is blocked, so keep a flush under LCD_ASYNC_QUEUE_SIZE bytes*/
+	LCD_FbWriteString(&lcd4, 0, 0, (uint8_t*)"Temp: 21.5 C");
+	LCD_FbWriteString(&lcd4, 1, 18, (uint8_t*)"clipped");
+	LCD_Flush(&lcd4);
+	TEST_Drain();
+	TEST_CHECK(TEST_DdramIs(&sim[1], 0x00, "Temp: 21.5 C        "));
+	TEST_CHECK(TEST_DdramIs(&sim[1], 0x40 + 18, "cl"));
+	TEST_CHECK(sim[1].ddram[0x40 + 20] == ' ');
+
+	/*two adjacent cells changed: one address command and two data bytes*/
+	LCD_FbWriteString(&lcd4, 0, 6, (uint8_t*)"19");
+	uint32_t writes = sim[1].writes;
+	TEST_CHECK(LCD_Flush(&lcd4) == 3);
+	TEST_Drain();
+	TEST_CHECK(sim[1].writes - writes == 3);
+	TEST_CHECK(TEST_DdramIs(&sim[1], 0x00, "Temp: 19.5 C"));
+
+	/*nothing changed: nothing sent*/
+	TEST_CHECK(LCD_Flush(&lcd4) == 0);
+	TEST_CHECK(sim[1].violations == 0);
+}
+
+static void TEST_SlowController(void){
+
+	/*a clone running at ~140 KHz: BF polling must still wait for it*/
+	sim[0].exec_scale_pct = 190;
+	LCD_SetCursor(&lcd8, 0, 0);
+	LCD_PrintString(&lcd8, (uint8_t*)"Slow clone");
+	TEST_Drain();
+	TEST_CHECK(TEST_DdramIs(&sim[0], 0x00, "Slow clone"));
+	TEST_CHECK(sim[0].violations == 0);
+	sim[0].exec_scale_pct = 100;
+}
+
+static void TEST_InterruptsPerByte(void){
+
+	/*BF is read before the execution time then every interval, not every tick: E pulse + two reads per byte (8-bit),
+	  plus the interrupt finding the queue drained*/
+	uint32_t interrupts = sim_interrupts;
+	LCD_SetCursor(&lcd8, 0, 0);
+	LCD_PrintString(&lcd8, (uint8_t*)"0123456789ABCDE");
+	TEST_Drain();
+	TEST_CHECK((sim_interrupts - interrupts) <= ((16 * 6) + 1));
+	TEST_CHECK(sim[0].violations == 0);
+}
+
+static void TEST_BusyFlagLatency(void){
+
+	/*the same bytes with BF polling, then with the fixed worst-case delays (the fallback of a missing BF)*/
+	LCD_SetCursor(&lcd8, 0, 0);
+	TEST_Drain();
+	LCD_PrintString(&lcd8, (uint8_t*)"polled busy flag");
+	uint32_t polled = TEST_Drain();
+
+	lcd8.bf_available = 0;
+	LCD_SetCursor(&lcd8, 0, 0);
+	TEST_Drain();
+	LCD_PrintString(&lcd8, (uint8_t*)"fixed delays    ");
+	uint32_t delays = TEST_Drain();
+	lcd8.bf_available = 1;
+
+	TEST_CHECK(polled < delays);
+	/*per byte: done within one poll interval of the 37 uS execution time*/
+	TEST_CHECK((polled / 16) < (SIM_EXEC_TIME_US + LCD_BUSY_POLL_INTERVAL_US));
+	TEST_CHECK(sim[0].violations == 0);
+}
+
+static void TEST_DisplayMissing(void){
+
+	/*BF reads stay high: the driver times out, falls back to the worst-case delays and doesn't hang*/
+	SIM_Reset(&sim[1], GPIOA, GPIOB, 0);
+	sim[1].present = 0;
+	TEST_Config(&lcd4, &sim[1], LCD_BUS_4BIT, 2, 16);
+	TEST_CHECK(LCD_Init(&lcd4) == 1);
+	LCD_PrintString(&lcd4, (uint8_t*)"nobody");
+	TEST_Drain();
+
+	TEST_CHECK(lcd4.bf_available == 0);
+	TEST_CHECK(LCD_IsIdle(&lcd4));
+
+	/*the other display is unaffected*/
+	LCD_SetCursor(&lcd8, 1, 0);
+	LCD_PrintString(&lcd8, (uint8_t*)"still ok");
+	TEST_Drain();
+	TEST_CHECK(TEST_DdramIs(&sim[0], 0x40, "still ok"));
+	TEST_CHECK(sim[0].violations == 0);
+}
+
+static void TEST_TooManyDisplays(void){
+
+	/*LCD_MAX_DISPLAYS already registered: the init fails and the APIs return instead of blocking on a full queue*/
+	static LCD_Handle_t extra;
+	SIM_Hd44780_t unused;
+	SIM_Reset(&unused, GPIOC, GPIOC, 1);
+	TEST_Config(&extra, &unused, LCD_BUS_8BIT, 2, 16);
+	TEST_CHECK(LCD_Init(&extra) == 0);
+	for(uint32_t i = 0; i < (2 * LCD_ASYNC_QUEUE_SIZE); i++){
+		LCD_PrintChar(&extra, 'x');
+	}
+	TEST_CHECK(LCD_IsIdle(&extra));
+
+	/*nothing reaches it: the flushed copy is left as is, so a later flush still sends every changed cell*/
+	memset(extra.fb_flushed, ' ', sizeof(extra.fb_flushed));
+	LCD_FbWriteString(&extra, 0, 0, (uint8_t*)"lost");
+	TEST_CHECK(LCD_Flush(&extra) == 0);
+	TEST_CHECK(extra.fb_flushed[0][0] == ' ' && extra.fb_flushed[0][3] == ' ');
+	TEST_CHECK(unused.writes == 0);
+
+	/*re-initializing a registered display still works*/
+	TEST_CHECK(LCD_Init(&lcd8) == 1);
+	TEST_Drain();
+	TEST_CHECK(sim[0].violations == 0);
+}
+
+/******************************* main *******************************/
+int main(void){
+
+	TEST_InitBothDisplays();
+	TEST_Print();
+	TEST_Glyphs();
+	TEST_Framebuffer();
+	TEST_SlowController();
+	TEST_InterruptsPerByte();
+	TEST_BusyFlagLatency();
+	TEST_DisplayMissing();
+	TEST_TooManyDisplays();
+
+	printf("test_lcd: %s (%lu timer interrupts, %lu uS simulated)\n", (failures == 0) ? "PASS" : "FAIL",
+			(unsigned long)sim_interrupts, (unsigned long)sim_us);
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file test_num_format.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of Lib/num_format against snprintf, and a benchmark of LIB_Format* vs snprintf and a
+ * 		  plain divide-by-10 itoa.
+ *
+ * # Running ?
+ * 		make -C Test/host test			(or "make bench" for the timing only)
+ * 		[♥] The timings compare the algorithms only (per call on the host CPU). On target snprintf also costs
+ * 			newlib's ~20 KB of formatting code and its reentrancy struct.
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "num_format.h"
+#include "usart.h"
+
+/*******************************  Macros *******************************/
+#define TEST_RANDOM_VALUES	(200000)
+#define TEST_BENCH_VALUES	(1000000)
+
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+/******************************* privates *******************************/
+static int failures = 0;
+static uint32_t lcg_state = 2026;
+static volatile uint32_t bench_sink = 0;
+
+static uint32_t TEST_Random(void){
+	lcg_state = (lcg_state * 1664525UL) + 1013904223UL;
+	return lcg_state;
+}
+
+/*random magnitudes spread over every digit count, not only 10-digit values*/
+static uint32_t TEST_RandomSpread(void){
+	return TEST_Random() >> (TEST_Random() % 32);
+}
+
+static double TEST_Seconds(void){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + ((double)now.tv_nsec * 1e-9);
+}
+
+/*the usual itoa: one division per digit, then reversed (not inlined, like the library calls)*/
+__attribute__((noinline)) static uint8_t TEST_Itoa(uint8_t* buf, int32_t value){
+	uint8_t len = 0;
+	uint32_t magnitude = (value < 0) ? (0UL - (uint32_t)value) : (uint32_t)value;
+	do{
+		buf[len++] = (uint8_t)('0' + (magnitude % 10));
+		magnitude /= 10;
+	}while(magnitude != 0);
+	if(value < 0){
+		buf[len++] = '-';
+	}
+	for(uint8_t i = 0; i < (len / 2); i++){
+		uint8_t tmp = buf[i];
+		buf[i] = buf[len - 1 - i];
+		buf[len - 1 - i] = tmp;
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+void USART_SendChar(USART_Peripheral_en usart, uint8_t msg){
+	(void)usart;
+	(void)msg;
+}
+
+/******************************* Tests *******************************/
+static void TEST_Integers(void){
+
+	static const int32_t edges[] = {0, 1, -1, 9, 10, -10, 99999, 100000, INT32_MAX, INT32_MIN, INT32_MIN + 1};
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	char ref[32];
+
+	for(uint32_t i = 0; i < (sizeof(edges) / sizeof(edges[0])); i++){
+		uint8_t len = LIB_FormatInt32(buf, edges[i]);
+		snprintf(ref, sizeof(ref), "%ld", (long)edges[i]);
+		TEST_CHECK(strcmp((char*)buf, ref) == 0 && len == strlen(ref));
+	}
+
+	for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+		uint32_t value = TEST_RandomSpread();
+
+		LIB_FormatUint32(buf, value);
+		snprintf(ref, sizeof(ref), "%lu", (unsigned long)value);
+		TEST_CHECK(strcmp((char*)buf, ref) == 0);
+
+		int32_t signed_value = (TEST_Random() & 1) ? -(int32_t)(value >> 1) : (int32_t)(value >> 1);
+		LIB_FormatInt32(buf, signed_value);
+		snprintf(ref, sizeof(ref), "%ld", (long)signed_value);
+		TEST_CHECK(strcmp((char*)buf, ref) == 0);
+
+		uint8_t digits = (uint8_t)(1 + (i % 8));
+		LIB_FormatHex32(buf, value, digits);
+		snprintf(ref, sizeof(ref), "%0*lX", digits, (unsigned long)value);
+		TEST_CHECK(strcmp((char*)buf, ref) == 0);
+	}
+}
+
+static void TEST_Fixed(void){
+
+	uint8_t buf[LIB_FORMAT_BUFFER_SIZE];
+	char ref[48];
+
+	/*known roundings: half up on the magnitude, no "-0.00"*/
+	LIB_FormatFixed(buf, 0x00018000, 16, 0);
+	TEST_CHECK(strcmp((char*)buf, "2") == 0);
+	LIB_FormatFixed(buf, -0x00008000, 16, 0);
+	TEST_CHECK(strcmp((char*)buf, "-1") == 0);
+	LIB_FormatFixed(buf, -1, 16, 2);
+	TEST_CHECK(strcmp((char*)buf, "0.00") == 0);
+	LIB_FormatFixed(buf, 0x0000FFFF, 16, 3);
+	TEST_CHECK(strcmp((char*)buf, "1.000") == 0);
+	LIB_FormatFixed(buf, INT32_MIN, 31, 9);
+	TEST_CHECK(strcmp((char*)buf, "-1.000000000") == 0);
+
+	for(uint32_t i = 0; i < TEST_RANDOM_VALUES; i++){
+		int32_t value = (int32_t)TEST_Random();
+		uint8_t frac_bits = (uint8_t)(TEST_Random() % 32);
+		uint8_t decimals = (uint8_t)(TEST_Random() % (LIB_FORMAT_MAX_DECIMALS + 1));
+
+		/*exact ties are rounded half up here and half even by printf, skip them*/
+		uint32_t magnitude = (value < 0) ? (0UL - (uint32_t)value) : (uint32_t)value;
+		unsigned __int128 scaled = (unsigned __int128)(magnitude & ((1ULL << frac_bits) - 1));
+		for(uint8_t d = 0; d < decimals; d++){
+			scaled *= 10;
+		}
+		if((frac_bits != 0) && ((scaled & ((1ULL << frac_bits) - 1)) == (1ULL << (frac_bits - 1)))){
+			continue;
+		}
+
+		LIB_FormatFixed(buf, value, frac_bits, decimals);
+		snprintf(ref, sizeof(ref), "%.*f", decimals, (double)value / (double)(1ULL << frac_bits));
+		char* expected = ref;
+		if((ref[0] == '-') && (strspn(&ref[1], "0.") == strlen(&ref[1]))){
+			expected++;
+		}
+		TEST_CHECK(strcmp((char*)buf, expected) == 0);
+	}
+}
+
+/******************************* Benchmark *******************************/
+static void TEST_Benchmark(void){
+
+	static int32_t values[1024];
+	uint8_t buf[32];
+	for(uint32_t i = 0; i < 1024; i++){
+		values[i] = (int32_t)TEST_RandomSpread();
+	}
+
+	double start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_VALUES; i++){
+		bench_sink += LIB_FormatInt32(buf, values[i & 1023]);
+	}
+	double lib = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_VALUES; i++){
+		bench_sink += TEST_Itoa(buf, values[i & 1023]);
+	}
+	double itoa = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_VALUES; i++){
+		bench_sink += (uint32_t)snprintf((char*)buf, sizeof(buf), "%ld", (long)values[i & 1023]);
+	}
+	double printf_time = TEST_Seconds() - start;
+
+	printf("int32   LIB_FormatInt32 %.1f ns   itoa %.1f ns   snprintf %.1f ns\n",
+			lib * 1e9 / TEST_BENCH_VALUES, itoa * 1e9 / TEST_BENCH_VALUES, printf_time * 1e9 / TEST_BENCH_VALUES);
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_VALUES; i++){
+		bench_sink += LIB_FormatFixed(buf, values[i & 1023], 16, 3);
+	}
+	lib = TEST_Seconds() - start;
+
+	start = TEST_Seconds();
+	for(uint32_t i = 0; i < TEST_BENCH_VALUES; i++){
+		bench_sink += (uint32_t)snprintf((char*)buf, sizeof(buf), "%.3f", (double)values[i & 1023] / 65536.0);
+	}
+	printf_time = TEST_Seconds() - start;
+
+	printf("Q16.16  LIB_FormatFixed %.1f ns   snprintf(%%.3f) %.1f ns\n",
+			lib * 1e9 / TEST_BENCH_VALUES, printf_time * 1e9 / TEST_BENCH_VALUES);
+}
+
+/******************************* main *******************************/
+int main(int argc, char** argv){
+
+	if((argc > 1) && (strcmp(argv[1], "bench") == 0)){
+		TEST_Benchmark();
+		return 0;
+	}
+
+	TEST_Integers();
+	TEST_Fixed();
+
+	printf("test_num_format: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file test_spi.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of MCAL/SPI transaction queue and SPI_GetStats() accounting over a simulated loopback
+ * 		  (MOSI wired to MISO).
+ *
+ * # How ?
+ * 		[♥] spi.c is included with SPI1-SPI3 pointing at RAM register blocks, the DMA driver is stubbed: the test
+ * 			moves the frames between the streams' memory addresses (TX -> RX) then raises the stream events the
+ * 			real DMA ISR would, including a TX transfer error in the middle of a transfer.
+ * 		[♥] The driver hands the DMA 32-bit addresses, on a 64-bit host they're mapped back to the test buffers.
+ *
+ * # Running ?
+ * 		make -C Test/host test
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <string.h>
+#include "spi.h"
+
+static SPI_t g_TEST_SPI[3];
+static GPIO_t g_TEST_CS_PORT;
+
+#undef SPI1
+#undef SPI2
+#undef SPI3
+#define SPI1	(&g_TEST_SPI[0])
+#define SPI2	(&g_TEST_SPI[1])
+#define SPI3	(&g_TEST_SPI[2])
+
+#include "../../MCAL/SPI/spi.c"
+
+/*******************************  Macros *******************************/
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+#define TEST_CS_PIN			GPIO_PIN3
+
+/******************************* DMA stub *******************************/
+typedef struct{
+	DMA_StreamConfig_t config;
+	uint32_t mem_addr;
+	uint16_t count;
+	uint16_t remaining;
+	uint8_t enabled;
+	uint8_t allocated;
+}TEST_Stream_t;
+
+static TEST_Stream_t g_TEST_STREAMS[2][8];
+static void* g_TEST_BUFFERS[16];
+static uint8_t g_TEST_BUFFERS_NUM = 0;
+static int failures = 0;
+
+uint8_t DMA_Allocate(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)channel;
+	if(g_TEST_STREAMS[dma][stream].allocated){
+		return 0;
+	}
+	g_TEST_STREAMS[dma][stream].allocated = 1;
+	return 1;
+}
+
+void DMA_Free(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)channel;
+	g_TEST_STREAMS[dma][stream].allocated = 0;
+}
+
+void DMA_Configure(DMA_Peripheral_en dma, DMA_Stream_en stream, const DMA_StreamConfig_t* config){
+	g_TEST_STREAMS[dma][stream].config = *config;
+}
+
+void DMA_Start(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem_addr, uint16_t count){
+	(void)periph_addr;
+	TEST_Stream_t* s = &g_TEST_STREAMS[dma][stream];
+	s->mem_addr = mem_addr;
+	s->count = count;
+	s->remaining = count;
+	s->enabled = 1;
+}
+
+void DMA_Stop(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	g_TEST_STREAMS[dma][stream].enabled = 0;
+}
+
+uint16_t DMA_GetRemaining(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	return g_TEST_STREAMS[dma][stream].remaining;
+}
+
+void RCC_EnableAPB1Clock(RCC_APB1PERIPH_en periph){
+	(void)periph;
+}
+
+void RCC_EnableAPB2Clock(RCC_APB2PERIPH_en periph){
+	(void)periph;
+}
+
+uint32_t LIB_EnterCritical(void){
+	return 0;
+}
+
+void LIB_ExitCritical(uint32_t primask){
+	(void)primask;
+}
+
+/******************************* Loopback *******************************/
+static void TEST_Register(void* buffer){
+	g_TEST_BUFFERS[g_TEST_BUFFERS_NUM++] = buffer;
+}
+
+static uint8_t* TEST_Pointer(uint32_t addr){
+	for(uint8_t i = 0; i < g_TEST_BUFFERS_NUM; i++){
+		if((uint32_t)(uintptr_t)g_TEST_BUFFERS[i] == addr){
+			return (uint8_t*)g_TEST_BUFFERS[i];
+		}
+	}
+	TEST_CHECK(!"DMA address of an unknown buffer");
+	return 0;
+}
+
+/**
+ * @brief Clocks up to max_frames frames of the running transfer: each TX frame comes back as the RX frame,
+ * 		  then raises RX completion (or a TX error after error_after frames). Returns 0 if nothing runs.
+ */
+static uint8_t TEST_RunBus(SPI_Peripheral_en spi, uint32_t error_after){
+
+	const SPI_DmaRequest_t* request = &g_SPI_DMA[spi];
+	TEST_Stream_t* rx = &g_TEST_STREAMS[request->dma][request->rx_stream];
+	TEST_Stream_t* tx = &g_TEST_STREAMS[request->dma][request->tx_stream];
+
+	if(!rx->enabled || !tx->enabled || !GET_BIT(g_TEST_SPI[spi].CR2, SPI_CR2_TXDMAEN)){
+		return 0;
+	}
+	uint8_t size = (rx->config.mem_size == DMA_SIZE_HALF_WORD) ? 2 : 1;
+	uint8_t* tx_mem = TEST_Pointer(tx->mem_addr);
+	uint8_t* rx_mem = TEST_Pointer(rx->mem_addr);
+
+	uint32_t frame = 0;
+	while(rx->remaining != 0){
+		if(frame == error_after){
+			if(!(tx->config.interrupts & DMA_IT_ERROR) || (tx->config.callback == 0)){
+				//error not reported: the stream stops and the transfer hangs
+				tx->enabled = 0;
+				return 0;
+			}
+			tx->config.callback(tx->config.context, DMA_EVENT_ERROR);
+			return 1;
+		}
+		memcpy(rx_mem, tx_mem, size);
+		if(tx->config.mem_inc == DMA_INCREMENT_ENABLED){
+			tx_mem += size;
+		}
+		if(rx->config.mem_inc == DMA_INCREMENT_ENABLED){
+			rx_mem += size;
+		}
+		tx->remaining--;
+		rx->remaining--;
+		frame++;
+	}
+	rx->enabled = 0;
+	tx->enabled = 0;
+	rx->config.callback(rx->config.context, DMA_EVENT_COMPLETE);
+	return 1;
+}
+
+static uint32_t g_TEST_DONE_ORDER[32];
+static uint8_t g_TEST_DONE_NUM = 0;
+
+static void TEST_Done(void* context){
+	g_TEST_DONE_ORDER[g_TEST_DONE_NUM++ & 31] = (uint32_t)(uintptr_t)context;
+}
+
+/******************************* Tests *******************************/
+static void TEST_QueueAndStats(void){
+
+	static uint8_t tx_a[5] = {1, 2, 3, 4, 5}, rx_a[5];
+	static uint8_t tx_b[300], rx_b[300];
+	static uint8_t rx_c[3];
+	SPI_Config_t config = {.max_hz = 1000000, .mode = SPI_MODE3, .frame = SPI_FRAME_8BIT, .bit_order = SPI_MSB_FIRST};
+	SPI_Stats_t stats;
+
+	for(uint32_t i = 0; i < sizeof(tx_b); i++){
+		tx_b[i] = (uint8_t)(i * 7);
+	}
+	TEST_Register(tx_a);
+	TEST_Register(rx_a);
+	TEST_Register(tx_b);
+	TEST_Register(rx_b);
+	TEST_Register(rx_c);
+	TEST_Register((void*)&g_SPI_DUMMY_TX);
+	TEST_Register(&g_SPI_DUMMY_RX);
+
+	/*16 MHz / 16 = 1 MHz*/
+	TEST_CHECK(SPI_Init(SPI_SPI1, &config) == 1000000);
+	/*the streams are owned now*/
+	TEST_CHECK(SPI_Init(SPI_SPI1, &config) == 0);
+
+	SPI_Transfer_t a = {&g_TEST_CS_PORT, TEST_CS_PIN, tx_a, rx_a, sizeof(tx_a), TEST_Done, (void*)1};
+	SPI_Transfer_t b = {&g_TEST_CS_PORT, TEST_CS_PIN, tx_b, rx_b, sizeof(tx_b), TEST_Done, (void*)2};
+	SPI_Transfer_t c = {&g_TEST_CS_PORT, TEST_CS_PIN, 0, rx_c, sizeof(rx_c), TEST_Done, (void*)3};
+	SPI_Transfer_t d = {0, TEST_CS_PIN, tx_a, 0, 2, TEST_Done, (void*)4};
+
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &a));
+	/*started right away, chip select asserted*/
+	TEST_CHECK(g_TEST_CS_PORT.BSRR == (1UL << (TEST_CS_PIN + 16)));
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &b));
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &c));
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &d));
+	TEST_CHECK(!SPI_IsIdle(SPI_SPI1));
+
+	while(TEST_RunBus(SPI_SPI1, UINT32_MAX));
+
+	TEST_CHECK(SPI_IsIdle(SPI_SPI1));
+	/*last chip-selected transfer released it*/
+	TEST_CHECK(g_TEST_CS_PORT.BSRR == (1UL << TEST_CS_PIN));
+	TEST_CHECK(memcmp(rx_a, tx_a, sizeof(tx_a)) == 0);
+	TEST_CHECK(memcmp(rx_b, tx_b, sizeof(tx_b)) == 0);
+	TEST_CHECK(rx_c[0] == 0xFF && rx_c[2] == 0xFF);
+	TEST_CHECK(g_TEST_DONE_NUM == 4 && g_TEST_DONE_ORDER[0] == 1 && g_TEST_DONE_ORDER[3] == 4);
+	TEST_CHECK(!GET_BIT(SPI1->CR2, SPI_CR2_TXDMAEN) && !GET_BIT(SPI1->CR2, SPI_CR2_RXDMAEN));
+
+	SPI_GetStats(SPI_SPI1, &stats);
+	TEST_CHECK(stats.transfers == 4);
+	TEST_CHECK(stats.frames == 5 + 300 + 3 + 2);
+	TEST_CHECK(stats.rejected == 0 && stats.errors == 0);
+
+	/*queue full: SPI_QUEUE_SIZE accepted, the next one rejected and counted*/
+	for(uint8_t i = 0; i < SPI_QUEUE_SIZE; i++){
+		TEST_CHECK(SPI_Queue(SPI_SPI1, &a));
+	}
+	TEST_CHECK(!SPI_Queue(SPI_SPI1, &a));
+	while(TEST_RunBus(SPI_SPI1, UINT32_MAX));
+	SPI_GetStats(SPI_SPI1, &stats);
+	TEST_CHECK(stats.transfers == 4 + SPI_QUEUE_SIZE);
+	TEST_CHECK(stats.rejected == 1);
+
+	/*zero frames: accepted, nothing runs*/
+	SPI_Transfer_t empty = {&g_TEST_CS_PORT, TEST_CS_PIN, tx_a, rx_a, 0, 0, 0};
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &empty));
+	TEST_CHECK(SPI_IsIdle(SPI_SPI1));
+}
+
+static void TEST_TxError(void){
+
+	static uint8_t tx[64], rx[64];
+	SPI_Stats_t before, after;
+	TEST_Register(tx);
+	TEST_Register(rx);
+
+	const SPI_DmaRequest_t* request = &g_SPI_DMA[SPI_SPI1];
+	SPI_GetStats(SPI_SPI1, &before);
+	g_TEST_DONE_NUM = 0;
+
+	SPI_Transfer_t broken = {&g_TEST_CS_PORT, TEST_CS_PIN, tx, rx, sizeof(tx), TEST_Done, (void*)5};
+	SPI_Transfer_t next = {&g_TEST_CS_PORT, TEST_CS_PIN, tx, rx, 16, TEST_Done, (void*)6};
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &broken));
+	TEST_CHECK(SPI_Queue(SPI_SPI1, &next));
+
+	/*the TX stream must report its errors, RX alone would wait forever for frames that never come*/
+	TEST_CHECK(g_TEST_STREAMS[request->dma][request->tx_stream].config.interrupts & DMA_IT_ERROR);
+	TEST_CHECK(g_TEST_STREAMS[request->dma][request->tx_stream].config.callback != 0);
+
+	/*TX bus error after 10 frames: the transfer ends, the next one runs (SPI_TransferBlocking() returns)*/
+	TEST_CHECK(TEST_RunBus(SPI_SPI1, 10));
+	TEST_CHECK(g_TEST_DONE_NUM == 1 && g_TEST_DONE_ORDER[0] == 5);
+	while(TEST_RunBus(SPI_SPI1, UINT32_MAX));
+	TEST_CHECK(SPI_IsIdle(SPI_SPI1));
+
+	SPI_GetStats(SPI_SPI1, &after);
+	TEST_CHECK(after.errors == before.errors + 1);
+	TEST_CHECK(after.transfers == before.transfers + 2);
+	TEST_CHECK(after.frames == before.frames + 10 + 16);
+}
+
+static void TEST_Frames16(void){
+
+	static uint16_t tx[4] = {0x1234, 0xABCD, 0x0001, 0xFFFE}, rx[4];
+	SPI_Config_t config = {.max_hz = 20000000, .mode = SPI_MODE0, .frame = SPI_FRAME_16BIT, .bit_order = SPI_MSB_FIRST};
+	SPI_Stats_t stats;
+	TEST_Register(tx);
+	TEST_Register(rx);
+
+	/*above PCLK / 2: the fastest prescaler*/
+	TEST_CHECK(SPI_Init(SPI_SPI2, &config) == 8000000);
+	TEST_CHECK(GET_BIT(SPI2->CR1, SPI_CR1_DFF));
+
+	SPI_Transfer_t t = {0, TEST_CS_PIN, tx, rx, 4, 0, 0};
+	TEST_CHECK(SPI_Queue(SPI_SPI2, &t));
+	while(TEST_RunBus(SPI_SPI2, UINT32_MAX));
+
+	TEST_CHECK(memcmp(rx, tx, sizeof(tx)) == 0);
+	SPI_GetStats(SPI_SPI2, &stats);
+	TEST_CHECK(stats.transfers == 1 && stats.frames == 4);
+}
+
+/******************************* main *******************************/
+int main(void){
+
+	TEST_QueueAndStats();
+	TEST_TxError();
+	TEST_Frames16();
+
+	printf("test_spi: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
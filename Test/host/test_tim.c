@@ -0,0 +1,256 @@
+/**
+ * @file test_tim.c
+ * @author Ali Shabana
+ * @date Oct 19, 2026
+ *
+ * @brief Host test of the MCAL/TIM 16-bit encoder extension to 32 bits across the 0x0000/0xFFFF wrap.
+ *
+ * # How ?
+ * 		[♥] tim.c is included with TIM1-TIM14 pointing at RAM register blocks, RCC/NVIC/DMA are stubbed.
+ * 		[♥] The encoder model steps TIM3 CNT one count at a time like the encoder interface: UIF at each wrap,
+ * 			CC3IF when CNT matches CCR3, and the update ISR only runs when the test lets it (interrupt latency),
+ * 			so several wraps can be pending on a single UIF.
+ *
+ * # Running ?
+ * 		make -C Test/host test
+ */
+/******************************* Includes *******************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "tim.h"
+
+static TIM_t g_TEST_TIM[14];
+
+#undef TIM1
+#undef TIM2
+#undef TIM3
+#undef TIM4
+#undef TIM5
+#undef TIM6
+#undef TIM7
+#undef TIM8
+#undef TIM9
+#undef TIM10
+#undef TIM11
+#undef TIM12
+#undef TIM13
+#undef TIM14
+#define TIM1	(&g_TEST_TIM[0])
+#define TIM2	(&g_TEST_TIM[1])
+#define TIM3	(&g_TEST_TIM[2])
+#define TIM4	(&g_TEST_TIM[3])
+#define TIM5	(&g_TEST_TIM[4])
+#define TIM6	(&g_TEST_TIM[5])
+#define TIM7	(&g_TEST_TIM[6])
+#define TIM8	(&g_TEST_TIM[7])
+#define TIM9	(&g_TEST_TIM[8])
+#define TIM10	(&g_TEST_TIM[9])
+#define TIM11	(&g_TEST_TIM[10])
+#define TIM12	(&g_TEST_TIM[11])
+#define TIM13	(&g_TEST_TIM[12])
+#define TIM14	(&g_TEST_TIM[13])
+
+#include "../../MCAL/TIM/tim.c"
+
+/*******************************  Macros *******************************/
+#define TEST_CHECK(cond)	do{ if(!(cond)){ printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #cond); failures++; } }while(0)
+
+/******************************* Stubs *******************************/
+static int failures = 0;
+
+void RCC_EnableAPB1Clock(RCC_APB1PERIPH_en periph){
+	(void)periph;
+}
+
+void RCC_EnableAPB2Clock(RCC_APB2PERIPH_en periph){
+	(void)periph;
+}
+
+void NVIC_EnableIRQ(int16_t irq){
+	(void)irq;
+}
+
+uint8_t DMA_Allocate(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)dma;
+	(void)stream;
+	(void)channel;
+	return 1;
+}
+
+void DMA_Free(DMA_Peripheral_en dma, DMA_Stream_en stream, uint8_t channel){
+	(void)dma;
+	(void)stream;
+	(void)channel;
+}
+
+void DMA_Configure(DMA_Peripheral_en dma, DMA_Stream_en stream, const DMA_StreamConfig_t* config){
+	(void)dma;
+	(void)stream;
+	(void)config;
+}
+
+void DMA_Start(DMA_Peripheral_en dma, DMA_Stream_en stream, uint32_t periph_addr, uint32_t mem_addr, uint16_t count){
+	(void)dma;
+	(void)stream;
+	(void)periph_addr;
+	(void)mem_addr;
+	(void)count;
+}
+
+uint16_t DMA_GetRemaining(DMA_Peripheral_en dma, DMA_Stream_en stream){
+	(void)dma;
+	(void)stream;
+	return 0;
+}
+
+uint32_t LIB_EnterCritical(void){
+	return 0;
+}
+
+void LIB_ExitCritical(uint32_t primask){
+	(void)primask;
+}
+
+void LIB_JitterReset(LIB_Jitter_t* jitter){
+	*jitter = (LIB_Jitter_t){0};
+}
+
+void LIB_JitterRecord(LIB_Jitter_t* jitter){
+	jitter->samples++;
+}
+
+/******************************* Encoder model *******************************/
+/*Position the encoder really is at*/
+static int32_t g_TEST_POSITION = 0;
+
+/**
+ * @func TEST_Move
+ * @brief Moves the TIM3 encoder by counts, one edge at a time, without running the update ISR.
+ */
+static void TEST_Move(int32_t counts){
+
+	TIM_t* tim = TIM3;
+	int32_t step = (counts < 0) ? -1 : 1;
+
+	for(int32_t i = 0; i != counts; i += step){
+		if((step > 0) && (tim->CNT == tim->ARR)){
+			tim->CNT = 0;
+			SET_BIT(tim->SR, TIM_SR_UIF);
+		}else if((step < 0) && (tim->CNT == 0)){
+			tim->CNT = tim->ARR;
+			SET_BIT(tim->SR, TIM_SR_UIF);
+		}else{
+			tim->CNT += step;
+		}
+		if(tim->CNT == tim->CCR3){
+			SET_BIT(tim->SR, TIM_SR_CC3IF);
+		}
+		g_TEST_POSITION += step;
+	}
+}
+
+/**
+ * @func TEST_Isr
+ * @brief Lets the pending update interrupt of TIM3 run.
+ */
+static void TEST_Isr(void){
+	if(GET_BIT(TIM3->SR, TIM_SR_UIF) && GET_BIT(TIM3->DIER, TIM_DIER_UIE)){
+		TIM3_IRQHandler();
+		//rc_w0: the ISR serves UIF and CC3IF, in RAM its write of ~flags also sets the other bits
+		TIM3->SR = 0;
+	}
+}
+
+/******************************* Tests *******************************/
+static void TEST_Init(void){
+
+	TIM_EncoderConfig_t config = {.mode = TIM_ENCODER_TI12, .filter = 0, .direction = TIM_ENCODER_DIRECTION_NORMAL};
+
+	TEST_CHECK(TIM_EncoderInit(TIM_TIM3, &config));
+	TEST_CHECK(TIM3->ARR == TIM_MAX_16BIT_VALUE);
+	TEST_CHECK(GET_BIT(TIM3->DIER, TIM_DIER_UIE));
+	g_TEST_POSITION = 0;
+	TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == 0);
+}
+
+/*Dithering over the wrap with the ISR served after every move*/
+static void TEST_BackAndForth(void){
+
+	static const int32_t moves[] = {-1, 1, -1, 2, -3, 1, 1, -5, 7, -2, -4, 3};
+
+	for(uint8_t i = 0; i < (sizeof(moves) / sizeof(moves[0])); i++){
+		TEST_Move(moves[i]);
+		TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+		TEST_Isr();
+		TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+	}
+}
+
+/*Several wraps before the ISR runs (one UIF): CNT alone at ISR time can't tell how many there were*/
+static void TEST_CoalescedWraps(void){
+
+	static const int32_t bursts[][3] = {
+			{-3, 2, 0},		/*underflow, overflow: back in the lower half, no wrap left*/
+			{-2, 4, -3},	/*underflow, overflow, underflow*/
+			{3, -2, 0},		/*overflow, underflow*/
+			{-4, 0, 0},		/*single underflow, farther than the dithering*/
+			{5, -5, 5},		/*overflow, underflow, overflow*/
+	};
+
+	for(uint8_t i = 0; i < (sizeof(bursts) / sizeof(bursts[0])); i++){
+		for(uint8_t j = 0; j < 3; j++){
+			TEST_Move(bursts[i][j]);
+		}
+		TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+		TEST_Isr();
+		TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+	}
+}
+
+/*Full turns both ways, and half turns coming back through the middle, the ISR a few counts late*/
+static void TEST_Turns(void){
+
+	static const int32_t moves[] = {70000, 70000, -140000, -70000, 0xC000, -0xC000, -0xC000, 0xC000, 3 * 65536};
+
+	for(uint8_t i = 0; i < (sizeof(moves) / sizeof(moves[0])); i++){
+		int32_t left = moves[i];
+		while(left != 0){
+			int32_t chunk = (abs(left) > 1000) ? ((left < 0) ? -1000 : 1000) : left;
+			TEST_Move(chunk);
+			left -= chunk;
+			TEST_Isr();
+		}
+		TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+	}
+}
+
+/*Homing anywhere, then dithering over the wrap again*/
+static void TEST_SetPosition(void){
+
+	TIM_EncoderSetPosition(TIM_TIM3, -65537);
+	g_TEST_POSITION = -65537;
+	TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == -65537);
+
+	TEST_Move(3);
+	TEST_Move(-2);
+	TEST_Isr();
+	TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+	TEST_Move(-5);
+	TEST_Isr();
+	TEST_Move(-40000);
+	TEST_Isr();
+	TEST_CHECK(TIM_EncoderGetPosition(TIM_TIM3) == g_TEST_POSITION);
+}
+
+/******************************* main *******************************/
+int main(void){
+
+	TEST_Init();
+	TEST_BackAndForth();
+	TEST_CoalescedWraps();
+	TEST_Turns();
+	TEST_SetPosition();
+
+	printf("test_tim: %s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}